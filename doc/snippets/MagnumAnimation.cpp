@@ -38,6 +38,15 @@
 using namespace Magnum;
 using namespace Magnum::Math::Literals;
 
+namespace {
+
+struct JobSystem {
+    template<class F> void submit(F&&) {}
+    void wait() {}
+};
+
+}
+
 int main() {
 
 {
@@ -207,6 +216,37 @@ player.advance(std::chrono::system_clock::now().time_since_epoch());
 /* [Player-usage-chrono] */
 }
 
+{
+struct Character {
+    Animation::Player<Float> player;
+};
+Timeline timeline;
+/* [PlayerBatch-usage] */
+Containers::Array<Character> characters;
+
+Animation::PlayerBatch<Float> batch;
+for(Character& character: characters)
+    batch.add(character.player);
+
+// every frame
+batch.advance(timeline.previousFrameTime());
+/* [PlayerBatch-usage] */
+
+JobSystem jobs;
+/* [PlayerBatch-usage-threads] */
+const std::size_t count = batch.prepare(timeline.previousFrameTime());
+
+// evaluate in chunks of 1024 tracks across worker threads
+std::size_t chunkSize = 1024;
+for(std::size_t offset = 0; offset < count; offset += chunkSize)
+    jobs.submit([&batch, offset, count, chunkSize]{
+        batch.evaluate(offset, count - offset < chunkSize ?
+                               count - offset : chunkSize);
+    });
+jobs.wait();
+/* [PlayerBatch-usage-threads] */
+}
+
 {
 /* [Player-higher-order] */
 struct Data {
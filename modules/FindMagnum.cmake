@@ -85,6 +85,8 @@
 #  WglContext                   - WGL context
 #  OpenGLTester                 - OpenGLTester class
 #  VulkanTester                 - VulkanTester class
+#  BlobImporter                 - Magnum blob importer plugin
+#  BlobSceneConverter           - Magnum blob scene converter plugin
 #  MagnumFont                   - Magnum bitmap font plugin
 #  MagnumFontConverter          - Magnum bitmap font converter plugin
 #  ObjImporter                  - OBJ importer plugin
@@ -360,8 +362,9 @@ set(_MAGNUM_LIBRARY_COMPONENTS
     WindowlessEglApplication EglContext OpenGLTester)
 set(_MAGNUM_PLUGIN_COMPONENTS
     AnyAudioImporter AnyImageConverter AnyImageImporter AnySceneConverter
-    AnySceneImporter MagnumFont MagnumFontConverter ObjImporter
-    TgaImageConverter TgaImporter WavAudioImporter)
+    AnySceneImporter BlobImporter BlobSceneConverter MagnumFont
+    MagnumFontConverter ObjImporter TgaImageConverter TgaImporter
+    WavAudioImporter)
 set(_MAGNUM_EXECUTABLE_COMPONENTS
     imageconverter sceneconverter shaderconverter gl-info al-info)
 # Audio and Vk libs aren't enabled by default, and none of the Context,
@@ -890,6 +893,14 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         elseif(_component STREQUAL MeshTools)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES CompressIndices.h)
 
+            # Multithreaded algorithms need to link to the platform threading
+            # library in case of a static build
+            if(MAGNUM_BUILD_STATIC)
+                find_package(Threads REQUIRED)
+                set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES Threads::Threads)
+            endif()
+
         # OpenGLTester library
         elseif(_component STREQUAL OpenGLTester)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_SUFFIX Magnum/GL)
@@ -904,6 +915,16 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
 
         # No special setup for SceneGraph library
 
+        # SceneTools library
+        elseif(_component STREQUAL SceneTools)
+            # Multithreaded algorithms need to link to the platform threading
+            # library in case of a static build
+            if(MAGNUM_BUILD_STATIC)
+                find_package(Threads REQUIRED)
+                set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES Threads::Threads)
+            endif()
+
         # ShaderTools library
         elseif(_component STREQUAL ShaderTools)
             set_property(TARGET Magnum::${_component} APPEND PROPERTY
@@ -936,9 +957,11 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         # No special setup for AnyImageConverter plugin
         # No special setup for AnyImageImporter plugin
         # No special setup for AnySceneImporter plugin
+        # No special setup for BlobImporter plugin
+        # No special setup for BlobSceneConverter plugin
         # No special setup for MagnumFont plugin
         # No special setup for MagnumFontConverter plugin
-        # No special setup for ObjImporter plugin
+        # ObjImporter plugin setup is done below, only for a static build
         # No special setup for TgaImageConverter plugin
         # No special setup for TgaImporter plugin
         # No special setup for WavAudioImporter plugin
@@ -960,6 +983,14 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
             if(NOT _magnum${_component}_BUILD_STATIC EQUAL -1)
                 set_property(TARGET Magnum::${_component} APPEND PROPERTY
                     INTERFACE_SOURCES ${_MAGNUM_${_COMPONENT}_INCLUDE_DIR}/importStaticPlugin.cpp)
+
+                # ObjImporter parses on multiple threads, needs to link to the
+                # platform threading library in case of a static build
+                if(_component STREQUAL ObjImporter)
+                    find_package(Threads REQUIRED)
+                    set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                        INTERFACE_LINK_LIBRARIES Threads::Threads)
+                endif()
             endif()
         endif()
 
@@ -43,8 +43,10 @@ template<class V> using ResultOf = typename Implementation::ResultTraits<V>::Typ
 
 enum class Interpolation: UnsignedByte;
 enum class Extrapolation: UnsignedByte;
+enum class KeyframeSearch: UnsignedByte;
 
 template<class T, class K = T> class Player;
+template<class T, class K = T> class PlayerBatch;
 
 template<class K, class V, class R = ResultOf<V>> class Track;
 template<class K> class TrackViewStorage;
@@ -69,6 +69,25 @@ Debug& operator<<(Debug& debug, const Extrapolation value) {
 
     return debug << (packed ? "" : "(") << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << (packed ? "" : ")");
 }
+
+Debug& operator<<(Debug& debug, const KeyframeSearch value) {
+    const bool packed = debug.immediateFlags() >= Debug::Flag::Packed;
+
+    if(!packed)
+        debug << "Animation::KeyframeSearch" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case KeyframeSearch::value: return debug << (packed ? "" : "::") << Debug::nospace << #value;
+        _c(Linear)
+        _c(Binary)
+        _c(Uniform)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << (packed ? "" : "(") << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << (packed ? "" : ")");
+}
 #endif
 
 namespace Implementation {
@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Alias @ref Magnum::Animation::ResultOf, enum @ref Magnum::Animation::Interpolation. @ref Magnum::Animation::Extrapolation, function @ref Magnum::Animation::interpolatorFor(), @ref Magnum::Animation::interpolate(), @ref Magnum::Animation::interpolateStrict(), @ref Magnum::Animation::ease(), @ref Magnum::Animation::easeClamped() @ref Magnum::Animation::unpack(), @ref Magnum::Animation::unpackEase(), @ref Magnum::Animation::unpackEaseClamped()
+ * @brief Alias @ref Magnum::Animation::ResultOf, enum @ref Magnum::Animation::Interpolation. @ref Magnum::Animation::Extrapolation, @ref Magnum::Animation::KeyframeSearch, function @ref Magnum::Animation::interpolatorFor(), @ref Magnum::Animation::interpolate(), @ref Magnum::Animation::interpolateStrict(), @ref Magnum::Animation::ease(), @ref Magnum::Animation::easeClamped() @ref Magnum::Animation::unpack(), @ref Magnum::Animation::unpackEase(), @ref Magnum::Animation::unpackEaseClamped()
  */
 
 #include <Corrade/Containers/StridedArrayView.h>
@@ -162,6 +162,56 @@ enum class Extrapolation: UnsignedByte {
 /** @debugoperatorenum{Extrapolation} */
 MAGNUM_EXPORT Debug& operator<<(Debug& debug, Extrapolation value);
 
+/**
+@brief Keyframe search strategy
+@m_since_latest
+
+Describes how @ref interpolate() and @ref interpolateStrict() find the
+keyframe pair around given frame. All strategies give the same result for
+keys sorted in an ascending order, they differ only in performance
+characteristics.
+@see @ref Track::at(K, std::size_t&, KeyframeSearch) const,
+    @ref TrackView::at(K, std::size_t&, KeyframeSearch) const
+@experimental
+*/
+enum class KeyframeSearch: UnsignedByte {
+    /**
+     * Linear search starting at the hint, restarted from the first keyframe if
+     * the frame is earlier than the hint. Best suited for short tracks and
+     * for playback going forward in small steps, where the matching keyframe
+     * is usually found after at most a few iterations. Rewinding or reverse
+     * playback is @f$ \mathcal{O}(n) @f$ in the number of keyframes.
+     */
+    Linear,
+
+    /**
+     * Exponential search in either direction from the hint, followed by a
+     * binary search in the bracketed range. Costs
+     * @f$ \mathcal{O}(\log d) @f$ in the distance from the hint, which means
+     * it's nearly as fast as @ref KeyframeSearch::Linear for forward playback
+     * while staying fast for random seeking and reverse playback on long
+     * tracks.
+     */
+    Binary,
+
+    /**
+     * Keyframe index calculated directly from the frame, assuming the keys
+     * are uniformly spaced between the first and the last keyframe, which is
+     * common for sampled or motion-captured data. The hint isn't used as a
+     * starting point but is still updated. The calculated index is verified
+     * and adjusted using a linear search, so the result is correct even for
+     * non-uniformly spaced keys, but the lookup isn't
+     * @f$ \mathcal{O}(1) @f$ anymore in that case.
+     */
+    Uniform
+};
+
+/**
+@debugoperatorenum{KeyframeSearch}
+@m_since_latest
+*/
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, KeyframeSearch value);
+
 /**
 @brief Interpolate animation value
 @tparam K           Key type
@@ -174,8 +224,9 @@ MAGNUM_EXPORT Debug& operator<<(Debug& debug, Extrapolation value);
 @param interpolator Interpolator function
 @param frame        Frame at which to interpolate
 @param hint         Hint for keyframe search
+@param search       Keyframe search strategy
 
-Does a linear search over the keyframes until it finds last keyframe which is
+Searches the keyframes using @p search until it finds last keyframe which is
 not larger than @p frame. Once the keyframe is found, reference to it and the immediately following keyframe is passed to @p interpolator along with
 calculated interpolation factor, returning the interpolated value.
 
@@ -187,9 +238,10 @@ calculated interpolation factor, returning the interpolated value.
     the interpolator.
 -   In case no keyframes are present, default-constructed value is returned.
 
-The @p hint parameter hints where to start the linear search and is updated
-with keyframe index matching @p frame. If @p frame is earlier than @p hint, the
-search is restarted from the beginning.
+The @p hint parameter hints where to start the search and is updated with
+keyframe index matching @p frame. With @ref KeyframeSearch::Linear, if
+@p frame is earlier than @p hint, the search is restarted from the beginning.
+See @ref KeyframeSearch for details about other strategies.
 
 Used internally from @ref Track::at() / @ref TrackView::at(), see @ref Track
 documentation for more information.
@@ -198,17 +250,18 @@ documentation for more information.
     @ref Math::slerp(), @ref Math::sclerp()
 @experimental
 */
-template<class K, class V, class R = ResultOf<V>> R interpolate(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, Extrapolation before, Extrapolation after, R(*interpolator)(const V&, const V&, Float), K frame, std::size_t& hint);
+template<class K, class V, class R = ResultOf<V>> R interpolate(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, Extrapolation before, Extrapolation after, R(*interpolator)(const V&, const V&, Float), K frame, std::size_t& hint, KeyframeSearch search = KeyframeSearch::Linear);
 
 /**
 @brief Interpolate animation value with strict constraints
 
-Does a linear search over the keyframes until it finds last keyframe which is
+Searches the keyframes using @p search until it finds last keyframe which is
 not larger than @p frame. Once the keyframe is found, reference to it and the immediately following keyframe is passed to @p interpolator along with
 calculated interpolation factor, returning the interpolated value. The @p hint
-parameter hints where to start the linear search and is updated with keyframe
-index matching @p frame. If @p frame is earlier than @p hint, the search is
-restarted from the beginning.
+parameter hints where to start the search and is updated with keyframe index
+matching @p frame. With @ref KeyframeSearch::Linear, if @p frame is earlier
+than @p hint, the search is restarted from the beginning. See
+@ref KeyframeSearch for details about other strategies.
 
 This is a stricter but more performant version of @ref interpolate() with
 implicit @ref Extrapolation::Extrapolated behavior. Expects that there are
@@ -221,7 +274,7 @@ Used internally from @ref Track::atStrict() / @ref TrackView::atStrict(), see
     @ref Math::sclerp()
 @experimental
 */
-template<class K, class V, class R = ResultOf<V>> R interpolateStrict(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, R(*interpolator)(const V&, const V&, Float), K frame, std::size_t& hint);
+template<class K, class V, class R = ResultOf<V>> R interpolateStrict(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, R(*interpolator)(const V&, const V&, Float), K frame, std::size_t& hint, KeyframeSearch search = KeyframeSearch::Linear);
 
 /**
 @brief Combine easing function and an interpolator
@@ -415,7 +468,70 @@ template<class V, class R> auto interpolatorFor(Interpolation interpolation) ->
     return Implementation::TypeTraits<typename std::remove_const<V>::type, R>::interpolator(interpolation);
 }
 
-template<class K, class V, class R> R interpolate(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, const Extrapolation before, const Extrapolation after, R(*const interpolator)(const V&, const V&, Float), K frame, std::size_t& hint) {
+namespace Implementation {
+
+/* Returns index of the last keyframe not larger than frame, clamped to
+   [0, keys.size() - 2]. Expects at least two keys. */
+template<class K> std::size_t keyframeFor(const Containers::StridedArrayView1D<const K>& keys, const K frame, std::size_t hint, const KeyframeSearch search) {
+    const std::size_t lastPair = keys.size() - 2;
+
+    if(search == KeyframeSearch::Binary) {
+        if(hint > lastPair) hint = lastPair;
+
+        /* Find the first key in [begin, end] that's larger than frame, the
+           last key acting as a sentinel. First bracket the range by
+           exponentially growing steps from the hint in the direction of the
+           frame. */
+        std::size_t begin, end;
+        if(frame >= keys[hint]) {
+            begin = end = hint + 1;
+            for(std::size_t step = 1; end < keys.size() - 1 && frame >= keys[end]; step *= 2) {
+                begin = end + 1;
+                end = begin + step < keys.size() - 1 ? begin + step : keys.size() - 1;
+            }
+        } else {
+            if(!hint) return 0;
+            begin = end = hint;
+            for(std::size_t step = 1; begin > 1 && frame < keys[begin - 1]; step *= 2) {
+                end = begin - 1;
+                begin = end > step ? end - step : 1;
+            }
+        }
+
+        while(begin < end) {
+            const std::size_t middle = begin + (end - begin)/2;
+            if(frame < keys[middle]) end = middle;
+            else begin = middle + 1;
+        }
+
+        return begin - 1;
+    }
+
+    if(search == KeyframeSearch::Uniform) {
+        /* Written in a way that handles NaNs and a zero key range, in which
+           case the linear search below does the rest */
+        const Float index = (Float(frame) - Float(keys[0]))/(Float(keys[keys.size() - 1]) - Float(keys[0]))*Float(keys.size() - 1);
+        hint = !(index > 0.0f) ? 0 :
+            index >= Float(lastPair) ? lastPair : std::size_t(index);
+
+        /* Fix up rounding errors or non-uniform spacing */
+        while(hint && frame < keys[hint])
+            --hint;
+    } else {
+        /* Rewind from the beginning if hint is too late */
+        if(hint >= keys.size() || frame < keys[hint]) hint = 0;
+    }
+
+    /* Go through the keys until we find a pair that is around given time */
+    while(hint < lastPair && frame >= keys[hint + 1])
+        ++hint;
+
+    return hint;
+}
+
+}
+
+template<class K, class V, class R> R interpolate(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, const Extrapolation before, const Extrapolation after, R(*const interpolator)(const V&, const V&, Float), K frame, std::size_t& hint, const KeyframeSearch search) {
     CORRADE_ASSERT(keys.size() == values.size(), "Animation::interpolate(): keys and values don't have the same size", {});
 
     /* No data, return default-constructed value */
@@ -430,12 +546,7 @@ template<class K, class V, class R> R interpolate(const Containers::StridedArray
         return interpolator(values[0], values[0], 0.0f);
     }
 
-    /* Rewind from the beginning if hint is too late */
-    if(hint >= keys.size() || frame < keys[hint]) hint = 0;
-
-    /* Go through the keys until we find a pair that is around given time */
-    while(hint + 2 < keys.size() && frame >= keys[hint + 1])
-        ++hint;
+    hint = Implementation::keyframeFor(keys, frame, hint, search);
 
     /* Special extrapolation outside of range. Usual extrapolation is handled
        below. */
@@ -451,16 +562,11 @@ template<class K, class V, class R> R interpolate(const Containers::StridedArray
         Math::lerpInverted(Float(keys[hint]), Float(keys[hint + 1]), Float(frame)));
 }
 
-template<class K, class V, class R> R interpolateStrict(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, R(*const interpolator)(const V&, const V&, Float), const K frame, std::size_t& hint) {
+template<class K, class V, class R> R interpolateStrict(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, R(*const interpolator)(const V&, const V&, Float), const K frame, std::size_t& hint, const KeyframeSearch search) {
     CORRADE_ASSERT(keys.size() >= 2, "Animation::interpolateStrict(): at least two keyframes required", {});
     CORRADE_ASSERT(keys.size() == values.size(), "Animation::interpolateStrict(): keys and values don't have the same size", {});
 
-    /* Rewind from the beginning if hint is too late */
-    if(hint >= keys.size() || frame < keys[hint]) hint = 0;
-
-    /* Go through the keys until we find a pair that is around given time */
-    while(hint + 2 < keys.size() && frame >= keys[hint + 1])
-        ++hint;
+    hint = Implementation::keyframeFor(keys, frame, hint, search);
 
     return interpolator(values[hint], values[hint + 1],
         Math::lerpInverted(Float(keys[hint]), Float(keys[hint + 1]), Float(frame)));
@@ -55,6 +55,8 @@ Debug& operator<<(Debug& debug, const State value) {
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template class MAGNUM_EXPORT_HPP Player<Float, Float>;
 template class MAGNUM_EXPORT_HPP Player<std::chrono::nanoseconds, Float>;
+template class MAGNUM_EXPORT_HPP PlayerBatch<Float, Float>;
+template class MAGNUM_EXPORT_HPP PlayerBatch<std::chrono::nanoseconds, Float>;
 #endif
 
 }}
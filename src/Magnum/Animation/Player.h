@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Animation::Player, enum @ref Magnum::Animation::State
+ * @brief Class @ref Magnum::Animation::Player, @ref Magnum::Animation::PlayerBatch, enum @ref Magnum::Animation::State
  */
 
 #include <chrono>
@@ -72,6 +72,17 @@ MAGNUM_EXPORT Debug& operator<<(Debug& debug, State value);
 
 namespace Implementation {
     template<class, class> struct DefaultScaler;
+
+    template<class K> struct PlayerBatchItem {
+        const TrackViewStorage<const K>* track;
+        std::size_t* hint;
+        void* destination;
+        K key;
+        void(*advancer)(Containers::ArrayView<const PlayerBatchItem<K>>);
+        UnsignedInt group;
+    };
+
+    template<class K, class V, class R> void playerBatchAdvance(Containers::ArrayView<const PlayerBatchItem<K>> items);
 }
 
 /**
@@ -262,6 +273,8 @@ template<class T, class K
          * @brief Advance multiple players at the same time
          *
          * Equivalent to calling @ref advance(T) for each item in @p players.
+         * For advancing a large number of players use @ref PlayerBatch
+         * instead.
          */
         static void advance(T time, std::initializer_list<Containers::Reference<Player<T, K>>> players);
 
@@ -801,9 +814,11 @@ template<class T, class K
         Player<T, K>& advance(T time);
 
     private:
+        friend PlayerBatch<T, K>;
+
         struct Track;
 
-        Player<T, K>& addInternal(const TrackViewStorage<const K>& track, void (*advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* destination, void(*userCallback)(), void* userCallbackData);
+        Player<T, K>& addInternal(const TrackViewStorage<const K>& track, void (*advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* destination, void(*userCallback)(), void* userCallbackData, void(*batchAdvancer)(Containers::ArrayView<const Implementation::PlayerBatchItem<K>>) = nullptr, void(*batchInterpolator)() = nullptr);
 
         Containers::Optional<std::pair<UnsignedInt, K>> elapsedInternal(T time, T& updatedStartTime, T& updatedPauseTime, State& updatedState) const;
 
@@ -819,7 +834,9 @@ template<class T, class K> template<class V, class R> Player<T, K>& Player<T, K>
     return addInternal(track,
         [](const TrackViewStorage<const K>& track, K key, std::size_t& hint, void* destination, void(*)(), void*) {
             *static_cast<R*>(destination) = static_cast<const TrackView<const K, const V, R>&>(track).at(key, hint);
-        }, &destination, nullptr, nullptr);
+        }, &destination, nullptr, nullptr,
+        Implementation::playerBatchAdvance<K, V, R>,
+        reinterpret_cast<void(*)()>(track.interpolator()));
 }
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -871,9 +888,242 @@ template<class T, class K> template<class V, class R, class Callback> Player<T,
 }
 #endif
 
+/**
+@brief Batched animation player evaluation
+@tparam T   Time type
+@tparam K   Key type
+@m_since_latest
+
+Advances a large number of @ref Player instances at once. Compared to calling
+@ref Player::advance() on each of them, tracks of all players are grouped by
+their value type, result type and interpolator, and each group is then
+evaluated in a single tight loop --- first looking up keyframes and
+interpolation factors for all tracks in the group and then calling the
+(same) interpolator for all of them. This avoids an indirect call per track and
+keeps the instruction and branch predictor caches warm, which is significant
+when advancing thousands of players with dozens of tracks each.
+
+@section Animation-PlayerBatch-usage Usage
+
+Add players to the batch using @ref add() and then call @ref advance() every
+frame instead of @ref Player::advance() on the particular players. The batch
+references the players, so they have to stay alive and at the same memory
+location for the whole batch lifetime. Tracks can be added to the players even
+after they were added to the batch, the grouping is updated on the next
+advance.
+
+@snippet MagnumAnimation.cpp PlayerBatch-usage
+
+All player state handling is the same as with @ref Player::advance(). Only
+tracks added with @ref Player::add() are batched, tracks added with
+@ref Player::addWithCallback(), @relativeref{Player,addWithCallbackOnChange()}
+and @relativeref{Player,addRawCallback()} are advanced the same way as with
+@ref Player::advance(), in the order they were added to each player, before
+the batched tracks are evaluated. That means, compared to
+@ref Player::advance(), the callbacks can't rely on destination locations of
+the non-callback tracks being already updated for the current iteration.
+
+@section Animation-PlayerBatch-threads Multi-threaded evaluation
+
+The @ref advance() function is a combination of @ref prepare() and
+@ref evaluate(). The @ref prepare() function updates state of all players,
+fires all callbacks and returns the count of track evaluations that need to be
+done. These can be then split into arbitrary ranges that get passed to
+@ref evaluate() calls executed in parallel, for example using an existing job
+system:
+
+@snippet MagnumAnimation.cpp PlayerBatch-usage-threads
+
+The @ref evaluate() calls for disjoint ranges are thread-safe as long as
+destination locations of the tracks don't overlap and the track interpolators
+are free of side effects, which is the case for all builtin interpolators.
+
+@section Animation-PlayerBatch-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into the @ref Animation
+library. For other specializations you have to use the @ref Player.hpp
+implementation file to avoid linker errors. See also
+@ref compilation-speedup-hpp for more information.
+
+-   @ref PlayerBatch "PlayerBatch<Float, Float>"
+-   @ref PlayerBatch "PlayerBatch<std::chrono::nanoseconds, Float>"
+
+@experimental
+*/
+template<class T, class K
+    #ifdef DOXYGEN_GENERATING_OUTPUT
+    = T
+    #endif
+> class PlayerBatch {
+    public:
+        /** @brief Time type */
+        typedef T TimeType;
+
+        /** @brief Key type */
+        typedef K KeyType;
+
+        /** @brief Constructor */
+        explicit PlayerBatch();
+
+        /** @brief Copying is not allowed */
+        PlayerBatch(const PlayerBatch<T, K>&) = delete;
+
+        /** @brief Move constructor */
+        PlayerBatch(PlayerBatch<T, K>&&) noexcept;
+
+        ~PlayerBatch();
+
+        /** @brief Copying is not allowed */
+        PlayerBatch<T, K>& operator=(const PlayerBatch<T, K>&) = delete;
+
+        /** @brief Move assignment */
+        PlayerBatch<T, K>& operator=(PlayerBatch<T, K>&&) noexcept;
+
+        /**
+         * @brief Whether the batch is empty
+         *
+         * @see @ref size()
+         */
+        bool isEmpty() const;
+
+        /**
+         * @brief Count of players in the batch
+         *
+         * @see @ref isEmpty()
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Add a player
+         * @return Reference to self (for method chaining)
+         *
+         * The player is expected to stay alive and at the same memory
+         * location for the whole lifetime of the batch.
+         */
+        PlayerBatch<T, K>& add(Player<T, K>& player);
+
+        /**
+         * @brief Prepare for evaluation
+         *
+         * Goes through all players, updates their state the same way as
+         * @ref Player::advance() and advances all tracks that were not added
+         * with @ref Player::add(). Returns count of remaining track
+         * evaluations, which are then meant to be done by one or more
+         * @ref evaluate() calls.
+         * @see @ref advance()
+         */
+        std::size_t prepare(T time);
+
+        /**
+         * @brief Evaluate a range of tracks
+         *
+         * Evaluates tracks in range @cpp [offset, offset + count) @ce, where
+         * @cpp offset + count @ce is expected to not be larger than the value
+         * returned by the last @ref prepare() call. Calls with disjoint ranges
+         * can be executed from multiple threads in parallel, see
+         * @ref Animation-PlayerBatch-threads for more information. Adding
+         * tracks to any of the players invalidates the state, call
+         * @ref prepare() again in that case.
+         */
+        void evaluate(std::size_t offset, std::size_t count);
+
+        /**
+         * @brief Advance all players
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling @ref prepare() and then @ref evaluate() for
+         * the whole range. See @ref Player::advance() for details about how
+         * the player state is updated.
+         */
+        PlayerBatch<T, K>& advance(T time);
+
+    private:
+        struct Entry;
+
+        void updateEntries();
+
+        Containers::Array<Containers::Reference<Player<T, K>>> _players;
+        /* Track counts of all players at the time the entries were built, to
+           detect tracks added later */
+        Containers::Array<std::size_t> _trackCounts;
+        /* Batched tracks of all players, sorted by group */
+        Containers::Array<Entry> _entries;
+        /* Key for each player in current iteration or NullOpt if the player
+           isn't advancing */
+        Containers::Array<Containers::Optional<K>> _keys;
+        Containers::Array<Implementation::PlayerBatchItem<K>> _items;
+};
+
+namespace Implementation {
+
+/* Advances a run of tracks that all have the same key, value and result type
+   and the same interpolator. First it looks up keyframes and interpolation
+   factors for a chunk of tracks and then calls the interpolator on all of
+   them in a tight loop. */
+template<class K, class V, class R> void playerBatchAdvance(const Containers::ArrayView<const PlayerBatchItem<K>> items) {
+    enum: std::size_t { ChunkSize = 64 };
+    const V* from[ChunkSize];
+    const V* to[ChunkSize];
+    Float factors[ChunkSize];
+    R* destinations[ChunkSize];
+
+    const typename TrackView<const K, const V, R>::Interpolator interpolator = static_cast<const TrackView<const K, const V, R>&>(*items.front().track).interpolator();
+
+    for(std::size_t offset = 0; offset < items.size(); offset += ChunkSize) {
+        const std::size_t end = offset + ChunkSize < items.size() ? offset + ChunkSize : items.size();
+
+        std::size_t count = 0;
+        for(std::size_t i = offset; i != end; ++i) {
+            const PlayerBatchItem<K>& item = items[i];
+            const TrackView<const K, const V, R>& track = static_cast<const TrackView<const K, const V, R>&>(*item.track);
+            R& destination = *static_cast<R*>(item.destination);
+
+            /* Tracks with less than two keyframes are rare, delegate to the
+               generic implementation */
+            const Containers::StridedArrayView1D<const K> keys = track.keys();
+            if(keys.size() < 2) {
+                destination = track.at(item.key, *item.hint);
+                continue;
+            }
+
+            /* Same as in interpolate(), except that the interpolator call is
+               deferred */
+            K frame = item.key;
+            const std::size_t hint = *item.hint = keyframeFor(keys, frame, *item.hint, KeyframeSearch::Linear);
+            if(frame < keys[hint]) {
+                if(track.before() == Extrapolation::DefaultConstructed) {
+                    destination = R{};
+                    continue;
+                }
+                if(track.before() == Extrapolation::Constant) frame = keys[hint];
+            } else if(frame >= keys[hint + 1]) {
+                if(track.after() == Extrapolation::DefaultConstructed) {
+                    destination = R{};
+                    continue;
+                }
+                if(track.after() == Extrapolation::Constant) frame = keys[hint + 1];
+            }
+
+            const Containers::StridedArrayView1D<const V> values = track.values();
+            from[count] = &values[hint];
+            to[count] = &values[hint + 1];
+            factors[count] = Math::lerpInverted(Float(keys[hint]), Float(keys[hint + 1]), Float(frame));
+            destinations[count] = &destination;
+            ++count;
+        }
+
+        for(std::size_t i = 0; i != count; ++i)
+            *destinations[i] = interpolator(*from[i], *to[i], factors[i]);
+    }
+}
+
+}
+
 #if defined(CORRADE_TARGET_WINDOWS) && !(defined(CORRADE_TARGET_MINGW) && !defined(CORRADE_TARGET_CLANG))
 extern template class MAGNUM_EXPORT Player<Float, Float>;
 extern template class MAGNUM_EXPORT Player<std::chrono::nanoseconds, Float>;
+extern template class MAGNUM_EXPORT PlayerBatch<Float, Float>;
+extern template class MAGNUM_EXPORT PlayerBatch<std::chrono::nanoseconds, Float>;
 #endif
 
 }}
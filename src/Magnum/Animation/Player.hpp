@@ -31,6 +31,8 @@
 
 #include "Player.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/Reference.h>
@@ -61,15 +63,26 @@ namespace Implementation {
 template<class T, class K> struct Player<T, K>::Track  {
     /* Not sure why is this still needed for emplace_back(). It's 2018,
        COME ON  ¯\_(ツ)_/¯ */
-    /*implicit*/ Track(const TrackViewStorage<const K>& track, void (*advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* destination, void(*userCallback)(), void* userCallbackData, std::size_t hint) noexcept: track{track}, advancer{advancer}, destination{destination}, userCallback{userCallback}, userCallbackData{userCallbackData}, hint{hint} {}
+    /*implicit*/ Track(const TrackViewStorage<const K>& track, void (*advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* destination, void(*userCallback)(), void* userCallbackData, void(*batchAdvancer)(Containers::ArrayView<const Implementation::PlayerBatchItem<K>>), void(*batchInterpolator)(), std::size_t hint) noexcept: track{track}, advancer{advancer}, destination{destination}, userCallback{userCallback}, userCallbackData{userCallbackData}, batchAdvancer{batchAdvancer}, batchInterpolator{batchInterpolator}, hint{hint} {}
 
     TrackViewStorage<const K> track;
     void (*advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*);
     void* destination;
     void(*userCallback)();
     void* userCallbackData;
+    /* Used by PlayerBatch, null if the track can't be batched */
+    void(*batchAdvancer)(Containers::ArrayView<const Implementation::PlayerBatchItem<K>>);
+    void(*batchInterpolator)();
     std::size_t hint;
 };
+
+template<class T, class K> struct PlayerBatch<T, K>::Entry  {
+    /*implicit*/ Entry(std::size_t player, std::size_t track) noexcept: player{player}, track{track}, group{} {}
+
+    std::size_t player;
+    std::size_t track;
+    UnsignedInt group;
+};
 #endif
 
 template<class T, class K> void Player<T, K>::advance(const T time, const std::initializer_list<Containers::Reference<Player<T, K>>> players) {
@@ -101,12 +114,12 @@ template<class T, class K> const TrackViewStorage<const K>& Player<T, K>::track(
     return _tracks[i].track;
 }
 
-template<class T, class K> Player<T, K>& Player<T, K>::addInternal(const TrackViewStorage<const K>& track, void(*const advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* const destination, void(*const userCallback)(), void* const userCallbackData) {
+template<class T, class K> Player<T, K>& Player<T, K>::addInternal(const TrackViewStorage<const K>& track, void(*const advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* const destination, void(*const userCallback)(), void* const userCallbackData, void(*const batchAdvancer)(Containers::ArrayView<const Implementation::PlayerBatchItem<K>>), void(*const batchInterpolator)()) {
     if(_tracks.isEmpty() && _duration == Math::Range1D<K>{})
         _duration = track.duration();
     else
         _duration = Math::join(track.duration(), _duration);
-    arrayAppend(_tracks, InPlaceInit, track, advancer, destination, userCallback, userCallbackData, 0u);
+    arrayAppend(_tracks, InPlaceInit, track, advancer, destination, userCallback, userCallbackData, batchAdvancer, batchInterpolator, 0u);
     return *this;
 }
 
@@ -308,6 +321,117 @@ template<class T, class K> Player<T, K>& Player<T, K>::advance(const T time) {
     return *this;
 }
 
+template<class T, class K> PlayerBatch<T, K>::PlayerBatch() = default;
+
+template<class T, class K> PlayerBatch<T, K>::PlayerBatch(PlayerBatch<T, K>&&) noexcept = default;
+
+template<class T, class K> PlayerBatch<T, K>::~PlayerBatch() = default;
+
+template<class T, class K> PlayerBatch<T, K>& PlayerBatch<T, K>::operator=(PlayerBatch<T, K>&&) noexcept = default;
+
+template<class T, class K> bool PlayerBatch<T, K>::isEmpty() const {
+    return _players.isEmpty();
+}
+
+template<class T, class K> std::size_t PlayerBatch<T, K>::size() const {
+    return _players.size();
+}
+
+template<class T, class K> PlayerBatch<T, K>& PlayerBatch<T, K>::add(Player<T, K>& player) {
+    arrayAppend(_players, InPlaceInit, player);
+    arrayAppend(_keys, Containers::Optional<K>{});
+    /* Make sure the entries get rebuilt on the next prepare() even if the
+       player is empty */
+    arrayAppend(_trackCounts, ~std::size_t{});
+    return *this;
+}
+
+template<class T, class K> void PlayerBatch<T, K>::updateEntries() {
+    arrayResize(_entries, NoInit, 0);
+    for(std::size_t i = 0; i != _players.size(); ++i) {
+        const Player<T, K>& player = _players[i];
+        _trackCounts[i] = player._tracks.size();
+        for(std::size_t j = 0; j != player._tracks.size(); ++j)
+            if(player._tracks[j].batchAdvancer)
+                arrayAppend(_entries, InPlaceInit, i, j);
+    }
+
+    /* Group tracks with the same advancer and interpolator together, keeping
+       the original order otherwise */
+    const auto groupKey = [this](const Entry& entry) {
+        const typename Player<T, K>::Track& track = _players[entry.player]->_tracks[entry.track];
+        return std::make_pair(reinterpret_cast<std::uintptr_t>(track.batchAdvancer), reinterpret_cast<std::uintptr_t>(track.batchInterpolator));
+    };
+    std::stable_sort(_entries.begin(), _entries.end(), [&groupKey](const Entry& a, const Entry& b) {
+        return groupKey(a) < groupKey(b);
+    });
+
+    /* Assign a group ID to each entry so evaluate() can find the runs
+       without having to look at the tracks */
+    for(std::size_t i = 1; i < _entries.size(); ++i)
+        _entries[i].group = _entries[i - 1].group + (groupKey(_entries[i - 1]) != groupKey(_entries[i]) ? 1 : 0);
+}
+
+template<class T, class K> std::size_t PlayerBatch<T, K>::prepare(const T time) {
+    /* Rebuild the grouping if any player has a different track count than
+       before */
+    for(std::size_t i = 0; i != _players.size(); ++i) {
+        if(_players[i]->_tracks.size() != _trackCounts[i]) {
+            updateEntries();
+            break;
+        }
+    }
+
+    for(std::size_t i = 0; i != _players.size(); ++i) {
+        Player<T, K>& player = _players[i];
+
+        /* Same as in Player::advance() */
+        const Containers::Optional<std::pair<UnsignedInt, K>> elapsed = Implementation::playerElapsed(player._duration.size(), player._playCount, player._scaler, time, player._startTime, player._stopPauseTime, player._state);
+        if(!elapsed) {
+            _keys[i] = Containers::NullOpt;
+            continue;
+        }
+
+        const K key = player._duration.min() + elapsed->second;
+        _keys[i] = key;
+
+        /* Tracks that can't be batched are advanced right away */
+        for(typename Player<T, K>::Track& t: player._tracks)
+            if(!t.batchAdvancer)
+                t.advancer(t.track, key, t.hint, t.destination, t.userCallback, t.userCallbackData);
+    }
+
+    arrayResize(_items, NoInit, 0);
+    for(const Entry& entry: _entries) {
+        if(!_keys[entry.player]) continue;
+
+        typename Player<T, K>::Track& t = _players[entry.player]->_tracks[entry.track];
+        arrayAppend(_items, Implementation::PlayerBatchItem<K>{&t.track, &t.hint, t.destination, *_keys[entry.player], t.batchAdvancer, entry.group});
+    }
+
+    return _items.size();
+}
+
+template<class T, class K> void PlayerBatch<T, K>::evaluate(const std::size_t offset, const std::size_t count) {
+    CORRADE_ASSERT(offset + count <= _items.size(),
+        "Animation::PlayerBatch::evaluate(): range [" << Debug::nospace << offset << Debug::nospace << "," << offset + count << Debug::nospace << ") out of bounds for" << _items.size() << "items", );
+
+    const Containers::ArrayView<const Implementation::PlayerBatchItem<K>> items = _items.slice(offset, offset + count);
+    for(std::size_t begin = 0; begin != items.size(); ) {
+        std::size_t end = begin + 1;
+        while(end != items.size() && items[end].group == items[begin].group)
+            ++end;
+
+        items[begin].advancer(items.slice(begin, end));
+        begin = end;
+    }
+}
+
+template<class T, class K> PlayerBatch<T, K>& PlayerBatch<T, K>::advance(const T time) {
+    evaluate(0, prepare(time));
+    return *this;
+}
+
 }}
 
 #endif
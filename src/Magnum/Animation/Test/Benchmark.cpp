@@ -35,6 +35,9 @@ struct Benchmark: TestSuite::Tester {
     void interpolateEmpty();
     void interpolateInterleaved();
     void interpolateInterleavedStrict();
+    void interpolateInterleavedStrictSearch();
+    void interpolateInterleavedStrictSearchReverse();
+    void interpolateInterleavedStrictSearchRandom();
 
     void atEmpty();
     void at();
@@ -49,6 +52,8 @@ struct Benchmark: TestSuite::Tester {
     void playerAdvanceCallback();
     void playerAdvanceRawCallback();
     void playerAdvanceRawCallbackDirectInterpolator();
+    void playerAdvanceMany();
+    void playerBatchAdvance();
 
     Containers::Array<Float> _keys;
     Containers::Array<Int> _values;
@@ -60,9 +65,18 @@ struct Benchmark: TestSuite::Tester {
 };
 
 namespace {
-    enum: std::size_t { DataSize = 2000 };
+    enum: std::size_t { DataSize = 2000, PlayerCount = 100, PlayerTrackCount = 4 };
 }
 
+const struct {
+    const char* name;
+    KeyframeSearch search;
+} SearchData[]{
+    {"linear", KeyframeSearch::Linear},
+    {"binary", KeyframeSearch::Binary},
+    {"uniform", KeyframeSearch::Uniform}
+};
+
 Benchmark::Benchmark() {
     addBenchmarks({&Benchmark::interpolateEmpty,
                    &Benchmark::interpolateInterleaved,
@@ -80,7 +94,14 @@ Benchmark::Benchmark() {
                    &Benchmark::playerAdvance,
                    &Benchmark::playerAdvanceCallback,
                    &Benchmark::playerAdvanceRawCallback,
-                   &Benchmark::playerAdvanceRawCallbackDirectInterpolator}, 10);
+                   &Benchmark::playerAdvanceRawCallbackDirectInterpolator,
+                   &Benchmark::playerAdvanceMany,
+                   &Benchmark::playerBatchAdvance}, 10);
+
+    addInstancedBenchmarks({&Benchmark::interpolateInterleavedStrictSearch,
+                            &Benchmark::interpolateInterleavedStrictSearchReverse,
+                            &Benchmark::interpolateInterleavedStrictSearchRandom}, 10,
+        Containers::arraySize(SearchData));
 
     _keys = Containers::Array<Float>{DataSize};
     _values = Containers::Array<Int>{DirectInit, DataSize, 1};
@@ -126,6 +147,48 @@ void Benchmark::interpolateInterleavedStrict() {
     CORRADE_COMPARE(result, 125000);
 }
 
+void Benchmark::interpolateInterleavedStrictSearch() {
+    auto&& data = SearchData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Int result{};
+    CORRADE_BENCHMARK(250) {
+        std::size_t hint{};
+        for(Float i = 0.0f; i < 500.0f; i += 1.0f)
+            result += interpolateStrict(_keysInterleaved, _valuesInterleaved, Math::select, i, hint, data.search);
+    }
+    CORRADE_COMPARE(result, 125000);
+}
+
+void Benchmark::interpolateInterleavedStrictSearchReverse() {
+    auto&& data = SearchData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Going backwards through the whole track, which makes the linear search
+       rewind to the beginning every time */
+    Int result{};
+    CORRADE_BENCHMARK(250) {
+        std::size_t hint{};
+        for(Float i = 6000.0f; i > 0.0f; i -= 12.0f)
+            result += interpolateStrict(_keysInterleaved, _valuesInterleaved, Math::select, i, hint, data.search);
+    }
+    CORRADE_COMPARE(result, 125000);
+}
+
+void Benchmark::interpolateInterleavedStrictSearchRandom() {
+    auto&& data = SearchData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Seeking to pseudo-random positions, simulating scrubbing */
+    Int result{};
+    CORRADE_BENCHMARK(250) {
+        std::size_t hint{};
+        for(UnsignedInt i = 0; i != 500; ++i)
+            result += interpolateStrict(_keysInterleaved, _valuesInterleaved, Math::select, Float(i*7919 % 6000), hint, data.search);
+    }
+    CORRADE_COMPARE(result, 125000);
+}
+
 void Benchmark::atEmpty() {
     TrackView<Float, Int> empty{nullptr, nullptr, Math::select};
 
@@ -260,6 +323,51 @@ void Benchmark::playerAdvanceRawCallbackDirectInterpolator() {
     CORRADE_COMPARE(result, 125000);
 }
 
+void Benchmark::playerAdvanceMany() {
+    Int results[PlayerCount*PlayerTrackCount]{};
+    Player<Float> players[PlayerCount];
+    for(std::size_t i = 0; i != PlayerCount; ++i) {
+        players[i].add(_track, results[i*PlayerTrackCount + 0])
+            .add(_trackInterleaved, results[i*PlayerTrackCount + 1])
+            .add(_track, results[i*PlayerTrackCount + 2])
+            .add(_trackInterleaved, results[i*PlayerTrackCount + 3])
+            .play({});
+    }
+
+    CORRADE_BENCHMARK(250) {
+        for(Float i = 0.0f; i < 50.0f; i += 1.0f)
+            for(Player<Float>& player: players)
+                player.advance(i);
+    }
+
+    Int sum{};
+    for(Int result: results) sum += result;
+    CORRADE_COMPARE(sum, Int(PlayerCount*PlayerTrackCount));
+}
+
+void Benchmark::playerBatchAdvance() {
+    Int results[PlayerCount*PlayerTrackCount]{};
+    Player<Float> players[PlayerCount];
+    PlayerBatch<Float> batch;
+    for(std::size_t i = 0; i != PlayerCount; ++i) {
+        players[i].add(_track, results[i*PlayerTrackCount + 0])
+            .add(_trackInterleaved, results[i*PlayerTrackCount + 1])
+            .add(_track, results[i*PlayerTrackCount + 2])
+            .add(_trackInterleaved, results[i*PlayerTrackCount + 3])
+            .play({});
+        batch.add(players[i]);
+    }
+
+    CORRADE_BENCHMARK(250) {
+        for(Float i = 0.0f; i < 50.0f; i += 1.0f)
+            batch.advance(i);
+    }
+
+    Int sum{};
+    for(Int result: results) sum += result;
+    CORRADE_COMPARE(sum, Int(PlayerCount*PlayerTrackCount));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Animation::Test::Benchmark)
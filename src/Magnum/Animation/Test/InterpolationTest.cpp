@@ -24,6 +24,7 @@
 */
 
 #include <sstream>
+#include <initializer_list>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/DebugStl.h>
 
@@ -68,6 +69,8 @@ struct InterpolationTest: TestSuite::Tester {
 
     void interpolateHint();
     void interpolateStrictHint();
+    void interpolateSearch();
+    void interpolateStrictSearch();
 
     void interpolateDifferentResultType();
     void interpolateStrictDifferentResultType();
@@ -88,6 +91,8 @@ struct InterpolationTest: TestSuite::Tester {
     void debugInterpolationPacked();
     void debugExtrapolation();
     void debugExtrapolationPacked();
+    void debugKeyframeSearch();
+    void debugKeyframeSearchPacked();
 };
 
 using namespace Math::Literals;
@@ -158,6 +163,15 @@ const struct {
     {"out of bounds", 405780454}
 };
 
+const struct {
+    const char* name;
+    KeyframeSearch search;
+} SearchData[] {
+    {"linear", KeyframeSearch::Linear},
+    {"binary", KeyframeSearch::Binary},
+    {"uniform", KeyframeSearch::Uniform}
+};
+
 InterpolationTest::InterpolationTest() {
     addTests({&InterpolationTest::interpolatorFor,
               &InterpolationTest::interpolatorForInvalid,
@@ -193,6 +207,10 @@ InterpolationTest::InterpolationTest() {
                        &InterpolationTest::interpolateStrictHint},
                        Containers::arraySize(HintData));
 
+    addInstancedTests({&InterpolationTest::interpolateSearch,
+                       &InterpolationTest::interpolateStrictSearch},
+                       Containers::arraySize(SearchData));
+
     addTests({&InterpolationTest::interpolateDifferentResultType,
               &InterpolationTest::interpolateStrictDifferentResultType,
 
@@ -211,7 +229,9 @@ InterpolationTest::InterpolationTest() {
               &InterpolationTest::debugInterpolation,
               &InterpolationTest::debugInterpolationPacked,
               &InterpolationTest::debugExtrapolation,
-              &InterpolationTest::debugExtrapolationPacked});
+              &InterpolationTest::debugExtrapolationPacked,
+              &InterpolationTest::debugKeyframeSearch,
+              &InterpolationTest::debugKeyframeSearchPacked});
 }
 
 void InterpolationTest::interpolatorFor() {
@@ -502,6 +522,87 @@ void InterpolationTest::interpolateStrictHint() {
     CORRADE_COMPARE(hint, 2);
 }
 
+/* Uniformly spaced keys, for which KeyframeSearch::Uniform calculates the
+   keyframe directly, and non-uniformly spaced keys, for which it has to
+   adjust the index. The values are the same as key indices. */
+struct SearchKeys {
+    SearchKeys() {
+        for(std::size_t i = 0; i != Containers::arraySize(values); ++i) {
+            uniform[i] = 0.25f*Float(i) - 2.0f;
+            nonUniform[i] = 0.01f*Float(i*i) - 2.0f;
+            values[i] = Float(i);
+        }
+    }
+
+    Float uniform[37];
+    Float nonUniform[37];
+    Float values[37];
+};
+
+/* The frames range from before the first key to after the last key of both
+   variants, the hints are at the start, in the middle, at the end and out of
+   bounds */
+constexpr std::size_t SearchHints[]{0, 5, 20, 35, 36, 405780454};
+
+void InterpolationTest::interpolateSearch() {
+    auto&& data = SearchData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const SearchKeys storage;
+    for(const Containers::ArrayView<const Float> keys: {Containers::arrayView(storage.uniform), Containers::arrayView(storage.nonUniform)}) {
+        CORRADE_ITERATION(keys.data() == storage.uniform ? "uniform" : "non-uniform");
+
+        for(Float frame = -3.0f; frame < 12.0f; frame += 0.125f) {
+            CORRADE_ITERATION(frame);
+
+            /* The reference is a linear search from the beginning */
+            std::size_t expected = 0;
+            while(expected + 2 < keys.size() && frame >= keys[expected + 1])
+                ++expected;
+
+            for(const std::size_t startHint: SearchHints) {
+                CORRADE_ITERATION(startHint);
+
+                std::size_t hint = startHint;
+                CORRADE_COMPARE((Animation::interpolate<Float, Float>(
+                    keys, storage.values, Extrapolation::Extrapolated,
+                    Extrapolation::Extrapolated, Math::lerp, frame, hint,
+                    data.search)), Math::lerp(storage.values[expected], storage.values[expected + 1], Math::lerpInverted(keys[expected], keys[expected + 1], frame)));
+                CORRADE_COMPARE(hint, expected);
+            }
+        }
+    }
+}
+
+void InterpolationTest::interpolateStrictSearch() {
+    auto&& data = SearchData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const SearchKeys storage;
+    for(const Containers::ArrayView<const Float> keys: {Containers::arrayView(storage.uniform), Containers::arrayView(storage.nonUniform)}) {
+        CORRADE_ITERATION(keys.data() == storage.uniform ? "uniform" : "non-uniform");
+
+        for(Float frame = -3.0f; frame < 12.0f; frame += 0.125f) {
+            CORRADE_ITERATION(frame);
+
+            /* The reference is a linear search from the beginning */
+            std::size_t expected = 0;
+            while(expected + 2 < keys.size() && frame >= keys[expected + 1])
+                ++expected;
+
+            for(const std::size_t startHint: SearchHints) {
+                CORRADE_ITERATION(startHint);
+
+                std::size_t hint = startHint;
+                CORRADE_COMPARE((Animation::interpolateStrict<Float, Float>(
+                    keys, storage.values, Math::lerp, frame, hint,
+                    data.search)), Math::lerp(storage.values[expected], storage.values[expected + 1], Math::lerpInverted(keys[expected], keys[expected + 1], frame)));
+                CORRADE_COMPARE(hint, expected);
+            }
+        }
+    }
+}
+
 using namespace Math::Literals;
 
 const Half HalfValues[]{3.0_h, 1.0_h, 2.5_h, 0.5_h};
@@ -655,6 +756,20 @@ void InterpolationTest::debugExtrapolationPacked() {
     CORRADE_COMPARE(out.str(), "DefaultConstructed 0xde Animation::Extrapolation::Constant\n");
 }
 
+void InterpolationTest::debugKeyframeSearch() {
+    std::ostringstream out;
+
+    Debug{&out} << KeyframeSearch::Binary << KeyframeSearch(0xde);
+    CORRADE_COMPARE(out.str(), "Animation::KeyframeSearch::Binary Animation::KeyframeSearch(0xde)\n");
+}
+
+void InterpolationTest::debugKeyframeSearchPacked() {
+    std::ostringstream out;
+    /* Last is not packed, ones before should not make any flags persistent */
+    Debug{&out} << Debug::packed << KeyframeSearch::Binary << Debug::packed << KeyframeSearch(0xde) << KeyframeSearch::Uniform;
+    CORRADE_COMPARE(out.str(), "Binary 0xde Animation::KeyframeSearch::Uniform\n");
+}
+
 
 }}}}
 
@@ -90,6 +90,12 @@ struct PlayerTest: TestSuite::Tester {
     void runFor100YearsFloat();
     void runFor100YearsChrono();
 
+    void batch();
+    void batchEvaluateRanges();
+    void batchExtrapolation();
+    void batchAddTrackLater();
+    void batchEvaluateOutOfRange();
+
     void debugState();
 
     Animation::Track<Float, Float> mutableTrack{{
@@ -188,7 +194,13 @@ PlayerTest::PlayerTest() {
         &PlayerTest::runFor100YearsChrono},
         Containers::arraySize(RunFor100YearsData));
 
-    addTests({&PlayerTest::debugState});
+    addTests({&PlayerTest::batch,
+              &PlayerTest::batchEvaluateRanges,
+              &PlayerTest::batchExtrapolation,
+              &PlayerTest::batchAddTrackLater,
+              &PlayerTest::batchEvaluateOutOfRange,
+
+              &PlayerTest::debugState});
 }
 
 void PlayerTest::constructEmpty() {
@@ -1398,6 +1410,197 @@ void PlayerTest::runFor100YearsChrono() {
     CORRADE_COMPARE(value, 3.0f);
 }
 
+const Animation::Track<Float, Int> TrackInt{{
+    {1.0f, 10},
+    {2.0f, 20},
+    {4.0f, 40}
+}, Math::select};
+
+void PlayerTest::batch() {
+    Float valueA1 = -1.0f, valueB1 = -1.0f, valueC = -1.0f, callbackValue = -1.0f;
+    Int valueA2 = -1, valueB2 = -1;
+    Player<Float> a, b, c;
+    a.add(Track, valueA1)
+     .add(TrackInt, valueA2)
+     .play(2.0f);
+    /* The callback track isn't batched but should still get called */
+    b.add(TrackInt, valueB2)
+     .addWithCallback(Track, [](Float, const Float& value, Float& out) {
+        out = value;
+     }, callbackValue)
+     .add(Track, valueB1)
+     .play(1.0f);
+    /* Not playing, shouldn't get touched */
+    c.add(Track, valueC);
+
+    PlayerBatch<Float> batch;
+    CORRADE_VERIFY(batch.isEmpty());
+    CORRADE_COMPARE(batch.size(), 0);
+
+    batch.add(a)
+         .add(b)
+         .add(c);
+    CORRADE_VERIFY(!batch.isEmpty());
+    CORRADE_COMPARE(batch.size(), 3);
+
+    /* 1.75 secs in for A, 2.75 seconds in for B */
+    batch.advance(3.75f);
+    CORRADE_COMPARE(a.state(), State::Playing);
+    CORRADE_COMPARE(b.state(), State::Playing);
+    CORRADE_COMPARE(c.state(), State::Stopped);
+    CORRADE_COMPARE(valueA1, 4.0f);
+    CORRADE_COMPARE(valueA2, 20);
+    CORRADE_COMPARE(valueB1, 2.75f);
+    CORRADE_COMPARE(valueB2, 20);
+    CORRADE_COMPARE(callbackValue, 2.75f);
+    CORRADE_COMPARE(valueC, -1.0f);
+
+    /* Past the end, the values should get parked at the end of the duration
+       and the players stopped */
+    batch.advance(20.0f);
+    CORRADE_COMPARE(a.state(), State::Stopped);
+    CORRADE_COMPARE(b.state(), State::Stopped);
+    CORRADE_COMPARE(valueA1, 2.0f);
+    CORRADE_COMPARE(valueA2, 40);
+    CORRADE_COMPARE(valueB1, 2.0f);
+    CORRADE_COMPARE(valueB2, 40);
+    CORRADE_COMPARE(callbackValue, 2.0f);
+    CORRADE_COMPARE(valueC, -1.0f);
+}
+
+void PlayerTest::batchEvaluateRanges() {
+    Player<Float> players[10];
+    Player<Float> expectedPlayers[10];
+    Float values[10];
+    Float expectedValues[10];
+    Int valuesInt[10];
+    Int expectedValuesInt[10];
+    PlayerBatch<Float> batch;
+    for(std::size_t i = 0; i != 10; ++i) {
+        values[i] = expectedValues[i] = -1.0f;
+        valuesInt[i] = expectedValuesInt[i] = -1;
+        /* Alternating the order to have the two types interleaved */
+        if(i % 2) {
+            players[i].add(Track, values[i])
+                      .add(TrackInt, valuesInt[i]);
+            expectedPlayers[i].add(Track, expectedValues[i])
+                              .add(TrackInt, expectedValuesInt[i]);
+        } else {
+            players[i].add(TrackInt, valuesInt[i])
+                      .add(Track, values[i]);
+            expectedPlayers[i].add(TrackInt, expectedValuesInt[i])
+                              .add(Track, expectedValues[i]);
+        }
+        players[i].play(-0.25f*Float(i));
+        expectedPlayers[i].play(-0.25f*Float(i));
+        batch.add(players[i]);
+    }
+
+    for(Float time: {0.0f, 0.5f, 1.25f, 0.75f, 2.5f}) {
+        CORRADE_ITERATION(time);
+
+        /* The items can be split in arbitrary ranges, not just at group
+           boundaries */
+        CORRADE_COMPARE(batch.prepare(time), 20);
+        batch.evaluate(0, 7);
+        batch.evaluate(7, 0);
+        batch.evaluate(7, 12);
+        batch.evaluate(19, 1);
+
+        for(Player<Float>& player: expectedPlayers)
+            player.advance(time);
+
+        CORRADE_COMPARE_AS(Containers::arrayView(values),
+            Containers::arrayView(expectedValues),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(Containers::arrayView(valuesInt),
+            Containers::arrayView(expectedValuesInt),
+            TestSuite::Compare::Container);
+    }
+}
+
+void PlayerTest::batchExtrapolation() {
+    const Animation::Track<Float, Float> tracks[]{
+        Animation::Track<Float, Float>{{
+            {2.0f, 1.0f},
+            {4.0f, 3.0f}
+        }, Math::lerp, Extrapolation::DefaultConstructed},
+        Animation::Track<Float, Float>{{
+            {2.0f, 1.0f},
+            {4.0f, 3.0f}
+        }, Math::lerp, Extrapolation::Constant},
+        Animation::Track<Float, Float>{{
+            {2.0f, 1.0f},
+            {4.0f, 3.0f}
+        }, Math::lerp, Extrapolation::Extrapolated},
+        Animation::Track<Float, Float>{{
+            {3.0f, 5.0f}
+        }, Math::lerp, Extrapolation::DefaultConstructed},
+        Animation::Track<Float, Float>{Containers::Array<std::pair<Float, Float>>{}, Math::lerp}
+    };
+
+    Float values[Containers::arraySize(tracks)];
+    Player<Float> player;
+    for(std::size_t i = 0; i != Containers::arraySize(tracks); ++i) {
+        values[i] = -1.0f;
+        player.add(tracks[i], values[i]);
+    }
+    player.setDuration({0.0f, 6.0f})
+        .setPlayCount(0)
+        .play(0.0f);
+
+    PlayerBatch<Float> batch;
+    batch.add(player);
+
+    for(Float time: {1.0f, 2.5f, 3.0f, 5.0f}) {
+        CORRADE_ITERATION(time);
+        batch.advance(time);
+
+        for(std::size_t i = 0; i != Containers::arraySize(tracks); ++i) {
+            CORRADE_ITERATION(i);
+            CORRADE_COMPARE(values[i], tracks[i].at(time));
+        }
+    }
+}
+
+void PlayerTest::batchAddTrackLater() {
+    Float value1 = -1.0f, value2 = -1.0f;
+    Player<Float> player;
+    player.add(Track, value1)
+          .play(0.0f);
+
+    PlayerBatch<Float> batch;
+    batch.add(player);
+
+    batch.advance(1.75f);
+    CORRADE_COMPARE(value1, 4.0f);
+    CORRADE_COMPARE(value2, -1.0f);
+
+    /* The new track should get picked up on the next advance */
+    player.add(Track, value2);
+    batch.advance(2.75f);
+    CORRADE_COMPARE(value1, 2.75f);
+    CORRADE_COMPARE(value2, 2.75f);
+}
+
+void PlayerTest::batchEvaluateOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Float value = -1.0f;
+    Player<Float> player;
+    player.add(Track, value)
+          .play(0.0f);
+
+    PlayerBatch<Float> batch;
+    batch.add(player);
+    CORRADE_COMPARE(batch.prepare(1.0f), 1);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batch.evaluate(1, 1);
+    CORRADE_COMPARE(out.str(), "Animation::PlayerBatch::evaluate(): range [1, 2) out of bounds for 1 items\n");
+}
+
 void PlayerTest::debugState() {
     std::ostringstream out;
 
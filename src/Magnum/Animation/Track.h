@@ -82,6 +82,14 @@ remember last used keyframe index and pass it in the next iteration as a hint:
 
 @snippet MagnumAnimation.cpp Track-performance-hint
 
+For long tracks that are sought randomly or played in reverse, the default
+linear search from the hint can get expensive. Pass a different
+@ref KeyframeSearch to @ref at(K, std::size_t&, KeyframeSearch) const or
+@ref atStrict(K, std::size_t&, KeyframeSearch) const ---
+@ref KeyframeSearch::Binary is logarithmic in the distance from the hint and
+@ref KeyframeSearch::Uniform calculates the keyframe index directly for
+uniformly sampled tracks.
+
 @subsection Animation-Track-performance-strict Strict interpolation
 
 While it's possible to have different @ref Extrapolation modes for frames
@@ -420,6 +428,56 @@ template<class K, class V, class R
             return interpolateStrict(keys(), values(), interpolator, frame, hint);
         }
 
+        /**
+         * @brief Animated value at a given time with a keyframe search strategy
+         * @m_since_latest
+         *
+         * Like @ref at(K, std::size_t&) const, but using @p search instead of
+         * the default @ref KeyframeSearch::Linear. See @ref interpolate() for
+         * more information.
+         * @see @ref atStrict(K, std::size_t&, KeyframeSearch) const
+         */
+        R at(K frame, std::size_t& hint, KeyframeSearch search) const {
+            return at(_interpolator, frame, hint, search);
+        }
+
+        /**
+         * @brief Animated value at a given time with a keyframe search strategy
+         * @m_since_latest
+         *
+         * Like @ref at(Interpolator, K, std::size_t&) const, but using
+         * @p search instead of the default @ref KeyframeSearch::Linear. See
+         * @ref interpolate() for more information.
+         */
+        R at(Interpolator interpolator, K frame, std::size_t& hint, KeyframeSearch search) const {
+            return interpolate(keys(), values(), _before, _after, interpolator, frame, hint, search);
+        }
+
+        /**
+         * @brief Animated value at a given time with a keyframe search strategy
+         * @m_since_latest
+         *
+         * Like @ref atStrict(K, std::size_t&) const, but using @p search
+         * instead of the default @ref KeyframeSearch::Linear. See
+         * @ref interpolateStrict() for more information.
+         * @see @ref at(K, std::size_t&, KeyframeSearch) const
+         */
+        R atStrict(K frame, std::size_t& hint, KeyframeSearch search) const {
+            return atStrict(_interpolator, frame, hint, search);
+        }
+
+        /**
+         * @brief Animated value at a given time with a keyframe search strategy
+         * @m_since_latest
+         *
+         * Like @ref atStrict(Interpolator, K, std::size_t&) const, but using
+         * @p search instead of the default @ref KeyframeSearch::Linear. See
+         * @ref interpolateStrict() for more information.
+         */
+        R atStrict(Interpolator interpolator, K frame, std::size_t& hint, KeyframeSearch search) const {
+            return interpolateStrict(keys(), values(), interpolator, frame, hint, search);
+        }
+
     private:
         Containers::Array<std::pair<K, V>> _data;
         Interpolator _interpolator;
@@ -796,6 +854,56 @@ template<class K, class V, class R
         R atStrict(Interpolator interpolator, K frame, std::size_t& hint) const {
             return interpolateStrict<typename std::remove_const<K>::type, typename std::remove_const<V>::type, R>(TrackViewStorage<K>::_keys, values(), interpolator, frame, hint);
         }
+
+        /**
+         * @brief Animated value at a given time with a keyframe search strategy
+         * @m_since_latest
+         *
+         * Like @ref at(K, std::size_t&) const, but using @p search instead of
+         * the default @ref KeyframeSearch::Linear. See @ref interpolate() for
+         * more information.
+         * @see @ref atStrict(K, std::size_t&, KeyframeSearch) const
+         */
+        R at(K frame, std::size_t& hint, KeyframeSearch search) const {
+            return at(interpolator(), frame, hint, search);
+        }
+
+        /**
+         * @brief Animated value at a given time with a keyframe search strategy
+         * @m_since_latest
+         *
+         * Like @ref at(Interpolator, K, std::size_t&) const, but using
+         * @p search instead of the default @ref KeyframeSearch::Linear. See
+         * @ref interpolate() for more information.
+         */
+        R at(Interpolator interpolator, K frame, std::size_t& hint, KeyframeSearch search) const {
+            return interpolate<typename std::remove_const<K>::type, typename std::remove_const<V>::type, R>(TrackViewStorage<K>::_keys, values(), TrackViewStorage<K>::_before, TrackViewStorage<K>::_after, interpolator, frame, hint, search);
+        }
+
+        /**
+         * @brief Animated value at a given time with a keyframe search strategy
+         * @m_since_latest
+         *
+         * Like @ref atStrict(K, std::size_t&) const, but using @p search
+         * instead of the default @ref KeyframeSearch::Linear. See
+         * @ref interpolateStrict() for more information.
+         * @see @ref at(K, std::size_t&, KeyframeSearch) const
+         */
+        R atStrict(K frame, std::size_t& hint, KeyframeSearch search) const {
+            return atStrict(interpolator(), frame, hint, search);
+        }
+
+        /**
+         * @brief Animated value at a given time with a keyframe search strategy
+         * @m_since_latest
+         *
+         * Like @ref atStrict(Interpolator, K, std::size_t&) const, but using
+         * @p search instead of the default @ref KeyframeSearch::Linear. See
+         * @ref interpolateStrict() for more information.
+         */
+        R atStrict(Interpolator interpolator, K frame, std::size_t& hint, KeyframeSearch search) const {
+            return interpolateStrict<typename std::remove_const<K>::type, typename std::remove_const<V>::type, R>(TrackViewStorage<K>::_keys, values(), interpolator, frame, hint, search);
+        }
 };
 
 }}
@@ -0,0 +1,90 @@
+#ifndef Magnum_Implementation_parallelFor_h
+#define Magnum_Implementation_parallelFor_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <thread>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+
+/* Emscripten without -pthread has std::thread but creating it fails at
+   runtime */
+#if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+#define MAGNUM_IMPLEMENTATION_PARALLELFOR_THREADS
+#endif
+
+namespace Magnum { namespace Implementation {
+
+/* Thread count to use for a given user-supplied count. Zero means all
+   hardware threads, if the platform doesn't support threads it's always
+   one. */
+inline UnsignedInt parallelThreadCount(const UnsignedInt threadCount) {
+    #ifdef MAGNUM_IMPLEMENTATION_PARALLELFOR_THREADS
+    if(threadCount) return threadCount;
+    const UnsignedInt hardwareThreadCount = std::thread::hardware_concurrency();
+    return hardwareThreadCount ? hardwareThreadCount : 1;
+    #else
+    static_cast<void>(threadCount);
+    return 1;
+    #endif
+}
+
+/* Calls `f(job)` for all jobs in [0, jobCount), distributed over at most
+   `threadCount` threads, one of them being the calling thread. The jobs are
+   expected to be independent of each other, the order in which they're
+   executed and the thread they get executed on is unspecified. Returns once
+   all jobs are finished. */
+template<class F> void parallelFor(const UnsignedInt threadCount, const std::size_t jobCount, F&& f) {
+    #ifdef MAGNUM_IMPLEMENTATION_PARALLELFOR_THREADS
+    std::size_t usedThreadCount = parallelThreadCount(threadCount);
+    if(usedThreadCount > jobCount) usedThreadCount = jobCount;
+    if(usedThreadCount > 1) {
+        std::atomic<std::size_t> next{0};
+        auto worker = [&next, jobCount, &f]() {
+            for(std::size_t job; (job = next.fetch_add(1, std::memory_order_relaxed)) < jobCount; )
+                f(job);
+        };
+
+        Containers::Array<std::thread> threads{usedThreadCount - 1};
+        for(std::thread& thread: threads)
+            thread = std::thread{worker};
+        worker();
+        for(std::thread& thread: threads)
+            thread.join();
+        return;
+    }
+    #else
+    static_cast<void>(threadCount);
+    #endif
+
+    for(std::size_t job = 0; job != jobCount; ++job)
+        f(job);
+}
+
+}}
+
+#endif
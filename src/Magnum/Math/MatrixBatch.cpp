@@ -0,0 +1,214 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MatrixBatch.h"
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Complex.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Quaternion.h"
+
+#ifdef CORRADE_TARGET_SSE2
+#include <xmmintrin.h>
+#endif
+
+namespace Magnum { namespace Math {
+
+namespace {
+
+/* All kernels read both inputs completely before writing the output, so
+   the output is allowed to alias either of them. The SIMD variants sum the
+   products in the same order as the scalar variants, giving the same
+   results. */
+
+#ifdef CORRADE_TARGET_SSE2
+inline void multiplyKernel(const Matrix4<Float>& a, const Matrix4<Float>& b, Matrix4<Float>& out) {
+    const Float* const aData = a.data();
+    const Float* const bData = b.data();
+    const __m128 a0 = _mm_loadu_ps(aData + 0);
+    const __m128 a1 = _mm_loadu_ps(aData + 4);
+    const __m128 a2 = _mm_loadu_ps(aData + 8);
+    const __m128 a3 = _mm_loadu_ps(aData + 12);
+
+    /* Starting from zero like RectangularMatrix::operator*() does, which
+       matters for negative zeros */
+    __m128 columns[4];
+    for(std::size_t col = 0; col != 4; ++col) {
+        __m128 column = _mm_setzero_ps();
+        column = _mm_add_ps(column, _mm_mul_ps(a0, _mm_set1_ps(bData[col*4 + 0])));
+        column = _mm_add_ps(column, _mm_mul_ps(a1, _mm_set1_ps(bData[col*4 + 1])));
+        column = _mm_add_ps(column, _mm_mul_ps(a2, _mm_set1_ps(bData[col*4 + 2])));
+        column = _mm_add_ps(column, _mm_mul_ps(a3, _mm_set1_ps(bData[col*4 + 3])));
+        columns[col] = column;
+    }
+
+    Float* const outData = out.data();
+    for(std::size_t col = 0; col != 4; ++col)
+        _mm_storeu_ps(outData + col*4, columns[col]);
+}
+
+inline void multiplyKernel(const Matrix4x3<Float>& a, const Matrix4x3<Float>& b, Matrix4x3<Float>& out) {
+    /* The columns have three components, so each load takes also the first
+       component of the next column, which is ignored. The last column is
+       loaded with a one-component offset to not read past the matrix and
+       then rotated back. */
+    const Float* const aData = a.data();
+    const Float* const bData = b.data();
+    const __m128 a0 = _mm_loadu_ps(aData + 0);
+    const __m128 a1 = _mm_loadu_ps(aData + 3);
+    const __m128 a2 = _mm_loadu_ps(aData + 6);
+    const __m128 a3Shifted = _mm_loadu_ps(aData + 8);
+    const __m128 a3 = _mm_shuffle_ps(a3Shifted, a3Shifted, _MM_SHUFFLE(0, 3, 2, 1));
+
+    __m128 columns[4];
+    for(std::size_t col = 0; col != 4; ++col) {
+        __m128 column = _mm_mul_ps(a0, _mm_set1_ps(bData[col*3 + 0]));
+        column = _mm_add_ps(column, _mm_mul_ps(a1, _mm_set1_ps(bData[col*3 + 1])));
+        column = _mm_add_ps(column, _mm_mul_ps(a2, _mm_set1_ps(bData[col*3 + 2])));
+        columns[col] = column;
+    }
+    /* The implicit bottom row is (0, 0, 0, 1), so the translation is added
+       only to the last column */
+    columns[3] = _mm_add_ps(columns[3], a3);
+
+    /* Each store overwrites the garbage fourth component of the previous
+       one. The last column is again stored with a one-component offset,
+       with the third component of the previous column put in front. */
+    Float* const outData = out.data();
+    _mm_storeu_ps(outData + 0, columns[0]);
+    _mm_storeu_ps(outData + 3, columns[1]);
+    _mm_storeu_ps(outData + 6, columns[2]);
+    _mm_storeu_ps(outData + 8, _mm_move_ss(
+        _mm_shuffle_ps(columns[3], columns[3], _MM_SHUFFLE(2, 1, 0, 0)),
+        _mm_shuffle_ps(columns[2], columns[2], _MM_SHUFFLE(2, 2, 2, 2))));
+}
+#else
+inline void multiplyKernel(const Matrix4<Float>& a, const Matrix4<Float>& b, Matrix4<Float>& out) {
+    out = a*b;
+}
+#endif
+
+inline void multiplyKernel(const Matrix3<Float>& a, const Matrix3<Float>& b, Matrix3<Float>& out) {
+    out = a*b;
+}
+
+/* Multiplication of two affine matrices with the bottom row omitted. The
+   first product isn't added to zero, same as in the SSE2 variant. Used also
+   by the affine variants of SceneTools::flattenMeshHierarchy3D(). */
+template<std::size_t size> inline void affineMultiplyKernel(const RectangularMatrix<size, size - 1, Float>& a, const RectangularMatrix<size, size - 1, Float>& b, RectangularMatrix<size, size - 1, Float>& out) {
+    RectangularMatrix<size, size - 1, Float> result{NoInit};
+    for(std::size_t col = 0; col != size; ++col) {
+        Vector<size - 1, Float> column = a[0]*b[col][0];
+        for(std::size_t k = 1; k != size - 1; ++k)
+            column += a[k]*b[col][k];
+        if(col == size - 1) column += a[size - 1];
+        result[col] = column;
+    }
+    out = result;
+}
+
+#ifndef CORRADE_TARGET_SSE2
+inline void multiplyKernel(const Matrix4x3<Float>& a, const Matrix4x3<Float>& b, Matrix4x3<Float>& out) {
+    affineMultiplyKernel<4>(a, b, out);
+}
+#endif
+
+inline void multiplyKernel(const Matrix3x2<Float>& a, const Matrix3x2<Float>& b, Matrix3x2<Float>& out) {
+    affineMultiplyKernel<3>(a, b, out);
+}
+
+template<class T> void multiplyIntoImplementation(const Corrade::Containers::StridedArrayView1D<const T>& a, const Corrade::Containers::StridedArrayView1D<const T>& b, const Corrade::Containers::StridedArrayView1D<T>& out) {
+    CORRADE_ASSERT(a.size() == b.size() && a.size() == out.size(),
+        "Math::multiplyInto(): expected views of the same size, got" << a.size() << Corrade::Utility::Debug::nospace << "," << b.size() << "and" << out.size(), );
+
+    /* Caching values to avoid inline function calls in debug builds */
+    const char* aPtr = static_cast<const char*>(a.data());
+    const char* bPtr = static_cast<const char*>(b.data());
+    char* outPtr = static_cast<char*>(out.data());
+    const std::ptrdiff_t aStride = a.stride();
+    const std::ptrdiff_t bStride = b.stride();
+    const std::ptrdiff_t outStride = out.stride();
+    for(std::size_t i = 0, max = a.size(); i != max; ++i) {
+        multiplyKernel(*reinterpret_cast<const T*>(aPtr), *reinterpret_cast<const T*>(bPtr), *reinterpret_cast<T*>(outPtr));
+
+        aPtr += aStride;
+        bPtr += bStride;
+        outPtr += outStride;
+    }
+}
+
+}
+
+void multiplyInto(const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& b, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& out) {
+    multiplyIntoImplementation(a, b, out);
+}
+
+void multiplyInto(const Corrade::Containers::StridedArrayView1D<const Matrix3<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Matrix3<Float>>& b, const Corrade::Containers::StridedArrayView1D<Matrix3<Float>>& out) {
+    multiplyIntoImplementation(a, b, out);
+}
+
+void multiplyInto(const Corrade::Containers::StridedArrayView1D<const Matrix4x3<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Matrix4x3<Float>>& b, const Corrade::Containers::StridedArrayView1D<Matrix4x3<Float>>& out) {
+    multiplyIntoImplementation(a, b, out);
+}
+
+void multiplyInto(const Corrade::Containers::StridedArrayView1D<const Matrix3x2<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Matrix3x2<Float>>& b, const Corrade::Containers::StridedArrayView1D<Matrix3x2<Float>>& out) {
+    multiplyIntoImplementation(a, b, out);
+}
+
+void translationRotationScalingInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& translations, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& rotations, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& scalings, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& out) {
+    CORRADE_ASSERT(translations.size() == out.size() && rotations.size() == out.size() && scalings.size() == out.size(),
+        "Math::translationRotationScalingInto(): expected views of the same size, got" << translations.size() << Corrade::Utility::Debug::nospace << "," << rotations.size() << Corrade::Utility::Debug::nospace << "," << scalings.size() << "and" << out.size(), );
+
+    /* Instead of a full matrix multiplication with a scaling matrix, each
+       rotation column is scaled directly */
+    for(std::size_t i = 0, max = out.size(); i != max; ++i) {
+        const Matrix3x3<Float> rotation = rotations[i].toMatrix();
+        const Vector3<Float> scaling = scalings[i];
+        out[i] = Matrix4<Float>{
+            {rotation[0]*scaling.x(), 0.0f},
+            {rotation[1]*scaling.y(), 0.0f},
+            {rotation[2]*scaling.z(), 0.0f},
+            {translations[i], 1.0f}};
+    }
+}
+
+void translationRotationScalingInto(const Corrade::Containers::StridedArrayView1D<const Vector2<Float>>& translations, const Corrade::Containers::StridedArrayView1D<const Complex<Float>>& rotations, const Corrade::Containers::StridedArrayView1D<const Vector2<Float>>& scalings, const Corrade::Containers::StridedArrayView1D<Matrix3<Float>>& out) {
+    CORRADE_ASSERT(translations.size() == out.size() && rotations.size() == out.size() && scalings.size() == out.size(),
+        "Math::translationRotationScalingInto(): expected views of the same size, got" << translations.size() << Corrade::Utility::Debug::nospace << "," << rotations.size() << Corrade::Utility::Debug::nospace << "," << scalings.size() << "and" << out.size(), );
+
+    for(std::size_t i = 0, max = out.size(); i != max; ++i) {
+        const Matrix2x2<Float> rotation = rotations[i].toMatrix();
+        const Vector2<Float> scaling = scalings[i];
+        out[i] = Matrix3<Float>{
+            {rotation[0]*scaling.x(), 0.0f},
+            {rotation[1]*scaling.y(), 0.0f},
+            {translations[i], 1.0f}};
+    }
+}
+
+}}
@@ -0,0 +1,139 @@
+#ifndef Magnum_Math_MatrixBatch_h
+#define Magnum_Math_MatrixBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Functions @ref Magnum::Math::multiplyInto(), @ref Magnum::Math::translationRotationScalingInto()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/visibility.h"
+#include "Magnum/Math/Math.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@{ @name Batch matrix functions
+
+These functions process an unbounded range of matrices, as opposed to single
+matrices.
+
+On x86, the @ref multiplyInto() overloads for @ref Matrix4 and
+@ref Matrix4x3 use SSE2 if @ref CORRADE_TARGET_SSE2 is defined, the
+remaining overloads and @ref translationRotationScalingInto() are scalar.
+The SIMD code sums the products in the same order as the scalar code, so the
+results are the same. The views can have arbitrary strides, including zero
+strides for multiplying many matrices with a single one, see
+@ref Corrade::Containers::StridedArrayView::broadcasted().
+*/
+
+/**
+@brief Multiply matrices
+@param[in]  a       Left-hand side matrices
+@param[in]  b       Right-hand side matrices
+@param[out] out     Where to put the results
+@m_since_latest
+
+Calculates @cpp out[i] = a[i]*b[i] @ce for all items. Expects that all views
+have the same size. The @p out view is allowed to alias either @p a or @p b,
+which is useful for example when turning local transformations into absolute.
+@see @ref Matrix4::operator*()
+*/
+MAGNUM_EXPORT void multiplyInto(const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& b, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& out);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT void multiplyInto(const Corrade::Containers::StridedArrayView1D<const Matrix3<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Matrix3<Float>>& b, const Corrade::Containers::StridedArrayView1D<Matrix3<Float>>& out);
+
+/**
+@brief Multiply affine matrices
+@param[in]  a       Left-hand side matrices
+@param[in]  b       Right-hand side matrices
+@param[out] out     Where to put the results
+@m_since_latest
+
+Matrices are treated as 3D affine transformations with the bottom row omitted
+and implicitly set to @f$ (0, 0, 0, 1) @f$. The result is the same as
+converting @p a and @p b to a @ref Matrix4, multiplying them and converting
+the result back, but it needs only roughly three quarters of the memory and
+multiplications. Expects that all views have the same size. The @p out view
+is allowed to alias either @p a or @p b.
+*/
+MAGNUM_EXPORT void multiplyInto(const Corrade::Containers::StridedArrayView1D<const Matrix4x3<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Matrix4x3<Float>>& b, const Corrade::Containers::StridedArrayView1D<Matrix4x3<Float>>& out);
+
+/**
+@brief Multiply 2D affine matrices
+@m_since_latest
+
+Same as @ref multiplyInto(const Corrade::Containers::StridedArrayView1D<const Matrix4x3<Float>>&, const Corrade::Containers::StridedArrayView1D<const Matrix4x3<Float>>&, const Corrade::Containers::StridedArrayView1D<Matrix4x3<Float>>&),
+but for 2D affine transformations with the bottom row implicitly set to
+@f$ (0, 0, 1) @f$.
+*/
+MAGNUM_EXPORT void multiplyInto(const Corrade::Containers::StridedArrayView1D<const Matrix3x2<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Matrix3x2<Float>>& b, const Corrade::Containers::StridedArrayView1D<Matrix3x2<Float>>& out);
+
+/**
+@brief Compose 3D transformation matrices from translation, rotation and scaling
+@param[in]  translations    Translations
+@param[in]  rotations       Rotations
+@param[in]  scalings        Scalings
+@param[out] out             Where to put the results
+@m_since_latest
+
+Calculates the same as
+@cpp Matrix4::from(rotations[i].toMatrix(), translations[i])*Matrix4::scaling(scalings[i]) @ce
+for all items, i.e., a scaling applied first, then a rotation and then a
+translation. Expects that all views have the same size. Useful for example
+together with @ref Trade::SceneData::translationsRotationsScalings3DInto().
+*/
+MAGNUM_EXPORT void translationRotationScalingInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& translations, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& rotations, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& scalings, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& out);
+
+/**
+@brief Compose 2D transformation matrices from translation, rotation and scaling
+@param[in]  translations    Translations
+@param[in]  rotations       Rotations
+@param[in]  scalings        Scalings
+@param[out] out             Where to put the results
+@m_since_latest
+
+Calculates the same as
+@cpp Matrix3::from(rotations[i].toMatrix(), translations[i])*Matrix3::scaling(scalings[i]) @ce
+for all items. Expects that all views have the same size. Useful for example
+together with @ref Trade::SceneData::translationsRotationsScalings2DInto().
+*/
+MAGNUM_EXPORT void translationRotationScalingInto(const Corrade::Containers::StridedArrayView1D<const Vector2<Float>>& translations, const Corrade::Containers::StridedArrayView1D<const Complex<Float>>& rotations, const Corrade::Containers::StridedArrayView1D<const Vector2<Float>>& scalings, const Corrade::Containers::StridedArrayView1D<Matrix3<Float>>& out);
+
+/**
+ * @}
+ */
+
+}}
+
+#endif
@@ -31,37 +31,280 @@
 #include "Magnum/Math/Packing.h"
 #include "Magnum/Math/Implementation/halfTables.hpp"
 
+#ifdef CORRADE_TARGET_X86
+#include <Corrade/Cpu.h>
+#endif
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef CORRADE_ENABLE_AVX_F16C
+#include <immintrin.h>
+#endif
+
 namespace Magnum { namespace Math {
 
 namespace {
 
-template<class T> inline void unpackUnsignedIntoImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    CORRADE_ASSERT(src.size() == dst.size(),
-        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
-    CORRADE_ASSERT(src.template isContiguous<1>() && dst.isContiguous<1>(),
-        "Math::unpackInto(): second view dimension is not contiguous", );
-
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
+/* Calls the kernel on each row of the views. If both views are contiguous,
+   the kernel is called just once for all data, which allows the SIMD
+   implementations to process whole vectors even if the rows are shorter,
+   such as with three-component normals. */
+template<class T, class U, class Kernel> inline void batchInto(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<U>& dst, Kernel kernel) {
+    if(src.isContiguous() && dst.isContiguous()) {
+        kernel(static_cast<const T*>(src.data()), static_cast<U*>(dst.data()), src.size()[0]*src.size()[1]);
+        return;
+    }
 
-    /* Caching values to avoid inline function calls in ebug builds */
-    constexpr Float bitMax = Implementation::bitMax<T>();
+    /* Caching values to avoid inline function calls in debug builds */
     const char* srcPtr = reinterpret_cast<const char*>(src.data());
     char* dstPtr = reinterpret_cast<char*>(dst.data());
     const std::ptrdiff_t srcStride = src.stride()[0];
     const std::ptrdiff_t dstStride = dst.stride()[0];
     const std::size_t maxJ = src.size()[1];
     for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const T* srcPtrI = reinterpret_cast<const T*>(srcPtr);
-        Float* dstPtrI = reinterpret_cast<Float*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j)
-            *dstPtrI++ = *srcPtrI++/bitMax;
+        kernel(reinterpret_cast<const T*>(srcPtr), reinterpret_cast<U*>(dstPtr), maxJ);
 
         srcPtr += srcStride;
         dstPtr += dstStride;
     }
 }
 
+/* The SIMD kernels process as many items as they can in whole vectors and
+   return the count of processed items, the rest is done by the scalar code.
+   The generic variants don't process anything. All SIMD variants are
+   expected to give bit-exact results compared to the scalar code. */
+template<class T, class U> inline std::size_t unpackSse2(const T*, U*, std::size_t) { return 0; }
+template<class T, class U> inline std::size_t packSse2(const T*, U*, std::size_t) { return 0; }
+template<class T, class U> inline std::size_t castSse2(const T*, U*, std::size_t) { return 0; }
+
+#ifdef CORRADE_TARGET_SSE2
+/* Sign- or zero-extend 16 bytes or 8 shorts to 32-bit integers */
+inline void widenSse2(const UnsignedByte* const src, __m128i(&out)[4]) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    const __m128i lo = _mm_unpacklo_epi8(in, zero);
+    const __m128i hi = _mm_unpackhi_epi8(in, zero);
+    out[0] = _mm_unpacklo_epi16(lo, zero);
+    out[1] = _mm_unpackhi_epi16(lo, zero);
+    out[2] = _mm_unpacklo_epi16(hi, zero);
+    out[3] = _mm_unpackhi_epi16(hi, zero);
+}
+
+inline void widenSse2(const Byte* const src, __m128i(&out)[4]) {
+    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    /* Put each byte into the upper half of a 16-bit lane and shift it back
+       with sign extension, then the same for 16-bit to 32-bit */
+    const __m128i lo = _mm_srai_epi16(_mm_unpacklo_epi8(in, in), 8);
+    const __m128i hi = _mm_srai_epi16(_mm_unpackhi_epi8(in, in), 8);
+    out[0] = _mm_srai_epi32(_mm_unpacklo_epi16(lo, lo), 16);
+    out[1] = _mm_srai_epi32(_mm_unpackhi_epi16(lo, lo), 16);
+    out[2] = _mm_srai_epi32(_mm_unpacklo_epi16(hi, hi), 16);
+    out[3] = _mm_srai_epi32(_mm_unpackhi_epi16(hi, hi), 16);
+}
+
+inline void widenSse2(const UnsignedShort* const src, __m128i(&out)[2]) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    out[0] = _mm_unpacklo_epi16(in, zero);
+    out[1] = _mm_unpackhi_epi16(in, zero);
+}
+
+inline void widenSse2(const Short* const src, __m128i(&out)[2]) {
+    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    out[0] = _mm_srai_epi32(_mm_unpacklo_epi16(in, in), 16);
+    out[1] = _mm_srai_epi32(_mm_unpackhi_epi16(in, in), 16);
+}
+
+inline void widenSse2(const Int* const src, __m128i(&out)[1]) {
+    out[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+}
+
+/* Integers to floats, optionally divided by the max value and clamped to
+   -1. Division instead of multiplication with a reciprocal to match the
+   scalar code. */
+template<bool normalize, bool clamp, class T> std::size_t toFloatSse2(const T* const src, Float* const dst, const std::size_t count) {
+    constexpr std::size_t VectorCount = 4/sizeof(T);
+    constexpr std::size_t ItemCount = VectorCount*4;
+    const __m128 bitMax = _mm_set1_ps(Implementation::bitMax<T>());
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+
+    std::size_t i = 0;
+    for(; i + ItemCount <= count; i += ItemCount) {
+        __m128i in[VectorCount];
+        widenSse2(src + i, in);
+        for(std::size_t j = 0; j != VectorCount; ++j) {
+            __m128 value = _mm_cvtepi32_ps(in[j]);
+            if(normalize) value = _mm_div_ps(value, bitMax);
+            if(clamp) value = _mm_max_ps(value, minusOne);
+            _mm_storeu_ps(dst + i + j*4, value);
+        }
+    }
+    return i;
+}
+
+inline std::size_t unpackSse2(const UnsignedByte* const src, Float* const dst, const std::size_t count) {
+    return toFloatSse2<true, false>(src, dst, count);
+}
+
+inline std::size_t unpackSse2(const UnsignedShort* const src, Float* const dst, const std::size_t count) {
+    return toFloatSse2<true, false>(src, dst, count);
+}
+
+inline std::size_t unpackSse2(const Byte* const src, Float* const dst, const std::size_t count) {
+    return toFloatSse2<true, true>(src, dst, count);
+}
+
+inline std::size_t unpackSse2(const Short* const src, Float* const dst, const std::size_t count) {
+    return toFloatSse2<true, true>(src, dst, count);
+}
+
+inline std::size_t castSse2(const UnsignedByte* const src, Float* const dst, const std::size_t count) {
+    return toFloatSse2<false, false>(src, dst, count);
+}
+
+inline std::size_t castSse2(const Byte* const src, Float* const dst, const std::size_t count) {
+    return toFloatSse2<false, false>(src, dst, count);
+}
+
+inline std::size_t castSse2(const UnsignedShort* const src, Float* const dst, const std::size_t count) {
+    return toFloatSse2<false, false>(src, dst, count);
+}
+
+inline std::size_t castSse2(const Short* const src, Float* const dst, const std::size_t count) {
+    return toFloatSse2<false, false>(src, dst, count);
+}
+
+inline std::size_t castSse2(const Int* const src, Float* const dst, const std::size_t count) {
+    return toFloatSse2<false, false>(src, dst, count);
+}
+
+inline std::size_t castSse2(const Float* const src, Int* const dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_cvttps_epi32(_mm_loadu_ps(src + i)));
+    return i;
+}
+
+/* Multiplies four floats by the max value and rounds them half away from
+   zero like std::round() does, as opposed to _mm_cvtps_epi32() which rounds
+   half to even. Values outside of the integer range are undefined behavior
+   in the scalar code as well, so not handled here. */
+inline __m128i roundSse2(const Float* const src, const __m128 bitMax) {
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    const __m128 value = _mm_mul_ps(_mm_loadu_ps(src), bitMax);
+    const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(value));
+    const __m128 fraction = _mm_andnot_ps(signMask, _mm_sub_ps(value, truncated));
+    const __m128 adjust = _mm_and_ps(_mm_cmpge_ps(fraction, half),
+        _mm_or_ps(_mm_and_ps(value, signMask), one));
+    return _mm_cvttps_epi32(_mm_add_ps(truncated, adjust));
+}
+
+inline std::size_t packSse2(const Float* const src, UnsignedByte* const dst, const std::size_t count) {
+    const __m128 bitMax = _mm_set1_ps(Implementation::bitMax<UnsignedByte>());
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16) {
+        const __m128i lo = _mm_packs_epi32(roundSse2(src + i + 0, bitMax), roundSse2(src + i + 4, bitMax));
+        const __m128i hi = _mm_packs_epi32(roundSse2(src + i + 8, bitMax), roundSse2(src + i + 12, bitMax));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+    }
+    return i;
+}
+
+inline std::size_t packSse2(const Float* const src, Byte* const dst, const std::size_t count) {
+    const __m128 bitMax = _mm_set1_ps(Implementation::bitMax<Byte>());
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16) {
+        const __m128i lo = _mm_packs_epi32(roundSse2(src + i + 0, bitMax), roundSse2(src + i + 4, bitMax));
+        const __m128i hi = _mm_packs_epi32(roundSse2(src + i + 8, bitMax), roundSse2(src + i + 12, bitMax));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi16(lo, hi));
+    }
+    return i;
+}
+
+inline std::size_t packSse2(const Float* const src, UnsignedShort* const dst, const std::size_t count) {
+    const __m128 bitMax = _mm_set1_ps(Implementation::bitMax<UnsignedShort>());
+    /* There's no unsigned saturating 32-to-16-bit pack in SSE2, so shift the
+       range to signed and back */
+    const __m128i bias32 = _mm_set1_epi32(32768);
+    const __m128i bias16 = _mm_set1_epi16(-32768);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m128i lo = _mm_sub_epi32(roundSse2(src + i + 0, bitMax), bias32);
+        const __m128i hi = _mm_sub_epi32(roundSse2(src + i + 4, bitMax), bias32);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(_mm_packs_epi32(lo, hi), bias16));
+    }
+    return i;
+}
+
+inline std::size_t packSse2(const Float* const src, Short* const dst, const std::size_t count) {
+    const __m128 bitMax = _mm_set1_ps(Implementation::bitMax<Short>());
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(roundSse2(src + i + 0, bitMax), roundSse2(src + i + 4, bitMax)));
+    return i;
+}
+#endif
+
+#ifdef CORRADE_ENABLE_AVX_F16C
+CORRADE_ENABLE_AVX_F16C std::size_t unpackHalfF16c(const UnsignedShort* const src, Float* const dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+    return i;
+}
+
+CORRADE_ENABLE_AVX_F16C std::size_t packHalfF16c(const Float* const src, UnsignedShort* const dst, const std::size_t count) {
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    const __m256 overflowThreshold = _mm256_set1_ps(65536.0f);
+    const __m128i signMask = _mm_set1_epi16(-32768);
+    const __m128i infinity = _mm_set1_epi16(0x7c00);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m256 in = _mm256_loadu_ps(src + i);
+        /* The tables used by the scalar code truncate the mantissa, so round
+           towards zero as well. Unlike the tables, rounding towards zero
+           however doesn't turn values out of range into an infinity, so fix
+           those up. NaNs compare false and are left as-is. */
+        const __m128i out = _mm256_cvtps_ph(in, _MM_FROUND_TO_ZERO|_MM_FROUND_NO_EXC);
+        const __m256 overflow = _mm256_cmp_ps(_mm256_and_ps(in, absMask), overflowThreshold, _CMP_GE_OQ);
+        const __m128i overflow16 = _mm_packs_epi32(
+            _mm_castps_si128(_mm256_castps256_ps128(overflow)),
+            _mm_castps_si128(_mm256_extractf128_ps(overflow, 1)));
+        const __m128i signedInfinity = _mm_or_si128(_mm_and_si128(out, signMask), infinity);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+            _mm_or_si128(_mm_andnot_si128(overflow16, out), _mm_and_si128(overflow16, signedInfinity)));
+    }
+    return i;
+}
+
+#ifndef CORRADE_TARGET_AVX_F16C
+/* Not enabled at compile time, query the CPU just once */
+bool hasF16c() {
+    static const bool has = bool(Corrade::Cpu::runtimeFeatures() & Corrade::Cpu::AvxF16c);
+    return has;
+}
+#endif
+#endif
+
+template<class T> void unpackUnsignedKernel(const T* const src, Float* const dst, const std::size_t count) {
+    /* Caching values to avoid inline function calls in debug builds */
+    constexpr Float bitMax = Implementation::bitMax<T>();
+    for(std::size_t i = unpackSse2(src, dst, count); i != count; ++i)
+        dst[i] = src[i]/bitMax;
+}
+
+template<class T> inline void unpackUnsignedIntoImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.template isContiguous<1>() && dst.isContiguous<1>(),
+        "Math::unpackInto(): second view dimension is not contiguous", );
+
+    batchInto(src, dst, unpackUnsignedKernel<T>);
+}
+
 }
 
 void unpackInto(const Corrade::Containers::StridedArrayView2D<const UnsignedByte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
@@ -74,34 +317,23 @@ void unpackInto(const Corrade::Containers::StridedArrayView2D<const UnsignedShor
 
 namespace {
 
+template<class T> void unpackSignedKernel(const T* const src, Float* const dst, const std::size_t count) {
+    /* Caching values to avoid inline function calls in debug builds */
+    constexpr Float bitMax = Implementation::bitMax<T>();
+    for(std::size_t i = unpackSse2(src, dst, count); i != count; ++i) {
+        const Float value = src[i]/bitMax;
+        /* Avoiding a max() call in Debug */
+        dst[i] = value < -1.0f ? -1.0f : value;
+    }
+}
+
 template<class T> inline void unpackSignedIntoImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
     CORRADE_ASSERT(src.size() == dst.size(),
         "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
     CORRADE_ASSERT(src.template isContiguous<1>() && dst.isContiguous<1>(),
         "Math::unpackInto(): second view dimension is not contiguous", );
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
-
-    /* Caching values to avoid inline function calls in debug builds */
-    constexpr Float bitMax = Implementation::bitMax<T>();
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const T* srcPtrI = reinterpret_cast<const T*>(srcPtr);
-        Float* dstPtrI = reinterpret_cast<Float*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j) {
-            const Float value = *srcPtrI++/bitMax;
-            /* Avoiding a max() call in Debug */
-            *dstPtrI++ = value < -1.0f ? -1.0f : value;
-        }
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    batchInto(src, dst, unpackSignedKernel<T>);
 }
 
 }
@@ -116,32 +348,21 @@ void unpackInto(const Corrade::Containers::StridedArrayView2D<const Short>& src,
 
 namespace {
 
+template<class T> void packKernel(const Float* const src, T* const dst, const std::size_t count) {
+    /* Caching values to avoid inline function calls in debug builds */
+    constexpr Float bitMax = Implementation::bitMax<T>();
+    for(std::size_t i = packSse2(src, dst, count); i != count; ++i)
+        /** @todo provide a version that doesn't do rounding */
+        dst[i] = std::round(src[i]*bitMax);
+}
+
 template<class T> inline void packIntoImplementation(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<T>& dst) {
     CORRADE_ASSERT(src.size() == dst.size(),
         "Math::packInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
     CORRADE_ASSERT(src.isContiguous<1>() && dst.template isContiguous<1>(),
         "Math::packInto(): second view dimension is not contiguous", );
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
-
-    /* Caching values to avoid inline function calls in debug builds */
-    constexpr Float bitMax = Implementation::bitMax<T>();
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const Float* srcPtrI = reinterpret_cast<const Float*>(srcPtr);
-        T* dstPtrI = reinterpret_cast<T*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j)
-            /** @todo provide a version that doesn't do rounding */
-            *dstPtrI++ = std::round(*srcPtrI++*bitMax);
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    batchInto(src, dst, packKernel<T>);
 }
 
 }
@@ -164,30 +385,18 @@ void packInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, c
 
 namespace {
 
+template<class T, class U> void castKernel(const T* const src, U* const dst, const std::size_t count) {
+    for(std::size_t i = castSse2(src, dst, count); i != count; ++i)
+        dst[i] = U(src[i]);
+}
+
 template<class T, class U> inline void castIntoImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<U>& dst) {
     CORRADE_ASSERT(src.size() == dst.size(),
         "Math::castInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
     CORRADE_ASSERT(src.template isContiguous<1>() && dst.template isContiguous<1>(),
         "Math::castInto(): second view dimension is not contiguous", );
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
-
-    /* Caching values to avoid inline function calls in debug buílds */
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const T* srcPtrI = reinterpret_cast<const T*>(srcPtr);
-        U* dstPtrI = reinterpret_cast<U*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j)
-            *dstPtrI++ = U(*srcPtrI++);
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    batchInto(src, dst, castKernel<T, U>);
 }
 
 }
@@ -398,29 +607,47 @@ static_assert(sizeof(HalfMantissaTable) + sizeof(HalfOffsetTable) + sizeof(HalfE
 static_assert(sizeof(HalfBaseTable) + sizeof(HalfShiftTable) == 1536,
     "improper size of float->half conversion tables");
 
+namespace {
+
+void unpackHalfKernel(const UnsignedShort* const src, Float* const dst, const std::size_t count) {
+    std::size_t i = 0;
+    #ifdef CORRADE_TARGET_AVX_F16C
+    i = unpackHalfF16c(src, dst, count);
+    #elif defined(CORRADE_ENABLE_AVX_F16C)
+    if(hasF16c()) i = unpackHalfF16c(src, dst, count);
+    #endif
+
+    UnsignedInt* const dstI = reinterpret_cast<UnsignedInt*>(dst);
+    for(; i != count; ++i) {
+        const UnsignedShort h = src[i];
+        dstI[i] = HalfMantissaTable[HalfOffsetTable[h >> 10] + (h & 0x3ff)] + HalfExponentTable[h >> 10];
+    }
+}
+
+void packHalfKernel(const Float* const src, UnsignedShort* const dst, const std::size_t count) {
+    std::size_t i = 0;
+    #ifdef CORRADE_TARGET_AVX_F16C
+    i = packHalfF16c(src, dst, count);
+    #elif defined(CORRADE_ENABLE_AVX_F16C)
+    if(hasF16c()) i = packHalfF16c(src, dst, count);
+    #endif
+
+    const UnsignedInt* const srcI = reinterpret_cast<const UnsignedInt*>(src);
+    for(; i != count; ++i) {
+        const UnsignedInt f = srcI[i];
+        dst[i] = HalfBaseTable[(f >> 23) & 0x1ff] + ((f & 0x007fffff) >> HalfShiftTable[(f >> 23) & 0x1ff]);
+    }
+}
+
+}
+
 void unpackHalfInto(const Corrade::Containers::StridedArrayView2D<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
     CORRADE_ASSERT(src.size() == dst.size(),
         "Math::unpackHalfInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
     CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
         "Math::unpackHalfInto(): second view dimension is not contiguous", );
 
-    /* Caching values to avoid inline function calls in debug builds */
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const UnsignedShort* srcPtrI = reinterpret_cast<const UnsignedShort*>(srcPtr);
-        UnsignedInt* dstPtrI = reinterpret_cast<UnsignedInt*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j) {
-            const UnsignedShort h = *srcPtrI++;
-            *dstPtrI++ = HalfMantissaTable[HalfOffsetTable[h >> 10] + (h & 0x3ff)] + HalfExponentTable[h >> 10];
-        }
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    batchInto(src, dst, unpackHalfKernel);
 }
 
 void packHalfInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedShort>& dst) {
@@ -429,23 +656,7 @@ void packHalfInto(const Corrade::Containers::StridedArrayView2D<const Float>& sr
     CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
         "Math::packHalfInto(): second view dimension is not contiguous", );
 
-    /* Caching values to avoid inline function calls in debug builds */
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const UnsignedInt* srcPtrI = reinterpret_cast<const UnsignedInt*>(srcPtr);
-        UnsignedShort* dstPtrI = reinterpret_cast<UnsignedShort*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j) {
-            const UnsignedInt f = *srcPtrI++;
-            *dstPtrI++ = HalfBaseTable[(f >> 23) & 0x1ff] + ((f & 0x007fffff) >> HalfShiftTable[(f >> 23) & 0x1ff]);
-        }
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    batchInto(src, dst, packHalfKernel);
 }
 
 }}
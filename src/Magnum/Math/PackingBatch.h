@@ -42,6 +42,15 @@ namespace Magnum { namespace Math {
 
 These functions process an ubounded range of values, as opposed to single
 vectors or scalars.
+
+On x86, the @ref packInto(), @ref unpackInto() functions as well as
+@ref castInto() between 8-, 16- and 32-bit integers and 32-bit floats use SSE2
+if @ref CORRADE_TARGET_SSE2 is defined, and @ref packHalfInto() and
+@ref unpackHalfInto() use F16C instructions if they're either enabled at
+compile time or detected at runtime. Results are the same as with the scalar
+code. If both views are contiguous, all data are processed at once, otherwise
+just each row is vectorized, which is considerably slower for rows with only a
+few components.
 */
 
 /**
@@ -141,7 +150,9 @@ and @p dst have the same size and that the second dimension in both is
 contiguous.
 
 Algorithm used: *Jeroen van der Zijp -- Fast Half Float Conversions, 2008,
-ftp://ftp.fox-toolkit.org/pub/fasthalffloatconversion.pdf*
+ftp://ftp.fox-toolkit.org/pub/fasthalffloatconversion.pdf*. If F16C is
+available, it's used instead with the same results, except for NaN payloads
+that may differ.
 @see @ref Half
 */
 MAGNUM_EXPORT void packHalfInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedShort>& dst);
@@ -160,7 +171,9 @@ thus more suitable for batch conversions of large data amounts. Expects that
 contiguous.
 
 Algorithm used: *Jeroen van der Zijp -- Fast Half Float Conversions, 2008,
-ftp://ftp.fox-toolkit.org/pub/fasthalffloatconversion.pdf*
+ftp://ftp.fox-toolkit.org/pub/fasthalffloatconversion.pdf*. If F16C is
+available, it's used instead with the same results, except for signaling NaNs
+that get converted to quiet NaNs.
 @see @ref Half
 */
 MAGNUM_EXPORT void unpackHalfInto(const Corrade::Containers::StridedArrayView2D<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst);
@@ -0,0 +1,156 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SwizzleBatch.h"
+
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Vector4.h"
+
+#ifdef CORRADE_TARGET_X86
+#include <Corrade/Cpu.h>
+#endif
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef CORRADE_ENABLE_SSSE3
+#include <tmmintrin.h>
+#endif
+
+namespace Magnum { namespace Math {
+
+namespace {
+
+/* The SIMD kernels process as many items as they can in whole vectors and
+   return the count of processed items, the rest is done by the scalar code.
+   The generic variants don't process anything. */
+#ifndef CORRADE_TARGET_SSE2
+inline std::size_t swapRedBlueSse2(Vector4<UnsignedByte>*, std::size_t) { return 0; }
+#else
+/* Four-component variant done with shifts and masks, processing four pixels
+   at a time */
+inline std::size_t swapRedBlueSse2(Vector4<UnsignedByte>* const data, const std::size_t count) {
+    const __m128i greenAlphaMask = _mm_set1_epi32(Int(0xff00ff00));
+    const __m128i redMask = _mm_set1_epi32(0x000000ff);
+    const __m128i blueMask = _mm_set1_epi32(0x00ff0000);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        __m128i* const ptr = reinterpret_cast<__m128i*>(data + i);
+        const __m128i in = _mm_loadu_si128(ptr);
+        _mm_storeu_si128(ptr, _mm_or_si128(_mm_and_si128(in, greenAlphaMask),
+            _mm_or_si128(_mm_and_si128(_mm_srli_epi32(in, 16), redMask),
+                         _mm_and_si128(_mm_slli_epi32(in, 16), blueMask))));
+    }
+    return i;
+}
+#endif
+
+#ifdef CORRADE_ENABLE_SSSE3
+/* Three-component pixels don't fit into a 16-byte vector, so each iteration
+   processes eight pixels from three overlapping 16-byte windows, each
+   producing eight bytes of output. All loads are done before the stores, so
+   the in-place operation doesn't need to wait on store forwarding. */
+CORRADE_ENABLE_SSSE3 std::size_t swapRedBlueSsse3(Vector3<UnsignedByte>* const data, const std::size_t count) {
+    const __m128i shuffle0 = _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i shuffle1 = _mm_setr_epi8(2, 7, 6, 5, 10, 9, 8, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i shuffle2 = _mm_setr_epi8(8, 7, 12, 11, 10, 15, 14, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        char* const ptr = reinterpret_cast<char*>(data + i);
+        const __m128i in0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + 0));
+        const __m128i in1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + 4));
+        const __m128i in2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + 8));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(ptr + 0), _mm_shuffle_epi8(in0, shuffle0));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(ptr + 8), _mm_shuffle_epi8(in1, shuffle1));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(ptr + 16), _mm_shuffle_epi8(in2, shuffle2));
+    }
+    return i;
+}
+
+CORRADE_ENABLE_SSSE3 std::size_t swapRedBlueSsse3(Vector4<UnsignedByte>* const data, const std::size_t count) {
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        __m128i* const ptr = reinterpret_cast<__m128i*>(data + i);
+        _mm_storeu_si128(ptr, _mm_shuffle_epi8(_mm_loadu_si128(ptr), shuffle));
+    }
+    return i;
+}
+
+#ifndef CORRADE_TARGET_SSSE3
+/* Not enabled at compile time, query the CPU just once */
+bool hasSsse3() {
+    static const bool has = bool(Corrade::Cpu::runtimeFeatures() & Corrade::Cpu::Ssse3);
+    return has;
+}
+#endif
+#endif
+
+template<class T> inline void swapRedBlueScalar(const Corrade::Containers::StridedArrayView1D<T>& data, const std::size_t begin) {
+    /* Caching values to avoid inline function calls in debug builds */
+    char* ptr = static_cast<char*>(data.data()) + begin*data.stride();
+    const std::ptrdiff_t stride = data.stride();
+    for(std::size_t i = begin, max = data.size(); i != max; ++i, ptr += stride) {
+        T& pixel = *reinterpret_cast<T*>(ptr);
+        const UnsignedByte red = pixel[0];
+        pixel[0] = pixel[2];
+        pixel[2] = red;
+    }
+}
+
+}
+
+void swapRedBlueInPlace(const Corrade::Containers::StridedArrayView1D<Vector3<UnsignedByte>>& data) {
+    std::size_t i = 0;
+    #ifdef CORRADE_ENABLE_SSSE3
+    if(data.isContiguous()) {
+        #ifdef CORRADE_TARGET_SSSE3
+        i = swapRedBlueSsse3(static_cast<Vector3<UnsignedByte>*>(data.data()), data.size());
+        #else
+        if(hasSsse3()) i = swapRedBlueSsse3(static_cast<Vector3<UnsignedByte>*>(data.data()), data.size());
+        #endif
+    }
+    #endif
+
+    swapRedBlueScalar(data, i);
+}
+
+void swapRedBlueInPlace(const Corrade::Containers::StridedArrayView1D<Vector4<UnsignedByte>>& data) {
+    std::size_t i = 0;
+    if(data.isContiguous()) {
+        Vector4<UnsignedByte>* const ptr = static_cast<Vector4<UnsignedByte>*>(data.data());
+        #ifdef CORRADE_TARGET_SSSE3
+        i = swapRedBlueSsse3(ptr, data.size());
+        #elif defined(CORRADE_ENABLE_SSSE3)
+        i = hasSsse3() ? swapRedBlueSsse3(ptr, data.size()) : swapRedBlueSse2(ptr, data.size());
+        #else
+        i = swapRedBlueSse2(ptr, data.size());
+        #endif
+    }
+
+    swapRedBlueScalar(data, i);
+}
+
+}}
@@ -0,0 +1,83 @@
+#ifndef Magnum_Math_SwizzleBatch_h
+#define Magnum_Math_SwizzleBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Function @ref Magnum::Math::swapRedBlueInPlace()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/visibility.h"
+#include "Magnum/Math/Math.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@{ @name Batch swizzle functions
+
+These functions process an unbounded range of vectors, as opposed to single
+vectors.
+
+On x86, @ref swapRedBlueInPlace() uses SSSE3 if it's either enabled at
+compile time or detected at runtime, and the four-component variant falls back
+to SSE2 if @ref CORRADE_TARGET_SSE2 is defined. The SIMD code is used only if
+the view is contiguous, otherwise the vectors are processed one by one.
+*/
+
+/**
+@brief Swap red and blue channels of 8-bit RGB vectors in-place
+@param[in,out] data     Vectors to swizzle
+@m_since_latest
+
+Calculates @cpp data[i] = Math::gather<'b', 'g', 'r'>(data[i]) @ce for all
+items, i.e. converts RGB to BGR and vice versa. Useful for file formats such
+as TGA that store the channels in a reverse order.
+@see @ref gather()
+*/
+MAGNUM_EXPORT void swapRedBlueInPlace(const Corrade::Containers::StridedArrayView1D<Vector3<UnsignedByte>>& data);
+
+/**
+@brief Swap red and blue channels of 8-bit RGBA vectors in-place
+@param[in,out] data     Vectors to swizzle
+@m_since_latest
+
+Calculates @cpp data[i] = Math::gather<'b', 'g', 'r', 'a'>(data[i]) @ce for
+all items, i.e. converts RGBA to BGRA and vice versa.
+@see @ref gather()
+*/
+MAGNUM_EXPORT void swapRedBlueInPlace(const Corrade::Containers::StridedArrayView1D<Vector4<UnsignedByte>>& data);
+
+/**
+ * @}
+ */
+
+}}
+
+#endif
@@ -0,0 +1,225 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/MatrixBatch.h"
+#include "Magnum/Math/Quaternion.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct MatrixBatchBenchmark: Corrade::TestSuite::Tester {
+    explicit MatrixBatchBenchmark();
+
+    void multiply4Baseline();
+    void multiply4();
+    void multiplyAffine3DBaseline();
+    void multiplyAffine3D();
+    void multiply4BroadcastedBaseline();
+    void multiply4Broadcasted();
+
+    void translationRotationScaling3DBaseline();
+    void translationRotationScaling3D();
+
+    private:
+        void throughputBegin();
+        std::uint64_t throughputEnd();
+
+        std::chrono::high_resolution_clock::time_point _begin;
+};
+
+/* Each benchmark iteration processes Count matrices. Instead of the time, the
+   benchmarks report the count of matrices produced per second. */
+enum: std::size_t { Count = 16384 };
+
+typedef Math::Deg<Float> Deg;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Matrix4x3<Float> Matrix4x3;
+typedef Math::Quaternion<Float> Quaternion;
+
+MatrixBatchBenchmark::MatrixBatchBenchmark() {
+    addCustomBenchmarks({&MatrixBatchBenchmark::multiply4Baseline,
+                         &MatrixBatchBenchmark::multiply4,
+                         &MatrixBatchBenchmark::multiplyAffine3DBaseline,
+                         &MatrixBatchBenchmark::multiplyAffine3D,
+                         &MatrixBatchBenchmark::multiply4BroadcastedBaseline,
+                         &MatrixBatchBenchmark::multiply4Broadcasted,
+
+                         &MatrixBatchBenchmark::translationRotationScaling3DBaseline,
+                         &MatrixBatchBenchmark::translationRotationScaling3D}, 50,
+        &MatrixBatchBenchmark::throughputBegin,
+        &MatrixBatchBenchmark::throughputEnd,
+        BenchmarkUnits::Count);
+}
+
+void MatrixBatchBenchmark::throughputBegin() {
+    _begin = std::chrono::high_resolution_clock::now();
+}
+
+std::uint64_t MatrixBatchBenchmark::throughputEnd() {
+    const std::chrono::nanoseconds::rep duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - _begin).count();
+    return std::uint64_t(Double(Count)*1.0e9/Double(duration ? duration : 1));
+}
+
+Corrade::Containers::Array<Matrix4> transformations(const Float offset) {
+    Corrade::Containers::Array<Matrix4> out{Corrade::NoInit, Count};
+    for(std::size_t i = 0; i != Count; ++i)
+        out[i] = Matrix4::translation({Float(i%17), offset, -Float(i%5)})*
+                 Matrix4::rotation(Deg(Float(i%360) + offset), Vector3{1.0f, 3.0f, -1.4f}.normalized())*
+                 Matrix4::scaling(Vector3{1.0f + Float(i%3)});
+    return out;
+}
+
+Corrade::Containers::Array<Matrix4x3> affineTransformations(const Float offset) {
+    const Corrade::Containers::Array<Matrix4> in = transformations(offset);
+    Corrade::Containers::Array<Matrix4x3> out{Corrade::NoInit, Count};
+    for(std::size_t i = 0; i != Count; ++i)
+        out[i] = Matrix4x3{in[i]};
+    return out;
+}
+
+void MatrixBatchBenchmark::multiply4Baseline() {
+    const Corrade::Containers::Array<Matrix4> a = transformations(0.0f);
+    const Corrade::Containers::Array<Matrix4> b = transformations(1.0f);
+    Corrade::Containers::Array<Matrix4> out{Corrade::NoInit, Count};
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != Count; ++i)
+            out[i] = a[i]*b[i];
+    }
+
+    CORRADE_COMPARE(out[1], a[1]*b[1]);
+}
+
+void MatrixBatchBenchmark::multiply4() {
+    const Corrade::Containers::Array<Matrix4> a = transformations(0.0f);
+    const Corrade::Containers::Array<Matrix4> b = transformations(1.0f);
+    Corrade::Containers::Array<Matrix4> out{Corrade::NoInit, Count};
+    CORRADE_BENCHMARK(1) {
+        multiplyInto(Corrade::Containers::stridedArrayView(a),
+                     Corrade::Containers::stridedArrayView(b),
+                     Corrade::Containers::stridedArrayView(out));
+    }
+
+    CORRADE_COMPARE(out[1], a[1]*b[1]);
+}
+
+void MatrixBatchBenchmark::multiplyAffine3DBaseline() {
+    /* Done through full 4x4 matrices, as that's what one would do without
+       the batch API */
+    const Corrade::Containers::Array<Matrix4x3> a = affineTransformations(0.0f);
+    const Corrade::Containers::Array<Matrix4x3> b = affineTransformations(1.0f);
+    Corrade::Containers::Array<Matrix4x3> out{Corrade::NoInit, Count};
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != Count; ++i)
+            out[i] = Matrix4x3{Matrix4{a[i]}*Matrix4{b[i]}};
+    }
+
+    CORRADE_COMPARE(out[1], Matrix4x3{Matrix4{a[1]}*Matrix4{b[1]}});
+}
+
+void MatrixBatchBenchmark::multiplyAffine3D() {
+    const Corrade::Containers::Array<Matrix4x3> a = affineTransformations(0.0f);
+    const Corrade::Containers::Array<Matrix4x3> b = affineTransformations(1.0f);
+    Corrade::Containers::Array<Matrix4x3> out{Corrade::NoInit, Count};
+    CORRADE_BENCHMARK(1) {
+        multiplyInto(Corrade::Containers::stridedArrayView(a),
+                     Corrade::Containers::stridedArrayView(b),
+                     Corrade::Containers::stridedArrayView(out));
+    }
+
+    CORRADE_COMPARE(out[1], Matrix4x3{Matrix4{a[1]}*Matrix4{b[1]}});
+}
+
+void MatrixBatchBenchmark::multiply4BroadcastedBaseline() {
+    const Matrix4 global = Matrix4::scaling(Vector3{2.0f});
+    Corrade::Containers::Array<Matrix4> out = transformations(0.0f);
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != Count; ++i)
+            out[i] = global*out[i];
+    }
+
+    CORRADE_VERIFY(out[1].toVector().sum() != 0);
+}
+
+void MatrixBatchBenchmark::multiply4Broadcasted() {
+    const Matrix4 global = Matrix4::scaling(Vector3{2.0f});
+    Corrade::Containers::Array<Matrix4> out = transformations(0.0f);
+    CORRADE_BENCHMARK(1) {
+        multiplyInto(Corrade::Containers::stridedArrayView(Corrade::Containers::arrayView(&global, 1)).broadcasted<0>(Count),
+                     Corrade::Containers::stridedArrayView(out),
+                     Corrade::Containers::stridedArrayView(out));
+    }
+
+    CORRADE_VERIFY(out[1].toVector().sum() != 0);
+}
+
+void MatrixBatchBenchmark::translationRotationScaling3DBaseline() {
+    Corrade::Containers::Array<Vector3> translations{Corrade::NoInit, Count};
+    Corrade::Containers::Array<Quaternion> rotations{Corrade::NoInit, Count};
+    Corrade::Containers::Array<Vector3> scalings{Corrade::NoInit, Count};
+    for(std::size_t i = 0; i != Count; ++i) {
+        translations[i] = {Float(i%17), 0.0f, -Float(i%5)};
+        rotations[i] = Quaternion::rotation(Deg(Float(i%360)), Vector3{1.0f, 3.0f, -1.4f}.normalized());
+        scalings[i] = Vector3{1.0f + Float(i%3)};
+    }
+
+    Corrade::Containers::Array<Matrix4> out{Corrade::NoInit, Count};
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != Count; ++i)
+            out[i] = Matrix4::from(rotations[i].toMatrix(), translations[i])*Matrix4::scaling(scalings[i]);
+    }
+
+    CORRADE_COMPARE(out[1], Matrix4::from(rotations[1].toMatrix(), translations[1])*Matrix4::scaling(scalings[1]));
+}
+
+void MatrixBatchBenchmark::translationRotationScaling3D() {
+    Corrade::Containers::Array<Vector3> translations{Corrade::NoInit, Count};
+    Corrade::Containers::Array<Quaternion> rotations{Corrade::NoInit, Count};
+    Corrade::Containers::Array<Vector3> scalings{Corrade::NoInit, Count};
+    for(std::size_t i = 0; i != Count; ++i) {
+        translations[i] = {Float(i%17), 0.0f, -Float(i%5)};
+        rotations[i] = Quaternion::rotation(Deg(Float(i%360)), Vector3{1.0f, 3.0f, -1.4f}.normalized());
+        scalings[i] = Vector3{1.0f + Float(i%3)};
+    }
+
+    Corrade::Containers::Array<Matrix4> out{Corrade::NoInit, Count};
+    CORRADE_BENCHMARK(1) {
+        translationRotationScalingInto(Corrade::Containers::stridedArrayView(translations),
+                                       Corrade::Containers::stridedArrayView(rotations),
+                                       Corrade::Containers::stridedArrayView(scalings),
+                                       Corrade::Containers::stridedArrayView(out));
+    }
+
+    CORRADE_COMPARE(out[1], Matrix4::from(rotations[1].toMatrix(), translations[1])*Matrix4::scaling(scalings[1]));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::MatrixBatchBenchmark)
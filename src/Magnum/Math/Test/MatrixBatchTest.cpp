@@ -0,0 +1,301 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Complex.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/MatrixBatch.h"
+#include "Magnum/Math/Quaternion.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct MatrixBatchTest: Corrade::TestSuite::Tester {
+    explicit MatrixBatchTest();
+
+    void multiply3();
+    void multiply4();
+    void multiplyAffine2D();
+    void multiplyAffine3D();
+    void multiplyAliased();
+    void multiplyStridedBroadcasted();
+
+    void translationRotationScaling2D();
+    void translationRotationScaling3D();
+
+    void assertions();
+};
+
+typedef Math::Deg<Float> Deg;
+typedef Math::Vector2<Float> Vector2;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Matrix3<Float> Matrix3;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Matrix3x2<Float> Matrix3x2;
+typedef Math::Matrix4x3<Float> Matrix4x3;
+typedef Math::Complex<Float> Complex;
+typedef Math::Quaternion<Float> Quaternion;
+
+MatrixBatchTest::MatrixBatchTest() {
+    addTests({&MatrixBatchTest::multiply3,
+              &MatrixBatchTest::multiply4,
+              &MatrixBatchTest::multiplyAffine2D,
+              &MatrixBatchTest::multiplyAffine3D,
+              &MatrixBatchTest::multiplyAliased,
+              &MatrixBatchTest::multiplyStridedBroadcasted,
+
+              &MatrixBatchTest::translationRotationScaling2D,
+              &MatrixBatchTest::translationRotationScaling3D,
+
+              &MatrixBatchTest::assertions});
+}
+
+const Matrix3 Transformations2D[]{
+    Matrix3::translation({1.0f, -2.0f})*Matrix3::rotation(Deg{35.0f}),
+    Matrix3::scaling({0.5f, 3.0f})*Matrix3::rotation(Deg{-120.0f}),
+    Matrix3::rotation(Deg{15.0f})*Matrix3::translation({-0.25f, 7.5f}),
+};
+
+const Matrix4 Transformations3D[]{
+    Matrix4::translation({1.0f, -2.0f, 3.0f})*Matrix4::rotationX(Deg{35.0f}),
+    Matrix4::scaling({0.5f, 3.0f, -1.0f})*Matrix4::rotation(Deg{-120.0f}, Vector3{1.0f, 1.0f, 0.0f}.normalized()),
+    Matrix4::rotationZ(Deg{15.0f})*Matrix4::translation({-0.25f, 7.5f, 0.0f}),
+};
+
+void MatrixBatchTest::multiply3() {
+    const Matrix3 b[]{
+        Matrix3::rotation(Deg{90.0f}),
+        Matrix3::translation({3.0f, 4.0f}),
+        Matrix3::scaling({2.0f, 2.0f})
+    };
+    /* Full matrices with a non-trivial bottom row */
+    const Matrix3 a[]{
+        Transformations2D[0],
+        Transformations2D[1],
+        Matrix3::projection({4.0f, 3.0f})*Transformations2D[2]
+    };
+
+    Matrix3 out[3];
+    multiplyInto(a, b, out);
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i], a[i]*b[i]);
+    }
+}
+
+void MatrixBatchTest::multiply4() {
+    const Matrix4 b[]{
+        Matrix4::rotationY(Deg{90.0f}),
+        Matrix4::translation({3.0f, 4.0f, 5.0f}),
+        Matrix4::scaling({2.0f, 2.0f, -1.0f})
+    };
+    /* Full matrices with a non-trivial bottom row */
+    const Matrix4 a[]{
+        Transformations3D[0],
+        Matrix4::perspectiveProjection(Deg{60.0f}, 1.5f, 0.1f, 100.0f)*Transformations3D[1],
+        Transformations3D[2]
+    };
+
+    Matrix4 out[3];
+    multiplyInto(a, b, out);
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i], a[i]*b[i]);
+    }
+}
+
+void MatrixBatchTest::multiplyAffine2D() {
+    Matrix3x2 a[3];
+    Matrix3x2 b[3];
+    for(std::size_t i = 0; i != 3; ++i) {
+        a[i] = Matrix3x2{Transformations2D[i]};
+        b[i] = Matrix3x2{Transformations2D[2 - i]};
+    }
+
+    Matrix3x2 out[3];
+    multiplyInto(a, b, out);
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i], Matrix3x2{Transformations2D[i]*Transformations2D[2 - i]});
+    }
+}
+
+void MatrixBatchTest::multiplyAffine3D() {
+    Matrix4x3 a[3];
+    Matrix4x3 b[3];
+    for(std::size_t i = 0; i != 3; ++i) {
+        a[i] = Matrix4x3{Transformations3D[i]};
+        b[i] = Matrix4x3{Transformations3D[2 - i]};
+    }
+
+    /* Guard items around the output to verify the SIMD code doesn't write
+       outside of the matrices */
+    const Matrix4x3 guard{Math::IdentityInit, 7.0f};
+    Matrix4x3 out[5]{guard, {}, {}, {}, guard};
+    multiplyInto(a, b, Corrade::Containers::arrayView(out).slice(1, 4));
+    CORRADE_COMPARE(out[0], guard);
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i + 1], Matrix4x3{Transformations3D[i]*Transformations3D[2 - i]});
+    }
+    CORRADE_COMPARE(out[4], guard);
+}
+
+void MatrixBatchTest::multiplyAliased() {
+    Matrix4 a[3];
+    Matrix4 b[3];
+    Matrix4x3 aAffine[3];
+    Matrix4x3 bAffine[3];
+    for(std::size_t i = 0; i != 3; ++i) {
+        a[i] = Transformations3D[i];
+        b[i] = Transformations3D[2 - i];
+        aAffine[i] = Matrix4x3{a[i]};
+        bAffine[i] = Matrix4x3{b[i]};
+    }
+
+    /* Output aliasing the left side, the usual case when turning local
+       transformations into absolute */
+    multiplyInto(b, a, b);
+    multiplyInto(bAffine, aAffine, bAffine);
+    /* Output aliasing the right side */
+    multiplyInto(b, a, a);
+    multiplyInto(bAffine, aAffine, aAffine);
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        const Matrix4 expected = Transformations3D[2 - i]*Transformations3D[i];
+        CORRADE_COMPARE(b[i], expected);
+        CORRADE_COMPARE(bAffine[i], Matrix4x3{expected});
+        CORRADE_COMPARE(a[i], expected*Transformations3D[i]);
+        CORRADE_COMPARE(aAffine[i], Matrix4x3{expected*Transformations3D[i]});
+    }
+}
+
+void MatrixBatchTest::multiplyStridedBroadcasted() {
+    struct Node {
+        Int parent;
+        Matrix4 transformation;
+        Matrix4 absolute;
+    } nodes[]{
+        {-1, Transformations3D[0], {}},
+        {0, Transformations3D[1], {}},
+        {0, Transformations3D[2], {}}
+    };
+
+    const Matrix4 global = Matrix4::scaling(Vector3{2.0f});
+    Corrade::Containers::StridedArrayView1D<Node> view = nodes;
+    multiplyInto(
+        Corrade::Containers::stridedArrayView(Corrade::Containers::arrayView(&global, 1)).broadcasted<0>(3),
+        view.slice(&Node::transformation),
+        view.slice(&Node::absolute));
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(nodes[i].absolute, global*Transformations3D[i]);
+        /* The input stays untouched */
+        CORRADE_COMPARE(nodes[i].transformation, Transformations3D[i]);
+    }
+}
+
+void MatrixBatchTest::translationRotationScaling2D() {
+    const Vector2 translations[]{
+        {1.0f, -2.0f},
+        {},
+        {0.5f, 7.0f}
+    };
+    const Complex rotations[]{
+        Complex::rotation(Deg{35.0f}),
+        Complex::rotation(Deg{-120.0f}),
+        {}
+    };
+    const Vector2 scalings[]{
+        {1.0f, 1.0f},
+        {0.5f, 3.0f},
+        {-2.0f, 0.25f}
+    };
+
+    Matrix3 out[3];
+    translationRotationScalingInto(translations, rotations, scalings, out);
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i], Matrix3::from(rotations[i].toMatrix(), translations[i])*Matrix3::scaling(scalings[i]));
+    }
+}
+
+void MatrixBatchTest::translationRotationScaling3D() {
+    const Vector3 translations[]{
+        {1.0f, -2.0f, 3.0f},
+        {},
+        {0.5f, 7.0f, -1.0f}
+    };
+    const Quaternion rotations[]{
+        Quaternion::rotation(Deg{35.0f}, Vector3::xAxis()),
+        Quaternion::rotation(Deg{-120.0f}, Vector3{1.0f, 1.0f, 0.0f}.normalized()),
+        {}
+    };
+    const Vector3 scalings[]{
+        {1.0f, 1.0f, 1.0f},
+        {0.5f, 3.0f, -1.0f},
+        {-2.0f, 0.25f, 4.0f}
+    };
+
+    Matrix4 out[3];
+    translationRotationScalingInto(translations, rotations, scalings, out);
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i], Matrix4::from(rotations[i].toMatrix(), translations[i])*Matrix4::scaling(scalings[i]));
+    }
+}
+
+void MatrixBatchTest::assertions() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Matrix4 a[3];
+    Matrix4 b[2];
+    Matrix4 out[3];
+    Vector3 vectors[3];
+    Quaternion rotations[2];
+    Vector2 vectors2D[3];
+    Complex rotations2D[3];
+    Matrix3 out2D[2];
+
+    std::ostringstream outStream;
+    Error redirectError{&outStream};
+    multiplyInto(a, b, out);
+    multiplyInto(a, a, Corrade::Containers::arrayView(out).prefix(2));
+    translationRotationScalingInto(vectors, rotations, vectors, out);
+    translationRotationScalingInto(vectors2D, rotations2D, vectors2D, out2D);
+    CORRADE_COMPARE(outStream.str(),
+        "Math::multiplyInto(): expected views of the same size, got 3, 2 and 3\n"
+        "Math::multiplyInto(): expected views of the same size, got 3, 3 and 2\n"
+        "Math::translationRotationScalingInto(): expected views of the same size, got 3, 2, 3 and 3\n"
+        "Math::translationRotationScalingInto(): expected views of the same size, got 3, 3, 3 and 2\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::MatrixBatchTest)
@@ -0,0 +1,257 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <type_traits>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/PackingBatch.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct PackingBatchBenchmark: Corrade::TestSuite::Tester {
+    explicit PackingBatchBenchmark();
+
+    template<class T> void unpackBaseline();
+    template<class T> void unpack();
+    template<class T> void packBaseline();
+    template<class T> void pack();
+    template<class T> void castBaseline();
+    template<class T> void cast();
+
+    void unpackHalfBaseline();
+    void unpackHalf();
+    void packHalfBaseline();
+    void packHalf();
+
+    private:
+        void throughputBegin();
+        std::uint64_t throughputEnd();
+
+        std::chrono::high_resolution_clock::time_point _begin;
+        std::size_t _bytes;
+};
+
+/* Each benchmark iteration processes Count items. Instead of the time, the
+   benchmarks report the amount of data read and written per second, so the
+   SIMD variants and baselines for different types can be compared
+   directly. */
+enum: std::size_t { Count = 1024*1024 };
+
+PackingBatchBenchmark::PackingBatchBenchmark() {
+    addCustomBenchmarks({
+        &PackingBatchBenchmark::unpackBaseline<UnsignedByte>,
+        &PackingBatchBenchmark::unpack<UnsignedByte>,
+        &PackingBatchBenchmark::unpackBaseline<Byte>,
+        &PackingBatchBenchmark::unpack<Byte>,
+        &PackingBatchBenchmark::unpackBaseline<UnsignedShort>,
+        &PackingBatchBenchmark::unpack<UnsignedShort>,
+        &PackingBatchBenchmark::unpackBaseline<Short>,
+        &PackingBatchBenchmark::unpack<Short>,
+
+        &PackingBatchBenchmark::packBaseline<UnsignedByte>,
+        &PackingBatchBenchmark::pack<UnsignedByte>,
+        &PackingBatchBenchmark::packBaseline<Byte>,
+        &PackingBatchBenchmark::pack<Byte>,
+        &PackingBatchBenchmark::packBaseline<UnsignedShort>,
+        &PackingBatchBenchmark::pack<UnsignedShort>,
+        &PackingBatchBenchmark::packBaseline<Short>,
+        &PackingBatchBenchmark::pack<Short>,
+
+        &PackingBatchBenchmark::castBaseline<UnsignedShort>,
+        &PackingBatchBenchmark::cast<UnsignedShort>,
+        &PackingBatchBenchmark::castBaseline<Int>,
+        &PackingBatchBenchmark::cast<Int>,
+
+        &PackingBatchBenchmark::unpackHalfBaseline,
+        &PackingBatchBenchmark::unpackHalf,
+        &PackingBatchBenchmark::packHalfBaseline,
+        &PackingBatchBenchmark::packHalf}, 50,
+        &PackingBatchBenchmark::throughputBegin,
+        &PackingBatchBenchmark::throughputEnd,
+        BenchmarkUnits::Bytes);
+}
+
+void PackingBatchBenchmark::throughputBegin() {
+    _begin = std::chrono::high_resolution_clock::now();
+}
+
+std::uint64_t PackingBatchBenchmark::throughputEnd() {
+    const std::chrono::nanoseconds::rep duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - _begin).count();
+    return std::uint64_t(Double(_bytes)*1.0e9/Double(duration ? duration : 1));
+}
+
+template<class T> Corrade::Containers::Array<T> integers() {
+    Corrade::Containers::Array<T> out{Corrade::NoInit, Count};
+    for(std::size_t i = 0; i != Count; ++i)
+        out[i] = T(i*37);
+    return out;
+}
+
+template<class T> Corrade::Containers::Array<Float> normalized() {
+    Corrade::Containers::Array<Float> out{Corrade::NoInit, Count};
+    for(std::size_t i = 0; i != Count; ++i)
+        out[i] = Float(i%1000)/(std::is_signed<T>::value ? 500.0f : 1000.0f) - (std::is_signed<T>::value ? 1.0f : 0.0f);
+    return out;
+}
+
+template<class T> void PackingBatchBenchmark::unpackBaseline() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    const Corrade::Containers::Array<T> src = integers<T>();
+    Corrade::Containers::Array<Float> dst{Corrade::NoInit, Count};
+    _bytes = Count*(sizeof(T) + sizeof(Float));
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != Count; ++i)
+            dst[i] = Math::unpack<Float>(src[i]);
+    }
+
+    CORRADE_COMPARE(dst[1], (Math::unpack<Float, T>(T(37))));
+}
+
+template<class T> void PackingBatchBenchmark::unpack() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    const Corrade::Containers::Array<T> src = integers<T>();
+    Corrade::Containers::Array<Float> dst{Corrade::NoInit, Count};
+    _bytes = Count*(sizeof(T) + sizeof(Float));
+    CORRADE_BENCHMARK(1) {
+        unpackInto(Corrade::Containers::arrayCast<2, const T>(Corrade::Containers::stridedArrayView(src)),
+                   Corrade::Containers::arrayCast<2, Float>(Corrade::Containers::stridedArrayView(dst)));
+    }
+
+    CORRADE_COMPARE(dst[1], (Math::unpack<Float, T>(T(37))));
+}
+
+template<class T> void PackingBatchBenchmark::packBaseline() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    const Corrade::Containers::Array<Float> src = normalized<T>();
+    Corrade::Containers::Array<T> dst{Corrade::NoInit, Count};
+    _bytes = Count*(sizeof(Float) + sizeof(T));
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != Count; ++i)
+            dst[i] = Math::pack<T>(src[i]);
+    }
+
+    CORRADE_COMPARE(dst[1], Math::pack<T>(src[1]));
+}
+
+template<class T> void PackingBatchBenchmark::pack() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    const Corrade::Containers::Array<Float> src = normalized<T>();
+    Corrade::Containers::Array<T> dst{Corrade::NoInit, Count};
+    _bytes = Count*(sizeof(Float) + sizeof(T));
+    CORRADE_BENCHMARK(1) {
+        packInto(Corrade::Containers::arrayCast<2, const Float>(Corrade::Containers::stridedArrayView(src)),
+                 Corrade::Containers::arrayCast<2, T>(Corrade::Containers::stridedArrayView(dst)));
+    }
+
+    CORRADE_COMPARE(dst[1], Math::pack<T>(src[1]));
+}
+
+template<class T> void PackingBatchBenchmark::castBaseline() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    const Corrade::Containers::Array<T> src = integers<T>();
+    Corrade::Containers::Array<Float> dst{Corrade::NoInit, Count};
+    _bytes = Count*(sizeof(T) + sizeof(Float));
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != Count; ++i)
+            dst[i] = Float(src[i]);
+    }
+
+    CORRADE_COMPARE(dst[1], 37.0f);
+}
+
+template<class T> void PackingBatchBenchmark::cast() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    const Corrade::Containers::Array<T> src = integers<T>();
+    Corrade::Containers::Array<Float> dst{Corrade::NoInit, Count};
+    _bytes = Count*(sizeof(T) + sizeof(Float));
+    CORRADE_BENCHMARK(1) {
+        castInto(Corrade::Containers::arrayCast<2, const T>(Corrade::Containers::stridedArrayView(src)),
+                 Corrade::Containers::arrayCast<2, Float>(Corrade::Containers::stridedArrayView(dst)));
+    }
+
+    CORRADE_COMPARE(dst[1], 37.0f);
+}
+
+void PackingBatchBenchmark::unpackHalfBaseline() {
+    const Corrade::Containers::Array<UnsignedShort> src = integers<UnsignedShort>();
+    Corrade::Containers::Array<Float> dst{Corrade::NoInit, Count};
+    _bytes = Count*(sizeof(UnsignedShort) + sizeof(Float));
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != Count; ++i)
+            dst[i] = Math::unpackHalf(src[i]);
+    }
+
+    CORRADE_COMPARE(dst[1], Math::unpackHalf(37));
+}
+
+void PackingBatchBenchmark::unpackHalf() {
+    const Corrade::Containers::Array<UnsignedShort> src = integers<UnsignedShort>();
+    Corrade::Containers::Array<Float> dst{Corrade::NoInit, Count};
+    _bytes = Count*(sizeof(UnsignedShort) + sizeof(Float));
+    CORRADE_BENCHMARK(1) {
+        unpackHalfInto(Corrade::Containers::arrayCast<2, const UnsignedShort>(Corrade::Containers::stridedArrayView(src)),
+                       Corrade::Containers::arrayCast<2, Float>(Corrade::Containers::stridedArrayView(dst)));
+    }
+
+    CORRADE_COMPARE(dst[1], Math::unpackHalf(37));
+}
+
+void PackingBatchBenchmark::packHalfBaseline() {
+    const Corrade::Containers::Array<Float> src = normalized<Short>();
+    Corrade::Containers::Array<UnsignedShort> dst{Corrade::NoInit, Count};
+    _bytes = Count*(sizeof(Float) + sizeof(UnsignedShort));
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != Count; ++i)
+            dst[i] = Math::packHalf(src[i]);
+    }
+
+    CORRADE_COMPARE(dst[0], Math::packHalf(-1.0f));
+}
+
+void PackingBatchBenchmark::packHalf() {
+    const Corrade::Containers::Array<Float> src = normalized<Short>();
+    Corrade::Containers::Array<UnsignedShort> dst{Corrade::NoInit, Count};
+    _bytes = Count*(sizeof(Float) + sizeof(UnsignedShort));
+    CORRADE_BENCHMARK(1) {
+        packHalfInto(Corrade::Containers::arrayCast<2, const Float>(Corrade::Containers::stridedArrayView(src)),
+                     Corrade::Containers::arrayCast<2, UnsignedShort>(Corrade::Containers::stridedArrayView(dst)));
+    }
+
+    CORRADE_COMPARE(dst[0], Math::packHalf(-1.0f));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::PackingBatchBenchmark)
@@ -23,7 +23,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <limits>
 #include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
@@ -59,6 +62,10 @@ struct PackingBatchTest: Corrade::TestSuite::Tester {
 
     void castFloatDouble();
 
+    template<class T> void packUnpackVectorized();
+    void castIntFloatVectorized();
+    void packUnpackHalfVectorized();
+
     template<class T> void assertionsPackUnpack();
     void assertionsPackUnpackHalf();
     template<class U, class T> void assertionsCast();
@@ -104,6 +111,13 @@ PackingBatchTest::PackingBatchTest() {
 
               &PackingBatchTest::castFloatDouble,
 
+              &PackingBatchTest::packUnpackVectorized<UnsignedByte>,
+              &PackingBatchTest::packUnpackVectorized<Byte>,
+              &PackingBatchTest::packUnpackVectorized<UnsignedShort>,
+              &PackingBatchTest::packUnpackVectorized<Short>,
+              &PackingBatchTest::castIntFloatVectorized,
+              &PackingBatchTest::packUnpackHalfVectorized,
+
               &PackingBatchTest::assertionsPackUnpack<UnsignedByte>,
               &PackingBatchTest::assertionsPackUnpack<Byte>,
               &PackingBatchTest::assertionsPackUnpack<UnsignedShort>,
@@ -637,6 +651,163 @@ void PackingBatchTest::castFloatDouble() {
         Corrade::TestSuite::Compare::Container);
 }
 
+/* Contiguous views are processed all at once, which makes them go through the
+   SIMD code paths if available. Views with a single-item rows and a padding
+   between go through the scalar code as there's not enough data in a row to
+   fill a SIMD vector. The results should be the same in both cases. The item
+   count is chosen to not be a multiple of any SIMD vector size. */
+constexpr std::size_t VectorizedRowCount = 117;
+
+template<class T> void PackingBatchTest::packUnpackVectorized() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    constexpr std::size_t count = VectorizedRowCount*3;
+    Corrade::Containers::Array<T> packed{Corrade::NoInit, count};
+    for(std::size_t i = 0; i != count; ++i)
+        packed[i] = T(i*37 + 11);
+    packed[0] = std::numeric_limits<T>::min();
+    packed[1] = std::numeric_limits<T>::max();
+
+    struct Strided {
+        T packed;
+        Float unpacked;
+        Float cast;
+    };
+    Corrade::Containers::Array<Strided> strided{Corrade::ValueInit, count};
+    for(std::size_t i = 0; i != count; ++i)
+        strided[i].packed = packed[i];
+    Corrade::Containers::StridedArrayView1D<T> stridedPacked{strided, &strided[0].packed, count, sizeof(Strided)};
+    Corrade::Containers::StridedArrayView1D<Float> stridedUnpacked{strided, &strided[0].unpacked, count, sizeof(Strided)};
+    Corrade::Containers::StridedArrayView1D<Float> stridedCast{strided, &strided[0].cast, count, sizeof(Strided)};
+
+    Corrade::Containers::Array<Float> unpacked{Corrade::NoInit, count};
+    unpackInto(Corrade::Containers::StridedArrayView2D<const T>{packed, {VectorizedRowCount, 3}},
+               Corrade::Containers::StridedArrayView2D<Float>{unpacked, {VectorizedRowCount, 3}});
+    unpackInto(Corrade::Containers::arrayCast<2, const T>(stridedPacked),
+               Corrade::Containers::arrayCast<2, Float>(stridedUnpacked));
+    CORRADE_COMPARE_AS(Corrade::Containers::stridedArrayView(unpacked), stridedUnpacked,
+        Corrade::TestSuite::Compare::Container);
+    CORRADE_COMPARE(unpacked[2], (Math::unpack<Float, T>(packed[2])));
+
+    Corrade::Containers::Array<Float> cast{Corrade::NoInit, count};
+    castInto(Corrade::Containers::StridedArrayView2D<const T>{packed, {VectorizedRowCount, 3}},
+             Corrade::Containers::StridedArrayView2D<Float>{cast, {VectorizedRowCount, 3}});
+    castInto(Corrade::Containers::arrayCast<2, const T>(stridedPacked),
+             Corrade::Containers::arrayCast<2, Float>(stridedCast));
+    CORRADE_COMPARE_AS(Corrade::Containers::stridedArrayView(cast), stridedCast,
+        Corrade::TestSuite::Compare::Container);
+    CORRADE_COMPARE(cast[2], Float(packed[2]));
+
+    /* Pack the values back, with some of them exactly in the middle between
+       two integers to verify rounding. Skipping the range ends, as those
+       would go out of range. */
+    for(std::size_t i = 0; i < count; i += 5)
+        if(packed[i] != std::numeric_limits<T>::min() && packed[i] != std::numeric_limits<T>::max())
+            unpacked[i] = (Float(packed[i]) + (packed[i] < 0 ? -0.5f : 0.5f))/Float(Implementation::bitMax<T>());
+    for(std::size_t i = 0; i != count; ++i)
+        stridedUnpacked[i] = unpacked[i];
+    packInto(Corrade::Containers::StridedArrayView2D<const Float>{unpacked, {VectorizedRowCount, 3}},
+             Corrade::Containers::StridedArrayView2D<T>{packed, {VectorizedRowCount, 3}});
+    packInto(Corrade::Containers::arrayCast<2, const Float>(stridedUnpacked),
+             Corrade::Containers::arrayCast<2, T>(stridedPacked));
+    CORRADE_COMPARE_AS(Corrade::Containers::stridedArrayView(packed), stridedPacked,
+        Corrade::TestSuite::Compare::Container);
+    CORRADE_COMPARE(packed[5], (Math::pack<T, Float>(unpacked[5])));
+}
+
+void PackingBatchTest::castIntFloatVectorized() {
+    constexpr std::size_t count = VectorizedRowCount*3;
+    Corrade::Containers::Array<Int> integers{Corrade::NoInit, count};
+    for(std::size_t i = 0; i != count; ++i)
+        integers[i] = Int(i*2654435761u);
+
+    struct Strided {
+        Int integer;
+        Float floatingPoint;
+    };
+    Corrade::Containers::Array<Strided> strided{Corrade::ValueInit, count};
+    for(std::size_t i = 0; i != count; ++i)
+        strided[i].integer = integers[i];
+    Corrade::Containers::StridedArrayView1D<Int> stridedIntegers{strided, &strided[0].integer, count, sizeof(Strided)};
+    Corrade::Containers::StridedArrayView1D<Float> stridedFloatingPoints{strided, &strided[0].floatingPoint, count, sizeof(Strided)};
+
+    Corrade::Containers::Array<Float> floatingPoints{Corrade::NoInit, count};
+    castInto(Corrade::Containers::StridedArrayView2D<const Int>{integers, {VectorizedRowCount, 3}},
+             Corrade::Containers::StridedArrayView2D<Float>{floatingPoints, {VectorizedRowCount, 3}});
+    castInto(Corrade::Containers::arrayCast<2, const Int>(stridedIntegers),
+             Corrade::Containers::arrayCast<2, Float>(stridedFloatingPoints));
+    CORRADE_COMPARE_AS(Corrade::Containers::stridedArrayView(floatingPoints), stridedFloatingPoints,
+        Corrade::TestSuite::Compare::Container);
+
+    /* And back, with fractional values to verify truncation */
+    for(std::size_t i = 0; i != count; ++i)
+        stridedFloatingPoints[i] = floatingPoints[i] = Float(Int(i) - 150)*0.75f;
+    castInto(Corrade::Containers::StridedArrayView2D<const Float>{floatingPoints, {VectorizedRowCount, 3}},
+             Corrade::Containers::StridedArrayView2D<Int>{integers, {VectorizedRowCount, 3}});
+    castInto(Corrade::Containers::arrayCast<2, const Float>(stridedFloatingPoints),
+             Corrade::Containers::arrayCast<2, Int>(stridedIntegers));
+    CORRADE_COMPARE_AS(Corrade::Containers::stridedArrayView(integers), stridedIntegers,
+        Corrade::TestSuite::Compare::Container);
+    CORRADE_COMPARE(integers[1], -149);
+}
+
+void PackingBatchTest::packUnpackHalfVectorized() {
+    /* All half values except NaNs, for which the vectorized implementation
+       may produce a different payload */
+    Corrade::Containers::Array<UnsignedShort> halves;
+    Corrade::Containers::arrayReserve(halves, 65536);
+    for(UnsignedInt i = 0; i != 65536; ++i)
+        if((i & 0x7c00) != 0x7c00 || !(i & 0x03ff))
+            Corrade::Containers::arrayAppend(halves, UnsignedShort(i));
+    const std::size_t count = halves.size();
+
+    struct Strided {
+        UnsignedShort half;
+        Float floatingPoint;
+    };
+    Corrade::Containers::Array<Strided> strided{Corrade::ValueInit, count};
+    for(std::size_t i = 0; i != count; ++i)
+        strided[i].half = halves[i];
+    Corrade::Containers::StridedArrayView1D<UnsignedShort> stridedHalves{strided, &strided[0].half, count, sizeof(Strided)};
+    Corrade::Containers::StridedArrayView1D<Float> stridedFloatingPoints{strided, &strided[0].floatingPoint, count, sizeof(Strided)};
+
+    Corrade::Containers::Array<Float> floatingPoints{Corrade::NoInit, count};
+    unpackHalfInto(Corrade::Containers::arrayCast<2, const UnsignedShort>(Corrade::Containers::stridedArrayView(halves)),
+                   Corrade::Containers::arrayCast<2, Float>(Corrade::Containers::stridedArrayView(floatingPoints)));
+    unpackHalfInto(Corrade::Containers::arrayCast<2, const UnsignedShort>(stridedHalves),
+                   Corrade::Containers::arrayCast<2, Float>(stridedFloatingPoints));
+    CORRADE_COMPARE_AS(Corrade::Containers::stridedArrayView(floatingPoints), stridedFloatingPoints,
+        Corrade::TestSuite::Compare::Container);
+
+    /* Packing back should give the same values */
+    packHalfInto(Corrade::Containers::arrayCast<2, const Float>(Corrade::Containers::stridedArrayView(floatingPoints)),
+                 Corrade::Containers::arrayCast<2, UnsignedShort>(Corrade::Containers::stridedArrayView(halves)));
+    packHalfInto(Corrade::Containers::arrayCast<2, const Float>(stridedFloatingPoints),
+                 Corrade::Containers::arrayCast<2, UnsignedShort>(stridedHalves));
+    CORRADE_COMPARE_AS(Corrade::Containers::stridedArrayView(halves), stridedHalves,
+        Corrade::TestSuite::Compare::Container);
+
+    /* Values that aren't exactly representable, including ones that round
+       to the largest finite value or overflow to an infinity */
+    const Float values[]{
+        0.1f, -0.1f, 1.0e-5f, -1.0e-5f, 1.0e-8f, -1.0e-8f, 3.14159f, -3.14159f,
+        65519.0f, -65519.0f, 65535.0f, -65535.0f, 65536.0f, -65536.0f,
+        1.0e6f, -1.0e6f, 1.0e-30f, -1.0e-30f, 65504.0f, -65504.0f
+    };
+    UnsignedShort packed[Corrade::Containers::arraySize(values)];
+    packHalfInto(Corrade::Containers::arrayCast<2, const Float>(Corrade::Containers::stridedArrayView(values)),
+                 Corrade::Containers::arrayCast<2, UnsignedShort>(Corrade::Containers::stridedArrayView(packed)));
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(values); ++i) {
+        CORRADE_ITERATION(i);
+        UnsignedShort expected;
+        packHalfInto(Corrade::Containers::StridedArrayView2D<const Float>{Corrade::Containers::arrayView(values).slice(i, i + 1), {1, 1}},
+                     Corrade::Containers::StridedArrayView2D<UnsignedShort>{Corrade::Containers::arrayView(&expected, 1), {1, 1}});
+        CORRADE_COMPARE(packed[i], expected);
+    }
+    CORRADE_COMPARE(packed[10], 0x7bff);
+    CORRADE_COMPARE(packed[13], 0xfc00);
+}
+
 template<class T> void PackingBatchTest::assertionsPackUnpack() {
     CORRADE_SKIP_IF_NO_ASSERT();
 
@@ -0,0 +1,123 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Swizzle.h"
+#include "Magnum/Math/SwizzleBatch.h"
+#include "Magnum/Math/Vector4.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct SwizzleBatchTest: Corrade::TestSuite::Tester {
+    explicit SwizzleBatchTest();
+
+    void swapRedBlue3();
+    void swapRedBlue4();
+    void swapRedBlueStrided();
+};
+
+typedef Math::Vector3<UnsignedByte> Vector3ub;
+typedef Math::Vector4<UnsignedByte> Vector4ub;
+
+const struct {
+    const char* name;
+    std::size_t count;
+} SwapRedBlueData[]{
+    {"single item", 1},
+    {"less than a SIMD vector", 3},
+    {"exactly two SIMD vectors", 16},
+    {"SIMD vectors and a remainder", 23}
+};
+
+SwizzleBatchTest::SwizzleBatchTest() {
+    addInstancedTests({&SwizzleBatchTest::swapRedBlue3,
+                       &SwizzleBatchTest::swapRedBlue4},
+        Corrade::Containers::arraySize(SwapRedBlueData));
+
+    addTests({&SwizzleBatchTest::swapRedBlueStrided});
+}
+
+void SwizzleBatchTest::swapRedBlue3() {
+    auto&& data = SwapRedBlueData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* One more item after the end to verify it's not touched */
+    Vector3ub pixels[24];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(pixels); ++i)
+        pixels[i] = Vector3ub{UnsignedByte(i*3 + 0), UnsignedByte(i*3 + 1), UnsignedByte(i*3 + 2)};
+
+    swapRedBlueInPlace(Corrade::Containers::arrayView(pixels).prefix(data.count));
+    for(std::size_t i = 0; i != data.count; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(pixels[i], (Vector3ub{UnsignedByte(i*3 + 2), UnsignedByte(i*3 + 1), UnsignedByte(i*3 + 0)}));
+    }
+    CORRADE_COMPARE(pixels[data.count], (Vector3ub{UnsignedByte(data.count*3 + 0), UnsignedByte(data.count*3 + 1), UnsignedByte(data.count*3 + 2)}));
+}
+
+void SwizzleBatchTest::swapRedBlue4() {
+    auto&& data = SwapRedBlueData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* One more item after the end to verify it's not touched */
+    Vector4ub pixels[24];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(pixels); ++i)
+        pixels[i] = Vector4ub{UnsignedByte(i*4 + 0), UnsignedByte(i*4 + 1), UnsignedByte(i*4 + 2), UnsignedByte(i*4 + 3)};
+
+    swapRedBlueInPlace(Corrade::Containers::arrayView(pixels).prefix(data.count));
+    for(std::size_t i = 0; i != data.count; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(pixels[i], (Vector4ub{UnsignedByte(i*4 + 2), UnsignedByte(i*4 + 1), UnsignedByte(i*4 + 0), UnsignedByte(i*4 + 3)}));
+    }
+    CORRADE_COMPARE(pixels[data.count], (Vector4ub{UnsignedByte(data.count*4 + 0), UnsignedByte(data.count*4 + 1), UnsignedByte(data.count*4 + 2), UnsignedByte(data.count*4 + 3)}));
+}
+
+void SwizzleBatchTest::swapRedBlueStrided() {
+    Vector4ub pixels[]{
+        {1, 2, 3, 4},
+        {5, 6, 7, 8},
+        {9, 10, 11, 12},
+        {13, 14, 15, 16},
+        {17, 18, 19, 20},
+        {21, 22, 23, 24},
+        {25, 26, 27, 28},
+        {29, 30, 31, 32},
+        {33, 34, 35, 36},
+        {37, 38, 39, 40}
+    };
+
+    /* Every second pixel, which has to go through the non-SIMD path */
+    swapRedBlueInPlace(Corrade::Containers::stridedArrayView(pixels).every(2));
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(pixels); ++i) {
+        CORRADE_ITERATION(i);
+        const Vector4ub original{UnsignedByte(i*4 + 1), UnsignedByte(i*4 + 2), UnsignedByte(i*4 + 3), UnsignedByte(i*4 + 4)};
+        CORRADE_COMPARE(pixels[i], i % 2 ? original : gather<'b', 'g', 'r', 'a'>(original));
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::SwizzleBatchTest)
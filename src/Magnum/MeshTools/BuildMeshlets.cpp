@@ -0,0 +1,191 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BuildMeshlets.h"
+
+#include <cmath>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/MeshTools/BoundingVolume.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+template<class T> Meshlets buildMeshletsImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    CORRADE_ASSERT(!(indices.size()%3),
+        "MeshTools::buildMeshlets(): index count not divisible by 3", {});
+    CORRADE_ASSERT(maxVertexCount >= 3 && maxVertexCount <= 256,
+        "MeshTools::buildMeshlets(): expected max vertex count to be between 3 and 256 but got" << maxVertexCount, {});
+    CORRADE_ASSERT(maxTriangleCount,
+        "MeshTools::buildMeshlets(): expected non-zero max triangle count", {});
+    #ifndef CORRADE_NO_ASSERT
+    for(const T index: indices)
+        CORRADE_ASSERT(index < positions.size(),
+            "MeshTools::buildMeshlets(): index" << UnsignedInt(index) << "out of range for" << positions.size() << "vertices", {});
+    #endif
+
+    const std::size_t triangleCount = indices.size()/3;
+
+    /* Every triangle ends up in exactly one meshlet, the vertex count is
+       unknown upfront but can't be larger than the index count */
+    Meshlets out;
+    out.triangles = Containers::Array<Vector3ub>{NoInit, triangleCount};
+    arrayReserve(out.vertices, indices.size());
+
+    /* Location of each vertex in the current meshlet, ~UnsignedInt{} if it's
+       not there */
+    Containers::Array<UnsignedInt> localIndex{DirectInit, positions.size(), ~UnsignedInt{}};
+    Containers::Array<Vector3> meshletPositions{NoInit, maxVertexCount};
+
+    Meshlet current{};
+    const auto finishMeshlet = [&]() {
+        const Containers::ArrayView<const UnsignedInt> vertices = out.vertices.slice(current.vertexOffset, current.vertexOffset + current.vertexCount);
+        const Containers::ArrayView<const Vector3ub> triangles = out.triangles.slice(current.triangleOffset, current.triangleOffset + current.triangleCount);
+
+        /* Bounding sphere of all meshlet vertices, reset the vertex locations
+           for the next meshlet */
+        for(std::size_t i = 0; i != vertices.size(); ++i) {
+            meshletPositions[i] = positions[vertices[i]];
+            localIndex[vertices[i]] = ~UnsignedInt{};
+        }
+        const Containers::Pair<Vector3, Float> sphere = boundingSphereBouncingBubble(meshletPositions.prefix(vertices.size()));
+        current.center = sphere.first();
+        current.radius = sphere.second();
+
+        /* Normal cone axis is an average of all normals, the cutoff is
+           derived from the normal that's furthest from the axis. Degenerate
+           triangles are skipped. */
+        Vector3 axis;
+        for(const Vector3ub& triangle: triangles) {
+            const Vector3 normal = Math::cross(
+                meshletPositions[triangle[1]] - meshletPositions[triangle[0]],
+                meshletPositions[triangle[2]] - meshletPositions[triangle[0]]);
+            const Float length = normal.length();
+            if(length) axis += normal/length;
+        }
+        const Float axisLength = axis.length();
+        current.coneAxis = axisLength ? axis/axisLength : Vector3{};
+        current.coneCutoff = 1.0f;
+        if(axisLength) {
+            Float minDot = 1.0f;
+            for(const Vector3ub& triangle: triangles) {
+                const Vector3 normal = Math::cross(
+                    meshletPositions[triangle[1]] - meshletPositions[triangle[0]],
+                    meshletPositions[triangle[2]] - meshletPositions[triangle[0]]);
+                const Float length = normal.length();
+                if(length) minDot = Math::min(minDot, Math::dot(current.coneAxis, normal/length));
+            }
+            if(minDot >= 0.0f)
+                current.coneCutoff = std::sqrt(1.0f - minDot*minDot);
+        }
+
+        arrayAppend(out.meshlets, current);
+        const UnsignedInt nextTriangleOffset = current.triangleOffset + current.triangleCount;
+        current = {};
+        current.vertexOffset = out.vertices.size();
+        current.triangleOffset = nextTriangleOffset;
+    };
+
+    for(std::size_t t = 0; t != triangleCount; ++t) {
+        const UnsignedInt a = indices[t*3 + 0];
+        const UnsignedInt b = indices[t*3 + 1];
+        const UnsignedInt c = indices[t*3 + 2];
+
+        /* If the triangle doesn't fit, start a new meshlet. Degenerate
+           triangles need to have their vertices counted just once. */
+        const UnsignedInt newVertexCount =
+            (localIndex[a] == ~UnsignedInt{}) +
+            (b != a && localIndex[b] == ~UnsignedInt{}) +
+            (c != a && c != b && localIndex[c] == ~UnsignedInt{});
+        if(current.vertexCount + newVertexCount > maxVertexCount ||
+           current.triangleCount == maxTriangleCount)
+            finishMeshlet();
+
+        Vector3ub& triangle = out.triangles[current.triangleOffset + current.triangleCount++];
+        for(UnsignedInt i = 0; i != 3; ++i) {
+            const UnsignedInt v = indices[t*3 + i];
+            if(localIndex[v] == ~UnsignedInt{}) {
+                localIndex[v] = current.vertexCount++;
+                arrayAppend(out.vertices, v);
+            }
+            triangle[i] = UnsignedByte(localIndex[v]);
+        }
+    }
+
+    if(current.triangleCount) finishMeshlet();
+
+    /* Convert back to default deleters so the output can be used without
+       the growable array allocator */
+    arrayShrink(out.meshlets, DefaultInit);
+    arrayShrink(out.vertices, DefaultInit);
+    return out;
+}
+
+}
+
+Meshlets buildMeshlets(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    return buildMeshletsImplementation(indices, positions, maxVertexCount, maxTriangleCount);
+}
+
+Meshlets buildMeshlets(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    return buildMeshletsImplementation(indices, positions, maxVertexCount, maxTriangleCount);
+}
+
+Meshlets buildMeshlets(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    return buildMeshletsImplementation(indices, positions, maxVertexCount, maxTriangleCount);
+}
+
+Meshlets buildMeshlets(const Trade::MeshData& mesh, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::buildMeshlets(): expected" << MeshPrimitive::Triangles << "but got" << mesh.primitive(), {});
+    const Containers::Optional<UnsignedInt> positionAttributeId = mesh.findAttributeId(Trade::MeshAttribute::Position);
+    CORRADE_ASSERT(positionAttributeId,
+        "MeshTools::buildMeshlets(): the mesh has no positions", {});
+    CORRADE_ASSERT(!isVertexFormatImplementationSpecific(mesh.attributeFormat(*positionAttributeId)),
+        "MeshTools::buildMeshlets(): positions have an implementation-specific format" << reinterpret_cast<void*>(vertexFormatUnwrap(mesh.attributeFormat(*positionAttributeId))), {});
+    CORRADE_ASSERT(vertexFormatComponentCount(mesh.attributeFormat(*positionAttributeId)) == 3,
+        "MeshTools::buildMeshlets(): expected 3D positions but got" << mesh.attributeFormat(*positionAttributeId), {});
+    CORRADE_ASSERT(!mesh.isIndexed() || !isMeshIndexTypeImplementationSpecific(mesh.indexType()),
+        "MeshTools::buildMeshlets(): mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(mesh.indexType())), {});
+
+    const Containers::Array<Vector3> positions = mesh.positions3DAsArray();
+    Containers::Array<UnsignedInt> indices;
+    if(mesh.isIndexed())
+        indices = mesh.indicesAsArray();
+    else {
+        indices = Containers::Array<UnsignedInt>{NoInit, mesh.vertexCount()};
+        for(UnsignedInt i = 0; i != indices.size(); ++i) indices[i] = i;
+    }
+
+    return buildMeshletsImplementation(Containers::StridedArrayView1D<const UnsignedInt>{indices}, Containers::StridedArrayView1D<const Vector3>{positions}, maxVertexCount, maxTriangleCount);
+}
+
+}}
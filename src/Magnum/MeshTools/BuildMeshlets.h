@@ -0,0 +1,171 @@
+#ifndef Magnum_MeshTools_BuildMeshlets_h
+#define Magnum_MeshTools_BuildMeshlets_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::MeshTools::Meshlet, @ref Magnum::MeshTools::Meshlets, function @ref Magnum::MeshTools::buildMeshlets()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Meshlet
+@m_since_latest
+
+A single meshlet produced by @ref buildMeshlets(). See @ref Meshlets for
+information about the data layout.
+*/
+struct Meshlet {
+    /** @brief Offset into @ref Meshlets::vertices */
+    UnsignedInt vertexOffset;
+
+    /** @brief Vertex count */
+    UnsignedInt vertexCount;
+
+    /** @brief Offset into @ref Meshlets::triangles */
+    UnsignedInt triangleOffset;
+
+    /** @brief Triangle count */
+    UnsignedInt triangleCount;
+
+    /**
+     * @brief Bounding sphere center
+     *
+     * Calculated with @ref boundingSphereBouncingBubble() from positions of
+     * all meshlet vertices.
+     */
+    Vector3 center;
+
+    /** @brief Bounding sphere radius */
+    Float radius;
+
+    /**
+     * @brief Normal cone axis
+     *
+     * Normalized average of all meshlet triangle normals. Zero if all
+     * triangles in the meshlet are degenerate or their normals cancel each
+     * other out.
+     */
+    Vector3 coneAxis;
+
+    /**
+     * @brief Normal cone cutoff
+     *
+     * Sine of the largest angle between @ref coneAxis and any of the meshlet
+     * triangle normals. The whole meshlet is back-facing for a normalized
+     * view direction @f$ \boldsymbol{v} @f$ if
+     * @f$ \boldsymbol{v} \cdot \boldsymbol{a} > c @f$, where
+     * @f$ \boldsymbol{a} @f$ is the cone axis and @f$ c @f$ the cutoff. If
+     * the normals span more than a hemisphere or the meshlet contains just
+     * degenerate triangles, the cutoff is @cpp 1.0f @ce, i.e. the meshlet is
+     * never considered back-facing.
+     */
+    Float coneCutoff;
+};
+
+/**
+@brief Meshlets
+@m_since_latest
+
+Output of @ref buildMeshlets(). The @ref Meshlet::vertexCount items starting
+at @ref Meshlet::vertexOffset in @ref vertices are indices into the original
+vertex data, @ref Meshlet::triangleCount items starting at
+@ref Meshlet::triangleOffset in @ref triangles are triangles indexing into
+the meshlet vertex list.
+*/
+struct Meshlets {
+    /** @brief Meshlets */
+    Containers::Array<Meshlet> meshlets;
+
+    /** @brief Vertex remap tables of all meshlets */
+    Containers::Array<UnsignedInt> vertices;
+
+    /** @brief Local index buffers of all meshlets */
+    Containers::Array<Vector3ub> triangles;
+};
+
+/**
+@brief Split a mesh into meshlets
+@param indices          Triangle indices
+@param positions        Vertex positions
+@param maxVertexCount   Max vertex count in a meshlet
+@param maxTriangleCount Max triangle count in a meshlet
+@m_since_latest
+
+Goes through the triangles in order and puts them into a meshlet until
+either @p maxVertexCount or @p maxTriangleCount would be exceeded, in which
+case a new meshlet is started. The quality of the result thus depends on
+locality of the input, it's recommended to call
+@ref optimizeVertexCacheInPlace() on the indices first. For each meshlet, a
+bounding sphere and a normal cone is calculated.
+
+The @p indices are expected to describe a @ref MeshPrimitive::Triangles mesh,
+i.e. their count being divisible by 3, and all of them are expected to be less
+than size of @p positions. The @p maxVertexCount is expected to be in range
+@f$ [3, 256] @f$ so the local indices fit into 8 bits, @p maxTriangleCount is
+expected to be non-zero.
+@see @ref boundingSphereBouncingBubble()
+*/
+MAGNUM_MESHTOOLS_EXPORT Meshlets buildMeshlets(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt maxVertexCount = 64, UnsignedInt maxTriangleCount = 124);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Meshlets buildMeshlets(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt maxVertexCount = 64, UnsignedInt maxTriangleCount = 124);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Meshlets buildMeshlets(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt maxVertexCount = 64, UnsignedInt maxTriangleCount = 124);
+
+/**
+@brief Split a mesh data into meshlets
+@m_since_latest
+
+Expects that the mesh is a @ref MeshPrimitive::Triangles with a
+three-dimensional @ref Trade::MeshAttribute::Position, and that neither the
+index type nor the position format is implementation-specific. Non-indexed
+meshes are treated as if they had trivial indices. See
+@ref buildMeshlets(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, UnsignedInt, UnsignedInt)
+for more information.
+@see @ref isMeshIndexTypeImplementationSpecific(),
+    @ref isVertexFormatImplementationSpecific()
+*/
+MAGNUM_MESHTOOLS_EXPORT Meshlets buildMeshlets(const Trade::MeshData& mesh, UnsignedInt maxVertexCount = 64, UnsignedInt maxTriangleCount = 124);
+
+}}
+
+#endif
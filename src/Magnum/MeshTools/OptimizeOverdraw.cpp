@@ -0,0 +1,180 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "OptimizeOverdraw.h"
+
+#include <algorithm>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+template<class T> void optimizeOverdrawInPlaceImplementation(const Containers::StridedArrayView1D<T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt cacheSize, const Float threshold) {
+    CORRADE_ASSERT(!(indices.size()%3),
+        "MeshTools::optimizeOverdrawInPlace(): index count not divisible by 3", );
+    #ifndef CORRADE_NO_ASSERT
+    for(const T index: indices)
+        CORRADE_ASSERT(index < positions.size(),
+            "MeshTools::optimizeOverdrawInPlace(): index" << UnsignedInt(index) << "out of range for" << positions.size() << "vertices", );
+    #endif
+
+    const std::size_t triangleCount = indices.size()/3;
+    if(!triangleCount) return;
+
+    /* Global time, per-vertex caching timestamps, same as in tipsifyInPlace().
+       Advancing the time by more than the cache size flushes the cache. */
+    UnsignedInt time = cacheSize + 1;
+    Containers::Array<UnsignedInt> timestamp{positions.size()};
+    const auto triangleMissCount = [&](const std::size_t t) {
+        UnsignedInt misses = 0;
+        for(UnsignedInt vi = 0; vi != 3; ++vi) {
+            const UnsignedInt v = indices[t*3 + vi];
+            if(time - timestamp[v] <= cacheSize) continue;
+            timestamp[v] = time++;
+            ++misses;
+        }
+        return misses;
+    };
+
+    /* Hard cluster boundaries are where all three vertices of a triangle miss
+       the cache, i.e. where the original algorithm jumped to a vertex
+       that's no longer in the cache */
+    Containers::Array<UnsignedInt> triangleMisses{NoInit, triangleCount};
+    Containers::Array<UnsignedInt> hardClusterOffsets;
+    for(std::size_t t = 0; t != triangleCount; ++t) {
+        triangleMisses[t] = triangleMissCount(t);
+        if(!t || triangleMisses[t] == 3) arrayAppend(hardClusterOffsets, UnsignedInt(t));
+    }
+    arrayAppend(hardClusterOffsets, UnsignedInt(triangleCount));
+
+    /* Split the hard clusters further as long as the miss ratio of the new
+       clusters, with the cache flushed at the beginning of each, stays
+       below the threshold */
+    Containers::Array<UnsignedInt> clusterOffsets;
+    for(std::size_t i = 0; i + 1 != hardClusterOffsets.size(); ++i) {
+        const UnsignedInt begin = hardClusterOffsets[i];
+        const UnsignedInt end = hardClusterOffsets[i + 1];
+        UnsignedInt hardMisses = 0;
+        for(UnsignedInt t = begin; t != end; ++t)
+            hardMisses += triangleMisses[t];
+        const Float limit = threshold*Float(hardMisses)/Float(end - begin);
+
+        arrayAppend(clusterOffsets, begin);
+        time += cacheSize + 1;
+        UnsignedInt clusterBegin = begin;
+        UnsignedInt misses = 0;
+        for(UnsignedInt t = begin; t != end; ++t) {
+            misses += triangleMissCount(t);
+            if(t + 1 != end && Float(misses) <= limit*Float(t + 1 - clusterBegin)) {
+                clusterBegin = t + 1;
+                misses = 0;
+                time += cacheSize + 1;
+                arrayAppend(clusterOffsets, clusterBegin);
+            }
+        }
+    }
+    arrayAppend(clusterOffsets, UnsignedInt(triangleCount));
+    const std::size_t clusterCount = clusterOffsets.size() - 1;
+
+    /* Area-weighted centroid and normal of each cluster, area-weighted
+       centroid of the whole mesh. The cross product length is twice the
+       triangle area, but the scale doesn't matter here. */
+    Containers::Array<Vector3> clusterCentroids{NoInit, clusterCount};
+    Containers::Array<Vector3> clusterNormals{NoInit, clusterCount};
+    Vector3 meshCentroid;
+    Float meshArea = 0.0f;
+    for(std::size_t i = 0; i != clusterCount; ++i) {
+        Vector3 centroid;
+        Vector3 vertexCentroid;
+        Vector3 normal;
+        Float area = 0.0f;
+        for(UnsignedInt t = clusterOffsets[i]; t != clusterOffsets[i + 1]; ++t) {
+            const Vector3 a = positions[indices[t*3 + 0]];
+            const Vector3 b = positions[indices[t*3 + 1]];
+            const Vector3 c = positions[indices[t*3 + 2]];
+            const Vector3 n = Math::cross(b - a, c - a);
+            const Float triangleArea = n.length();
+            centroid += (a + b + c)*triangleArea;
+            vertexCentroid += a + b + c;
+            normal += n;
+            area += triangleArea;
+        }
+
+        meshCentroid += centroid;
+        meshArea += area;
+        /* Clusters with only degenerate triangles have a zero area, use a
+           plain average for those */
+        clusterCentroids[i] = area ? centroid/(3.0f*area) :
+            vertexCentroid/Float(3*(clusterOffsets[i + 1] - clusterOffsets[i]));
+        clusterNormals[i] = normal;
+    }
+    if(meshArea) meshCentroid /= 3.0f*meshArea;
+
+    /* Sort the clusters by how much they face outwards, stable so the
+       clusters that are the same get drawn in the original order */
+    Containers::Array<Float> clusterScores{NoInit, clusterCount};
+    Containers::Array<UnsignedInt> clusterOrder{NoInit, clusterCount};
+    for(std::size_t i = 0; i != clusterCount; ++i) {
+        const Float normalLength = clusterNormals[i].length();
+        clusterScores[i] = normalLength ? Math::dot(clusterCentroids[i] - meshCentroid, clusterNormals[i])/normalLength : 0.0f;
+        clusterOrder[i] = i;
+    }
+    std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&](UnsignedInt a, UnsignedInt b) {
+        return clusterScores[a] > clusterScores[b];
+    });
+
+    /* Output index buffer */
+    Containers::Array<T> outputIndices{NoInit, indices.size()};
+    std::size_t outputIndex = 0;
+    for(const UnsignedInt i: clusterOrder) {
+        for(std::size_t index = clusterOffsets[i]*3; index != clusterOffsets[i + 1]*3; ++index)
+            outputIndices[outputIndex++] = indices[index];
+    }
+    CORRADE_INTERNAL_ASSERT(outputIndex == indices.size());
+
+    /* Swap original index buffer with optimized */
+    Utility::copy(outputIndices, indices);
+}
+
+}
+
+void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt cacheSize, const Float threshold) {
+    optimizeOverdrawInPlaceImplementation(indices, positions, cacheSize, threshold);
+}
+
+void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt cacheSize, const Float threshold) {
+    optimizeOverdrawInPlaceImplementation(indices, positions, cacheSize, threshold);
+}
+
+void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt cacheSize, const Float threshold) {
+    optimizeOverdrawInPlaceImplementation(indices, positions, cacheSize, threshold);
+}
+
+}}
@@ -0,0 +1,87 @@
+#ifndef Magnum_MeshTools_OptimizeOverdraw_h
+#define Magnum_MeshTools_OptimizeOverdraw_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::optimizeOverdrawInPlace()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Reorder triangle clusters to reduce overdraw in-place
+@param[in,out] indices  Indices array to operate on
+@param[in] positions    Vertex positions
+@param[in] cacheSize    Post-transform vertex cache size
+@param[in] threshold    Allowed cache efficiency degradation
+@m_since_latest
+
+Meant to be called on output of @ref tipsifyInPlace() or
+@ref optimizeVertexCacheInPlace() with the same @p cacheSize. Splits the
+triangle sequence into clusters at places where the simulated vertex cache
+gets flushed, and then further into smaller clusters as long as their average
+cache miss ratio doesn't get worse than @p threshold times the miss ratio of
+the original cluster. The clusters are then sorted by a view-independent
+occlusion heuristic --- the dot product of the cluster normal and the
+direction from the mesh centroid to the cluster centroid --- so the clusters
+facing outwards and thus likely occluding others are drawn first. Algorithm
+used: *Pedro V. Sander, Diego Nehab, and Joshua Barczak --- Fast Triangle
+Reordering for Vertex Locality and Reduced Overdraw, SIGGRAPH 2007,
+https://gfx.cs.princeton.edu/pubs/Sander_2007_%3eTR/tipsy.pdf*.
+
+Lower values of @p threshold result in fewer and larger clusters, preserving
+the vertex cache efficiency, higher values give more freedom for overdraw
+reduction at the cost of vertex cache efficiency. Triangles inside each cluster
+keep their relative order.
+
+The @p indices are expected to describe a @ref MeshPrimitive::Triangles mesh,
+i.e. their count being divisible by 3, and all of them are expected to be less
+than size of @p positions.
+@see @ref vertexCacheStatistics()
+*/
+MAGNUM_MESHTOOLS_EXPORT void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt cacheSize, Float threshold = 1.05f);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt cacheSize, Float threshold = 1.05f);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt cacheSize, Float threshold = 1.05f);
+
+}}
+
+#endif
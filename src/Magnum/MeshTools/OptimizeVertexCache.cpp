@@ -0,0 +1,264 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "OptimizeVertexCache.h"
+
+#include <cmath>
+#include <utility>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/MeshTools/Implementation/Tipsify.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Scoring constants, the values are the ones suggested in the paper */
+constexpr Float CacheDecayPower = 1.5f;
+constexpr Float LastTriangleScore = 0.75f;
+constexpr Float ValenceBoostScale = 2.0f;
+constexpr Float ValenceBoostPower = 0.5f;
+
+/* Valence scores are precalculated up to this live triangle count, higher
+   counts are calculated on the fly */
+constexpr UnsignedInt PrecalculatedValenceCount = 32;
+
+/** @todo switch to a BitArray once it exists */
+inline bool bit(const Containers::ArrayView<const UnsignedInt> bits, const std::size_t i) {
+    return bits[i >> 5] & (1u << (i & 31));
+}
+
+inline void setBit(const Containers::ArrayView<UnsignedInt> bits, const std::size_t i) {
+    bits[i >> 5] |= 1u << (i & 31);
+}
+
+template<class T> void optimizeVertexCacheInPlaceImplementation(const Containers::StridedArrayView1D<T>& indices, const UnsignedInt vertexCount, const UnsignedInt cacheSize) {
+    CORRADE_ASSERT(!(indices.size()%3),
+        "MeshTools::optimizeVertexCacheInPlace(): index count not divisible by 3", );
+    CORRADE_ASSERT(cacheSize >= 4,
+        "MeshTools::optimizeVertexCacheInPlace(): expected cache size to be at least 4 but got" << cacheSize, );
+    #ifndef CORRADE_NO_ASSERT
+    for(const T index: indices)
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::optimizeVertexCacheInPlace(): index" << UnsignedInt(index) << "out of range for" << vertexCount << "vertices", );
+    #endif
+
+    const std::size_t triangleCount = indices.size()/3;
+    if(!triangleCount) return;
+
+    /* Neighboring triangles for each vertex, per-vertex live triangle count.
+       Neighbors of each vertex are kept partitioned so the live triangles are
+       always the first liveTriangleCount[i] items. */
+    Containers::Array<UnsignedInt> liveTriangleCount, neighborOffset, neighbors;
+    Implementation::buildAdjacency<T>(indices, vertexCount, liveTriangleCount, neighborOffset, neighbors);
+
+    /* Precalculated score for a vertex based on its position in the cache and
+       on its live triangle count. The three most recent vertices get a fixed
+       score so the next triangle doesn't get picked from the one just added,
+       which would produce long thin strips. */
+    Containers::Array<Float> cachePositionScore{NoInit, cacheSize};
+    for(UnsignedInt i = 0; i != cacheSize; ++i)
+        cachePositionScore[i] = i < 3 ? LastTriangleScore :
+            std::pow(1.0f - Float(i - 3)/Float(cacheSize - 3), CacheDecayPower);
+    Float valenceScore[PrecalculatedValenceCount];
+    for(UnsignedInt i = 1; i != PrecalculatedValenceCount; ++i)
+        valenceScore[i] = ValenceBoostScale*std::pow(Float(i), -ValenceBoostPower);
+    const auto vertexScore = [&](const Int cachePosition, const UnsignedInt liveTriangles) {
+        /* Vertices without any live triangles don't matter anymore */
+        if(!liveTriangles) return -1.0f;
+        return (cachePosition < 0 ? 0.0f : cachePositionScore[cachePosition]) +
+            (liveTriangles < PrecalculatedValenceCount ? valenceScore[liveTriangles] :
+                ValenceBoostScale*std::pow(Float(liveTriangles), -ValenceBoostPower));
+    };
+
+    /* Per-vertex cache position and score, per-triangle score and emitted
+       bit */
+    Containers::Array<Int> cachePosition{DirectInit, vertexCount, -1};
+    Containers::Array<Float> scores{NoInit, vertexCount};
+    for(UnsignedInt i = 0; i != vertexCount; ++i)
+        scores[i] = vertexScore(-1, liveTriangleCount[i]);
+    Containers::Array<Float> triangleScores{NoInit, triangleCount};
+    for(std::size_t i = 0; i != triangleCount; ++i)
+        triangleScores[i] = scores[indices[i*3 + 0]] + scores[indices[i*3 + 1]] + scores[indices[i*3 + 2]];
+    Containers::Array<UnsignedInt> emitted{ValueInit, (triangleCount + 31)/32};
+
+    /* Simulated LRU cache. Temporarily holds up to three more vertices while
+       a triangle is being added, these get evicted after. */
+    Containers::Array<UnsignedInt> cache{NoInit, cacheSize + 3};
+    Containers::Array<UnsignedInt> nextCache{NoInit, cacheSize + 3};
+    std::size_t cacheCount = 0;
+
+    /* Output index buffer */
+    Containers::Array<T> outputIndices{NoInit, indices.size()};
+
+    /* The first triangle is the one with the best score overall, after that
+       only triangles around vertices in the cache are considered and the
+       cursor is used to find the next not-yet-emitted triangle when all
+       triangles around the cache are exhausted */
+    std::size_t bestTriangle = 0;
+    for(std::size_t i = 1; i != triangleCount; ++i)
+        if(triangleScores[i] > triangleScores[bestTriangle]) bestTriangle = i;
+    std::size_t cursor = 0;
+
+    for(std::size_t outputTriangle = 0; outputTriangle != triangleCount; ++outputTriangle) {
+        if(bestTriangle == ~std::size_t{}) {
+            while(bit(emitted, cursor)) ++cursor;
+            bestTriangle = cursor;
+        }
+
+        /* Emit the triangle, remove it from the live triangle lists of its
+           vertices. For a degenerate triangle this gets done for each of its
+           occurences in the list. */
+        const std::size_t t = bestTriangle;
+        setBit(emitted, t);
+        std::size_t nextCacheCount = 0;
+        for(UnsignedInt vi = 0; vi != 3; ++vi) {
+            const UnsignedInt v = indices[t*3 + vi];
+            outputIndices[outputTriangle*3 + vi] = v;
+
+            const UnsignedInt begin = neighborOffset[v];
+            const UnsignedInt end = begin + liveTriangleCount[v];
+            for(UnsignedInt ti = begin; ti != end; ++ti) {
+                if(neighbors[ti] != t) continue;
+                neighbors[ti] = neighbors[end - 1];
+                neighbors[end - 1] = t;
+                --liveTriangleCount[v];
+                break;
+            }
+
+            /* Put the vertex to the front of the new cache, unless it's there
+               already in case of a degenerate triangle */
+            bool present = false;
+            for(std::size_t i = 0; i != nextCacheCount; ++i) if(nextCache[i] == v) {
+                present = true;
+                break;
+            }
+            if(!present) nextCache[nextCacheCount++] = v;
+        }
+
+        /* Append the rest of the original cache after the new vertices */
+        const std::size_t newVertexCount = nextCacheCount;
+        for(std::size_t i = 0; i != cacheCount; ++i) {
+            const UnsignedInt v = cache[i];
+            bool present = false;
+            for(std::size_t j = 0; j != newVertexCount; ++j) if(nextCache[j] == v) {
+                present = true;
+                break;
+            }
+            if(!present) nextCache[nextCacheCount++] = v;
+        }
+
+        /* Update cache positions and scores of all affected vertices,
+           including the ones that just fell out of the cache */
+        for(std::size_t i = 0; i != nextCacheCount; ++i) {
+            const UnsignedInt v = nextCache[i];
+            cachePosition[v] = i < cacheSize ? Int(i) : -1;
+            scores[v] = vertexScore(cachePosition[v], liveTriangleCount[v]);
+        }
+
+        /* Update scores of live triangles around affected vertices and pick
+           the best one from those that are around vertices still in the
+           cache */
+        bestTriangle = ~std::size_t{};
+        Float bestScore = -1.0f;
+        for(std::size_t i = 0; i != nextCacheCount; ++i) {
+            const UnsignedInt v = nextCache[i];
+            for(UnsignedInt ti = neighborOffset[v], end = neighborOffset[v] + liveTriangleCount[v]; ti != end; ++ti) {
+                const UnsignedInt n = neighbors[ti];
+                const Float score = triangleScores[n] = scores[indices[n*3 + 0]] + scores[indices[n*3 + 1]] + scores[indices[n*3 + 2]];
+                if(i < cacheSize && score > bestScore) {
+                    bestTriangle = n;
+                    bestScore = score;
+                }
+            }
+        }
+
+        /* Swap the caches, dropping the overflowing vertices */
+        std::swap(cache, nextCache);
+        cacheCount = Math::min(nextCacheCount, std::size_t(cacheSize));
+    }
+
+    /* Swap original index buffer with optimized */
+    Utility::copy(outputIndices, indices);
+}
+
+template<class T> Containers::Pair<Float, Float> vertexCacheStatisticsImplementation(const Containers::StridedArrayView1D<const T>& indices, const UnsignedInt vertexCount, const UnsignedInt cacheSize) {
+    CORRADE_ASSERT(!(indices.size()%3),
+        "MeshTools::vertexCacheStatistics(): index count not divisible by 3", {});
+
+    if(indices.isEmpty()) return {0.0f, 0.0f};
+
+    /* Global time, per-vertex caching timestamps, same as in tipsifyInPlace().
+       A vertex is in the cache if at most cacheSize other vertices were
+       added to it since, a zero timestamp means it was never referenced. */
+    UnsignedInt time = cacheSize + 1;
+    Containers::Array<UnsignedInt> timestamp{vertexCount};
+    std::size_t missCount = 0;
+    std::size_t referencedVertexCount = 0;
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        const UnsignedInt v = indices[i];
+        CORRADE_ASSERT(v < vertexCount,
+            "MeshTools::vertexCacheStatistics(): index" << v << "out of range for" << vertexCount << "vertices", {});
+
+        if(time - timestamp[v] <= cacheSize) continue;
+        if(!timestamp[v]) ++referencedVertexCount;
+        timestamp[v] = time++;
+        ++missCount;
+    }
+
+    return {Float(missCount)/Float(indices.size()/3),
+            Float(missCount)/Float(referencedVertexCount)};
+}
+
+}
+
+void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const UnsignedInt vertexCount, const UnsignedInt cacheSize) {
+    optimizeVertexCacheInPlaceImplementation(indices, vertexCount, cacheSize);
+}
+
+void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const UnsignedInt vertexCount, const UnsignedInt cacheSize) {
+    optimizeVertexCacheInPlaceImplementation(indices, vertexCount, cacheSize);
+}
+
+void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const UnsignedInt vertexCount, const UnsignedInt cacheSize) {
+    optimizeVertexCacheInPlaceImplementation(indices, vertexCount, cacheSize);
+}
+
+Containers::Pair<Float, Float> vertexCacheStatistics(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const UnsignedInt vertexCount, const UnsignedInt cacheSize) {
+    return vertexCacheStatisticsImplementation(indices, vertexCount, cacheSize);
+}
+
+Containers::Pair<Float, Float> vertexCacheStatistics(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const UnsignedInt vertexCount, const UnsignedInt cacheSize) {
+    return vertexCacheStatisticsImplementation(indices, vertexCount, cacheSize);
+}
+
+Containers::Pair<Float, Float> vertexCacheStatistics(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const UnsignedInt vertexCount, const UnsignedInt cacheSize) {
+    return vertexCacheStatisticsImplementation(indices, vertexCount, cacheSize);
+}
+
+}}
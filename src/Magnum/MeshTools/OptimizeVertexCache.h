@@ -0,0 +1,112 @@
+#ifndef Magnum_MeshTools_OptimizeVertexCache_h
+#define Magnum_MeshTools_OptimizeVertexCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::optimizeVertexCacheInPlace(), @ref Magnum::MeshTools::vertexCacheStatistics()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Optimize the mesh for post-transform vertex cache in-place
+@param[in,out] indices  Indices array to operate on
+@param[in] vertexCount  Vertex count
+@param[in] cacheSize    Post-transform vertex cache size
+@m_since_latest
+
+Rearranges triangles in the index array for better usage of post-transform
+vertex cache. Compared to @ref tipsifyInPlace() it doesn't assume any
+particular cache size on the target hardware and generally produces better
+results for larger caches, at the cost of being slower. Algorithm used:
+* *Tom Forsyth --- Linear-Speed Vertex Cache Optimisation, 2006,
+https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html*.
+
+The @p indices are expected to describe a @ref MeshPrimitive::Triangles mesh,
+i.e. their count being divisible by 3, and @p cacheSize is expected to be at
+least @cpp 4 @ce. Vertices of each triangle are kept in the original order.
+Use @ref vertexCacheStatistics() to measure the result.
+@see @ref tipsifyInPlace()
+*/
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, UnsignedInt vertexCount, UnsignedInt cacheSize = 32);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, UnsignedInt vertexCount, UnsignedInt cacheSize = 32);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, UnsignedInt vertexCount, UnsignedInt cacheSize = 32);
+
+/**
+@brief Post-transform vertex cache statistics
+@param indices          Indices array
+@param vertexCount      Vertex count
+@param cacheSize        Post-transform vertex cache size
+@return Average cache miss ratio (ACMR) and average transformed vertex ratio
+    (ATVR)
+@m_since_latest
+
+Simulates a FIFO post-transform vertex cache of given size and counts vertex
+shader invocations caused by cache misses. The first returned value is the
+miss count divided by triangle count, with @cpp 0.5 @ce being the theoretical
+optimum for large regular meshes and @cpp 3.0 @ce the worst case. The second
+value is the miss count divided by count of vertices actually referenced by
+@p indices, with @cpp 1.0 @ce being the optimum. If @p indices are empty,
+returns @cpp 0.0f @ce for both.
+
+The @p indices are expected to describe a @ref MeshPrimitive::Triangles mesh,
+i.e. their count being divisible by 3, and all of them are expected to be less
+than @p vertexCount.
+@see @ref optimizeVertexCacheInPlace(), @ref tipsifyInPlace()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Pair<Float, Float> vertexCacheStatistics(const Containers::StridedArrayView1D<const UnsignedInt>& indices, UnsignedInt vertexCount, UnsignedInt cacheSize);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Pair<Float, Float> vertexCacheStatistics(const Containers::StridedArrayView1D<const UnsignedShort>& indices, UnsignedInt vertexCount, UnsignedInt cacheSize);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Pair<Float, Float> vertexCacheStatistics(const Containers::StridedArrayView1D<const UnsignedByte>& indices, UnsignedInt vertexCount, UnsignedInt cacheSize);
+
+}}
+
+#endif
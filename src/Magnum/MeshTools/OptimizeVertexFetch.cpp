@@ -0,0 +1,151 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "OptimizeVertexFetch.h"
+
+#include <utility>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Reference.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+template<class T> UnsignedInt optimizeVertexFetchInPlaceIntoImplementation(const Containers::StridedArrayView1D<T>& indices, const Containers::StridedArrayView1D<UnsignedInt>& mapping) {
+    for(UnsignedInt& i: mapping) i = ~UnsignedInt{};
+
+    /* Assign new locations in order of first use */
+    UnsignedInt next = 0;
+    for(T& index: indices) {
+        CORRADE_ASSERT(index < mapping.size(),
+            "MeshTools::optimizeVertexFetchInPlaceInto(): index" << UnsignedInt(index) << "out of range for" << mapping.size() << "vertices", {});
+        UnsignedInt& location = mapping[index];
+        if(location == ~UnsignedInt{}) location = next++;
+        index = location;
+    }
+
+    /* Put the unreferenced vertices after */
+    const UnsignedInt usedCount = next;
+    for(UnsignedInt& i: mapping)
+        if(i == ~UnsignedInt{}) i = next++;
+
+    return usedCount;
+}
+
+/* Moves i-th item of the view to mapping[i] */
+void permuteInPlace(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<const UnsignedInt>& mapping) {
+    Containers::Array<char> copy{NoInit, data.size()[0]*data.size()[1]};
+    const Containers::StridedArrayView2D<char> copyView{copy, data.size()};
+    Utility::copy(data, copyView);
+    for(std::size_t i = 0; i != mapping.size(); ++i)
+        Utility::copy(copyView[i], data[mapping[i]]);
+}
+
+}
+
+UnsignedInt optimizeVertexFetchInPlaceInto(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<UnsignedInt>& mapping) {
+    return optimizeVertexFetchInPlaceIntoImplementation(indices, mapping);
+}
+
+UnsignedInt optimizeVertexFetchInPlaceInto(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<UnsignedInt>& mapping) {
+    return optimizeVertexFetchInPlaceIntoImplementation(indices, mapping);
+}
+
+UnsignedInt optimizeVertexFetchInPlaceInto(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<UnsignedInt>& mapping) {
+    return optimizeVertexFetchInPlaceIntoImplementation(indices, mapping);
+}
+
+Trade::MeshData optimizeVertexFetch(const Trade::MeshData& data) {
+    Trade::MeshData out = owned(data);
+    optimizeVertexFetchInPlace(out);
+    return out;
+}
+
+Trade::MeshData optimizeVertexFetch(Trade::MeshData&& data) {
+    /* Perform the operation in-place, if we can transfer the ownership */
+    if((data.indexDataFlags() & Trade::DataFlag::Owned) &&
+       (data.vertexDataFlags() & Trade::DataFlag::Owned))
+    {
+        optimizeVertexFetchInPlace(data);
+        return std::move(data);
+    }
+
+    /* Otherwise delegate to the function that does all the copying */
+    return optimizeVertexFetch(data);
+}
+
+void optimizeVertexFetchInPlace(Trade::MeshData& data) {
+    CORRADE_ASSERT(data.indexDataFlags() & Trade::DataFlag::Mutable,
+        "MeshTools::optimizeVertexFetchInPlace(): index data not mutable", );
+    CORRADE_ASSERT(data.vertexDataFlags() & Trade::DataFlag::Mutable,
+        "MeshTools::optimizeVertexFetchInPlace(): vertex data not mutable", );
+
+    /* Non-indexed meshes have vertices in the order of use already */
+    if(!data.isIndexed()) return;
+
+    CORRADE_ASSERT(!isMeshIndexTypeImplementationSpecific(data.indexType()),
+        "MeshTools::optimizeVertexFetchInPlace(): mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(data.indexType())), );
+
+    Containers::Array<UnsignedInt> mapping{NoInit, data.vertexCount()};
+    if(data.indexType() == MeshIndexType::UnsignedInt)
+        optimizeVertexFetchInPlaceInto(data.mutableIndices<UnsignedInt>(), mapping);
+    else if(data.indexType() == MeshIndexType::UnsignedShort)
+        optimizeVertexFetchInPlaceInto(data.mutableIndices<UnsignedShort>(), mapping);
+    else if(data.indexType() == MeshIndexType::UnsignedByte)
+        optimizeVertexFetchInPlaceInto(data.mutableIndices<UnsignedByte>(), mapping);
+    else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+    /* Nothing else to do for attributeless meshes */
+    if(!data.attributeCount()) return;
+
+    /* If the mesh is interleaved, move whole vertices at once */
+    if(isInterleaved(data)) {
+        permuteInPlace(interleavedMutableData(data), mapping);
+        return;
+    }
+
+    /* Otherwise go attribute by attribute. Skip attributes that alias
+       another attribute that was processed already, as they'd get moved
+       twice otherwise. */
+    for(UnsignedInt i = 0; i != data.attributeCount(); ++i) {
+        const Containers::StridedArrayView2D<char> attribute = data.mutableAttribute(i);
+        bool aliased = false;
+        for(UnsignedInt j = 0; j != i; ++j) {
+            const Containers::StridedArrayView2D<const char> other = data.attribute(j);
+            if(other.data() == attribute.data() && other.stride() == attribute.stride() && other.size()[1] >= attribute.size()[1]) {
+                aliased = true;
+                break;
+            }
+        }
+        if(!aliased) permuteInPlace(attribute, mapping);
+    }
+}
+
+}}
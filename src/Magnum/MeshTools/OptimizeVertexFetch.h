@@ -0,0 +1,123 @@
+#ifndef Magnum_MeshTools_OptimizeVertexFetch_h
+#define Magnum_MeshTools_OptimizeVertexFetch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::optimizeVertexFetchInPlaceInto(), @ref Magnum::MeshTools::optimizeVertexFetch(), @ref Magnum::MeshTools::optimizeVertexFetchInPlace()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Remap indices to vertex first-use order in-place
+@param[in,out] indices  Indices array to operate on
+@param[out] mapping     Where to put the new location of each vertex
+@return Count of vertices referenced by @p indices
+@m_since_latest
+
+Goes through @p indices and assigns each vertex a new location based on the
+order in which it's first referenced, replacing the indices with the new
+locations. Vertices that aren't referenced by any index are put after all
+referenced vertices in their original order, so the @p mapping is always a
+permutation. Size of @p mapping is the vertex count, all @p indices are
+expected to be less than it.
+
+The vertex data can be then rearranged by copying the @cpp i @ce -th vertex to
+location @cpp mapping[i] @ce. Use @ref optimizeVertexFetch() to perform the
+whole operation on a @ref Trade::MeshData instance.
+@see @ref optimizeVertexCacheInPlace(), @ref tipsifyInPlace()
+*/
+MAGNUM_MESHTOOLS_EXPORT UnsignedInt optimizeVertexFetchInPlaceInto(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<UnsignedInt>& mapping);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT UnsignedInt optimizeVertexFetchInPlaceInto(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<UnsignedInt>& mapping);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT UnsignedInt optimizeVertexFetchInPlaceInto(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<UnsignedInt>& mapping);
+
+/**
+@brief Optimize mesh vertex data for fetch locality
+@m_since_latest
+
+Rearranges the vertex data into the order in which the vertices are first
+referenced by the index buffer and remaps the indices accordingly using
+@ref optimizeVertexFetchInPlaceInto(). Vertices that aren't referenced by any
+index are kept at the end. The attribute layout, primitive and index type stay
+the same, only the data get reordered. Meant to be called after reordering the
+index buffer with @ref optimizeVertexCacheInPlace() or @ref tipsifyInPlace().
+
+Expects that the mesh index type, if the mesh is indexed, is not
+implementation-specific. If the mesh is not indexed, the vertices are already
+in the order in which they're used and the data are passed through unchanged.
+
+This function will unconditionally make a copy of all data. See
+@ref optimizeVertexFetch(Trade::MeshData&&) for a potentially more efficient
+operation, you can also do the operation in-place using
+@ref optimizeVertexFetchInPlace().
+@see @ref isMeshIndexTypeImplementationSpecific()
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimizeVertexFetch(const Trade::MeshData& data);
+
+/**
+@brief Optimize mesh vertex data for fetch locality
+@m_since_latest
+
+Compared to @ref optimizeVertexFetch(const Trade::MeshData&) this function can
+perform the operation in-place, transferring the data ownership to the
+returned instance, if both vertex and index data is owned.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimizeVertexFetch(Trade::MeshData&& data);
+
+/**
+@brief Optimize mesh vertex data for fetch locality in-place
+@m_since_latest
+
+Expects that the mesh has mutable index and vertex data and that the index
+type, if the mesh is indexed, is not implementation-specific. If the mesh is
+interleaved, whole vertices are moved at once, otherwise each attribute is
+reordered separately. See @ref optimizeVertexFetch(const Trade::MeshData&) for
+more information.
+@see @ref isInterleaved(), @ref Trade::MeshData::indexDataFlags(),
+    @ref Trade::MeshData::vertexDataFlags()
+*/
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexFetchInPlace(Trade::MeshData& data);
+
+}}
+
+#endif
@@ -0,0 +1,327 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Quantize.h"
+
+#include <limits>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/Triple.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/PackingBatch.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/MeshTools/BoundingVolume.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Like Math::sign(), but returning 1 for zero as well, so directions on the
+   octahedron edges don't collapse */
+Vector2 signNotZero(const Vector2& value) {
+    return {value.x() >= 0.0f ? 1.0f : -1.0f,
+            value.y() >= 0.0f ? 1.0f : -1.0f};
+}
+
+/* Projects the direction onto an octahedron with |x| + |y| + |z| = 1 and
+   folds the lower half over the diagonals of the upper half, giving a point
+   in the [-1, 1] square. A zero direction maps to the center. */
+Vector2 octahedralProject(const Vector3& direction) {
+    const Float sum = Math::abs(direction.x()) + Math::abs(direction.y()) + Math::abs(direction.z());
+    if(sum == 0.0f) return {};
+
+    const Vector2 projected = direction.xy()/sum;
+    if(direction.z() >= 0.0f) return projected;
+    return (Vector2{1.0f} - Math::abs(Vector2{projected.y(), projected.x()}))*signNotZero(projected);
+}
+
+Vector3 octahedralUnproject(const Vector2& projected) {
+    Vector3 direction{projected, 1.0f - Math::abs(projected.x()) - Math::abs(projected.y())};
+    if(direction.z() < 0.0f)
+        direction.xy() = (Vector2{1.0f} - Math::abs(Vector2{projected.y(), projected.x()}))*signNotZero(projected);
+    return direction.normalized();
+}
+
+template<class T> void encodeOctahedralIntoImplementation(const Containers::StridedArrayView1D<const Vector3>& directions, const Containers::StridedArrayView1D<Math::Vector2<T>>& encoded) {
+    CORRADE_ASSERT(encoded.size() == directions.size(),
+        "MeshTools::encodeOctahedralInto(): expected" << directions.size() << "items in the output but got" << encoded.size(), );
+
+    constexpr Float max = std::numeric_limits<T>::max();
+    for(std::size_t i = 0; i != directions.size(); ++i) {
+        const Vector3 direction = directions[i];
+        const Float length = direction.length();
+        if(length == 0.0f) {
+            encoded[i] = {};
+            continue;
+        }
+
+        /* Plain rounding of the projected coordinates isn't guaranteed to
+           give the closest direction because the mapping is non-linear. Try
+           all four neighbors instead and pick the one closest to the
+           original. Comparing squared distances and not dot products, as
+           those are too close to 1 to be distinguishable for 16-bit
+           values. */
+        const Vector3 normalized = direction/length;
+        const Vector2 floor = Math::floor(octahedralProject(normalized)*max);
+        Vector2 best;
+        Float bestDistance = Constants::inf();
+        for(UnsignedInt j = 0; j != 4; ++j) {
+            const Vector2 candidate = Math::clamp(floor + Vector2{Float(j & 1), Float(j >> 1)}, -max, max);
+            const Float distance = (octahedralUnproject(candidate/max) - normalized).dot();
+            if(distance < bestDistance) {
+                best = candidate;
+                bestDistance = distance;
+            }
+        }
+
+        encoded[i] = Math::Vector2<T>{best};
+    }
+}
+
+template<class T> void decodeOctahedralIntoImplementation(const Containers::StridedArrayView1D<const Math::Vector2<T>>& encoded, const Containers::StridedArrayView1D<Vector3>& directions) {
+    CORRADE_ASSERT(directions.size() == encoded.size(),
+        "MeshTools::decodeOctahedralInto(): expected" << encoded.size() << "items in the output but got" << directions.size(), );
+
+    for(std::size_t i = 0; i != encoded.size(); ++i)
+        directions[i] = octahedralUnproject(Math::unpack<Vector2>(encoded[i]));
+}
+
+/* Encodes the directions into given attribute and returns the max distance
+   between the normalized original and the decoded value. The attribute can
+   have more than two components, the rest is left untouched. */
+template<class T> Float encodeOctahedralAttributeImplementation(const Containers::StridedArrayView1D<const Vector3>& directions, const Containers::StridedArrayView1D<Math::Vector2<T>>& encoded) {
+    encodeOctahedralIntoImplementation<T>(directions, encoded);
+
+    Containers::Array<Vector3> decoded{NoInit, directions.size()};
+    decodeOctahedralIntoImplementation<T>(encoded, decoded);
+
+    Float error = 0.0f;
+    for(std::size_t i = 0; i != directions.size(); ++i) {
+        const Float length = directions[i].length();
+        /* Zero directions have no meaningful error */
+        if(length == 0.0f) continue;
+        error = Math::max(error, (directions[i]/length - decoded[i]).length());
+    }
+    return error;
+}
+
+Float encodeOctahedralAttribute(const Containers::StridedArrayView1D<const Vector3>& directions, const Containers::StridedArrayView2D<char>& attribute, const bool octahedralShort) {
+    if(octahedralShort)
+        return encodeOctahedralAttributeImplementation<Short>(directions, Containers::arrayCast<1, Vector2s>(attribute.prefix({attribute.size()[0], sizeof(Vector2s)})));
+    else
+        return encodeOctahedralAttributeImplementation<Byte>(directions, Containers::arrayCast<1, Vector2b>(attribute.prefix({attribute.size()[0], sizeof(Vector2b)})));
+}
+
+inline Containers::Triple<Trade::MeshData, Matrix4, Containers::Array<Float>> quantizeFailed() {
+    return {Trade::MeshData{MeshPrimitive{}, 0}, Matrix4{}, Containers::Array<Float>{}};
+}
+
+}
+
+void encodeOctahedralInto(const Containers::StridedArrayView1D<const Vector3>& directions, const Containers::StridedArrayView1D<Vector2b>& encoded) {
+    encodeOctahedralIntoImplementation(directions, encoded);
+}
+
+void encodeOctahedralInto(const Containers::StridedArrayView1D<const Vector3>& directions, const Containers::StridedArrayView1D<Vector2s>& encoded) {
+    encodeOctahedralIntoImplementation(directions, encoded);
+}
+
+void decodeOctahedralInto(const Containers::StridedArrayView1D<const Vector2b>& encoded, const Containers::StridedArrayView1D<Vector3>& directions) {
+    decodeOctahedralIntoImplementation(encoded, directions);
+}
+
+void decodeOctahedralInto(const Containers::StridedArrayView1D<const Vector2s>& encoded, const Containers::StridedArrayView1D<Vector3>& directions) {
+    decodeOctahedralIntoImplementation(encoded, directions);
+}
+
+Containers::Triple<Trade::MeshData, Matrix4, Containers::Array<Float>> quantize(const Trade::MeshData& mesh, const QuantizeFlags flags, const UnsignedShort customAttributeOffset) {
+    CORRADE_ASSERT(!mesh.isIndexed() || !isMeshIndexTypeImplementationSpecific(mesh.indexType()),
+        "MeshTools::quantize(): mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(mesh.indexType())),
+        quantizeFailed());
+    #ifndef CORRADE_NO_ASSERT
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        const VertexFormat format = mesh.attributeFormat(i);
+        CORRADE_ASSERT(!isVertexFormatImplementationSpecific(format),
+            "MeshTools::quantize(): attribute" << i << "has an implementation-specific format" << reinterpret_cast<void*>(vertexFormatUnwrap(format)),
+            quantizeFailed());
+    }
+    if(flags & QuantizeFlag::OctahedralDirections) for(UnsignedInt i = 0; i != 3; ++i) {
+        CORRADE_ASSERT(!mesh.hasAttribute(Trade::meshAttributeCustom(customAttributeOffset + i)),
+            "MeshTools::quantize(): the mesh already has a custom attribute" << customAttributeOffset + i,
+            quantizeFailed());
+    }
+    #endif
+
+    const UnsignedInt vertexCount = mesh.vertexCount();
+    const bool octahedralShort = flags >= QuantizeFlag::OctahedralShort;
+
+    /* ID of each attribute among attributes of the same name, for use with
+       the *AsArray() accessors */
+    Containers::Array<UnsignedInt> nameIds{ValueInit, mesh.attributeCount()};
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i)
+        for(UnsignedInt j = 0; j != i; ++j)
+            if(mesh.attributeName(j) == mesh.attributeName(i)) ++nameIds[i];
+
+    /* Decide on the output format of each attribute. Attributes that aren't
+       quantized keep their name, format and array size. */
+    Containers::Array<Trade::MeshAttributeData> attributes{mesh.attributeCount()};
+    Containers::Array<bool> quantized{ValueInit, mesh.attributeCount()};
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        const Trade::MeshAttribute name = mesh.attributeName(i);
+        const VertexFormat format = mesh.attributeFormat(i);
+        Trade::MeshAttribute outputName = name;
+        VertexFormat outputFormat = format;
+
+        /* Only the first position attribute is quantized as the returned
+           transformation can't apply to more than one */
+        if(name == Trade::MeshAttribute::Position && nameIds[i] == 0 && (flags & QuantizeFlag::Positions)) {
+            outputFormat = vertexFormatComponentCount(format) == 2 ?
+                VertexFormat::Vector2sNormalized :
+                VertexFormat::Vector3sNormalized;
+            quantized[i] = true;
+
+        } else if((name == Trade::MeshAttribute::Normal ||
+                   name == Trade::MeshAttribute::Tangent ||
+                   name == Trade::MeshAttribute::Bitangent) &&
+                  (flags & QuantizeFlag::OctahedralDirections)) {
+            outputName = Trade::meshAttributeCustom(customAttributeOffset +
+                (name == Trade::MeshAttribute::Normal ? 0 :
+                 name == Trade::MeshAttribute::Tangent ? 1 : 2));
+            if(name == Trade::MeshAttribute::Tangent && vertexFormatComponentCount(format) == 4)
+                outputFormat = octahedralShort ?
+                    VertexFormat::Vector3sNormalized :
+                    VertexFormat::Vector3bNormalized;
+            else
+                outputFormat = octahedralShort ?
+                    VertexFormat::Vector2sNormalized :
+                    VertexFormat::Vector2bNormalized;
+            quantized[i] = true;
+
+        } else if(name == Trade::MeshAttribute::TextureCoordinates && (flags & QuantizeFlag::TextureCoordinates)) {
+            /* Normalized unsigned formats can't represent anything outside of
+               the [0, 1] range, leave such sets untouched */
+            const Containers::Array<Vector2> textureCoordinates = mesh.textureCoordinates2DAsArray(nameIds[i]);
+            const Range2D range = Math::minmax(textureCoordinates);
+            if((range.min() >= Vector2{0.0f}).all() && (range.max() <= Vector2{1.0f}).all()) {
+                outputFormat = VertexFormat::Vector2usNormalized;
+                quantized[i] = true;
+            }
+        }
+
+        attributes[i] = Trade::MeshAttributeData{outputName, outputFormat, nullptr, mesh.attributeArraySize(i)};
+    }
+
+    /* Create an interleaved layout, then transfer it together with a copy of
+       the index buffer to a new mesh */
+    Trade::MeshData layout = interleavedLayout(Trade::MeshData{mesh.primitive(), vertexCount}, vertexCount, attributes);
+    Containers::Array<char> indexData;
+    Trade::MeshIndexData indices;
+    if(mesh.isIndexed()) {
+        const std::size_t indexTypeSize = meshIndexTypeSize(mesh.indexType());
+        indexData = Containers::Array<char>{NoInit, mesh.indexCount()*indexTypeSize};
+        Utility::copy(mesh.indices(), Containers::StridedArrayView2D<char>{indexData, {mesh.indexCount(), indexTypeSize}});
+        indices = Trade::MeshIndexData{mesh.indexType(), indexData};
+    }
+    Trade::MeshData out{mesh.primitive(),
+        std::move(indexData), indices,
+        layout.releaseVertexData(), layout.releaseAttributeData(), vertexCount};
+
+    Matrix4 transformation;
+    Containers::Array<Float> errors{ValueInit, mesh.attributeCount()};
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        const Trade::MeshAttribute name = mesh.attributeName(i);
+        const Containers::StridedArrayView2D<char> attribute = out.mutableAttribute(i);
+
+        if(!quantized[i]) {
+            Utility::copy(mesh.attribute(i), attribute);
+
+        } else if(name == Trade::MeshAttribute::Position) {
+            const Containers::Array<Vector3> positions = mesh.positions3DAsArray(nameIds[i]);
+            const UnsignedInt componentCount = vertexFormatComponentCount(out.attributeFormat(i));
+
+            /* Map the bounding box to the [-1, 1] range. Flat dimensions
+               (and Z of 2D positions) are left unscaled to avoid a division
+               by zero. */
+            const Range3D range = boundingRange(positions);
+            const Vector3 center = range.center();
+            Vector3 halfSize = range.size()*0.5f;
+            for(UnsignedInt j = 0; j != 3; ++j)
+                if(halfSize[j] == 0.0f) halfSize[j] = 1.0f;
+            transformation = Matrix4::translation(center)*Matrix4::scaling(halfSize);
+
+            Containers::Array<Vector3> normalized{NoInit, vertexCount};
+            for(UnsignedInt j = 0; j != vertexCount; ++j)
+                normalized[j] = (positions[j] - center)/halfSize;
+            const Containers::StridedArrayView2D<Float> normalized3f = Containers::arrayCast<2, Float>(Containers::stridedArrayView(normalized)).prefix({vertexCount, componentCount});
+            const Containers::StridedArrayView2D<Short> attribute3s = Containers::arrayCast<2, Short>(attribute);
+            Math::packInto(normalized3f, attribute3s);
+
+            /* Unpack back in place to calculate the error */
+            Math::unpackInto(attribute3s, normalized3f);
+            for(UnsignedInt j = 0; j != vertexCount; ++j)
+                errors[i] = Math::max(errors[i], (transformation.transformPoint(normalized[j]) - positions[j]).length());
+
+        } else if(name == Trade::MeshAttribute::Normal) {
+            errors[i] = encodeOctahedralAttribute(mesh.normalsAsArray(nameIds[i]), attribute, octahedralShort);
+
+        } else if(name == Trade::MeshAttribute::Tangent) {
+            errors[i] = encodeOctahedralAttribute(mesh.tangentsAsArray(nameIds[i]), attribute, octahedralShort);
+
+            /* Bitangent sign of four-component tangents goes to the last
+               component. It's either 1 or -1, so packing is lossless. */
+            if(vertexFormatComponentCount(out.attributeFormat(i)) == 3) {
+                const Containers::Array<Float> signs = mesh.bitangentSignsAsArray(nameIds[i]);
+                const Containers::StridedArrayView2D<const Float> signs1f = Containers::arrayCast<2, const Float>(Containers::stridedArrayView(signs));
+                if(octahedralShort)
+                    Math::packInto(signs1f, Containers::arrayCast<2, Short>(attribute).exceptPrefix({0, 2}));
+                else
+                    Math::packInto(signs1f, Containers::arrayCast<2, Byte>(attribute).exceptPrefix({0, 2}));
+            }
+
+        } else if(name == Trade::MeshAttribute::Bitangent) {
+            errors[i] = encodeOctahedralAttribute(mesh.bitangentsAsArray(nameIds[i]), attribute, octahedralShort);
+
+        } else if(name == Trade::MeshAttribute::TextureCoordinates) {
+            const Containers::Array<Vector2> textureCoordinates = mesh.textureCoordinates2DAsArray(nameIds[i]);
+            Containers::Array<Vector2> dequantized{NoInit, vertexCount};
+            const Containers::StridedArrayView2D<UnsignedShort> attribute2us = Containers::arrayCast<2, UnsignedShort>(attribute);
+            Math::packInto(Containers::arrayCast<2, const Float>(Containers::stridedArrayView(textureCoordinates)), attribute2us);
+            Math::unpackInto(attribute2us, Containers::arrayCast<2, Float>(Containers::stridedArrayView(dequantized)));
+            for(UnsignedInt j = 0; j != vertexCount; ++j)
+                errors[i] = Math::max(errors[i], (dequantized[j] - textureCoordinates[j]).length());
+
+        } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+
+    return {std::move(out), Matrix4{transformation}, std::move(errors)};
+}
+
+}}
@@ -0,0 +1,180 @@
+#ifndef Magnum_MeshTools_Quantize_h
+#define Magnum_MeshTools_Quantize_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::encodeOctahedralInto(), @ref Magnum::MeshTools::decodeOctahedralInto(), @ref Magnum::MeshTools::quantize(), enum @ref Magnum::MeshTools::QuantizeFlag, enum set @ref Magnum::MeshTools::QuantizeFlags
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Encode directions using an octahedral mapping
+@param[in] directions   Input directions
+@param[out] encoded     Where to put the encoded directions
+@m_since_latest
+
+Projects each direction onto an octahedron, unfolds it into a square and
+stores the two resulting coordinates as normalized signed integers. Out of the
+four nearest representable values, the one that decodes to a direction closest
+to the original is picked, which reduces the error by about a third compared
+to plain rounding. The directions don't need to be normalized, a
+zero direction is encoded as @f$ (0, 0, 1) @f$. Expects that both views have
+the same size.
+@see @ref decodeOctahedralInto(), @ref quantize()
+*/
+MAGNUM_MESHTOOLS_EXPORT void encodeOctahedralInto(const Containers::StridedArrayView1D<const Vector3>& directions, const Containers::StridedArrayView1D<Vector2b>& encoded);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void encodeOctahedralInto(const Containers::StridedArrayView1D<const Vector3>& directions, const Containers::StridedArrayView1D<Vector2s>& encoded);
+
+/**
+@brief Decode octahedrally encoded directions
+@param[in] encoded      Encoded directions
+@param[out] directions  Where to put the decoded normalized directions
+@m_since_latest
+
+Inverse of @ref encodeOctahedralInto(). Expects that both views have the same
+size.
+*/
+MAGNUM_MESHTOOLS_EXPORT void decodeOctahedralInto(const Containers::StridedArrayView1D<const Vector2b>& encoded, const Containers::StridedArrayView1D<Vector3>& directions);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void decodeOctahedralInto(const Containers::StridedArrayView1D<const Vector2s>& encoded, const Containers::StridedArrayView1D<Vector3>& directions);
+
+/**
+@brief Mesh quantization flag
+@m_since_latest
+
+@see @ref QuantizeFlags, @ref quantize()
+*/
+enum class QuantizeFlag: UnsignedByte {
+    /**
+     * Quantize @ref Trade::MeshAttribute::Position to
+     * @ref VertexFormat::Vector3sNormalized, or
+     * @ref VertexFormat::Vector2sNormalized for 2D positions, relative to the
+     * mesh bounding box.
+     */
+    Positions = 1 << 0,
+
+    /**
+     * Encode @ref Trade::MeshAttribute::Normal,
+     * @relativeref{Trade::MeshAttribute,Tangent} and
+     * @relativeref{Trade::MeshAttribute,Bitangent} using
+     * @ref encodeOctahedralInto() to @ref VertexFormat::Vector2bNormalized.
+     * Four-component tangents are encoded to
+     * @ref VertexFormat::Vector3bNormalized with the bitangent sign in the
+     * last component.
+     */
+    OctahedralDirections = 1 << 1,
+
+    /**
+     * Use @ref VertexFormat::Vector2sNormalized and
+     * @ref VertexFormat::Vector3sNormalized for octahedrally encoded
+     * directions instead of the 8-bit formats. Has no effect if
+     * @ref QuantizeFlag::OctahedralDirections isn't set.
+     */
+    OctahedralShort = 1 << 2,
+
+    /**
+     * Quantize @ref Trade::MeshAttribute::TextureCoordinates to
+     * @ref VertexFormat::Vector2usNormalized. Texture coordinate sets that
+     * are not in the @f$ [0, 1] @f$ range are left untouched.
+     */
+    TextureCoordinates = 1 << 3
+};
+
+/**
+@brief Mesh quantization flags
+@m_since_latest
+
+@see @ref quantize()
+*/
+typedef Containers::EnumSet<QuantizeFlag> QuantizeFlags;
+
+CORRADE_ENUMSET_OPERATORS(QuantizeFlags)
+
+/**
+@brief Quantize mesh attributes
+@param mesh                 Input mesh
+@param flags                Which attributes to quantize
+@param customAttributeOffset Offset for custom attribute IDs of octahedrally
+    encoded directions
+@return Quantized mesh, a transformation to dequantize the positions and
+    maximal quantization error for each attribute
+@m_since_latest
+
+Returns a copy of @p mesh with attributes selected by @p flags converted to
+smaller vertex formats and all attributes interleaved. Index data and other
+attributes are copied unchanged. The second value is a transformation that
+converts the normalized @ref VertexFormat::Vector3sNormalized positions back
+to the original space, usable directly as a part of the mesh transformation.
+If @ref QuantizeFlag::Positions isn't set or the mesh has no positions, it's
+an identity. For 2D positions only the XY coordinates of the transformation
+are relevant.
+
+As the builtin @ref Trade::MeshAttribute::Normal,
+@relativeref{Trade::MeshAttribute,Tangent} and
+@relativeref{Trade::MeshAttribute,Bitangent} don't allow two-component
+formats, octahedrally encoded directions are put into
+@ref Trade::meshAttributeCustom() with ID @p customAttributeOffset for
+normals, @cpp customAttributeOffset + 1 @ce for tangents and
+@cpp customAttributeOffset + 2 @ce for bitangents, preserving their relative
+order. Use @ref decodeOctahedralInto() or an equivalent shader code to decode
+them. Attribute order is otherwise unchanged.
+
+The third value contains the maximal quantization error for each attribute
+in the output, which is the largest distance between the original and
+dequantized value for positions and texture coordinates, and the largest
+distance between the normalized original and the decoded direction for
+normals, tangents and bitangents. Attributes that weren't quantized have the
+error set to @cpp 0.0f @ce.
+
+Expects that the mesh doesn't contain custom attributes with the above IDs if
+@ref QuantizeFlag::OctahedralDirections is set and that the index type and
+all attribute formats are not implementation-specific.
+@see @ref isMeshIndexTypeImplementationSpecific(),
+    @ref isVertexFormatImplementationSpecific()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Triple<Trade::MeshData, Matrix4, Containers::Array<Float>> quantize(const Trade::MeshData& mesh, QuantizeFlags flags, UnsignedShort customAttributeOffset = 0);
+
+}}
+
+#endif
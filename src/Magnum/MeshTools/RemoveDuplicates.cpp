@@ -28,13 +28,14 @@
 #include <cstring>
 #include <limits>
 #include <numeric>
-#include <unordered_map>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/MurmurHash2.h>
 
+#include "Magnum/Implementation/parallelFor.h"
 #include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Math/PackingBatch.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/MeshTools/Reference.h"
 #include "Magnum/MeshTools/Duplicate.h"
@@ -43,27 +44,287 @@
 
 namespace Magnum { namespace MeshTools {
 
-struct ArrayEqual {
-    explicit ArrayEqual(std::size_t size): _size{size} {}
+namespace {
+
+/* Marks an unused slot in the open-addressing table */
+constexpr UnsignedInt EmptySlot = ~UnsignedInt{};
 
-    bool operator()(const void* a, const void* b) const {
-        return std::memcmp(a, b, _size) == 0;
+/* Hash and comparison for keys of a size known only at runtime */
+struct RuntimeSizeKey {
+    explicit RuntimeSizeKey(std::size_t size): size{size} {}
+
+    std::size_t hash(const char* a) const {
+        return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2{}(a, size).byteArray());
     }
 
-    private: std::size_t _size;
+    bool equal(const char* a, const char* b) const {
+        return std::memcmp(a, b, size) == 0;
+    }
+
+    std::size_t size;
 };
 
-struct ArrayHash {
-    explicit ArrayHash(std::size_t size): _size{size} {}
+/* Hash and comparison for keys of a compile-time size, used for the most
+   common vertex sizes (three-component positions, interleaved positions +
+   normals / texture coordinates, ...). The loops get fully unrolled and
+   memcmp() turns into a few word comparisons, which is significantly faster
+   than going through MurmurHash2 and a runtime-sized memcmp(). The mixing
+   function is a 64-bit multiply-xorshift, which is good enough for a power-of
+   two table with linear probing. */
+template<std::size_t size_> struct FixedSizeKey {
+    static_assert(size_ % 4 == 0, "key size expected to be a multiple of four bytes");
+
+    explicit FixedSizeKey(std::size_t) {}
+
+    std::size_t hash(const char* a) const {
+        UnsignedLong h = 0x9e3779b97f4a7c15ull ^ size_;
+        for(std::size_t i = 0; i != size_; i += 4) {
+            UnsignedInt word;
+            std::memcpy(&word, a + i, 4);
+            h = (h ^ word)*0xff51afd7ed558ccdull;
+            h ^= h >> 32;
+        }
+        return std::size_t(h);
+    }
 
-    std::size_t operator()(const void* a) const {
-        return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2{}(static_cast<const char*>(a), _size).byteArray());
+    bool equal(const char* a, const char* b) const {
+        return std::memcmp(a, b, size_) == 0;
     }
+};
+
+/* Open-addressing hash table with linear probing, storing just indices into
+   a key array, no keys or values. Compared to std::unordered_map it does a
+   single allocation (or none, if the caller provides the memory) and doesn't
+   need to chase a pointer for every lookup. */
+template<class Key> class DuplicateTable {
+    public:
+        /* The slot count is expected to be a power of two and larger than the
+           count of keys that will be inserted */
+        explicit DuplicateTable(const Containers::ArrayView<UnsignedInt>& slots, const Containers::StridedArrayView2D<const char>& keys): _slots{slots}, _mask{slots.size() - 1}, _keys{keys}, _key{keys.size()[1]} {
+            for(UnsignedInt& i: _slots) i = EmptySlot;
+        }
 
-    private: std::size_t _size;
+        /* If a key equal to key `i` is already in the table, returns index of
+           that key, otherwise inserts `i` and returns it */
+        UnsignedInt findOrInsert(const UnsignedInt i) {
+            return findOrInsert(i, _key.hash(static_cast<const char*>(_keys[i].data())));
+        }
+
+        /* Same as above, but with a hash calculated upfront */
+        UnsignedInt findOrInsert(const UnsignedInt i, const std::size_t hash) {
+            const char* const key = static_cast<const char*>(_keys[i].data());
+            std::size_t slot = hash & _mask;
+            for(;;) {
+                const UnsignedInt existing = _slots[slot];
+                if(existing == EmptySlot)
+                    return _slots[slot] = i;
+                if(_key.equal(static_cast<const char*>(_keys[existing].data()), key))
+                    return existing;
+                slot = (slot + 1) & _mask;
+            }
+        }
+
+    private:
+        Containers::ArrayView<UnsignedInt> _slots;
+        std::size_t _mask;
+        Containers::StridedArrayView2D<const char> _keys;
+        Key _key;
 };
 
-std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+/* Calls given function templated on the key hashing & comparison for given
+   key size */
+template<template<class> class F, class ...Args> std::size_t dispatchKeySize(const std::size_t size, Args&&... args) {
+    switch(size) {
+        case 12: return F<FixedSizeKey<12>>{}(std::forward<Args>(args)...);
+        case 16: return F<FixedSizeKey<16>>{}(std::forward<Args>(args)...);
+        case 24: return F<FixedSizeKey<24>>{}(std::forward<Args>(args)...);
+        case 32: return F<FixedSizeKey<32>>{}(std::forward<Args>(args)...);
+    }
+
+    return F<RuntimeSizeKey>{}(std::forward<Args>(args)...);
+}
+
+template<class Key> struct RemoveDuplicatesInto {
+    std::size_t operator()(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::ArrayView<UnsignedInt>& slots) const {
+        DuplicateTable<Key> table{slots, data};
+
+        /* Go through all entries. The table contains index of first
+           occurrence for each unique entry, pointing into the original
+           unchanged data array. */
+        std::size_t count = 0;
+        for(std::size_t i = 0; i != data.size()[0]; ++i) {
+            const UnsignedInt index = table.findOrInsert(i);
+            if(index == i) ++count;
+
+            /* Put the (either new or already existing) index into the output
+               index array */
+            indices[i] = index;
+        }
+
+        return count;
+    }
+};
+
+template<class Key> struct RemoveDuplicatesInPlaceInto {
+    std::size_t operator()(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::ArrayView<UnsignedInt>& slots) const {
+        DuplicateTable<Key> table{slots, data};
+
+        /* Go through all entries and insert them into the table. The table
+           doesn't store a copy of the keys, only an index of them. The index
+           is to the original data that we mutate in-place, so extra care
+           needs to be taken to prevent already-inserted keys from getting
+           modified. */
+        std::size_t count = 0;
+        for(std::size_t i = 0; i != data.size()[0]; ++i) {
+            /* First copy the key data to a potentially final no-longer-mutable
+               place (except if the source and target location is the same).
+               Data in [count, i) is already present in the [0, count) range
+               from previous iterations so we aren't overwriting anything. If
+               insertion succeeds, this location will not be touched ever
+               again; if it fails the location isn't used as a key anywhere and
+               so it can be reused next time for a different key.
+
+               Alternatively we could first do a lookup and only then
+               conditionally do a copy() and an insertion, but that means the
+               hash & search would be performed twice, which is never faster
+               than a plain memory copy. */
+            if(i != count)
+                Utility::copy(data[i].asContiguous(), data[count].asContiguous());
+
+            /* Insert the new entry into the table. If it succeeds, the data at
+               `count` are guaranteed to not change anymore. */
+            const UnsignedInt index = table.findOrInsert(count);
+            if(index == count) ++count;
+
+            /* Put the (either new or already existing) index into the output
+               index array */
+            indices[i] = index;
+        }
+
+        return count;
+    }
+};
+
+/* Compared to RemoveDuplicatesInto, the output indices point to the unique
+   items in order of their first occurence instead of to the original data */
+template<class Key> struct RemoveDuplicatesCompactInto {
+    std::size_t operator()(const Containers::StridedArrayView2D<const char>& keys, const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::ArrayView<UnsignedInt>& slots) const {
+        DuplicateTable<Key> table{slots, keys};
+
+        std::size_t count = 0;
+        for(std::size_t i = 0; i != keys.size()[0]; ++i) {
+            const UnsignedInt index = table.findOrInsert(i);
+            indices[i] = index == i ? count++ : indices[index];
+        }
+
+        return count;
+    }
+};
+
+/* Deterministic parallel variant of RemoveDuplicatesInto. The items are
+   first hashed and partitioned by the hash, each partition then gets
+   processed by a single thread. Since items in each partition are ordered by
+   their original index, the first occurence of each unique item in given
+   partition is also its first occurence in the whole array, leading to
+   exactly the same output as the serial version. */
+template<class Key> struct RemoveDuplicatesParallelInto {
+    std::size_t operator()(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const UnsignedInt threadCount) const {
+        const std::size_t dataSize = data.size()[0];
+        const Key key{data.size()[1]};
+
+        /* Split the input into one contiguous chunk per thread for hashing
+           and partitioning. Have a few times more partitions than threads to
+           balance out uneven partition sizes. Partition is taken from the top
+           bits of the 32-bit hash, the table slot from the bottom bits, so
+           the two are independent. */
+        const std::size_t chunkCount = threadCount;
+        std::size_t partitionBits = 0;
+        while((std::size_t{1} << partitionBits) < 4*threadCount && partitionBits < 10)
+            ++partitionBits;
+        const std::size_t partitionCount = std::size_t{1} << partitionBits;
+        const auto partitionFor = [partitionBits](const UnsignedInt hash) {
+            return partitionBits ? hash >> (32 - partitionBits) : 0;
+        };
+
+        /* 1. Hash all items and count how many of them go into which
+           partition, for each chunk separately */
+        Containers::Array<UnsignedInt> hashes{NoInit, dataSize};
+        Containers::Array<std::size_t> chunkPartitionOffsets{ValueInit, chunkCount*partitionCount};
+        Implementation::parallelFor(threadCount, chunkCount, [&](const std::size_t chunk) {
+            const Containers::ArrayView<std::size_t> counts = chunkPartitionOffsets.slice(chunk*partitionCount, (chunk + 1)*partitionCount);
+            for(std::size_t i = chunk*dataSize/chunkCount, end = (chunk + 1)*dataSize/chunkCount; i != end; ++i) {
+                const UnsignedLong hash = key.hash(static_cast<const char*>(data[i].data()));
+                hashes[i] = UnsignedInt(hash ^ (hash >> 32));
+                ++counts[partitionFor(hashes[i])];
+            }
+        });
+
+        /* 2. Turn the counts into offsets. Partitions are stored one after
+           another, within each partition the chunks follow their order in the
+           original array. */
+        Containers::Array<std::size_t> partitionOffsets{NoInit, partitionCount + 1};
+        {
+            std::size_t offset = 0;
+            for(std::size_t partition = 0; partition != partitionCount; ++partition) {
+                partitionOffsets[partition] = offset;
+                for(std::size_t chunk = 0; chunk != chunkCount; ++chunk) {
+                    std::size_t& chunkOffset = chunkPartitionOffsets[chunk*partitionCount + partition];
+                    const std::size_t count = chunkOffset;
+                    chunkOffset = offset;
+                    offset += count;
+                }
+            }
+            partitionOffsets[partitionCount] = offset;
+            CORRADE_INTERNAL_ASSERT(offset == dataSize);
+        }
+
+        /* 3. Scatter item indices into the partitions, preserving their
+           original order */
+        Containers::Array<UnsignedInt> order{NoInit, dataSize};
+        Implementation::parallelFor(threadCount, chunkCount, [&](const std::size_t chunk) {
+            const Containers::ArrayView<std::size_t> offsets = chunkPartitionOffsets.slice(chunk*partitionCount, (chunk + 1)*partitionCount);
+            for(std::size_t i = chunk*dataSize/chunkCount, end = (chunk + 1)*dataSize/chunkCount; i != end; ++i)
+                order[offsets[partitionFor(hashes[i])]++] = i;
+        });
+
+        /* 4. Deduplicate each partition with its own table. The tables are
+           all suballocated from a single allocation. */
+        Containers::Array<std::size_t> tableOffsets{NoInit, partitionCount + 1};
+        tableOffsets[0] = 0;
+        for(std::size_t partition = 0; partition != partitionCount; ++partition)
+            tableOffsets[partition + 1] = tableOffsets[partition] + removeDuplicatesTableSize(partitionOffsets[partition + 1] - partitionOffsets[partition]);
+        Containers::Array<UnsignedInt> slots{NoInit, tableOffsets[partitionCount]};
+        Containers::Array<std::size_t> uniqueCounts{ValueInit, partitionCount};
+        Implementation::parallelFor(threadCount, partitionCount, [&](const std::size_t partition) {
+            DuplicateTable<Key> table{slots.slice(tableOffsets[partition], tableOffsets[partition + 1]), data};
+            std::size_t count = 0;
+            for(std::size_t j = partitionOffsets[partition], end = partitionOffsets[partition + 1]; j != end; ++j) {
+                const UnsignedInt i = order[j];
+                const UnsignedInt index = table.findOrInsert(i, hashes[i]);
+                if(index == i) ++count;
+                indices[i] = index;
+            }
+            uniqueCounts[partition] = count;
+        });
+
+        std::size_t count = 0;
+        for(const std::size_t i: uniqueCounts) count += i;
+        return count;
+    }
+};
+
+}
+
+std::size_t removeDuplicatesTableSize(const std::size_t count) {
+    /* Keep the load factor at most 3/4, round up to a power of two so the
+       slot can be calculated with a mask instead of a division */
+    const std::size_t minSize = count + count/3 + 1;
+    std::size_t size = 1;
+    while(size < minSize) size <<= 1;
+    return size;
+}
+
+std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::ArrayView<UnsignedInt>& table) {
     /* Assuming the second dimension is contiguous so we can calculate the
        hashes easily */
     CORRADE_ASSERT(data.isEmpty()[0] || data.isContiguous<1>(),
@@ -72,29 +333,38 @@ std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char
     const std::size_t dataSize = data.size()[0];
     CORRADE_ASSERT(indices.size() == dataSize,
         "MeshTools::removeDuplicatesInto(): output index array has" << indices.size() << "elements but expected" << dataSize, {});
+    CORRADE_ASSERT(table.size() > dataSize && !(table.size() & (table.size() - 1)),
+        "MeshTools::removeDuplicatesInto(): expected a power-of-two table larger than" << dataSize << "elements but got" << table.size(), {});
 
-    /* Table containing index of first occurrence for each unique entry.
-       Reserving more buckets than necessary (i.e. as if each entry was
-       unique). */
-    std::unordered_map<const void*, UnsignedInt, ArrayHash, ArrayEqual> table{
-        dataSize,
-        ArrayHash{data.size()[1]},
-        ArrayEqual{data.size()[1]}};
+    const std::size_t count = dispatchKeySize<RemoveDuplicatesInto>(data.size()[1], data, indices, table);
+    CORRADE_INTERNAL_ASSERT(dataSize >= count);
+    return count;
+}
 
-    /* Go through all entries */
-    for(std::size_t i = 0; i != dataSize; ++i) {
-        /* Try to insert new entry into the table. The inserted index points
-           into the original unchanged data array. */
-        const Containers::ArrayView<const char> entry = data[i].asContiguous();
-        const auto result = table.emplace(entry, i);
-
-        /* Put the (either new or already existing) index into the output
-           index array */
-        indices[i] = result.first->second;
-    }
+std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+    Containers::Array<UnsignedInt> table{NoInit, removeDuplicatesTableSize(data.size()[0])};
+    return removeDuplicatesInto(data, indices, table);
+}
 
-    CORRADE_INTERNAL_ASSERT(dataSize >= table.size());
-    return table.size();
+std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, UnsignedInt threadCount) {
+    /* Assuming the second dimension is contiguous so we can calculate the
+       hashes easily */
+    CORRADE_ASSERT(data.isEmpty()[0] || data.isContiguous<1>(),
+        "MeshTools::removeDuplicatesInto(): second data view dimension is not contiguous", {});
+
+    const std::size_t dataSize = data.size()[0];
+    CORRADE_ASSERT(indices.size() == dataSize,
+        "MeshTools::removeDuplicatesInto(): output index array has" << indices.size() << "elements but expected" << dataSize, {});
+
+    /* If there's just one thread, there's no point in doing all the
+       partitioning work */
+    threadCount = Implementation::parallelThreadCount(threadCount);
+    if(threadCount == 1)
+        return removeDuplicatesInto(data, indices);
+
+    const std::size_t count = dispatchKeySize<RemoveDuplicatesParallelInto>(data.size()[1], data, indices, threadCount);
+    CORRADE_INTERNAL_ASSERT(dataSize >= count);
+    return count;
 }
 
 std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicates(const Containers::StridedArrayView2D<const char>& data) {
@@ -103,7 +373,7 @@ std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicates(const Co
     return {std::move(indices), size};
 }
 
-std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::ArrayView<UnsignedInt>& table) {
     /* Assuming the second dimension is contiguous so we can calculate the
        hashes easily */
     CORRADE_ASSERT(data.isEmpty()[0] || data.isContiguous<1>(),
@@ -112,47 +382,17 @@ std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<cha
     const std::size_t dataSize = data.size()[0];
     CORRADE_ASSERT(indices.size() == dataSize,
         "MeshTools::removeDuplicatesInPlaceInto(): output index array has" << indices.size() << "elements but expected" << dataSize, {});
+    CORRADE_ASSERT(table.size() > dataSize && !(table.size() & (table.size() - 1)),
+        "MeshTools::removeDuplicatesInPlaceInto(): expected a power-of-two table larger than" << dataSize << "elements but got" << table.size(), {});
 
-    /* Table containing index of first occurrence for each unique entry.
-       Reserving more buckets than necessary (i.e. as if each entry was
-       unique). */
-    std::unordered_map<const void*, UnsignedInt, ArrayHash, ArrayEqual> table{
-        dataSize,
-        ArrayHash{data.size()[1]},
-        ArrayEqual{data.size()[1]}};
-
-    /* Go through all entries and insert them into the table. Because the keys
-       have runtime size, the table doesn't store a copy of the keys, only a
-       reference. The reference is to the original data that we mutate
-       in-place, so extra care needs to be taken to prevent already-inserted
-       keys from getting modified. */
-    for(std::size_t i = 0; i != dataSize; ++i) {
-        /* First copy the key data to a potentially final no-longer-mutable
-           place (except if the source and target location is the same). Data
-           in [table.size()-1, i) is already present in the [0, table.size()-1)
-           range from previous iterations so we aren't overwriting anything. If
-           insertion succeeds, this location will not be touched ever again; if
-           it fails the location isn't used as a key anywhere and so it can be
-           reused next time for a different key.
-
-           Alternatively we could first call find() and only then conditionally
-           do a copy() and emplace(), but that means the hash & search would be
-           performed twice, which is never faster than a plain memory copy. */
-        const Containers::ArrayView<char> dst = data[table.size()].asContiguous();
-        if(i != table.size())
-            Utility::copy(data[i].asContiguous(), dst);
-
-        /* Insert the new entry into the table. If it succeeds, dst is
-           guaranteed to not change anymore. */
-        const auto result = table.emplace(dst, table.size());
-
-        /* Put the (either new or already existing) index into the output index
-           array */
-        indices[i] = result.first->second;
-    }
+    const std::size_t count = dispatchKeySize<RemoveDuplicatesInPlaceInto>(data.size()[1], data, indices, table);
+    CORRADE_INTERNAL_ASSERT(dataSize >= count);
+    return count;
+}
 
-    CORRADE_INTERNAL_ASSERT(dataSize >= table.size());
-    return table.size();
+std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+    Containers::Array<UnsignedInt> table{NoInit, removeDuplicatesTableSize(data.size()[0])};
+    return removeDuplicatesInPlaceInto(data, indices, table);
 }
 
 std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>& data) {
@@ -238,30 +478,25 @@ template<class IndexType, class T> std::size_t removeDuplicatesFuzzyIndexedInPla
        bounds. */
     epsilon = Math::max(epsilon, range/T(~std::size_t{}));
 
-    /* Table containing original vector index for each discretized vector.
-       Reserving more buckets than necessary (i.e. as if each vector was
-       unique). */
+    /* Table slots, sized for the case where each vector is unique; index
+       array that'll be filled in each pass and then used for remapping the
+       `indices`; discretized storage for all table keys. */
     std::size_t dataSize = data.size()[0];
-    std::unordered_map<const void*, UnsignedInt, ArrayHash, ArrayEqual> table{
-        dataSize,
-        ArrayHash{data.size()[1]*sizeof(std::size_t)},
-        ArrayEqual{data.size()[1]*sizeof(std::size_t)}};
-
-    /* Index array that'll be filled in each pass and then used for remapping
-       the `indices`; discretized storage for all map keys. */
+    Containers::Array<UnsignedInt> table{NoInit, removeDuplicatesTableSize(dataSize)};
     Containers::Array<UnsignedInt> remapping{NoInit, dataSize};
     Containers::Array<std::size_t> discretized{NoInit, dataSize*vectorSize};
+    const Containers::StridedArrayView2D<std::size_t> discretized2D{discretized, {dataSize, vectorSize}};
 
     /* First go with original coordinates, then move them by epsilon/2 in each
        dimension. */
     T moveAmount = T(0.0);
     for(std::size_t moving = 0; moving <= vectorSize; ++moving) {
+        /* Take the original vectors and discretize them -- append the move
+           amount to given dimension, subtract the minmal offset and divide by
+           epsilon. */
         for(std::size_t i = 0; i != dataSize; ++i) {
-            /* Take the original vector and discretize it -- append the move
-               amount to given dimension, subtract the minmal offset and divide
-               by epsilon. */
             const Containers::StridedArrayView1D<T> entry = data[i];
-            const Containers::ArrayView<std::size_t> discretizedEntry = discretized.slice(i*vectorSize, (i + 1)*vectorSize);
+            const Containers::StridedArrayView1D<std::size_t> discretizedEntry = discretized2D[i];
             for(std::size_t vi = 0; vi != vectorSize; ++vi) {
                 T c = entry[vi];
                 /* In iteration `0` we're not moving in any dimension, in
@@ -270,23 +505,26 @@ template<class IndexType, class T> std::size_t removeDuplicatesFuzzyIndexedInPla
                 if(vi + 1 == moving) c += moveAmount;
                 discretizedEntry[vi] = (c - offsets[vi])/epsilon;
             }
+        }
 
-            /* Try to insert new entry into the table. The inserted index
-               points into the new data array that has all duplicates removed.
-               This is a similar workflow to removeDuplicatesInPlaceInto() with
-               the only difference that we're remapping an existing index array
-               several times over instead of creating a new one */
-            const auto result = table.emplace(discretizedEntry, table.size());
-
-            /* Add the (either new or already existing) index into the array */
-            remapping[i] = result.first->second;
-
-            /* If this is a new combination, copy the data to new (earlier)
-               position in the array. Data in [table.size()-1, i) are already
-               present in the [0, table.size()-1) range from previous
-               iterations so we aren't overwriting anything. */
-            if(result.second && i != table.size() - 1)
-                Utility::copy(entry, data[table.size() - 1]);
+        /* Insert the discretized entries into the table. The resulting
+           indices point into the new data array that has all duplicates
+           removed. This is a similar workflow to removeDuplicatesInPlaceInto()
+           with the only difference that we're remapping an existing index
+           array several times over instead of creating a new one */
+        const std::size_t count = dispatchKeySize<RemoveDuplicatesCompactInto>(vectorSize*sizeof(std::size_t),
+            Containers::arrayCast<2, char>(discretized2D.prefix(dataSize)),
+            Containers::stridedArrayView(remapping).prefix(dataSize),
+            table.prefix(removeDuplicatesTableSize(dataSize)));
+
+        /* Copy the first occurences of each unique combination to new
+           (earlier) position in the array. Data in [next, i) are already
+           present in the [0, next) range from previous iterations so we aren't
+           overwriting anything. */
+        for(std::size_t i = 0, next = 0; i != dataSize; ++i) {
+            if(remapping[i] != next) continue;
+            if(i != next) Utility::copy(data[i], data[next]);
+            ++next;
         }
 
         /* Remap the resulting index array */
@@ -296,10 +534,8 @@ template<class IndexType, class T> std::size_t removeDuplicatesFuzzyIndexedInPla
            is moving + 1 in the next loop iteration) */
         moveAmount = epsilon/2;
 
-        /* Next time go only through the unique prefix; clear the table for the
-           next pass */
-        dataSize = table.size();
-        table.clear();
+        /* Next time go only through the unique prefix */
+        dataSize = count;
     }
 
     CORRADE_INTERNAL_ASSERT(data.size()[0] >= dataSize);
@@ -374,6 +610,160 @@ std::size_t removeDuplicatesFuzzyInPlaceInto(const Containers::StridedArrayView2
 
 namespace {
 
+/* Grid dimensions are the ones for which neighbor cells get looked up. Three
+   dimensions mean 8 lookups per item, each additional would double it. */
+constexpr std::size_t MaxGridDimensions = 3;
+
+template<class T> std::size_t removeDuplicatesFuzzyGridInPlaceIntoImplementation(const Containers::StridedArrayView2D<T>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const T>& epsilons) {
+    CORRADE_ASSERT(indices.size() == data.size()[0],
+        "MeshTools::removeDuplicatesFuzzyGridInPlaceInto(): output index array has" << indices.size() << "elements but expected" << data.size()[0], {});
+    CORRADE_ASSERT(epsilons.size() == data.size()[1],
+        "MeshTools::removeDuplicatesFuzzyGridInPlaceInto(): expected" << data.size()[1] << "epsilon values but got" << epsilons.size(), {});
+
+    const std::size_t dataSize = data.size()[0];
+    const std::size_t vectorSize = data.size()[1];
+
+    /* Dimensions with a non-zero epsilon are compared fuzzily, the first few
+       of them are used for the grid. Dimensions with a zero epsilon are
+       compared bit-exactly and are a part of the cell key as well. To make
+       the cell coordinates fit into 64 bits, the cell size is at least a
+       tiny fraction of the value range in given dimension. It's also twice
+       the epsilon so all items closer than epsilon are either in the same
+       cell or in a directly neighboring one, and only one of the two
+       neighbors in each dimension needs to be checked. */
+    Containers::Array<T> offsets{NoInit, vectorSize};
+    Containers::Array<T> cellSizes{ValueInit, vectorSize};
+    Containers::Array<UnsignedInt> keyDimensions{NoInit, vectorSize};
+    std::size_t gridDimensionCount = 0;
+    std::size_t keySize = 0;
+    for(std::size_t i = 0; i != vectorSize; ++i) {
+        CORRADE_ASSERT(epsilons[i] >= T(0),
+            "MeshTools::removeDuplicatesFuzzyGridInPlaceInto(): expected non-negative epsilon values but got" << epsilons[i] << "for dimension" << i, {});
+        if(epsilons[i] == T(0)) continue;
+
+        const Math::Range1D<T> minmax = Math::minmax(data.template transposed<0, 1>()[i]);
+        offsets[i] = minmax.min();
+        cellSizes[i] = Math::max(T(2)*epsilons[i], minmax.size()/T(1ull << 40));
+        if(gridDimensionCount < MaxGridDimensions) {
+            keyDimensions[keySize++] = i;
+            ++gridDimensionCount;
+        }
+    }
+    for(std::size_t i = 0; i != vectorSize; ++i)
+        if(epsilons[i] == T(0)) keyDimensions[keySize++] = i;
+
+    const auto matches = [&](const Containers::StridedArrayView1D<const T>& a, const Containers::StridedArrayView1D<const T>& b) {
+        for(std::size_t i = 0; i != vectorSize; ++i) {
+            if(epsilons[i] == T(0) ? std::memcmp(&a[i], &b[i], sizeof(T)) != 0 : Math::abs(a[i] - b[i]) > epsilons[i])
+                return false;
+        }
+        return true;
+    };
+
+    /* Cell key for given item. Grid dimensions are the integer cell
+       coordinates, the exact dimensions are the bit patterns. For grid
+       dimensions also records whether the item is closer to the lower or the
+       upper neighbor cell. */
+    const auto cellKey = [&](const Containers::StridedArrayView1D<const T>& item, const Containers::ArrayView<Long> key, UnsignedInt& upperNeighbors) {
+        upperNeighbors = 0;
+        for(std::size_t k = 0; k != keySize; ++k) {
+            const UnsignedInt i = keyDimensions[k];
+            if(k < gridDimensionCount) {
+                const T cell = (item[i] - offsets[i])/cellSizes[i];
+                key[k] = Long(cell);
+                if(cell - T(key[k]) >= T(0.5)) upperNeighbors |= 1u << k;
+            } else {
+                key[k] = 0;
+                std::memcpy(&key[k], &item[i], sizeof(T));
+            }
+        }
+    };
+
+    const auto hashKey = [keySize](const Long* const key) {
+        UnsignedLong h = 0x9e3779b97f4a7c15ull ^ keySize;
+        for(std::size_t k = 0; k != keySize; ++k) {
+            h = (h ^ UnsignedLong(key[k]))*0xff51afd7ed558ccdull;
+            h ^= h >> 32;
+        }
+        return std::size_t(h);
+    };
+
+    /* Cell table containing the most recently inserted unique item for each
+       cell, the other items in the same cell are linked through `next`.
+       Cell keys are stored for every unique item. */
+    Containers::Array<UnsignedInt> slots{DirectInit, removeDuplicatesTableSize(dataSize), EmptySlot};
+    const std::size_t mask = slots.size() - 1;
+    Containers::Array<UnsignedInt> next{NoInit, dataSize};
+    Containers::Array<Long> uniqueKeys{NoInit, dataSize*keySize};
+    Containers::Array<Long> key{NoInit, keySize};
+    Containers::Array<Long> neighborKey{NoInit, keySize};
+
+    /* Returns slot for given key -- either the one containing the key or an
+       empty one where it should be inserted */
+    const auto findSlot = [&](const Long* const key) {
+        std::size_t slot = hashKey(key) & mask;
+        for(;;) {
+            const UnsignedInt existing = slots[slot];
+            if(existing == EmptySlot || std::memcmp(uniqueKeys.data() + existing*keySize, key, keySize*sizeof(Long)) == 0)
+                return slot;
+            slot = (slot + 1) & mask;
+        }
+    };
+
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != dataSize; ++i) {
+        const Containers::StridedArrayView1D<const T> item = data[i];
+        UnsignedInt upperNeighbors;
+        cellKey(item, key, upperNeighbors);
+
+        /* Look into the cell and the closer neighbor in every grid dimension,
+           pick the earliest unique item that's close enough */
+        UnsignedInt found = EmptySlot;
+        for(UnsignedInt neighbor = 0; neighbor != 1u << gridDimensionCount; ++neighbor) {
+            /* Only the grid dimensions are offset, the exact ones stay */
+            Utility::copy(key, neighborKey);
+            for(std::size_t k = 0; k != gridDimensionCount; ++k)
+                if(neighbor & (1u << k))
+                    neighborKey[k] += upperNeighbors & (1u << k) ? 1 : -1;
+
+            for(UnsignedInt u = slots[findSlot(neighborKey.data())]; u != EmptySlot; u = next[u])
+                if(u < found && matches(data[u], item)) found = u;
+        }
+
+        if(found != EmptySlot) {
+            indices[i] = found;
+            continue;
+        }
+
+        /* Not found, add a new unique item. Data in [count, i) are already
+           present in the [0, count) range from previous iterations so we
+           aren't overwriting anything. */
+        const UnsignedInt unique = count++;
+        if(i != unique)
+            Utility::copy(data[i], data[unique]);
+        Utility::copy(key, uniqueKeys.slice(unique*keySize, (unique + 1)*keySize));
+        const std::size_t slot = findSlot(key.data());
+        next[unique] = slots[slot];
+        slots[slot] = unique;
+        indices[i] = unique;
+    }
+
+    CORRADE_INTERNAL_ASSERT(dataSize >= count);
+    return count;
+}
+
+}
+
+std::size_t removeDuplicatesFuzzyGridInPlaceInto(const Containers::StridedArrayView2D<Float>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Float>& epsilons) {
+    return removeDuplicatesFuzzyGridInPlaceIntoImplementation(data, indices, epsilons);
+}
+
+std::size_t removeDuplicatesFuzzyGridInPlaceInto(const Containers::StridedArrayView2D<Double>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Double>& epsilons) {
+    return removeDuplicatesFuzzyGridInPlaceIntoImplementation(data, indices, epsilons);
+}
+
+namespace {
+
 template<class T> std::size_t removeDuplicatesFuzzyIndexedInPlaceImplementation(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<T>& data, const T epsilon) {
     CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::removeDuplicatesFuzzyIndexedInPlace(): second index view dimension is not contiguous", {});
     if(indices.size()[1] == 4)
@@ -471,6 +861,172 @@ Trade::MeshData removeDuplicates(const Trade::MeshData& data) {
         uniqueVertexCount};
 }
 
+namespace {
+
+template<class T> void remapIndicesParallel(const Containers::StridedArrayView2D<const char>& indices, const Containers::ArrayView<char> output, const Containers::ArrayView<const UnsignedInt> firstOccurence, const Containers::ArrayView<const UnsignedInt> uniqueIndex, const UnsignedInt threadCount) {
+    const Containers::StridedArrayView1D<const T> src = Containers::arrayCast<1, const T>(indices);
+    const Containers::ArrayView<T> dst = Containers::arrayCast<T>(output);
+    Implementation::parallelFor(threadCount, threadCount, [&](const std::size_t chunk) {
+        for(std::size_t i = chunk*src.size()/threadCount, end = (chunk + 1)*src.size()/threadCount; i != end; ++i)
+            dst[i] = uniqueIndex[firstOccurence[src[i]]];
+    });
+}
+
+}
+
+Trade::MeshData removeDuplicates(const Trade::MeshData& data, UnsignedInt threadCount) {
+    /* With just a single thread it's faster to use the in-place algorithm as
+       it doesn't need the extra bookkeeping */
+    threadCount = Implementation::parallelThreadCount(threadCount);
+    if(threadCount == 1)
+        return removeDuplicates(data);
+
+    CORRADE_ASSERT(data.attributeCount(),
+        "MeshTools::removeDuplicates(): can't remove duplicates in an attributeless mesh",
+        (Trade::MeshData{MeshPrimitive::Points, 0}));
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != data.attributeCount(); ++i) {
+        const VertexFormat format = data.attributeFormat(i);
+        CORRADE_ASSERT(!isVertexFormatImplementationSpecific(format),
+            "MeshTools::removeDuplicates(): attribute" << i << "has an implementation-specific format" << reinterpret_cast<void*>(vertexFormatUnwrap(format)),
+            (Trade::MeshData{MeshPrimitive::Points, 0}));
+    }
+    #endif
+    CORRADE_ASSERT(!data.isIndexed() || !isMeshIndexTypeImplementationSpecific(data.indexType()),
+        "MeshTools::removeDuplicates(): mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(data.indexType())),
+        (Trade::MeshData{MeshPrimitive{}, 0}));
+
+    /* Compared to the serial variant the data aren't modified in-place, so
+       they don't need to be owned, only tightly packed */
+    const Trade::MeshData interleaved = interleave(data, {}, InterleaveFlags{});
+    const Containers::StridedArrayView2D<const char> vertexData = MeshTools::interleavedData(interleaved);
+    CORRADE_INTERNAL_ASSERT(vertexData.size()[1] == std::size_t(interleaved.attributeStride(0)));
+
+    /* For every vertex find the index of its first occurence */
+    const std::size_t vertexCount = interleaved.vertexCount();
+    Containers::Array<UnsignedInt> firstOccurence{NoInit, vertexCount};
+    const UnsignedInt uniqueVertexCount = removeDuplicatesInto(vertexData, firstOccurence, threadCount);
+
+    /* Position of each unique vertex in the output is the count of unique
+       vertices before it. To match the serial version, the unique vertices
+       stay in the order of their first occurence. */
+    Containers::Array<UnsignedInt> uniqueIndex{NoInit, vertexCount};
+    for(std::size_t i = 0, next = 0; i != vertexCount; ++i)
+        if(firstOccurence[i] == i) uniqueIndex[i] = next++;
+
+    /* Copy the unique vertices to the output */
+    Containers::Array<char> uniqueVertexData{NoInit, uniqueVertexCount*vertexData.size()[1]};
+    const Containers::StridedArrayView2D<char> uniqueVertices{uniqueVertexData, {uniqueVertexCount, vertexData.size()[1]}};
+    Implementation::parallelFor(threadCount, threadCount, [&](const std::size_t chunk) {
+        for(std::size_t i = chunk*vertexCount/threadCount, end = (chunk + 1)*vertexCount/threadCount; i != end; ++i)
+            if(firstOccurence[i] == i)
+                Utility::copy(vertexData[i], uniqueVertices[uniqueIndex[i]]);
+    });
+
+    /* Remap the original index buffer, or create a new one if there's
+       none */
+    Containers::Array<char> indexData;
+    MeshIndexType indexType;
+    if(interleaved.isIndexed()) {
+        indexType = interleaved.indexType();
+        indexData = Containers::Array<char>{NoInit, interleaved.indexCount()*meshIndexTypeSize(indexType)};
+        if(indexType == MeshIndexType::UnsignedInt)
+            remapIndicesParallel<UnsignedInt>(interleaved.indices(), indexData, firstOccurence, uniqueIndex, threadCount);
+        else if(indexType == MeshIndexType::UnsignedShort)
+            remapIndicesParallel<UnsignedShort>(interleaved.indices(), indexData, firstOccurence, uniqueIndex, threadCount);
+        else if(indexType == MeshIndexType::UnsignedByte)
+            remapIndicesParallel<UnsignedByte>(interleaved.indices(), indexData, firstOccurence, uniqueIndex, threadCount);
+        else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    } else {
+        indexType = MeshIndexType::UnsignedInt;
+        indexData = Containers::Array<char>{NoInit, vertexCount*sizeof(UnsignedInt)};
+        const Containers::ArrayView<UnsignedInt> indices = Containers::arrayCast<UnsignedInt>(indexData);
+        Implementation::parallelFor(threadCount, threadCount, [&](const std::size_t chunk) {
+            for(std::size_t i = chunk*vertexCount/threadCount, end = (chunk + 1)*vertexCount/threadCount; i != end; ++i)
+                indices[i] = uniqueIndex[firstOccurence[i]];
+        });
+    }
+
+    /* Route all attributes to the new vertex data */
+    Containers::Array<Trade::MeshAttributeData> attributeData{interleaved.attributeCount()};
+    for(UnsignedInt i = 0; i != interleaved.attributeCount(); ++i)
+        attributeData[i] = Trade::MeshAttributeData{interleaved.attributeName(i),
+            interleaved.attributeFormat(i),
+            Containers::StridedArrayView1D<void>{uniqueVertexData,
+                uniqueVertexData.data() + interleaved.attributeOffset(i),
+                uniqueVertexCount,
+                interleaved.attributeStride(i)},
+            interleaved.attributeArraySize(i)};
+
+    Trade::MeshIndexData indices{indexType, indexData};
+    return Trade::MeshData{interleaved.primitive(),
+        std::move(indexData), indices,
+        std::move(uniqueVertexData), std::move(attributeData),
+        uniqueVertexCount};
+}
+
+namespace {
+
+/* Epsilon for a floating-point attribute, scaled based on attribute type */
+Float floatAttributeEpsilon(const Trade::MeshAttribute name, const Containers::StridedArrayView2D<const Float>& attribute, const Float floatEpsilon) {
+    Float attributeEpsilon = 0.0f;
+    switch(name) {
+        /* These are usually in [0, 1] (color can be HDR but we definitely
+           don't want the epsilon to be higher there, texture coords can be
+           higher and repeat but the same applies), use epsilon as-is */
+        case Trade::MeshAttribute::TextureCoordinates:
+        case Trade::MeshAttribute::Color:
+            attributeEpsilon = floatEpsilon;
+            break;
+
+        /* Those are all [-1, 1], scale the epsilon 2x */
+        case Trade::MeshAttribute::Normal:
+        case Trade::MeshAttribute::Tangent:
+        case Trade::MeshAttribute::Bitangent:
+            attributeEpsilon = 2.0f*floatEpsilon;
+            break;
+
+        /* These have unbounded range. Do nothing but enumerate all these
+           here to silence warnings about unused enum values. */
+        case Trade::MeshAttribute::Position:
+            break;
+
+        /* These shouldn't be floating point */
+        /* LCOV_EXCL_START */
+        case Trade::MeshAttribute::ObjectId:
+            CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+        /* LCOV_EXCL_STOP */
+    }
+
+    /* For unbounded and custom attributes scale the epsilon by data range */
+    if(attributeEpsilon == 0.0f) {
+        Float range = 0.0f;
+        for(Containers::StridedArrayView1D<const Float> component: attribute.transposed<0, 1>())
+            range = Math::max(Range1D{Math::minmax(component)}.size(), range);
+        attributeEpsilon = floatEpsilon*range;
+    }
+
+    return attributeEpsilon;
+}
+
+template<class T> void remapIndicesInto(const Containers::StridedArrayView2D<const char>& indices, const Containers::ArrayView<const UnsignedInt> mapping, const Containers::ArrayView<char> output) {
+    const Containers::StridedArrayView1D<const T> src = Containers::arrayCast<1, const T>(indices);
+    const Containers::ArrayView<T> dst = Containers::arrayCast<T>(output);
+    for(std::size_t i = 0; i != src.size(); ++i)
+        dst[i] = mapping[src[i]];
+}
+
+/* Doubles. No builtin attributes support those at the moment, so there's just
+   the epsilon scaling based on attribute value range */
+Double doubleAttributeEpsilon(const Containers::StridedArrayView2D<const Double>& attribute, const Double doubleEpsilon) {
+    Double range = 0.0;
+    for(Containers::StridedArrayView1D<const Double> component: attribute.transposed<0, 1>())
+        range = Math::max(Range1Dd{Math::minmax(component)}.size(), range);
+    return doubleEpsilon*range;
+}
+
+}
+
 Trade::MeshData removeDuplicatesFuzzy(const Trade::MeshData& data, const Float floatEpsilon, const Double doubleEpsilon) {
     CORRADE_ASSERT(data.attributeCount(),
         "MeshTools::removeDuplicatesFuzzy(): can't remove duplicates in an attributeless mesh",
@@ -506,63 +1062,19 @@ Trade::MeshData removeDuplicatesFuzzy(const Trade::MeshData& data, const Float f
 
         const Containers::StridedArrayView1D<UnsignedInt> outputIndices = perAttributeIndices[i];
 
-        /* Floats, with special attribute-dependent handling */
+        /* Floats, with special attribute-dependent epsilon scaling */
         const VertexFormat componentFormat = vertexFormatComponentFormat(format);
         if(componentFormat == VertexFormat::Float) {
             const Containers::StridedArrayView2D<Float> attribute = Containers::arrayCast<2, Float>(owned.mutableAttribute(i));
 
-            /* Calculate scaled epsilon */
-            Float attributeEpsilon = 0.0f;
-            switch(owned.attributeName(i)) {
-                /* These are usually in [0, 1] (color can be HDR but we
-                   definitely don't want the epsilon to be higher there,
-                   texture coords can be higher and repeat but the same
-                   applies), use epsilon as-is */
-                case Trade::MeshAttribute::TextureCoordinates:
-                case Trade::MeshAttribute::Color:
-                    attributeEpsilon = floatEpsilon;
-                    break;
-
-                /* Those are all [-1, 1], scale the epsilon 2x */
-                case Trade::MeshAttribute::Normal:
-                case Trade::MeshAttribute::Tangent:
-                case Trade::MeshAttribute::Bitangent:
-                    attributeEpsilon = 2.0f*floatEpsilon;
-                    break;
-
-                /* These have unbounded range. Do nothing but enumerate all
-                   these here to silence warnings about unused enum values. */
-                case Trade::MeshAttribute::Position:
-                    break;
-
-                /* These shouldn't be floating point */
-                /* LCOV_EXCL_START */
-                case Trade::MeshAttribute::ObjectId:
-                    CORRADE_INTERNAL_ASSERT_UNREACHABLE();
-                /* LCOV_EXCL_STOP */
-            }
-
-            /* For unbounded and custom attributes scale the epsilon by data
-               range */
-            if(attributeEpsilon == 0.0f) {
-                Float range = 0.0f;
-                for(Containers::StridedArrayView1D<const Float> component: attribute.transposed<0, 1>())
-                    range = Math::max(Range1D{Math::minmax(component)}.size(), range);
-                attributeEpsilon = floatEpsilon*range;
-            }
-
-            removeDuplicatesFuzzyInPlaceIntoImplementation(attribute, outputIndices, attributeEpsilon);
+            removeDuplicatesFuzzyInPlaceIntoImplementation(attribute, outputIndices, floatAttributeEpsilon(owned.attributeName(i), attribute, floatEpsilon));
 
         /* Doubles. No builtin attributes support those at the moment, so
            there's just the epsilon scaling based on attribute value range */
         } else if(componentFormat == VertexFormat::Double) {
             const Containers::StridedArrayView2D<Double> attribute = Containers::arrayCast<2, Double>(owned.mutableAttribute(i));
 
-            Double range = 0.0;
-            for(Containers::StridedArrayView1D<const Double> component: attribute.transposed<0, 1>())
-                range = Math::max(Range1Dd{Math::minmax(component)}.size(), range);
-
-            removeDuplicatesFuzzyInPlaceIntoImplementation(attribute, outputIndices, doubleEpsilon*range);
+            removeDuplicatesFuzzyInPlaceIntoImplementation(attribute, outputIndices, doubleAttributeEpsilon(attribute, doubleEpsilon));
 
         /* Other attributes (integer, packed, half floats). No fuzzy
            comparison */
@@ -611,4 +1123,117 @@ Trade::MeshData removeDuplicatesFuzzy(const Trade::MeshData& data, const Float f
     return out;
 }
 
+Trade::MeshData removeDuplicatesFuzzyGrid(const Trade::MeshData& data, const Float floatEpsilon, const Double doubleEpsilon) {
+    CORRADE_ASSERT(data.attributeCount(),
+        "MeshTools::removeDuplicatesFuzzyGrid(): can't remove duplicates in an attributeless mesh",
+        (Trade::MeshData{MeshPrimitive::Points, 0}));
+    CORRADE_ASSERT(!data.isIndexed() || !isMeshIndexTypeImplementationSpecific(data.indexType()),
+        "MeshTools::removeDuplicatesFuzzyGrid(): mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(data.indexType())),
+        (Trade::MeshData{MeshPrimitive{}, 0}));
+
+    /* Count dimensions of all attributes combined. Floating-point attributes
+       contribute each of their components, other attributes a single
+       bit-exact dimension. */
+    const UnsignedInt vertexCount = data.vertexCount();
+    std::size_t dimensionCount = 0;
+    for(UnsignedInt i = 0; i != data.attributeCount(); ++i) {
+        const VertexFormat format = data.attributeFormat(i);
+        CORRADE_ASSERT(!isVertexFormatImplementationSpecific(format),
+            "MeshTools::removeDuplicatesFuzzyGrid(): attribute" << i << "has an implementation-specific format" << reinterpret_cast<void*>(vertexFormatUnwrap(format)),
+            (Trade::MeshData{MeshPrimitive::Points, 0}));
+
+        const VertexFormat componentFormat = vertexFormatComponentFormat(format);
+        if(componentFormat == VertexFormat::Float)
+            dimensionCount += data.attribute(i).size()[1]/sizeof(Float);
+        else if(componentFormat == VertexFormat::Double)
+            dimensionCount += data.attribute(i).size()[1]/sizeof(Double);
+        else
+            dimensionCount += 1;
+    }
+
+    /* Gather all attributes into a single Double array so they can be
+       processed in a single pass. Floats are representable in Doubles
+       exactly, non-floating-point attributes are first deduplicated
+       bit-exactly and the index of first occurence is used as the value. */
+    Containers::Array<Double> combined{NoInit, vertexCount*dimensionCount};
+    const Containers::StridedArrayView2D<Double> combinedView{combined, {vertexCount, dimensionCount}};
+    Containers::Array<Double> epsilons{NoInit, dimensionCount};
+    {
+        Containers::Array<UnsignedInt> firstOccurence;
+        std::size_t offset = 0;
+        for(UnsignedInt i = 0; i != data.attributeCount(); ++i) {
+            const VertexFormat componentFormat = vertexFormatComponentFormat(data.attributeFormat(i));
+            if(componentFormat == VertexFormat::Float) {
+                const Containers::StridedArrayView2D<const Float> attribute = Containers::arrayCast<2, const Float>(data.attribute(i));
+                const Float attributeEpsilon = floatAttributeEpsilon(data.attributeName(i), attribute, floatEpsilon);
+                for(std::size_t j = 0; j != attribute.size()[1]; ++j)
+                    epsilons[offset + j] = attributeEpsilon;
+                Math::castInto(attribute, combinedView.slice({0, offset}, {vertexCount, offset + attribute.size()[1]}));
+                offset += attribute.size()[1];
+
+            } else if(componentFormat == VertexFormat::Double) {
+                const Containers::StridedArrayView2D<const Double> attribute = Containers::arrayCast<2, const Double>(data.attribute(i));
+                const Double attributeEpsilon = doubleAttributeEpsilon(attribute, doubleEpsilon);
+                for(std::size_t j = 0; j != attribute.size()[1]; ++j)
+                    epsilons[offset + j] = attributeEpsilon;
+                Utility::copy(attribute, combinedView.slice({0, offset}, {vertexCount, offset + attribute.size()[1]}));
+                offset += attribute.size()[1];
+
+            } else {
+                if(!firstOccurence) firstOccurence = Containers::Array<UnsignedInt>{NoInit, vertexCount};
+                removeDuplicatesInto(data.attribute(i), firstOccurence);
+                const Containers::StridedArrayView1D<Double> dst = combinedView.transposed<0, 1>()[offset];
+                for(UnsignedInt j = 0; j != vertexCount; ++j)
+                    dst[j] = firstOccurence[j];
+                epsilons[offset] = 0.0;
+                offset += 1;
+            }
+        }
+        CORRADE_INTERNAL_ASSERT(offset == dimensionCount);
+    }
+
+    /* Find the unique combinations. The combined data array is modified in
+       the process, but we only need the resulting indices. */
+    Containers::Array<UnsignedInt> uniqueIndices{NoInit, vertexCount};
+    const UnsignedInt uniqueVertexCount = removeDuplicatesFuzzyGridInPlaceInto(combinedView, uniqueIndices, Containers::stridedArrayView(epsilons));
+
+    /* First occurence of each unique vertex is the one that gets copied to
+       the output */
+    Containers::Array<UnsignedInt> uniqueVertices{NoInit, uniqueVertexCount};
+    for(UnsignedInt i = 0, next = 0; i != vertexCount; ++i)
+        if(uniqueIndices[i] == next) uniqueVertices[next++] = i;
+
+    /* Remap the original index buffer, or use the unique indices directly if
+       there's none */
+    Containers::Array<char> indexData;
+    MeshIndexType indexType;
+    if(data.isIndexed()) {
+        indexType = data.indexType();
+        indexData = Containers::Array<char>{NoInit, data.indexCount()*meshIndexTypeSize(indexType)};
+        if(indexType == MeshIndexType::UnsignedInt)
+            remapIndicesInto<UnsignedInt>(data.indices(), uniqueIndices, indexData);
+        else if(indexType == MeshIndexType::UnsignedShort)
+            remapIndicesInto<UnsignedShort>(data.indices(), uniqueIndices, indexData);
+        else if(indexType == MeshIndexType::UnsignedByte)
+            remapIndicesInto<UnsignedByte>(data.indices(), uniqueIndices, indexData);
+        else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    } else {
+        indexType = MeshIndexType::UnsignedInt;
+        indexData = Containers::Array<char>{NoInit, vertexCount*sizeof(UnsignedInt)};
+        Utility::copy(uniqueIndices, Containers::arrayCast<UnsignedInt>(indexData));
+    }
+
+    Trade::MeshData layout = interleavedLayout(data, uniqueVertexCount);
+    Trade::MeshIndexData indices{indexType, indexData};
+    Trade::MeshData out{layout.primitive(),
+        std::move(indexData), indices,
+        layout.releaseVertexData(), layout.releaseAttributeData(), uniqueVertexCount};
+
+    /* Copy the first occurence of each unique vertex to the output */
+    for(UnsignedInt i = 0; i != data.attributeCount(); ++i)
+        duplicateInto(Containers::stridedArrayView(uniqueVertices), data.attribute(i), out.mutableAttribute(i));
+
+    return out;
+}
+
 }}
@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::removeDuplicatesInPlace(), @ref Magnum::MeshTools::removeDuplicatesIndexedInPlace()
+ * @brief Function @ref Magnum::MeshTools::removeDuplicatesInPlace(), @ref Magnum::MeshTools::removeDuplicatesIndexedInPlace(), @ref Magnum::MeshTools::removeDuplicatesTableSize()
  */
 
 #include <utility>
@@ -65,6 +65,14 @@ instead. Usage example:
 See @ref removeDuplicates(const Containers::StridedArrayView2D<const char>&)
 for a variant that doesn't modify the input data in any way but instead returns
 an index array pointing to original data locations.
+
+The implementation uses an open-addressing hash table storing just indices
+into @p data, which means a single allocation of
+@ref removeDuplicatesTableSize() four-byte items. Items that are 12, 16, 24 or
+32 bytes large use a specialized hashing and comparison code path. To avoid
+the allocation altogether, see the
+@ref removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>&, const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::ArrayView<UnsignedInt>&)
+overload.
 @see @ref Corrade::Containers::StridedArrayView::isContiguous(),
     @ref removeDuplicatesInPlaceInto()
 */
@@ -84,6 +92,23 @@ Same as above, except that the index array is not allocated but put into
 */
 MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices);
 
+/**
+@brief Remove duplicate data from given array in-place into given output index array using a caller-provided table
+@param[in,out] data     Data array, duplicate items will be cut away with order
+    preserved
+@param[out]    indices  Where to put the resulting index array
+@param[out]    table    Scratch memory for the hash table
+@return Size of unique prefix in the cleaned up @p data array
+@m_since_latest
+
+Same as above, except that the internal hash table isn't allocated but put
+into @p table instead. Expects that @p table size is a power of two larger than
+size of @p data, use @ref removeDuplicatesTableSize() to get a size that
+matches the default. The memory can be reused for subsequent calls, contents of
+it after the operation are unspecified.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::ArrayView<UnsignedInt>& table);
+
 /**
 @brief Remove duplicate data from given array
 @param[in] data     Data array
@@ -110,6 +135,57 @@ makes an index array pointing to original data locations.
 */
 MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices);
 
+/**
+@brief Remove duplicate data from given array into given output index array using a caller-provided table
+@param[in]  data    Data array
+@param[out] indices Where to put the resulting index array
+@param[out] table   Scratch memory for the hash table
+@return Count of unique items in the original @p data array
+@m_since_latest
+
+Same as above, except that the internal hash table isn't allocated but put
+into @p table instead. Expects that @p table size is a power of two larger than
+size of @p data, use @ref removeDuplicatesTableSize() to get a size that
+matches the default. The memory can be reused for subsequent calls, contents of
+it after the operation are unspecified.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::ArrayView<UnsignedInt>& table);
+
+/**
+@brief Remove duplicate data from given array into given output index array using multiple threads
+@param[in]  data        Data array
+@param[out] indices     Where to put the resulting index array
+@param[in]  threadCount Count of threads to use. If @cpp 0 @ce, uses all
+    hardware threads.
+@return Count of unique items in the original @p data array
+@m_since_latest
+
+Same as @ref removeDuplicatesInto(const Containers::StridedArrayView2D<const char>&, const Containers::StridedArrayView1D<UnsignedInt>&),
+except that the work is split across @p threadCount threads. The items are
+hashed and partitioned by the hash in parallel, each partition is then
+deduplicated on a single thread. The output is exactly the same as with the
+single-threaded variant, independently of the thread count. If the platform
+doesn't support threads or @p threadCount is @cpp 1 @ce, the single-threaded
+variant is called directly. Compared to it, this function additionally
+allocates three four-byte values for every item.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, UnsignedInt threadCount);
+
+/**
+@brief Hash table size used for duplicate removal
+@m_since_latest
+
+Size of the hash table allocated internally by @ref removeDuplicatesInto(),
+@ref removeDuplicatesInPlaceInto() and related APIs for given count of
+@p count items. The returned value is always a power of two and larger than
+@p count, keeping the load factor of the table at most @cpp 0.75 @ce. Use it
+to size scratch memory passed to
+@ref removeDuplicatesInto(const Containers::StridedArrayView2D<const char>&, const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::ArrayView<UnsignedInt>&)
+or
+@ref removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>&, const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::ArrayView<UnsignedInt>&).
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesTableSize(std::size_t count);
+
 /**
 @brief Remove duplicates from indexed data in-place
 @param[in,out] indices  Index array, which will get remapped to list just
@@ -202,6 +278,44 @@ MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyInPlaceInto(const Conta
  */
 MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyInPlaceInto(const Containers::StridedArrayView2D<Double>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, Double epsilon = Math::TypeTraits<Double>::epsilon());
 
+/**
+@brief Remove duplicate data from given array using fuzzy comparison on a grid in-place into given output index array
+@param[in,out] data Data array, duplicate items will be cut away with order
+    preserved
+@param[out] indices Where to put the resulting index array
+@param[in] epsilons Epsilon value for each dimension. Items that are closer
+    than this distance in all dimensions will be melt together.
+@return Size of unique prefix in the cleaned up @p data array
+@m_since_latest
+
+Alternative to @ref removeDuplicatesFuzzyInPlaceInto() that handles all
+dimensions in a single pass using a spatial hash. Each item is merged with the
+first preceding unique item that's closer than the corresponding epsilon in
+every dimension, or kept as unique if there's no such item. Compared to
+@ref removeDuplicatesFuzzyInPlaceInto(), which discretizes the data into
+buckets and thus has to repeat the process once for every dimension, close
+items are merged even if they lie on different sides of a bucket boundary, and
+each dimension can have a different epsilon.
+
+The first three dimensions with a non-zero epsilon define a grid with cell
+size of twice the epsilon, and for each item its cell and the closer
+neighboring cell in each of the three dimensions get looked up, resulting in
+eight lookups per item. Dimensions with a zero epsilon are compared bit-exactly
+and used for hashing as well. Remaining dimensions are only used for the
+comparison, so it's beneficial to have the most discriminative dimensions
+first. Expects that @p indices has the same size as @p data and @p epsilons
+have the same size as the second dimension of @p data and contain non-negative
+values. The data are expected to not contain NaNs.
+@see @ref removeDuplicatesFuzzyGrid()
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyGridInPlaceInto(const Containers::StridedArrayView2D<Float>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Float>& epsilons);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyGridInPlaceInto(const Containers::StridedArrayView2D<Double>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Double>& epsilons);
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 /**
 @brief Remove duplicate data from a STL vector using fuzzy comparison in-place
@@ -311,6 +425,23 @@ copies and interleaves the input vertex and index data.
 */
 MAGNUM_MESHTOOLS_EXPORT Trade::MeshData removeDuplicates(const Trade::MeshData& data);
 
+/**
+@brief Remove mesh data duplicates using multiple threads
+@param data         Input mesh data
+@param threadCount  Count of threads to use. If @cpp 0 @ce, uses all hardware
+    threads.
+@m_since_latest
+
+Produces exactly the same output as
+@ref removeDuplicates(const Trade::MeshData&), independently of the thread
+count, but uses
+@ref removeDuplicatesInto(const Containers::StridedArrayView2D<const char>&, const Containers::StridedArrayView1D<UnsignedInt>&, UnsignedInt)
+to find the unique vertices and then copies them and remaps the index buffer
+in parallel as well. If the platform doesn't support threads or
+@p threadCount is @cpp 1 @ce, delegates to the single-threaded variant.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData removeDuplicates(const Trade::MeshData& data, UnsignedInt threadCount);
+
 /**
 @brief Remove mesh data duplicates with fuzzy comparison for floating-point attributes
 @m_since{2020,06}
@@ -324,6 +455,27 @@ otherwise it's scaled to calculated value range.
 */
 MAGNUM_MESHTOOLS_EXPORT Trade::MeshData removeDuplicatesFuzzy(const Trade::MeshData& data, Float floatEpsilon = Math::TypeTraits<Float>::epsilon(), Double doubleEpsilon = Math::TypeTraits<Double>::epsilon());
 
+/**
+@brief Remove mesh data duplicates with single-pass fuzzy comparison on a grid
+@m_since_latest
+
+Compared to @ref removeDuplicatesFuzzy(const Trade::MeshData&, Float, Double),
+all attributes are processed together in a single pass of
+@ref removeDuplicatesFuzzyGridInPlaceInto() instead of deduplicating each
+attribute separately and then combining the results. Epsilon values for
+floating-point attributes are scaled the same way as in
+@ref removeDuplicatesFuzzy(const Trade::MeshData&, Float, Double), other
+attributes are compared bit-exactly. Since the grid is built from the first
+three floating-point components, it's beneficial to have the
+@ref Trade::MeshAttribute::Position attribute first. The input data are not
+modified in any way. If the mesh is indexed, the original index type is
+preserved, otherwise the mesh gets @ref MeshIndexType::UnsignedInt indices.
+The resulting mesh is always interleaved and owned. An index buffer, if
+present, is expected to not have an implementation-specific index type. All
+attributes are expected to not have an implementation-specific format.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData removeDuplicatesFuzzyGrid(const Trade::MeshData& data, Float floatEpsilon = Math::TypeTraits<Float>::epsilon(), Double doubleEpsilon = Math::TypeTraits<Double>::epsilon());
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 template<class Vector> std::vector<UnsignedInt> removeDuplicates(std::vector<Vector>& data, typename Vector::Type epsilon) {
     /* A trivial index array that'll be remapped and returned after */
@@ -0,0 +1,493 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Simplify.h"
+
+#include <cmath>
+#include <algorithm>
+#include <initializer_list>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/BoundingVolume.h"
+#include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/OptimizeVertexFetch.h"
+#include "Magnum/MeshTools/Reference.h"
+#include "Magnum/MeshTools/RemoveDuplicates.h"
+#include "Magnum/MeshTools/Implementation/Tipsify.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Symmetric 4x4 matrix of accumulated plane equations together with the
+   total weight of the planes. Using doubles as summing many nearly coplanar
+   planes loses a lot of precision otherwise. */
+struct Quadric {
+    Double a00, a01, a02, a03, a11, a12, a13, a22, a23, a33;
+    Double weight;
+};
+
+void addPlane(Quadric& q, const Vector3d& normal, const Double distance, const Double weight) {
+    q.a00 += weight*normal.x()*normal.x();
+    q.a01 += weight*normal.x()*normal.y();
+    q.a02 += weight*normal.x()*normal.z();
+    q.a03 += weight*normal.x()*distance;
+    q.a11 += weight*normal.y()*normal.y();
+    q.a12 += weight*normal.y()*normal.z();
+    q.a13 += weight*normal.y()*distance;
+    q.a22 += weight*normal.z()*normal.z();
+    q.a23 += weight*normal.z()*distance;
+    q.a33 += weight*distance*distance;
+    q.weight += weight;
+}
+
+void addQuadric(Quadric& a, const Quadric& b) {
+    a.a00 += b.a00;
+    a.a01 += b.a01;
+    a.a02 += b.a02;
+    a.a03 += b.a03;
+    a.a11 += b.a11;
+    a.a12 += b.a12;
+    a.a13 += b.a13;
+    a.a22 += b.a22;
+    a.a23 += b.a23;
+    a.a33 += b.a33;
+    a.weight += b.weight;
+}
+
+/* Weighted mean squared distance of a point to planes in a sum of two
+   quadrics */
+Double quadricError(const Quadric& a, const Quadric& b, const Vector3d& p) {
+    const Double weight = a.weight + b.weight;
+    if(weight == 0.0) return 0.0;
+
+    const Double x = p.x(), y = p.y(), z = p.z();
+    const Double error =
+        (a.a00 + b.a00)*x*x + (a.a11 + b.a11)*y*y + (a.a22 + b.a22)*z*z +
+        2.0*((a.a01 + b.a01)*x*y + (a.a02 + b.a02)*x*z + (a.a12 + b.a12)*y*z) +
+        2.0*((a.a03 + b.a03)*x + (a.a13 + b.a13)*y + (a.a23 + b.a23)*z) +
+        (a.a33 + b.a33);
+    /* Can get slightly negative due to rounding errors */
+    return Math::max(error/weight, 0.0);
+}
+
+enum class VertexKind: UnsignedByte {
+    /* Can be collapsed to any neighbor */
+    Interior,
+    /* Can be collapsed only along a border edge */
+    Border,
+    /* Can't be collapsed at all */
+    Locked
+};
+
+/* Border edges get additional planes perpendicular to the triangle to keep
+   the border shape, weighted higher than the triangle planes as the border
+   is usually more visible than small bumps on the surface */
+constexpr Double BorderWeight = 10.0;
+
+inline UnsignedLong edgeKey(UnsignedInt a, UnsignedInt b) {
+    if(a > b) std::swap(a, b);
+    return (UnsignedLong(a) << 32)|b;
+}
+
+template<class T> Containers::Pair<std::size_t, Float> simplifyInPlaceImplementation(const Containers::StridedArrayView1D<T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<const Float>& attributes, const Containers::StridedArrayView1D<const Float>& attributeWeights, const std::size_t targetIndexCount, const Float targetError, const SimplifyFlags flags) {
+    CORRADE_ASSERT(!(indices.size()%3),
+        "MeshTools::simplifyInPlace(): index count not divisible by 3", {});
+    const UnsignedInt vertexCount = positions.size();
+    #ifndef CORRADE_NO_ASSERT
+    for(const T index: indices)
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::simplifyInPlace(): index" << UnsignedInt(index) << "out of range for" << vertexCount << "vertices", {});
+    #endif
+
+    if(indices.isEmpty()) return {0, 0.0f};
+
+    /* Scale the positions so the largest dimension of the bounding box is 1,
+       making the error independent of mesh size */
+    Containers::Array<Vector3d> scaledPositions{NoInit, vertexCount};
+    {
+        const Range3D range = boundingRange(positions);
+        const Float maxSize = range.size().max();
+        const Double scale = maxSize > 0.0f ? 1.0/maxSize : 1.0;
+        for(UnsignedInt i = 0; i != vertexCount; ++i)
+            scaledPositions[i] = Vector3d{positions[i] - range.min()}*scale;
+    }
+
+    /* Vertices with the same position but different attributes would get
+       separated when collapsed independently, creating cracks. Lock them. */
+    Containers::Array<VertexKind> kinds{DirectInit, vertexCount, VertexKind::Interior};
+    {
+        Containers::Array<UnsignedInt> firstOccurence{NoInit, vertexCount};
+        removeDuplicatesInto(Containers::arrayCast<2, const char>(positions), firstOccurence);
+        for(UnsignedInt i = 0; i != vertexCount; ++i) if(firstOccurence[i] != i) {
+            kinds[i] = VertexKind::Locked;
+            kinds[firstOccurence[i]] = VertexKind::Locked;
+        }
+    }
+
+    /* Find border edges, i.e. edges used by just a single triangle, by
+       sorting all edges and counting the runs. Vertices of edges used by more
+       than two triangles are locked as there's no sane way to collapse
+       those. */
+    Containers::Array<UnsignedLong> borderEdges;
+    {
+        Containers::Array<UnsignedLong> edges;
+        arrayReserve(edges, indices.size());
+        for(std::size_t i = 0; i != indices.size(); i += 3) {
+            for(std::size_t j = 0; j != 3; ++j) {
+                const UnsignedInt a = indices[i + j];
+                const UnsignedInt b = indices[i + (j + 1)%3];
+                if(a != b) arrayAppend(edges, edgeKey(a, b));
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+
+        for(std::size_t i = 0; i != edges.size(); ) {
+            std::size_t j = i + 1;
+            while(j != edges.size() && edges[j] == edges[i]) ++j;
+
+            const UnsignedInt a = edges[i] >> 32;
+            const UnsignedInt b = edges[i] & 0xffffffffu;
+            if(j - i == 1) {
+                arrayAppend(borderEdges, edges[i]);
+                for(const UnsignedInt v: {a, b}) {
+                    if(kinds[v] == VertexKind::Interior)
+                        kinds[v] = flags & SimplifyFlag::LockBorder ? VertexKind::Locked : VertexKind::Border;
+                }
+            } else if(j - i > 2) {
+                kinds[a] = VertexKind::Locked;
+                kinds[b] = VertexKind::Locked;
+            }
+
+            i = j;
+        }
+    }
+    const auto isBorderEdge = [&borderEdges](UnsignedInt a, UnsignedInt b) {
+        return std::binary_search(borderEdges.begin(), borderEdges.end(), edgeKey(a, b));
+    };
+
+    /* Accumulate planes of all triangles, weighted by their area, into
+       vertex quadrics. Border edges get additional perpendicular planes. */
+    Containers::Array<Quadric> quadrics{ValueInit, vertexCount};
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        const UnsignedInt triangle[]{indices[i], indices[i + 1], indices[i + 2]};
+        const Vector3d& a = scaledPositions[triangle[0]];
+        const Vector3d cross = Math::cross(scaledPositions[triangle[1]] - a, scaledPositions[triangle[2]] - a);
+        const Double length = cross.length();
+        if(length == 0.0) continue;
+
+        const Vector3d normal = cross/length;
+        const Double distance = -Math::dot(normal, a);
+        for(const UnsignedInt v: triangle)
+            addPlane(quadrics[v], normal, distance, length*0.5);
+
+        if(flags & SimplifyFlag::LockBorder) continue;
+        for(std::size_t j = 0; j != 3; ++j) {
+            const UnsignedInt from = triangle[j];
+            const UnsignedInt to = triangle[(j + 1)%3];
+            if(!isBorderEdge(from, to)) continue;
+
+            const Vector3d edge = scaledPositions[to] - scaledPositions[from];
+            const Vector3d borderNormal = Math::cross(edge, normal).normalized();
+            const Double borderDistance = -Math::dot(borderNormal, scaledPositions[from]);
+            for(const UnsignedInt v: {from, to})
+                addPlane(quadrics[v], borderNormal, borderDistance, edge.dot()*BorderWeight);
+        }
+    }
+
+    const auto attributeError = [&attributes, &attributeWeights](UnsignedInt a, UnsignedInt b) {
+        Double error = 0.0;
+        for(std::size_t i = 0; i != attributeWeights.size(); ++i) {
+            const Double difference = attributes[a][i] - attributes[b][i];
+            error += attributeWeights[i]*difference*difference;
+        }
+        return error;
+    };
+
+    struct Collapse {
+        UnsignedInt from, to;
+        Double error;
+    };
+
+    Containers::Array<UnsignedInt> remap{NoInit, vertexCount};
+    for(UnsignedInt i = 0; i != vertexCount; ++i) remap[i] = i;
+    Containers::Array<bool> touched{NoInit, vertexCount};
+    Containers::Array<Collapse> collapses;
+    Containers::Array<UnsignedInt> liveTriangleCount, neighborOffset, neighbors;
+
+    const Double maxError = Double(targetError)*Double(targetError);
+    Double error = 0.0;
+    std::size_t indexCount = indices.size();
+    for(;;) {
+        /* Apply collapses from the previous iteration (or none in the first
+           iteration), dropping triangles that became degenerate */
+        std::size_t out = 0;
+        for(std::size_t i = 0; i != indexCount; i += 3) {
+            const UnsignedInt a = remap[indices[i]];
+            const UnsignedInt b = remap[indices[i + 1]];
+            const UnsignedInt c = remap[indices[i + 2]];
+            if(a == b || b == c || c == a) continue;
+            indices[out++] = a;
+            indices[out++] = b;
+            indices[out++] = c;
+        }
+        indexCount = out;
+        for(const Collapse& collapse: collapses)
+            remap[collapse.from] = collapse.from;
+
+        if(indexCount <= targetIndexCount) break;
+
+        const Containers::StridedArrayView1D<const T> currentIndices = indices.prefix(indexCount);
+        Implementation::buildAdjacency(currentIndices, vertexCount, liveTriangleCount, neighborOffset, neighbors);
+
+        /* Find the cheapest collapse for each vertex */
+        arrayResize(collapses, 0);
+        for(UnsignedInt from = 0; from != vertexCount; ++from) {
+            if(kinds[from] == VertexKind::Locked || !liveTriangleCount[from])
+                continue;
+
+            Collapse best{from, from, 0.0};
+            for(std::size_t i = neighborOffset[from]; i != neighborOffset[from + 1]; ++i) {
+                for(std::size_t j = 0; j != 3; ++j) {
+                    const UnsignedInt to = currentIndices[neighbors[i]*3 + j];
+                    if(to == from) continue;
+                    if(kinds[from] == VertexKind::Border && !isBorderEdge(from, to))
+                        continue;
+
+                    const Double collapseError = quadricError(quadrics[from], quadrics[to], scaledPositions[to]) + attributeError(from, to);
+                    if(best.to == from || collapseError < best.error)
+                        best = {from, to, collapseError};
+                }
+            }
+
+            if(best.to != from && best.error <= maxError)
+                arrayAppend(collapses, best);
+        }
+
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) {
+            return a.error < b.error || (a.error == b.error && a.from < b.from);
+        });
+
+        /* Perform the cheapest collapses. Every collapse removes usually two
+           triangles, limit the count to not go too much over the target.
+           Neighborhood of a collapsed vertex changes, so all vertices in it
+           are excluded from further collapses in this iteration. */
+        const std::size_t maxCollapseCount = Math::max((indexCount - targetIndexCount)/6, std::size_t{1});
+        std::size_t collapseCount = 0;
+        for(std::size_t i = 0; i != vertexCount; ++i) touched[i] = false;
+        for(const Collapse& collapse: collapses) {
+            if(collapseCount == maxCollapseCount) break;
+            if(touched[collapse.from] || touched[collapse.to]) continue;
+
+            /* Reject the collapse if it would flip any remaining triangle */
+            bool flips = false;
+            for(std::size_t i = neighborOffset[collapse.from]; i != neighborOffset[collapse.from + 1] && !flips; ++i) {
+                const std::size_t triangle = neighbors[i]*3;
+                UnsignedInt vertices[]{currentIndices[triangle], currentIndices[triangle + 1], currentIndices[triangle + 2]};
+                if(vertices[0] == collapse.to || vertices[1] == collapse.to || vertices[2] == collapse.to)
+                    continue;
+
+                const Vector3d before = Math::cross(
+                    scaledPositions[vertices[1]] - scaledPositions[vertices[0]],
+                    scaledPositions[vertices[2]] - scaledPositions[vertices[0]]);
+                for(UnsignedInt& v: vertices)
+                    if(v == collapse.from) v = collapse.to;
+                const Vector3d after = Math::cross(
+                    scaledPositions[vertices[1]] - scaledPositions[vertices[0]],
+                    scaledPositions[vertices[2]] - scaledPositions[vertices[0]]);
+                if(Math::dot(before, after) <= 0.0 && before.dot() > 0.0)
+                    flips = true;
+            }
+            if(flips) continue;
+
+            for(std::size_t i = neighborOffset[collapse.from]; i != neighborOffset[collapse.from + 1]; ++i)
+                for(std::size_t j = 0; j != 3; ++j)
+                    touched[currentIndices[neighbors[i]*3 + j]] = true;
+
+            remap[collapse.from] = collapse.to;
+            addQuadric(quadrics[collapse.to], quadrics[collapse.from]);
+            error = Math::max(error, collapse.error);
+            /* Keep the performed collapses at the front so the remap can be
+               reset after applying them */
+            collapses[collapseCount++] = collapse;
+        }
+
+        if(!collapseCount) break;
+        arrayResize(collapses, collapseCount);
+    }
+
+    return {indexCount, Float(std::sqrt(error))};
+}
+
+template<class T> Containers::Pair<std::size_t, Float> simplifyInPlaceAttributesImplementation(const Containers::StridedArrayView1D<T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<const Float>& attributes, const Containers::StridedArrayView1D<const Float>& attributeWeights, const std::size_t targetIndexCount, const Float targetError, const SimplifyFlags flags) {
+    CORRADE_ASSERT(attributes.size()[0] == positions.size(),
+        "MeshTools::simplifyInPlace(): expected" << positions.size() << "attribute items but got" << attributes.size()[0], {});
+    CORRADE_ASSERT(attributeWeights.size() == attributes.size()[1],
+        "MeshTools::simplifyInPlace(): expected" << attributes.size()[1] << "attribute weights but got" << attributeWeights.size(), {});
+    return simplifyInPlaceImplementation(indices, positions, attributes, attributeWeights, targetIndexCount, targetError, flags);
+}
+
+template<class T> void copyIndicesInto(const Containers::ArrayView<const UnsignedInt> indices, const Containers::ArrayView<char> out) {
+    const Containers::ArrayView<T> outT = Containers::arrayCast<T>(out);
+    for(std::size_t i = 0; i != indices.size(); ++i) outT[i] = indices[i];
+}
+
+}
+
+Containers::Pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<const Float>& attributes, const Containers::StridedArrayView1D<const Float>& attributeWeights, const std::size_t targetIndexCount, const Float targetError, const SimplifyFlags flags) {
+    return simplifyInPlaceAttributesImplementation(indices, positions, attributes, attributeWeights, targetIndexCount, targetError, flags);
+}
+
+Containers::Pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<const Float>& attributes, const Containers::StridedArrayView1D<const Float>& attributeWeights, const std::size_t targetIndexCount, const Float targetError, const SimplifyFlags flags) {
+    return simplifyInPlaceAttributesImplementation(indices, positions, attributes, attributeWeights, targetIndexCount, targetError, flags);
+}
+
+Containers::Pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<const Float>& attributes, const Containers::StridedArrayView1D<const Float>& attributeWeights, const std::size_t targetIndexCount, const Float targetError, const SimplifyFlags flags) {
+    return simplifyInPlaceAttributesImplementation(indices, positions, attributes, attributeWeights, targetIndexCount, targetError, flags);
+}
+
+Containers::Pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const std::size_t targetIndexCount, const Float targetError, const SimplifyFlags flags) {
+    return simplifyInPlaceImplementation(indices, positions, {}, {}, targetIndexCount, targetError, flags);
+}
+
+Containers::Pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const std::size_t targetIndexCount, const Float targetError, const SimplifyFlags flags) {
+    return simplifyInPlaceImplementation(indices, positions, {}, {}, targetIndexCount, targetError, flags);
+}
+
+Containers::Pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const std::size_t targetIndexCount, const Float targetError, const SimplifyFlags flags) {
+    return simplifyInPlaceImplementation(indices, positions, {}, {}, targetIndexCount, targetError, flags);
+}
+
+Trade::MeshData simplify(const Trade::MeshData& mesh, const std::size_t targetIndexCount, const Float targetError, const SimplifyFlags flags, const Float normalWeight, const Float textureCoordinateWeight) {
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::simplify(): expected" << MeshPrimitive::Triangles << "but got" << mesh.primitive(),
+        (Trade::MeshData{MeshPrimitive{}, 0}));
+    CORRADE_ASSERT(mesh.isIndexed(),
+        "MeshTools::simplify(): the mesh is not indexed",
+        (Trade::MeshData{MeshPrimitive{}, 0}));
+    CORRADE_ASSERT(!isMeshIndexTypeImplementationSpecific(mesh.indexType()),
+        "MeshTools::simplify(): mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(mesh.indexType())),
+        (Trade::MeshData{MeshPrimitive{}, 0}));
+    CORRADE_ASSERT(mesh.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::simplify(): the mesh has no positions",
+        (Trade::MeshData{MeshPrimitive{}, 0}));
+
+    const UnsignedInt vertexCount = mesh.vertexCount();
+    const Containers::Array<Vector3> positions = mesh.positions3DAsArray();
+
+    /* Gather the normals and texture coordinates, if present and not
+       ignored, into a single array */
+    const bool hasNormals = normalWeight != 0.0f && mesh.hasAttribute(Trade::MeshAttribute::Normal);
+    const bool hasTextureCoordinates = textureCoordinateWeight != 0.0f && mesh.hasAttribute(Trade::MeshAttribute::TextureCoordinates);
+    const std::size_t attributeCount = (hasNormals ? 3 : 0) + (hasTextureCoordinates ? 2 : 0);
+    Containers::Array<Float> attributes{NoInit, vertexCount*attributeCount};
+    const Containers::StridedArrayView2D<Float> attributeView{attributes, {vertexCount, attributeCount}};
+    Containers::Array<Float> attributeWeights{NoInit, attributeCount};
+    std::size_t offset = 0;
+    if(hasNormals) {
+        const Containers::Array<Vector3> normals = mesh.normalsAsArray();
+        for(UnsignedInt i = 0; i != vertexCount; ++i)
+            for(std::size_t j = 0; j != 3; ++j)
+                attributeView[i][offset + j] = normals[i][j];
+        for(std::size_t j = 0; j != 3; ++j)
+            attributeWeights[offset + j] = normalWeight;
+        offset += 3;
+    }
+    if(hasTextureCoordinates) {
+        const Containers::Array<Vector2> textureCoordinates = mesh.textureCoordinates2DAsArray();
+        for(UnsignedInt i = 0; i != vertexCount; ++i)
+            for(std::size_t j = 0; j != 2; ++j)
+                attributeView[i][offset + j] = textureCoordinates[i][j];
+        for(std::size_t j = 0; j != 2; ++j)
+            attributeWeights[offset + j] = textureCoordinateWeight;
+        offset += 2;
+    }
+    CORRADE_INTERNAL_ASSERT(offset == attributeCount);
+
+    /* Simplify the indices and move the used vertices to the front */
+    Containers::Array<UnsignedInt> indices = mesh.indicesAsArray();
+    const std::size_t indexCount = simplifyInPlaceImplementation(Containers::StridedArrayView1D<UnsignedInt>{indices}, Containers::StridedArrayView1D<const Vector3>{positions}, attributeView, Containers::StridedArrayView1D<const Float>{attributeWeights}, targetIndexCount, targetError, flags).first();
+    Containers::Array<UnsignedInt> mapping{NoInit, vertexCount};
+    const UnsignedInt usedVertexCount = optimizeVertexFetchInPlaceInto(Containers::stridedArrayView(indices).prefix(indexCount), mapping);
+
+    /* Mapping is from old to new vertices, invert it to copy the used
+       vertices to the output */
+    Containers::Array<UnsignedInt> usedVertices{NoInit, usedVertexCount};
+    for(UnsignedInt i = 0; i != vertexCount; ++i)
+        if(mapping[i] < usedVertexCount) usedVertices[mapping[i]] = i;
+
+    const MeshIndexType indexType = mesh.indexType();
+    Containers::Array<char> indexData{NoInit, indexCount*meshIndexTypeSize(indexType)};
+    if(indexType == MeshIndexType::UnsignedInt)
+        copyIndicesInto<UnsignedInt>(indices.prefix(indexCount), indexData);
+    else if(indexType == MeshIndexType::UnsignedShort)
+        copyIndicesInto<UnsignedShort>(indices.prefix(indexCount), indexData);
+    else if(indexType == MeshIndexType::UnsignedByte)
+        copyIndicesInto<UnsignedByte>(indices.prefix(indexCount), indexData);
+    else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+    Trade::MeshData layout = interleavedLayout(mesh, usedVertexCount);
+    Trade::MeshIndexData outIndices{indexType, indexData};
+    Trade::MeshData out{layout.primitive(),
+        std::move(indexData), outIndices,
+        layout.releaseVertexData(), layout.releaseAttributeData(), usedVertexCount};
+
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i)
+        duplicateInto(Containers::stridedArrayView(usedVertices), mesh.attribute(i), out.mutableAttribute(i));
+
+    return out;
+}
+
+Containers::Array<Trade::MeshData> simplifyLods(const Trade::MeshData& mesh, const UnsignedInt levelCount, const Float indexCountRatio, const Float targetError, const SimplifyFlags flags, const Float normalWeight, const Float textureCoordinateWeight) {
+    CORRADE_ASSERT(levelCount,
+        "MeshTools::simplifyLods(): expected non-zero level count", {});
+    CORRADE_ASSERT(indexCountRatio > 0.0f && indexCountRatio < 1.0f,
+        "MeshTools::simplifyLods(): expected index count ratio to be between 0 and 1 but got" << indexCountRatio, {});
+
+    Containers::Array<Trade::MeshData> out;
+    arrayReserve(out, levelCount);
+    arrayAppend(out, owned(mesh));
+    while(out.size() != levelCount) {
+        const Trade::MeshData& previous = out.back();
+        Trade::MeshData level = simplify(previous, std::size_t(previous.indexCount()*indexCountRatio), targetError, flags, normalWeight, textureCoordinateWeight);
+        if(level.indexCount() == previous.indexCount()) break;
+        arrayAppend(out, std::move(level));
+    }
+
+    /* Convert back to a default deleter to make the arrays usable in
+       plugins */
+    arrayShrink(out, DefaultInit);
+    return out;
+}
+
+}}
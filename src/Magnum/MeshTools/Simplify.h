@@ -0,0 +1,211 @@
+#ifndef Magnum_MeshTools_Simplify_h
+#define Magnum_MeshTools_Simplify_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::simplifyInPlace(), @ref Magnum::MeshTools::simplify(), @ref Magnum::MeshTools::simplifyLods(), enum @ref Magnum::MeshTools::SimplifyFlag, enum set @ref Magnum::MeshTools::SimplifyFlags
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Mesh simplification flag
+@m_since_latest
+
+@see @ref SimplifyFlags, @ref simplifyInPlace(), @ref simplify(),
+    @ref simplifyLods()
+*/
+enum class SimplifyFlag: UnsignedByte {
+    /**
+     * Don't move any vertices on the mesh border, i.e. vertices that are on
+     * an edge used by just a single triangle. Useful when the mesh is a part
+     * of a larger whole and the borders have to stay watertight with
+     * neighboring pieces. If not set, border vertices are allowed to slide
+     * along the border.
+     */
+    LockBorder = 1 << 0
+};
+
+/**
+@brief Mesh simplification flags
+@m_since_latest
+
+@see @ref simplifyInPlace(), @ref simplify(), @ref simplifyLods()
+*/
+typedef Containers::EnumSet<SimplifyFlag> SimplifyFlags;
+
+CORRADE_ENUMSET_OPERATORS(SimplifyFlags)
+
+/**
+@brief Simplify a mesh in-place
+@param[in,out] indices  Triangle indices
+@param[in] positions    Vertex positions
+@param[in] attributes   Additional vertex attributes to take into account
+@param[in] attributeWeights Weights of each attribute component
+@param[in] targetIndexCount Target index count
+@param[in] targetError  Max allowed error, relative to mesh size
+@param[in] flags        Flags
+@return Resulting index count and the error, relative to mesh size
+@m_since_latest
+
+Repeatedly collapses edges with the smallest error, as measured by a
+quadric error metric, by moving one edge endpoint to the other until the
+index count is at most @p targetIndexCount or until no further edge can be
+collapsed without exceeding @p targetError. Collapses that would flip a
+triangle are rejected. Degenerate triangles are removed from the output. The
+resulting triangles are written to the prefix of @p indices of the returned
+size, the rest of the array is left in an unspecified state. Since one collapse
+removes usually two triangles, the resulting index count can be slightly below
+@p targetIndexCount.
+
+As vertices are only moved onto positions of other vertices, the vertex data
+don't need to be modified and the result is always a subset of the original
+vertices. Use @ref optimizeVertexFetchInPlaceInto() to find and drop the
+vertices that are no longer referenced.
+
+The error is the square root of an area-weighted mean squared distance of
+moved vertices to planes of their original neighboring triangles, with
+positions scaled so the largest dimension of the mesh bounding box is
+@cpp 1.0f @ce. Thus a @p targetError of @cpp 0.01f @ce allows deviations of
+roughly one percent of the mesh size. For each collapse, difference of the
+@p attributes, which is expected to have one row per vertex, is multiplied
+by the corresponding @p attributeWeights component and added to the squared
+error, making it possible to preserve for example normal or texture coordinate
+discontinuities.
+
+Vertices that share a position with another vertex, such as on normal or
+texture coordinate seams, are never moved in order to not create cracks in
+the mesh. Vertices on the mesh border are only allowed to slide along the
+border, or not moved at all if @ref SimplifyFlag::LockBorder is set.
+
+The @p indices are expected to have a size divisible by 3, all of them are
+expected to be less than size of @p positions and @p attributeWeights is
+expected to have the same size as second dimension of @p attributes.
+@see @ref simplify(), @ref simplifyLods()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<const Float>& attributes, const Containers::StridedArrayView1D<const Float>& attributeWeights, std::size_t targetIndexCount, Float targetError, SimplifyFlags flags = {});
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<const Float>& attributes, const Containers::StridedArrayView1D<const Float>& attributeWeights, std::size_t targetIndexCount, Float targetError, SimplifyFlags flags = {});
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<const Float>& attributes, const Containers::StridedArrayView1D<const Float>& attributeWeights, std::size_t targetIndexCount, Float targetError, SimplifyFlags flags = {});
+
+/**
+@brief Simplify a mesh in-place using just positions
+@m_since_latest
+
+Same as calling @ref simplifyInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView2D<const Float>&, const Containers::StridedArrayView1D<const Float>&, std::size_t, Float, SimplifyFlags)
+with no additional attributes.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, std::size_t targetIndexCount, Float targetError, SimplifyFlags flags = {});
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, std::size_t targetIndexCount, Float targetError, SimplifyFlags flags = {});
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, std::size_t targetIndexCount, Float targetError, SimplifyFlags flags = {});
+
+/**
+@brief Simplify a mesh
+@param mesh                 Input mesh
+@param targetIndexCount     Target index count
+@param targetError          Max allowed error, relative to mesh size
+@param flags                Flags
+@param normalWeight         Weight of @ref Trade::MeshAttribute::Normal
+    differences
+@param textureCoordinateWeight Weight of
+    @ref Trade::MeshAttribute::TextureCoordinates differences
+@m_since_latest
+
+Simplifies the index buffer using @ref simplifyInPlace(), taking the first
+@ref Trade::MeshAttribute::Normal and
+@ref Trade::MeshAttribute::TextureCoordinates into account, if present, and
+then removes vertices that are no longer referenced. The returned mesh has
+the same primitive, index type and attribute layout as the input, with the
+index and vertex data tightly packed and the vertices in order in which they
+are first referenced. Set a weight to @cpp 0.0f @ce to ignore given attribute.
+
+Expects that the mesh is an indexed @ref MeshPrimitive::Triangles with a
+non-implementation-specific index type and that it has a
+@ref Trade::MeshAttribute::Position. A non-indexed mesh would have all
+vertices unique and thus nothing could be collapsed, use
+@ref removeDuplicates(const Trade::MeshData&) to create an index buffer first.
+@see @ref simplifyLods(), @ref isMeshIndexTypeImplementationSpecific()
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData simplify(const Trade::MeshData& mesh, std::size_t targetIndexCount, Float targetError, SimplifyFlags flags = {}, Float normalWeight = 1.0f, Float textureCoordinateWeight = 1.0f);
+
+/**
+@brief Create a chain of mesh levels of detail
+@param mesh                 Input mesh
+@param levelCount           Max level count, including the input mesh
+@param indexCountRatio      Ratio of index counts of two consecutive levels
+@param targetError          Max allowed error for each level, relative to
+    mesh size
+@param flags                Flags
+@param normalWeight         Weight of @ref Trade::MeshAttribute::Normal
+    differences
+@param textureCoordinateWeight Weight of
+    @ref Trade::MeshAttribute::TextureCoordinates differences
+@m_since_latest
+
+The first item is a copy of @p mesh, each following item is created by
+calling @ref simplify() on the previous level, with the target index count
+being @p indexCountRatio times the index count of the previous level. If a
+level fails to reduce the index count any further, for example because the
+@p targetError would be exceeded, the chain is ended early, so the returned
+array can have less than @p levelCount items. The order matches levels
+exposed by @ref Trade::AbstractImporter::mesh(UnsignedInt, UnsignedInt), i.e.
+the most detailed level first.
+
+Expects that @p levelCount is non-zero and @p indexCountRatio is in the
+@f$ (0, 1) @f$ range, see @ref simplify() for requirements on the mesh.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Trade::MeshData> simplifyLods(const Trade::MeshData& mesh, UnsignedInt levelCount, Float indexCountRatio = 0.5f, Float targetError = 0.05f, SimplifyFlags flags = {}, Float normalWeight = 1.0f, Float textureCoordinateWeight = 1.0f);
+
+}}
+
+#endif
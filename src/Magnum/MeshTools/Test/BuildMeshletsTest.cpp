@@ -0,0 +1,323 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/BoundingVolume.h"
+#include "Magnum/MeshTools/BuildMeshlets.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct BuildMeshletsTest: TestSuite::Tester {
+    explicit BuildMeshletsTest();
+
+    template<class T> void vertexLimit();
+    void triangleLimit();
+    void degenerateTriangle();
+    void normalCone();
+    void empty();
+    void invalid();
+
+    void meshData();
+    void meshDataNotIndexed();
+    void meshDataInvalid();
+};
+
+/* A strip of four quads facing +Z:
+
+    5 --- 6 --- 7 --- 8 --- 9
+    |   / |   / |   / |   / |
+    | /   | /   | /   | /   |
+    0 --- 1 --- 2 --- 3 --- 4
+*/
+const Vector3 StripPositions[]{
+    {0.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {2.0f, 0.0f, 0.0f},
+    {3.0f, 0.0f, 0.0f},
+    {4.0f, 0.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f},
+    {1.0f, 1.0f, 0.0f},
+    {2.0f, 1.0f, 0.0f},
+    {3.0f, 1.0f, 0.0f},
+    {4.0f, 1.0f, 0.0f}
+};
+constexpr UnsignedInt StripIndices[]{
+    0, 1, 6, 0, 6, 5,
+    1, 2, 7, 1, 7, 6,
+    2, 3, 8, 2, 8, 7,
+    3, 4, 9, 3, 9, 8
+};
+
+BuildMeshletsTest::BuildMeshletsTest() {
+    addTests({&BuildMeshletsTest::vertexLimit<UnsignedByte>,
+              &BuildMeshletsTest::vertexLimit<UnsignedShort>,
+              &BuildMeshletsTest::vertexLimit<UnsignedInt>,
+              &BuildMeshletsTest::triangleLimit,
+              &BuildMeshletsTest::degenerateTriangle,
+              &BuildMeshletsTest::normalCone,
+              &BuildMeshletsTest::empty,
+              &BuildMeshletsTest::invalid,
+
+              &BuildMeshletsTest::meshData,
+              &BuildMeshletsTest::meshDataNotIndexed,
+              &BuildMeshletsTest::meshDataInvalid});
+}
+
+template<class T> void BuildMeshletsTest::vertexLimit() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    T indices[Containers::arraySize(StripIndices)];
+    for(std::size_t i = 0; i != Containers::arraySize(StripIndices); ++i)
+        indices[i] = StripIndices[i];
+
+    /* With at most four vertices each quad becomes a meshlet */
+    Meshlets out = MeshTools::buildMeshlets(Containers::stridedArrayView(indices), StripPositions, 4);
+    CORRADE_COMPARE(out.meshlets.size(), 4);
+    CORRADE_COMPARE_AS(out.vertices, Containers::arrayView<UnsignedInt>({
+        0, 1, 6, 5,
+        1, 2, 7, 6,
+        2, 3, 8, 7,
+        3, 4, 9, 8
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.triangles, Containers::arrayView<Vector3ub>({
+        {0, 1, 2}, {0, 2, 3},
+        {0, 1, 2}, {0, 2, 3},
+        {0, 1, 2}, {0, 2, 3},
+        {0, 1, 2}, {0, 2, 3}
+    }), TestSuite::Compare::Container);
+
+    for(std::size_t i = 0; i != out.meshlets.size(); ++i) {
+        CORRADE_ITERATION(i);
+        const Meshlet& meshlet = out.meshlets[i];
+        CORRADE_COMPARE(meshlet.vertexOffset, i*4);
+        CORRADE_COMPARE(meshlet.vertexCount, 4);
+        CORRADE_COMPARE(meshlet.triangleOffset, i*2);
+        CORRADE_COMPARE(meshlet.triangleCount, 2);
+
+        /* The bounds should be the same as calculated directly */
+        const Vector3 positions[]{
+            StripPositions[out.vertices[i*4 + 0]],
+            StripPositions[out.vertices[i*4 + 1]],
+            StripPositions[out.vertices[i*4 + 2]],
+            StripPositions[out.vertices[i*4 + 3]]
+        };
+        const Containers::Pair<Vector3, Float> sphere = MeshTools::boundingSphereBouncingBubble(positions);
+        CORRADE_COMPARE(meshlet.center, sphere.first());
+        CORRADE_COMPARE(meshlet.radius, sphere.second());
+
+        /* All triangles face the same direction */
+        CORRADE_COMPARE(meshlet.coneAxis, Vector3::zAxis());
+        CORRADE_COMPARE(meshlet.coneCutoff, 0.0f);
+    }
+}
+
+void BuildMeshletsTest::triangleLimit() {
+    Meshlets out = MeshTools::buildMeshlets(Containers::stridedArrayView(StripIndices), StripPositions, 64, 3);
+    CORRADE_COMPARE(out.meshlets.size(), 3);
+    CORRADE_COMPARE(out.meshlets[0].vertexOffset, 0);
+    CORRADE_COMPARE(out.meshlets[0].vertexCount, 6);
+    CORRADE_COMPARE(out.meshlets[0].triangleOffset, 0);
+    CORRADE_COMPARE(out.meshlets[0].triangleCount, 3);
+    CORRADE_COMPARE(out.meshlets[1].vertexOffset, 6);
+    CORRADE_COMPARE(out.meshlets[1].vertexCount, 6);
+    CORRADE_COMPARE(out.meshlets[1].triangleOffset, 3);
+    CORRADE_COMPARE(out.meshlets[1].triangleCount, 3);
+    CORRADE_COMPARE(out.meshlets[2].vertexOffset, 12);
+    CORRADE_COMPARE(out.meshlets[2].vertexCount, 4);
+    CORRADE_COMPARE(out.meshlets[2].triangleOffset, 6);
+    CORRADE_COMPARE(out.meshlets[2].triangleCount, 2);
+    CORRADE_COMPARE_AS(out.vertices, Containers::arrayView<UnsignedInt>({
+        0, 1, 6, 5, 2, 7,
+        1, 7, 6, 2, 3, 8,
+        3, 4, 9, 8
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.triangles, Containers::arrayView<Vector3ub>({
+        {0, 1, 2}, {0, 2, 3}, {1, 4, 5},
+        {0, 1, 2}, {3, 4, 5}, {3, 5, 1},
+        {0, 1, 2}, {0, 2, 3}
+    }), TestSuite::Compare::Container);
+}
+
+void BuildMeshletsTest::degenerateTriangle() {
+    /* The degenerate triangle has its vertex counted just once so it fits
+       into the first meshlet, and it doesn't affect the normal cone */
+    const UnsignedInt indices[]{
+        0, 1, 6, 0, 6, 5,
+        6, 6, 6
+    };
+    Meshlets out = MeshTools::buildMeshlets(Containers::stridedArrayView(indices), StripPositions, 4);
+    CORRADE_COMPARE(out.meshlets.size(), 1);
+    CORRADE_COMPARE(out.meshlets[0].vertexCount, 4);
+    CORRADE_COMPARE(out.meshlets[0].triangleCount, 3);
+    CORRADE_COMPARE_AS(out.triangles, Containers::arrayView<Vector3ub>({
+        {0, 1, 2}, {0, 2, 3}, {2, 2, 2}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.meshlets[0].coneAxis, Vector3::zAxis());
+    CORRADE_COMPARE(out.meshlets[0].coneCutoff, 0.0f);
+}
+
+void BuildMeshletsTest::normalCone() {
+    const Vector3 positions[]{
+        {0.0f, 0.0f,  0.0f},
+        {1.0f, 0.0f,  0.0f},
+        {1.0f, 1.0f,  0.0f},
+        {1.0f, 0.0f, -1.0f},
+        {1.0f, 1.0f, -1.0f}
+    };
+
+    /* Triangles facing +Z and +X, the cone is in between */
+    {
+        const UnsignedInt indices[]{
+            0, 1, 2,
+            1, 3, 4
+        };
+        Meshlets out = MeshTools::buildMeshlets(Containers::stridedArrayView(indices), positions);
+        CORRADE_COMPARE(out.meshlets.size(), 1);
+        CORRADE_COMPARE(out.meshlets[0].coneAxis, (Vector3{1.0f, 0.0f, 1.0f}.normalized()));
+        CORRADE_COMPARE(out.meshlets[0].coneCutoff, Constants::sqrtHalf());
+
+    /* Triangles facing +Z and -Z, can't be culled */
+    } {
+        const UnsignedInt indices[]{
+            0, 1, 2,
+            0, 2, 1
+        };
+        Meshlets out = MeshTools::buildMeshlets(Containers::stridedArrayView(indices), positions);
+        CORRADE_COMPARE(out.meshlets.size(), 1);
+        CORRADE_COMPARE(out.meshlets[0].coneAxis, Vector3{});
+        CORRADE_COMPARE(out.meshlets[0].coneCutoff, 1.0f);
+    }
+}
+
+void BuildMeshletsTest::empty() {
+    Meshlets out = MeshTools::buildMeshlets(Containers::StridedArrayView1D<const UnsignedInt>{}, nullptr);
+    CORRADE_COMPARE(out.meshlets.size(), 0);
+    CORRADE_COMPARE(out.vertices.size(), 0);
+    CORRADE_COMPARE(out.triangles.size(), 0);
+}
+
+void BuildMeshletsTest::invalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Vector3 positions[3];
+    const UnsignedInt indices[]{0, 1, 2, 2, 1, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::buildMeshlets(Containers::stridedArrayView(indices).prefix(5), positions);
+    MeshTools::buildMeshlets(Containers::stridedArrayView(indices).prefix(3), positions, 2);
+    MeshTools::buildMeshlets(Containers::stridedArrayView(indices).prefix(3), positions, 257);
+    MeshTools::buildMeshlets(Containers::stridedArrayView(indices).prefix(3), positions, 64, 0);
+    MeshTools::buildMeshlets(Containers::stridedArrayView(indices), positions);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::buildMeshlets(): index count not divisible by 3\n"
+        "MeshTools::buildMeshlets(): expected max vertex count to be between 3 and 256 but got 2\n"
+        "MeshTools::buildMeshlets(): expected max vertex count to be between 3 and 256 but got 257\n"
+        "MeshTools::buildMeshlets(): expected non-zero max triangle count\n"
+        "MeshTools::buildMeshlets(): index 3 out of range for 3 vertices\n");
+}
+
+void BuildMeshletsTest::meshData() {
+    const UnsignedShort indices[]{
+        0, 1, 6, 0, 6, 5,
+        1, 2, 7, 1, 7, 6
+    };
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, StripPositions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(StripPositions)}
+        }};
+
+    Meshlets out = MeshTools::buildMeshlets(mesh, 4);
+    CORRADE_COMPARE(out.meshlets.size(), 2);
+    CORRADE_COMPARE_AS(out.vertices, Containers::arrayView<UnsignedInt>({
+        0, 1, 6, 5,
+        1, 2, 7, 6
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.triangles, Containers::arrayView<Vector3ub>({
+        {0, 1, 2}, {0, 2, 3},
+        {0, 1, 2}, {0, 2, 3}
+    }), TestSuite::Compare::Container);
+}
+
+void BuildMeshletsTest::meshDataNotIndexed() {
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, StripPositions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(StripPositions).prefix(6)}
+        }};
+
+    Meshlets out = MeshTools::buildMeshlets(mesh);
+    CORRADE_COMPARE(out.meshlets.size(), 1);
+    CORRADE_COMPARE(out.meshlets[0].vertexCount, 6);
+    CORRADE_COMPARE(out.meshlets[0].triangleCount, 2);
+    CORRADE_COMPARE_AS(out.vertices, Containers::arrayView<UnsignedInt>({
+        0, 1, 2, 3, 4, 5
+    }), TestSuite::Compare::Container);
+}
+
+void BuildMeshletsTest::meshDataInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Vector2 positions2D[3]{};
+    const UnsignedShort indices[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::buildMeshlets(Trade::MeshData{MeshPrimitive::Lines, 2});
+    MeshTools::buildMeshlets(Trade::MeshData{MeshPrimitive::Triangles, 3});
+    MeshTools::buildMeshlets(Trade::MeshData{MeshPrimitive::Triangles,
+        {}, positions2D, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions2D)}
+        }});
+    MeshTools::buildMeshlets(Trade::MeshData{MeshPrimitive::Triangles,
+        {}, StripPositions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, vertexFormatWrap(0xdead), Containers::stridedArrayView(StripPositions)}
+        }});
+    MeshTools::buildMeshlets(Trade::MeshData{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{meshIndexTypeWrap(0xcaca), Containers::stridedArrayView(indices)},
+        {}, StripPositions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(StripPositions)}
+        }});
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::buildMeshlets(): expected MeshPrimitive::Triangles but got MeshPrimitive::Lines\n"
+        "MeshTools::buildMeshlets(): the mesh has no positions\n"
+        "MeshTools::buildMeshlets(): expected 3D positions but got VertexFormat::Vector2\n"
+        "MeshTools::buildMeshlets(): positions have an implementation-specific format 0xdead\n"
+        "MeshTools::buildMeshlets(): mesh has an implementation-specific index type 0xcaca\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::BuildMeshletsTest)
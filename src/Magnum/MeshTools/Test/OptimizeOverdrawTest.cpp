@@ -0,0 +1,148 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/OptimizeOverdraw.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct OptimizeOverdrawTest: TestSuite::Tester {
+    explicit OptimizeOverdrawTest();
+
+    template<class T> void hardClusters();
+    void softClusters();
+    void empty();
+    void invalid();
+};
+
+OptimizeOverdrawTest::OptimizeOverdrawTest() {
+    addTests({&OptimizeOverdrawTest::hardClusters<UnsignedByte>,
+              &OptimizeOverdrawTest::hardClusters<UnsignedShort>,
+              &OptimizeOverdrawTest::hardClusters<UnsignedInt>,
+              &OptimizeOverdrawTest::softClusters,
+              &OptimizeOverdrawTest::empty,
+              &OptimizeOverdrawTest::invalid});
+}
+
+template<class T> void OptimizeOverdrawTest::hardClusters() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    /* Two disconnected parallel quads facing +Z, the one further along the
+       normal direction should get drawn first as it occludes the other */
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+
+        {0.0f, 0.0f, 1.0f},
+        {1.0f, 0.0f, 1.0f},
+        {1.0f, 1.0f, 1.0f},
+        {0.0f, 1.0f, 1.0f}
+    };
+    T indices[]{
+        0, 1, 2, 0, 2, 3,
+        4, 5, 6, 4, 6, 7
+    };
+
+    MeshTools::optimizeOverdrawInPlace(indices, positions, 16);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView<T>({
+        4, 5, 6, 4, 6, 7,
+        0, 1, 2, 0, 2, 3
+    }), TestSuite::Compare::Container);
+}
+
+void OptimizeOverdrawTest::softClusters() {
+    /* A quad facing +X and a smaller one facing +Z sharing an edge, so all
+       triangles are in a single hard cluster with a miss ratio of 6/4 */
+    const Vector3 positions[]{
+        {0.0f, 0.0f,  0.0f},
+        {1.0f, 0.0f,  0.0f},
+        {1.0f, 1.0f,  0.0f},
+        {0.0f, 1.0f,  0.0f},
+        {1.0f, 0.0f, -2.0f},
+        {1.0f, 1.0f, -2.0f}
+    };
+    /* With a low threshold no split happens as every smaller cluster would
+       make the cache efficiency worse */
+    {
+        UnsignedInt indices[]{
+            1, 4, 5, 1, 5, 2, /* +X */
+            0, 1, 2, 0, 2, 3  /* +Z */
+        };
+        MeshTools::optimizeOverdrawInPlace(indices, positions, 16, 1.05f);
+        CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView<UnsignedInt>({
+            1, 4, 5, 1, 5, 2,
+            0, 1, 2, 0, 2, 3
+        }), TestSuite::Compare::Container);
+    }
+
+    /* With a high threshold each triangle becomes a cluster on its own, the
+       +Z quad is further from the centroid along its normal so it's drawn
+       first */
+    {
+        UnsignedInt indices[]{
+            1, 4, 5, 1, 5, 2,
+            0, 1, 2, 0, 2, 3
+        };
+        MeshTools::optimizeOverdrawInPlace(indices, positions, 16, 2.0f);
+        CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView<UnsignedInt>({
+            0, 1, 2, 0, 2, 3,
+            1, 4, 5, 1, 5, 2
+        }), TestSuite::Compare::Container);
+    }
+}
+
+void OptimizeOverdrawTest::empty() {
+    /* Shouldn't crash or anything */
+    MeshTools::optimizeOverdrawInPlace(Containers::StridedArrayView1D<UnsignedInt>{}, nullptr, 16);
+    CORRADE_VERIFY(true);
+}
+
+void OptimizeOverdrawTest::invalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Vector3 positions[3];
+    UnsignedInt indices[]{0, 1, 2, 2, 1, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeOverdrawInPlace(Containers::arrayView(indices).prefix(5), positions, 16);
+    MeshTools::optimizeOverdrawInPlace(indices, positions, 16);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeOverdrawInPlace(): index count not divisible by 3\n"
+        "MeshTools::optimizeOverdrawInPlace(): index 3 out of range for 3 vertices\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::OptimizeOverdrawTest)
@@ -0,0 +1,221 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/OptimizeVertexCache.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct OptimizeVertexCacheTest: TestSuite::Tester {
+    explicit OptimizeVertexCacheTest();
+
+    template<class T> void optimize();
+    void optimizeEmpty();
+    void optimizeDegenerateTriangle();
+    void optimizeInvalid();
+
+    template<class T> void statistics();
+    void statisticsEmpty();
+    void statisticsInvalid();
+};
+
+/* A grid of quads with triangles in a scrambled order, which makes the cache
+   efficiency of the original index buffer close to the worst case */
+template<class T> Containers::Array<T> scrambledGrid(const UnsignedInt size) {
+    const UnsignedInt triangleCount = size*size*2;
+    Containers::Array<T> indices{NoInit, triangleCount*3};
+    for(UnsignedInt i = 0; i != triangleCount; ++i) {
+        /* 211 is coprime with the triangle count so this is a permutation */
+        const UnsignedInt t = (i*211) % triangleCount;
+        const UnsignedInt quad = t/2;
+        const UnsignedInt a = (quad/size)*(size + 1) + quad%size;
+        const UnsignedInt b = a + 1;
+        const UnsignedInt c = a + size + 1;
+        const UnsignedInt d = c + 1;
+        if(t % 2) {
+            indices[i*3 + 0] = a;
+            indices[i*3 + 1] = b;
+            indices[i*3 + 2] = d;
+        } else {
+            indices[i*3 + 0] = a;
+            indices[i*3 + 1] = d;
+            indices[i*3 + 2] = c;
+        }
+    }
+    return indices;
+}
+
+template<class T> Containers::Array<Vector3ui> sortedTriangles(Containers::ArrayView<const T> indices) {
+    Containers::Array<Vector3ui> triangles{NoInit, indices.size()/3};
+    for(std::size_t i = 0; i != triangles.size(); ++i)
+        triangles[i] = {indices[i*3 + 0], indices[i*3 + 1], indices[i*3 + 2]};
+    std::sort(triangles.begin(), triangles.end(), [](const Vector3ui& a, const Vector3ui& b) {
+        return std::make_tuple(a.x(), a.y(), a.z()) < std::make_tuple(b.x(), b.y(), b.z());
+    });
+    return triangles;
+}
+
+OptimizeVertexCacheTest::OptimizeVertexCacheTest() {
+    addTests({&OptimizeVertexCacheTest::optimize<UnsignedByte>,
+              &OptimizeVertexCacheTest::optimize<UnsignedShort>,
+              &OptimizeVertexCacheTest::optimize<UnsignedInt>,
+              &OptimizeVertexCacheTest::optimizeEmpty,
+              &OptimizeVertexCacheTest::optimizeDegenerateTriangle,
+              &OptimizeVertexCacheTest::optimizeInvalid,
+
+              &OptimizeVertexCacheTest::statistics<UnsignedByte>,
+              &OptimizeVertexCacheTest::statistics<UnsignedShort>,
+              &OptimizeVertexCacheTest::statistics<UnsignedInt>,
+              &OptimizeVertexCacheTest::statisticsEmpty,
+              &OptimizeVertexCacheTest::statisticsInvalid});
+}
+
+template<class T> void OptimizeVertexCacheTest::optimize() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    /* A 16x16 grid has 289 vertices, which doesn't fit into 8 bits */
+    const UnsignedInt size = sizeof(T) == 1 ? 8 : 16;
+    const UnsignedInt vertexCount = (size + 1)*(size + 1);
+    Containers::Array<T> indices = scrambledGrid<T>(size);
+
+    Containers::Array<T> original{NoInit, indices.size()};
+    Utility::copy(indices, original);
+
+    const Containers::Pair<Float, Float> before = MeshTools::vertexCacheStatistics(Containers::stridedArrayView(indices), vertexCount, 16);
+    MeshTools::optimizeVertexCacheInPlace(Containers::stridedArrayView(indices), vertexCount, 16);
+    const Containers::Pair<Float, Float> after = MeshTools::vertexCacheStatistics(Containers::stridedArrayView(indices), vertexCount, 16);
+
+    /* The output should contain the same triangles with the same winding,
+       just in a different order */
+    CORRADE_COMPARE_AS(sortedTriangles<T>(indices),
+        sortedTriangles<T>(original),
+        TestSuite::Compare::Container);
+
+    /* And it should be better than the original */
+    CORRADE_COMPARE_AS(after.first(), before.first(),
+        TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(after.second(), before.second(),
+        TestSuite::Compare::Less);
+
+    /* For the larger grid the result should be reasonably close to the
+       optimum of 289/512 misses per triangle */
+    if(size == 16) CORRADE_COMPARE_AS(after.first(), 1.0f,
+        TestSuite::Compare::Less);
+}
+
+void OptimizeVertexCacheTest::optimizeEmpty() {
+    /* Shouldn't crash or anything */
+    MeshTools::optimizeVertexCacheInPlace(Containers::StridedArrayView1D<UnsignedInt>{}, 0);
+    CORRADE_VERIFY(true);
+}
+
+void OptimizeVertexCacheTest::optimizeDegenerateTriangle() {
+    UnsignedInt indices[]{0, 0, 0, 1, 1, 0};
+    MeshTools::optimizeVertexCacheInPlace(indices, 2);
+
+    CORRADE_COMPARE_AS(sortedTriangles<UnsignedInt>(indices),
+        Containers::arrayView<Vector3ui>({{0, 0, 0}, {1, 1, 0}}),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeVertexCacheTest::optimizeInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedInt indices[6]{};
+    UnsignedInt indicesOutOfRange[]{0, 1, 2, 1, 2, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeVertexCacheInPlace(Containers::arrayView(indices).prefix(5), 1);
+    MeshTools::optimizeVertexCacheInPlace(indices, 1, 3);
+    MeshTools::optimizeVertexCacheInPlace(indicesOutOfRange, 3);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeVertexCacheInPlace(): index count not divisible by 3\n"
+        "MeshTools::optimizeVertexCacheInPlace(): expected cache size to be at least 4 but got 3\n"
+        "MeshTools::optimizeVertexCacheInPlace(): index 3 out of range for 3 vertices\n");
+}
+
+template<class T> void OptimizeVertexCacheTest::statistics() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    const T indices[]{
+        0, 1, 2,
+        2, 1, 3,
+        0, 1, 2
+    };
+
+    /* With a cache of size 3 vertex 3 evicts 0, which then evicts 1 and so
+       on, 7 misses in total */
+    Containers::Pair<Float, Float> small = MeshTools::vertexCacheStatistics(Containers::stridedArrayView(indices), 4, 3);
+    CORRADE_COMPARE(small.first(), 7.0f/3.0f);
+    CORRADE_COMPARE(small.second(), 7.0f/4.0f);
+
+    /* With a cache of size 4 every vertex is transformed just once */
+    Containers::Pair<Float, Float> large = MeshTools::vertexCacheStatistics(Containers::stridedArrayView(indices), 4, 4);
+    CORRADE_COMPARE(large.first(), 4.0f/3.0f);
+    CORRADE_COMPARE(large.second(), 1.0f);
+
+    /* Vertices that aren't referenced don't count into the ATVR */
+    Containers::Pair<Float, Float> unreferenced = MeshTools::vertexCacheStatistics(Containers::stridedArrayView(indices), 100, 4);
+    CORRADE_COMPARE(unreferenced.first(), 4.0f/3.0f);
+    CORRADE_COMPARE(unreferenced.second(), 1.0f);
+}
+
+void OptimizeVertexCacheTest::statisticsEmpty() {
+    Containers::Pair<Float, Float> out = MeshTools::vertexCacheStatistics(Containers::StridedArrayView1D<const UnsignedInt>{}, 0, 16);
+    CORRADE_COMPARE(out.first(), 0.0f);
+    CORRADE_COMPARE(out.second(), 0.0f);
+}
+
+void OptimizeVertexCacheTest::statisticsInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt indices[]{0, 1, 2, 1, 2, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::vertexCacheStatistics(Containers::arrayView(indices).prefix(5), 4, 16);
+    MeshTools::vertexCacheStatistics(Containers::arrayView(indices), 3, 16);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::vertexCacheStatistics(): index count not divisible by 3\n"
+        "MeshTools::vertexCacheStatistics(): index 3 out of range for 3 vertices\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::OptimizeVertexCacheTest)
@@ -0,0 +1,326 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/MeshTools/OptimizeVertexFetch.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct OptimizeVertexFetchTest: TestSuite::Tester {
+    explicit OptimizeVertexFetchTest();
+
+    template<class T> void into();
+    void intoOutOfRange();
+
+    void meshDataInterleaved();
+    void meshDataNonInterleaved();
+    void meshDataNotIndexed();
+    void meshDataImplementationSpecificIndexType();
+    void meshDataRvalue();
+    void meshDataRvalueNotOwned();
+    /* in-place variant called from the others and as such tested
+       sufficiently, except for the asserts below */
+    void meshDataInPlaceNotMutable();
+};
+
+OptimizeVertexFetchTest::OptimizeVertexFetchTest() {
+    addTests({&OptimizeVertexFetchTest::into<UnsignedByte>,
+              &OptimizeVertexFetchTest::into<UnsignedShort>,
+              &OptimizeVertexFetchTest::into<UnsignedInt>,
+              &OptimizeVertexFetchTest::intoOutOfRange,
+
+              &OptimizeVertexFetchTest::meshDataInterleaved,
+              &OptimizeVertexFetchTest::meshDataNonInterleaved,
+              &OptimizeVertexFetchTest::meshDataNotIndexed,
+              &OptimizeVertexFetchTest::meshDataImplementationSpecificIndexType,
+              &OptimizeVertexFetchTest::meshDataRvalue,
+              &OptimizeVertexFetchTest::meshDataRvalueNotOwned,
+              &OptimizeVertexFetchTest::meshDataInPlaceNotMutable});
+}
+
+template<class T> void OptimizeVertexFetchTest::into() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    T indices[]{3, 1, 3, 4, 1, 0};
+    UnsignedInt mapping[6];
+    CORRADE_COMPARE(MeshTools::optimizeVertexFetchInPlaceInto(indices, mapping), 4);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices),
+        Containers::arrayView<T>({0, 1, 0, 2, 1, 3}),
+        TestSuite::Compare::Container);
+    /* Vertices 2 and 5 are not referenced, they're put at the end in the
+       original order */
+    CORRADE_COMPARE_AS(Containers::arrayView(mapping),
+        Containers::arrayView<UnsignedInt>({3, 1, 4, 0, 2, 5}),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeVertexFetchTest::intoOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedShort indices[]{3, 1, 5};
+    UnsignedInt mapping[5];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeVertexFetchInPlaceInto(indices, mapping);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeVertexFetchInPlaceInto(): index 5 out of range for 5 vertices\n");
+}
+
+void OptimizeVertexFetchTest::meshDataInterleaved() {
+    /* Deliberately not owned to verify that the original data stay
+       untouched */
+    const UnsignedShort indices[]{3, 1, 3, 4, 1, 0};
+    const struct Vertex {
+        Vector2 position;
+        UnsignedByte id;
+        /* 3 bytes padding */
+    } vertices[]{
+        {{0.0f, 0.0f}, 10},
+        {{1.0f, 0.0f}, 11},
+        {{2.0f, 0.0f}, 12},
+        {{3.0f, 0.0f}, 13},
+        {{4.0f, 0.0f}, 14}
+    };
+    const auto view = Containers::stridedArrayView(vertices);
+
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, vertices, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, view.slice(&Vertex::position)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::ObjectId, view.slice(&Vertex::id)}
+        }};
+
+    Trade::MeshData out = MeshTools::optimizeVertexFetch(mesh);
+    CORRADE_COMPARE(out.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(out.indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE_AS(out.indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({0, 1, 0, 2, 1, 3}),
+        TestSuite::Compare::Container);
+
+    /* The layout should be preserved */
+    CORRADE_COMPARE(out.vertexCount(), 5);
+    CORRADE_COMPARE(out.attributeCount(), 2);
+    CORRADE_COMPARE(out.attributeStride(0), sizeof(Vertex));
+    CORRADE_COMPARE(out.attributeOffset(1), offsetof(Vertex, id));
+    CORRADE_COMPARE_AS(out.attribute<Vector2>(Trade::MeshAttribute::Position),
+        Containers::arrayView<Vector2>({
+            {3.0f, 0.0f},
+            {1.0f, 0.0f},
+            {4.0f, 0.0f},
+            {0.0f, 0.0f},
+            {2.0f, 0.0f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<UnsignedByte>(Trade::MeshAttribute::ObjectId),
+        Containers::arrayView<UnsignedByte>({13, 11, 14, 10, 12}),
+        TestSuite::Compare::Container);
+
+    /* The original data should be untouched */
+    CORRADE_COMPARE(indices[0], 3);
+    CORRADE_COMPARE(vertices[0].id, 10);
+}
+
+void OptimizeVertexFetchTest::meshDataNonInterleaved() {
+    Containers::Array<char> indexData{NoInit, 6*sizeof(UnsignedByte)};
+    auto indices = Containers::arrayCast<UnsignedByte>(indexData);
+    Utility::copy({3, 1, 3, 4, 1, 0}, indices);
+    Containers::Array<char> vertexData{NoInit, 5*sizeof(Vector2) + 5*sizeof(UnsignedByte)};
+    auto positions = Containers::arrayCast<Vector2>(vertexData.prefix(5*sizeof(Vector2)));
+    auto ids = Containers::arrayCast<UnsignedByte>(vertexData.exceptPrefix(5*sizeof(Vector2)));
+    Utility::copy({
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {2.0f, 0.0f},
+        {3.0f, 0.0f},
+        {4.0f, 0.0f}
+    }, positions);
+    Utility::copy({10, 11, 12, 13, 14}, ids);
+
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        std::move(indexData), Trade::MeshIndexData{indices},
+        std::move(vertexData), {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, positions},
+            Trade::MeshAttributeData{Trade::MeshAttribute::ObjectId, ids},
+            /* Aliases the positions, shouldn't get moved twice */
+            Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates, positions}
+        }};
+
+    MeshTools::optimizeVertexFetchInPlace(mesh);
+    CORRADE_COMPARE_AS(mesh.indices<UnsignedByte>(),
+        Containers::arrayView<UnsignedByte>({0, 1, 0, 2, 1, 3}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh.attribute<Vector2>(Trade::MeshAttribute::Position),
+        Containers::arrayView<Vector2>({
+            {3.0f, 0.0f},
+            {1.0f, 0.0f},
+            {4.0f, 0.0f},
+            {0.0f, 0.0f},
+            {2.0f, 0.0f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh.attribute<UnsignedByte>(Trade::MeshAttribute::ObjectId),
+        Containers::arrayView<UnsignedByte>({13, 11, 14, 10, 12}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates),
+        Containers::arrayView<Vector2>({
+            {3.0f, 0.0f},
+            {1.0f, 0.0f},
+            {4.0f, 0.0f},
+            {0.0f, 0.0f},
+            {2.0f, 0.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void OptimizeVertexFetchTest::meshDataNotIndexed() {
+    const Vector2 positions[]{
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {2.0f, 0.0f}
+    };
+    Trade::MeshData mesh{MeshPrimitive::Triangles, {}, positions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+    }};
+
+    Trade::MeshData out = MeshTools::optimizeVertexFetch(mesh);
+    CORRADE_VERIFY(!out.isIndexed());
+    CORRADE_COMPARE_AS(out.attribute<Vector2>(Trade::MeshAttribute::Position),
+        Containers::arrayView(positions),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeVertexFetchTest::meshDataImplementationSpecificIndexType() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedShort indices[]{3, 1, 2, 0, 2};
+    Trade::MeshData mesh{MeshPrimitive::Points,
+        {}, indices, Trade::MeshIndexData{meshIndexTypeWrap(0xcaca), Containers::stridedArrayView(indices).slice(1, 4)}, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeVertexFetch(mesh);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeVertexFetchInPlace(): mesh has an implementation-specific index type 0xcaca\n");
+}
+
+void OptimizeVertexFetchTest::meshDataRvalue() {
+    Containers::Array<char> indexData{NoInit, 3*sizeof(UnsignedInt)};
+    auto indices = Containers::arrayCast<UnsignedInt>(indexData);
+    Utility::copy({2, 0, 1}, indices);
+    Containers::Array<char> vertexData{NoInit, 3*sizeof(Vector2)};
+    auto positions = Containers::arrayCast<Vector2>(vertexData);
+    Utility::copy({
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {2.0f, 0.0f}
+    }, positions);
+    const void* originalIndexData = indexData.data();
+    const void* originalVertexData = vertexData.data();
+
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        std::move(indexData), Trade::MeshIndexData{indices},
+        std::move(vertexData), {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, positions}
+        }};
+
+    Trade::MeshData out = MeshTools::optimizeVertexFetch(std::move(mesh));
+
+    /* The data should be transferred */
+    CORRADE_COMPARE(out.indexData().data(), originalIndexData);
+    CORRADE_COMPARE(out.vertexData().data(), originalVertexData);
+    CORRADE_COMPARE_AS(out.indices<UnsignedInt>(),
+        Containers::arrayView<UnsignedInt>({0, 1, 2}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<Vector2>(Trade::MeshAttribute::Position),
+        Containers::arrayView<Vector2>({
+            {2.0f, 0.0f},
+            {0.0f, 0.0f},
+            {1.0f, 0.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void OptimizeVertexFetchTest::meshDataRvalueNotOwned() {
+    const UnsignedInt indices[]{2, 0, 1};
+    Containers::Array<char> vertexData{NoInit, 3*sizeof(Vector2)};
+    auto positions = Containers::arrayCast<Vector2>(vertexData);
+    Utility::copy({
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {2.0f, 0.0f}
+    }, positions);
+    const void* originalVertexData = vertexData.data();
+
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        std::move(vertexData), {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, positions}
+        }};
+
+    Trade::MeshData out = MeshTools::optimizeVertexFetch(std::move(mesh));
+
+    /* The index data isn't owned, so a copy is made */
+    CORRADE_VERIFY(out.indexData().data() != static_cast<const void*>(indices));
+    CORRADE_VERIFY(out.vertexData().data() != originalVertexData);
+    CORRADE_COMPARE_AS(out.indices<UnsignedInt>(),
+        Containers::arrayView<UnsignedInt>({0, 1, 2}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<Vector2>(Trade::MeshAttribute::Position),
+        Containers::arrayView<Vector2>({
+            {2.0f, 0.0f},
+            {0.0f, 0.0f},
+            {1.0f, 0.0f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(indices[0], 2);
+}
+
+void OptimizeVertexFetchTest::meshDataInPlaceNotMutable() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedShort indices[3]{};
+    Trade::MeshData indexImmutable{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices}, 3};
+    Trade::MeshData vertexImmutable{MeshPrimitive::Triangles, Trade::DataFlags{}, nullptr, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, VertexFormat::Vector2, nullptr},
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeVertexFetchInPlace(indexImmutable);
+    MeshTools::optimizeVertexFetchInPlace(vertexImmutable);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeVertexFetchInPlace(): index data not mutable\n"
+        "MeshTools::optimizeVertexFetchInPlace(): vertex data not mutable\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::OptimizeVertexFetchTest)
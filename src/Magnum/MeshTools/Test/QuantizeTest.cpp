@@ -0,0 +1,459 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/Triple.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/MeshTools/Quantize.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct QuantizeTest: TestSuite::Tester {
+    explicit QuantizeTest();
+
+    void encodeOctahedral();
+    void decodeOctahedral();
+    void octahedralPrecision();
+    void octahedralInvalidSize();
+
+    void meshData();
+    void meshData2DShort();
+    void meshDataTextureCoordinatesOnly();
+    void meshDataEmpty();
+    void meshDataInvalid();
+};
+
+QuantizeTest::QuantizeTest() {
+    addTests({&QuantizeTest::encodeOctahedral,
+              &QuantizeTest::decodeOctahedral,
+              &QuantizeTest::octahedralPrecision,
+              &QuantizeTest::octahedralInvalidSize,
+
+              &QuantizeTest::meshData,
+              &QuantizeTest::meshData2DShort,
+              &QuantizeTest::meshDataTextureCoordinatesOnly,
+              &QuantizeTest::meshDataEmpty,
+              &QuantizeTest::meshDataInvalid});
+}
+
+void QuantizeTest::encodeOctahedral() {
+    const Vector3 directions[]{
+        { 0.0f,  0.0f,  1.0f},
+        { 0.0f,  0.0f, -1.0f},
+        { 1.0f,  0.0f,  0.0f},
+        {-1.0f,  0.0f,  0.0f},
+        { 0.0f,  1.0f,  0.0f},
+        { 0.0f, -1.0f,  0.0f},
+        /* Not normalized */
+        { 0.0f,  0.0f,  5.0f},
+        {-3.0f,  0.0f,  0.0f},
+        /* Zero, encoded as +Z */
+        { 0.0f,  0.0f,  0.0f}
+    };
+
+    Vector2b encodedByte[Containers::arraySize(directions)];
+    encodeOctahedralInto(directions, encodedByte);
+    CORRADE_COMPARE_AS(Containers::arrayView(encodedByte), Containers::arrayView<Vector2b>({
+        {0, 0},
+        {127, 127},
+        {127, 0},
+        {-127, 0},
+        {0, 127},
+        {0, -127},
+        {0, 0},
+        {-127, 0},
+        {0, 0}
+    }), TestSuite::Compare::Container);
+
+    Vector2s encodedShort[Containers::arraySize(directions)];
+    encodeOctahedralInto(directions, encodedShort);
+    CORRADE_COMPARE_AS(Containers::arrayView(encodedShort), Containers::arrayView<Vector2s>({
+        {0, 0},
+        {32767, 32767},
+        {32767, 0},
+        {-32767, 0},
+        {0, 32767},
+        {0, -32767},
+        {0, 0},
+        {-32767, 0},
+        {0, 0}
+    }), TestSuite::Compare::Container);
+}
+
+void QuantizeTest::decodeOctahedral() {
+    const Vector2b encodedByte[]{
+        {0, 0},
+        {127, 127},
+        {-127, 0},
+        /* -128 is clamped to -1 on unpacking, same as -127 */
+        {0, -128},
+        {0, -127}
+    };
+    Vector3 decodedByte[Containers::arraySize(encodedByte)];
+    decodeOctahedralInto(encodedByte, decodedByte);
+    CORRADE_COMPARE_AS(Containers::arrayView(decodedByte), Containers::arrayView<Vector3>({
+        { 0.0f,  0.0f,  1.0f},
+        { 0.0f,  0.0f, -1.0f},
+        {-1.0f,  0.0f,  0.0f},
+        { 0.0f, -1.0f,  0.0f},
+        { 0.0f, -1.0f,  0.0f}
+    }), TestSuite::Compare::Container);
+
+    const Vector2s encodedShort[]{
+        {32767, 32767},
+        {0, 32767},
+        /* Halfway between +X and +Y, on the octahedron edge */
+        {16384, 16384}
+    };
+    Vector3 decodedShort[Containers::arraySize(encodedShort)];
+    decodeOctahedralInto(encodedShort, decodedShort);
+    CORRADE_COMPARE_AS(Containers::arrayView(decodedShort), Containers::arrayView<Vector3>({
+        {0.0f, 0.0f, -1.0f},
+        {0.0f, 1.0f,  0.0f},
+        Vector3{1.0f, 1.0f, 0.0f}.normalized()
+    }), TestSuite::Compare::Container);
+}
+
+void QuantizeTest::octahedralPrecision() {
+    /* Directions evenly distributed on a sphere */
+    Containers::Array<Vector3> directions{NoInit, 2000};
+    const Float goldenAngle = Constants::pi()*(3.0f - Math::sqrt(5.0f));
+    for(std::size_t i = 0; i != directions.size(); ++i) {
+        const Float z = 1.0f - 2.0f*(i + 0.5f)/directions.size();
+        const Float radius = Math::sqrt(1.0f - z*z);
+        const Rad angle{goldenAngle*i};
+        directions[i] = Vector3{radius*Math::cos(angle), radius*Math::sin(angle), z}.normalized();
+    }
+
+    Containers::Array<Vector3> decoded{NoInit, directions.size()};
+
+    /* Plain rounding of the projected coordinates would give a max error of
+       0.0152 and 0.0000583, respectively */
+    {
+        Containers::Array<Vector2b> encoded{NoInit, directions.size()};
+        encodeOctahedralInto(directions, encoded);
+        decodeOctahedralInto(encoded, decoded);
+        Float error = 0.0f;
+        for(std::size_t i = 0; i != directions.size(); ++i)
+            error = Math::max(error, (decoded[i] - directions[i]).length());
+        CORRADE_COMPARE_AS(error, 0.011f, TestSuite::Compare::Less);
+    } {
+        Containers::Array<Vector2s> encoded{NoInit, directions.size()};
+        encodeOctahedralInto(directions, encoded);
+        decodeOctahedralInto(encoded, decoded);
+        Float error = 0.0f;
+        for(std::size_t i = 0; i != directions.size(); ++i)
+            error = Math::max(error, (decoded[i] - directions[i]).length());
+        CORRADE_COMPARE_AS(error, 0.000045f, TestSuite::Compare::Less);
+    }
+}
+
+void QuantizeTest::octahedralInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Vector3 directions[3]{};
+    Vector3 directionsOut[2]{};
+    const Vector2b encodedByte[2]{};
+    Vector2b encodedByteOut[2]{};
+    const Vector2s encodedShort[3]{};
+    Vector2s encodedShortOut[4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    encodeOctahedralInto(directions, encodedByteOut);
+    encodeOctahedralInto(directions, encodedShortOut);
+    decodeOctahedralInto(encodedShort, directionsOut);
+    /* This one is fine */
+    decodeOctahedralInto(encodedByte, directionsOut);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::encodeOctahedralInto(): expected 3 items in the output but got 2\n"
+        "MeshTools::encodeOctahedralInto(): expected 3 items in the output but got 4\n"
+        "MeshTools::decodeOctahedralInto(): expected 3 items in the output but got 2\n");
+}
+
+struct Vertex {
+    Vector3 position;
+    Vector3 normal;
+    Vector4 tangent;
+    Vector2 textureCoordinates;
+    Vector2 textureCoordinatesOutOfRange;
+    UnsignedInt objectId;
+};
+
+const Vertex Vertices[]{
+    {{1.0f, 2.0f, 3.0f}, { 0.0f, 0.0f, 1.0f}, { 1.0f,  0.0f, 0.0f,  1.0f},
+     {0.0f, 0.0f}, {-1.0f, 0.0f}, 15},
+    {{5.0f, 2.0f, -1.0f}, {1.0f, 0.0f, 0.0f}, { 0.0f,  1.0f, 0.0f, -1.0f},
+     {1.0f, 1.0f}, {0.0f, 2.0f}, 3},
+    {{3.0f, 6.0f, 3.0f}, { 0.0f, 0.0f, -1.0f}, {-1.0f,  0.0f, 0.0f,  1.0f},
+     {0.5f, 0.25f}, {0.5f, 0.5f}, 0},
+    /* Normal not normalized */
+    {{2.0f, 3.0f, 0.0f}, { 2.0f, 0.0f, 0.0f}, { 0.0f, -1.0f, 0.0f, -1.0f},
+     {0.75f, 1.0f}, {1.0f, 1.0f}, 7}
+};
+
+const UnsignedShort Indices[]{0, 1, 2, 2, 1, 3};
+
+Trade::MeshData mesh() {
+    const Containers::StridedArrayView1D<const Vertex> vertices = Vertices;
+    return Trade::MeshData{MeshPrimitive::Triangles,
+        {}, Indices, Trade::MeshIndexData{Indices},
+        {}, Vertices, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                vertices.slice(&Vertex::position)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+                vertices.slice(&Vertex::normal)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Tangent,
+                vertices.slice(&Vertex::tangent)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+                vertices.slice(&Vertex::textureCoordinates)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+                vertices.slice(&Vertex::textureCoordinatesOutOfRange)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::ObjectId,
+                vertices.slice(&Vertex::objectId)}
+    }};
+}
+
+void QuantizeTest::meshData() {
+    Containers::Triple<Trade::MeshData, Matrix4, Containers::Array<Float>> out = quantize(mesh(), QuantizeFlag::Positions|QuantizeFlag::OctahedralDirections|QuantizeFlag::TextureCoordinates);
+
+    CORRADE_COMPARE(out.first().primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(out.first().isIndexed());
+    CORRADE_COMPARE(out.first().indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE_AS(out.first().indices<UnsignedShort>(),
+        Containers::arrayView(Indices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.first().vertexCount(), 4);
+    CORRADE_COMPARE(out.first().attributeCount(), 6);
+
+    /* Bounding box is {1, 2, -1} to {5, 6, 3} */
+    CORRADE_COMPARE(out.second(), Matrix4::translation({3.0f, 4.0f, 1.0f})*Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_COMPARE(out.first().attributeName(0), Trade::MeshAttribute::Position);
+    CORRADE_COMPARE(out.first().attributeFormat(0), VertexFormat::Vector3sNormalized);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector3s>(0), Containers::arrayView<Vector3s>({
+        {-32767, -32767, 32767},
+        {32767, -32767, -32767},
+        {0, 32767, 32767},
+        /* -0.5 rounds away from zero */
+        {-16384, -16384, -16384}
+    }), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(out.first().attributeName(1), Trade::meshAttributeCustom(0));
+    CORRADE_COMPARE(out.first().attributeFormat(1), VertexFormat::Vector2bNormalized);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector2b>(1), Containers::arrayView<Vector2b>({
+        {0, 0},
+        {127, 0},
+        {127, 127},
+        {127, 0}
+    }), TestSuite::Compare::Container);
+
+    /* Four-component tangent gets the bitangent sign in the last component */
+    CORRADE_COMPARE(out.first().attributeName(2), Trade::meshAttributeCustom(1));
+    CORRADE_COMPARE(out.first().attributeFormat(2), VertexFormat::Vector3bNormalized);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector3b>(2), Containers::arrayView<Vector3b>({
+        {127, 0, 127},
+        {0, 127, -127},
+        {-127, 0, 127},
+        {0, -127, -127}
+    }), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(out.first().attributeName(3), Trade::MeshAttribute::TextureCoordinates);
+    CORRADE_COMPARE(out.first().attributeFormat(3), VertexFormat::Vector2usNormalized);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector2us>(3), Containers::arrayView<Vector2us>({
+        {0, 0},
+        {65535, 65535},
+        {32768, 16384},
+        {49151, 65535}
+    }), TestSuite::Compare::Container);
+
+    /* Texture coordinates outside of the [0, 1] range and other attributes
+       are kept as-is */
+    CORRADE_COMPARE(out.first().attributeName(4), Trade::MeshAttribute::TextureCoordinates);
+    CORRADE_COMPARE(out.first().attributeFormat(4), VertexFormat::Vector2);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector2>(4),
+        Containers::stridedArrayView(Vertices).slice(&Vertex::textureCoordinatesOutOfRange),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.first().attributeName(5), Trade::MeshAttribute::ObjectId);
+    CORRADE_COMPARE(out.first().attributeFormat(5), VertexFormat::UnsignedInt);
+    CORRADE_COMPARE_AS(out.first().attribute<UnsignedInt>(5),
+        Containers::stridedArrayView(Vertices).slice(&Vertex::objectId),
+        TestSuite::Compare::Container);
+
+    /* Only the last position isn't exactly representable and all
+       directions are axis-aligned */
+    CORRADE_COMPARE(out.third().size(), 6);
+    CORRADE_COMPARE_AS(out.third()[0], 0.0f, TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(out.third()[0], 0.0001f, TestSuite::Compare::Less);
+    CORRADE_COMPARE(out.third()[1], 0.0f);
+    CORRADE_COMPARE(out.third()[2], 0.0f);
+    CORRADE_COMPARE_AS(out.third()[3], 0.0f, TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(out.third()[3], 0.00001f, TestSuite::Compare::Less);
+    CORRADE_COMPARE(out.third()[4], 0.0f);
+    CORRADE_COMPARE(out.third()[5], 0.0f);
+}
+
+void QuantizeTest::meshData2DShort() {
+    struct Vertex2D {
+        Vector2 position;
+        Vector3 normal;
+        Vector3 tangent;
+        Vector3 bitangent;
+    };
+    const Vertex2D vertices[]{
+        {{0.0f, 0.0f}, {0.0f, 0.0f, -1.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+        {{4.0f, 2.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}}
+    };
+    const auto view = Containers::stridedArrayView(vertices);
+
+    Containers::Triple<Trade::MeshData, Matrix4, Containers::Array<Float>> out = quantize(Trade::MeshData{MeshPrimitive::Lines, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            view.slice(&Vertex2D::position)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Bitangent,
+            view.slice(&Vertex2D::bitangent)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+            view.slice(&Vertex2D::normal)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Tangent,
+            view.slice(&Vertex2D::tangent)}
+    }}, QuantizeFlag::Positions|QuantizeFlag::OctahedralDirections|QuantizeFlag::OctahedralShort, 5);
+
+    CORRADE_COMPARE(out.first().primitive(), MeshPrimitive::Lines);
+    CORRADE_VERIFY(!out.first().isIndexed());
+    CORRADE_COMPARE(out.first().vertexCount(), 2);
+    CORRADE_COMPARE(out.first().attributeCount(), 4);
+
+    /* Z is left unscaled */
+    CORRADE_COMPARE(out.second(), Matrix4::translation({2.0f, 1.0f, 0.0f})*Matrix4::scaling({2.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(out.first().attributeName(0), Trade::MeshAttribute::Position);
+    CORRADE_COMPARE(out.first().attributeFormat(0), VertexFormat::Vector2sNormalized);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector2s>(0), Containers::arrayView<Vector2s>({
+        {-32767, -32767},
+        {32767, 32767}
+    }), TestSuite::Compare::Container);
+
+    /* Attribute order is preserved, names are offset */
+    CORRADE_COMPARE(out.first().attributeName(1), Trade::meshAttributeCustom(7));
+    CORRADE_COMPARE(out.first().attributeFormat(1), VertexFormat::Vector2sNormalized);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector2s>(1), Containers::arrayView<Vector2s>({
+        {0, 32767},
+        {-32767, 0}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.first().attributeName(2), Trade::meshAttributeCustom(5));
+    CORRADE_COMPARE(out.first().attributeFormat(2), VertexFormat::Vector2sNormalized);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector2s>(2), Containers::arrayView<Vector2s>({
+        {32767, 32767},
+        {0, 0}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.first().attributeName(3), Trade::meshAttributeCustom(6));
+    CORRADE_COMPARE(out.first().attributeFormat(3), VertexFormat::Vector2sNormalized);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector2s>(3), Containers::arrayView<Vector2s>({
+        {32767, 0},
+        {0, 32767}
+    }), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE_AS(out.third(), Containers::arrayView({
+        0.0f, 0.0f, 0.0f, 0.0f
+    }), TestSuite::Compare::Container);
+}
+
+void QuantizeTest::meshDataTextureCoordinatesOnly() {
+    Containers::Triple<Trade::MeshData, Matrix4, Containers::Array<Float>> out = quantize(mesh(), QuantizeFlag::TextureCoordinates);
+
+    CORRADE_COMPARE(out.second(), Matrix4{});
+    CORRADE_COMPARE(out.first().attributeCount(), 6);
+    CORRADE_COMPARE(out.first().attributeName(0), Trade::MeshAttribute::Position);
+    CORRADE_COMPARE(out.first().attributeFormat(0), VertexFormat::Vector3);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector3>(0),
+        Containers::stridedArrayView(Vertices).slice(&Vertex::position),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.first().attributeName(1), Trade::MeshAttribute::Normal);
+    CORRADE_COMPARE(out.first().attributeFormat(1), VertexFormat::Vector3);
+    CORRADE_COMPARE(out.first().attributeName(2), Trade::MeshAttribute::Tangent);
+    CORRADE_COMPARE(out.first().attributeFormat(2), VertexFormat::Vector4);
+    CORRADE_COMPARE(out.first().attributeFormat(3), VertexFormat::Vector2usNormalized);
+    CORRADE_COMPARE(out.first().attributeFormat(4), VertexFormat::Vector2);
+
+    CORRADE_COMPARE(out.third()[0], 0.0f);
+    CORRADE_COMPARE_AS(out.third()[3], 0.0f, TestSuite::Compare::Greater);
+}
+
+void QuantizeTest::meshDataEmpty() {
+    Containers::Triple<Trade::MeshData, Matrix4, Containers::Array<Float>> out = quantize(Trade::MeshData{MeshPrimitive::Points, 5}, QuantizeFlag::Positions);
+    CORRADE_COMPARE(out.first().primitive(), MeshPrimitive::Points);
+    CORRADE_VERIFY(!out.first().isIndexed());
+    CORRADE_COMPARE(out.first().vertexCount(), 5);
+    CORRADE_COMPARE(out.first().attributeCount(), 0);
+    CORRADE_COMPARE(out.second(), Matrix4{});
+    CORRADE_VERIFY(out.third().isEmpty());
+}
+
+void QuantizeTest::meshDataInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Vector3 positions[3]{};
+    const UnsignedShort indices[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    quantize(Trade::MeshData{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{meshIndexTypeWrap(0xcaca), Containers::stridedArrayView(indices)},
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+        }}, QuantizeFlag::Positions);
+    quantize(Trade::MeshData{MeshPrimitive::Triangles,
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Normal, vertexFormatWrap(0xdead), Containers::stridedArrayView(positions)}
+        }}, QuantizeFlag::Positions);
+    /* Custom attribute with an ID that'd be used for tangents */
+    quantize(Trade::MeshData{MeshPrimitive::Triangles,
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)},
+            Trade::MeshAttributeData{Trade::meshAttributeCustom(4), Containers::arrayView(positions)}
+        }}, QuantizeFlag::OctahedralDirections, 3);
+    /* This is fine, as the directions aren't encoded */
+    quantize(Trade::MeshData{MeshPrimitive::Triangles,
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)},
+            Trade::MeshAttributeData{Trade::meshAttributeCustom(4), Containers::arrayView(positions)}
+        }}, QuantizeFlag::Positions, 3);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::quantize(): mesh has an implementation-specific index type 0xcaca\n"
+        "MeshTools::quantize(): attribute 1 has an implementation-specific format 0xdead\n"
+        "MeshTools::quantize(): the mesh already has a custom attribute 4\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::QuantizeTest)
@@ -25,13 +25,16 @@
 
 #include <algorithm> /* std::shuffle() */
 #include <random> /* random device for std::shuffle() */
+#include <cstring>
 #include <sstream>
+#include <unordered_map>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/MurmurHash2.h>
 
-#include "Magnum/Math/Vector3.h"
+#include "Magnum/Math/Vector4.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/Trade/MeshData.h"
 
@@ -44,6 +47,10 @@ struct RemoveDuplicatesTest: TestSuite::Tester {
     void removeDuplicates();
     void removeDuplicatesNonContiguous();
     void removeDuplicatesIntoWrongOutputSize();
+    template<class T> void removeDuplicatesKeySize();
+    void removeDuplicatesIntoTable();
+    void removeDuplicatesIntoWrongTableSize();
+    void removeDuplicatesIntoThreads();
 
     template<class T> void removeDuplicatesIndexedInPlace();
     void removeDuplicatesIndexedInPlaceSmallType();
@@ -57,6 +64,9 @@ struct RemoveDuplicatesTest: TestSuite::Tester {
     template<class T> void removeDuplicatesFuzzyInPlaceMoreDimensions();
     template<class T> void removeDuplicatesFuzzyInPlaceInto();
     void removeDuplicatesFuzzyInPlaceIntoWrongOutputSize();
+    template<class T> void removeDuplicatesFuzzyGridInPlaceInto();
+    template<class T> void removeDuplicatesFuzzyGridInPlaceIntoCellBoundary();
+    void removeDuplicatesFuzzyGridInPlaceIntoInvalidInput();
     #ifdef MAGNUM_BUILD_DEPRECATED
     void removeDuplicatesFuzzyStl();
     #endif
@@ -82,19 +92,55 @@ struct RemoveDuplicatesTest: TestSuite::Tester {
     void removeDuplicatesMeshDataFuzzyImplementationSpecificIndexType();
     void removeDuplicatesMeshDataFuzzyImplementationSpecificVertexFormat();
 
+    void removeDuplicatesMeshDataFuzzyGrid();
+    void removeDuplicatesMeshDataFuzzyGridAttributeless();
+
     void soakTest();
     void soakTestFuzzy();
 
     void benchmark();
+    template<class T> void benchmarkKeySize();
+    template<class T> void benchmarkKeySizeTable();
+    template<class T> void benchmarkKeySizeUnorderedMap();
+    void benchmarkThreads();
     void benchmarkFuzzy();
 };
 
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadsData[] {
+    {"1 thread", 1},
+    {"2 threads", 2},
+    {"3 threads", 3},
+    {"8 threads", 8},
+    {"17 threads", 17},
+    {"all hardware threads", 0}
+};
+
 const struct {
     const char* name;
     bool indexed;
+    UnsignedInt threadCount;
 } RemoveDuplicatesMeshDataData[] {
-    {"", false},
-    {"indexed", true}
+    {"", false, 1},
+    {"indexed", true, 1},
+    {"4 threads", false, 4},
+    {"indexed, 4 threads", true, 4},
+    {"all hardware threads", false, 0},
+    {"indexed, all hardware threads", true, 0}
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} BenchmarkThreadsData[] {
+    {"1 thread", 1},
+    {"2 threads", 2},
+    {"4 threads", 4},
+    {"8 threads", 8},
+    {"16 threads", 16},
+    {"32 threads", 32}
 };
 
 const struct {
@@ -169,7 +215,18 @@ RemoveDuplicatesTest::RemoveDuplicatesTest() {
     addTests({&RemoveDuplicatesTest::removeDuplicates,
               &RemoveDuplicatesTest::removeDuplicatesNonContiguous,
               &RemoveDuplicatesTest::removeDuplicatesIntoWrongOutputSize,
-              &RemoveDuplicatesTest::removeDuplicatesIndexedInPlace<UnsignedByte>,
+              &RemoveDuplicatesTest::removeDuplicatesKeySize<Vector3i>,
+              &RemoveDuplicatesTest::removeDuplicatesKeySize<Vector4i>,
+              &RemoveDuplicatesTest::removeDuplicatesKeySize<Math::Vector<5, Int>>,
+              &RemoveDuplicatesTest::removeDuplicatesKeySize<Math::Vector<6, Int>>,
+              &RemoveDuplicatesTest::removeDuplicatesKeySize<Math::Vector<8, Int>>,
+              &RemoveDuplicatesTest::removeDuplicatesIntoTable,
+              &RemoveDuplicatesTest::removeDuplicatesIntoWrongTableSize});
+
+    addInstancedTests({&RemoveDuplicatesTest::removeDuplicatesIntoThreads},
+        Containers::arraySize(ThreadsData));
+
+    addTests({&RemoveDuplicatesTest::removeDuplicatesIndexedInPlace<UnsignedByte>,
               &RemoveDuplicatesTest::removeDuplicatesIndexedInPlace<UnsignedShort>,
               &RemoveDuplicatesTest::removeDuplicatesIndexedInPlace<UnsignedInt>,
               &RemoveDuplicatesTest::removeDuplicatesIndexedInPlaceSmallType,
@@ -188,6 +245,11 @@ RemoveDuplicatesTest::RemoveDuplicatesTest() {
               &RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceInto<Float>,
               &RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceInto<Double>,
               &RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceIntoWrongOutputSize,
+              &RemoveDuplicatesTest::removeDuplicatesFuzzyGridInPlaceInto<Float>,
+              &RemoveDuplicatesTest::removeDuplicatesFuzzyGridInPlaceInto<Double>,
+              &RemoveDuplicatesTest::removeDuplicatesFuzzyGridInPlaceIntoCellBoundary<Float>,
+              &RemoveDuplicatesTest::removeDuplicatesFuzzyGridInPlaceIntoCellBoundary<Double>,
+              &RemoveDuplicatesTest::removeDuplicatesFuzzyGridInPlaceIntoInvalidInput,
               #ifdef MAGNUM_BUILD_DEPRECATED
               &RemoveDuplicatesTest::removeDuplicatesFuzzyStl,
               #endif
@@ -225,13 +287,31 @@ RemoveDuplicatesTest::RemoveDuplicatesTest() {
 
               &RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyAttributeless,
               &RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyImplementationSpecificIndexType,
-              &RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyImplementationSpecificVertexFormat});
+              &RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyImplementationSpecificVertexFormat,
+
+              &RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyGrid,
+              &RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyGridAttributeless});
 
     addRepeatedTests({&RemoveDuplicatesTest::soakTest,
                       &RemoveDuplicatesTest::soakTestFuzzy}, 10);
 
     addBenchmarks({&RemoveDuplicatesTest::benchmark,
+                   &RemoveDuplicatesTest::benchmarkKeySize<Vector3i>,
+                   &RemoveDuplicatesTest::benchmarkKeySize<Vector4i>,
+                   &RemoveDuplicatesTest::benchmarkKeySize<Math::Vector<5, Int>>,
+                   &RemoveDuplicatesTest::benchmarkKeySize<Math::Vector<6, Int>>,
+                   &RemoveDuplicatesTest::benchmarkKeySize<Math::Vector<8, Int>>,
+                   &RemoveDuplicatesTest::benchmarkKeySizeTable<Vector3i>,
+                   &RemoveDuplicatesTest::benchmarkKeySizeTable<Math::Vector<8, Int>>,
+                   &RemoveDuplicatesTest::benchmarkKeySizeUnorderedMap<Vector3i>,
+                   &RemoveDuplicatesTest::benchmarkKeySizeUnorderedMap<Vector4i>,
+                   &RemoveDuplicatesTest::benchmarkKeySizeUnorderedMap<Math::Vector<5, Int>>,
+                   &RemoveDuplicatesTest::benchmarkKeySizeUnorderedMap<Math::Vector<6, Int>>,
+                   &RemoveDuplicatesTest::benchmarkKeySizeUnorderedMap<Math::Vector<8, Int>>,
                    &RemoveDuplicatesTest::benchmarkFuzzy}, 10);
+
+    addInstancedBenchmarks({&RemoveDuplicatesTest::benchmarkThreads}, 10,
+        Containers::arraySize(BenchmarkThreadsData));
 }
 
 void RemoveDuplicatesTest::removeDuplicates() {
@@ -286,6 +366,121 @@ void RemoveDuplicatesTest::removeDuplicatesIntoWrongOutputSize() {
         "MeshTools::removeDuplicatesInPlaceInto(): output index array has 7 elements but expected 8\n");
 }
 
+template<class T> void RemoveDuplicatesTest::removeDuplicatesKeySize() {
+    setTestCaseTemplateName(std::to_string(sizeof(T)));
+
+    /* 12, 16, 24 and 32 bytes go through a specialized code path, the rest
+       through a generic one. The results should be the same for all. */
+    T data[]{T{-15}, T{32}, T{24}, T{-15}, T{15}, T{7541}, T{24}, T{32}};
+    data[3][T::Size - 1] = 1;
+
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> result =
+        MeshTools::removeDuplicates(Containers::arrayCast<2, char>(Containers::arrayView(data)));
+    CORRADE_COMPARE_AS(Containers::arrayView(result.first),
+        Containers::arrayView<UnsignedInt>({0, 1, 2, 3, 4, 5, 2, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(result.second, 6);
+
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> resultInPlace =
+        MeshTools::removeDuplicatesInPlace(Containers::arrayCast<2, char>(Containers::arrayView(data)));
+    CORRADE_COMPARE_AS(Containers::arrayView(resultInPlace.first),
+        Containers::arrayView<UnsignedInt>({0, 1, 2, 3, 4, 5, 2, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(resultInPlace.second, 6);
+}
+
+void RemoveDuplicatesTest::removeDuplicatesIntoTable() {
+    Int data[]{-15, 32, 24, -15, 15, 7541, 24, 32};
+    UnsignedInt indices[8];
+
+    /* Non-zero garbage in the table shouldn't affect anything */
+    UnsignedInt table[16];
+    CORRADE_COMPARE(MeshTools::removeDuplicatesTableSize(Containers::arraySize(data)), Containers::arraySize(table));
+    for(UnsignedInt& i: table) i = 0xdeadbeef;
+
+    CORRADE_COMPARE(MeshTools::removeDuplicatesInto(
+        Containers::arrayCast<2, const char>(Containers::arrayView(data)),
+        indices, table), 5);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices),
+        Containers::arrayView<UnsignedInt>({0, 1, 2, 0, 4, 5, 2, 1}),
+        TestSuite::Compare::Container);
+
+    /* Reusing the same table memory again */
+    CORRADE_COMPARE(MeshTools::removeDuplicatesInPlaceInto(
+        Containers::arrayCast<2, char>(Containers::arrayView(data)),
+        indices, table), 5);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices),
+        Containers::arrayView<UnsignedInt>({0, 1, 2, 0, 3, 4, 2, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(data).prefix(5),
+        Containers::arrayView<Int>({-15, 32, 24, 15, 7541}),
+        TestSuite::Compare::Container);
+
+    /* A non-default table size is fine as well */
+    CORRADE_COMPARE(MeshTools::removeDuplicatesInto(
+        Containers::arrayCast<2, const char>(Containers::arrayView(data).prefix(5)),
+        Containers::arrayView(indices).prefix(5),
+        Containers::arrayView(table).prefix(8)), 5);
+}
+
+void RemoveDuplicatesTest::removeDuplicatesIntoWrongTableSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Int data[8]{};
+    UnsignedInt output[8];
+    UnsignedInt table[12];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::removeDuplicatesInto(
+        Containers::arrayCast<2, const char>(Containers::arrayView(data)),
+        output, Containers::arrayView(table).prefix(8));
+    MeshTools::removeDuplicatesInPlaceInto(
+        Containers::arrayCast<2, char>(Containers::arrayView(data)),
+        output, table);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::removeDuplicatesInto(): expected a power-of-two table larger than 8 elements but got 8\n"
+        "MeshTools::removeDuplicatesInPlaceInto(): expected a power-of-two table larger than 8 elements but got 12\n");
+}
+
+void RemoveDuplicatesTest::removeDuplicatesIntoThreads() {
+    auto&& data = ThreadsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Array of 1000 unique items, each present 10 times, shuffled. Output
+       should be the same as with the single-threaded variant regardless of
+       thread count. */
+    Containers::Array<Vector3i> vertices{NoInit, 10000};
+    for(std::size_t i = 0; i != vertices.size(); ++i)
+        vertices[i] = Vector3i{Int(i/10), Int(i/10 % 3), 0};
+    std::shuffle(vertices.begin(), vertices.end(), std::minstd_rand{std::random_device{}()});
+
+    Containers::Array<UnsignedInt> expected{NoInit, vertices.size()};
+    const std::size_t expectedCount = MeshTools::removeDuplicatesInto(
+        Containers::arrayCast<2, const char>(Containers::arrayView(vertices)),
+        expected);
+    CORRADE_COMPARE(expectedCount, 1000);
+
+    Containers::Array<UnsignedInt> actual{NoInit, vertices.size()};
+    CORRADE_COMPARE(MeshTools::removeDuplicatesInto(
+        Containers::arrayCast<2, const char>(Containers::arrayView(vertices)),
+        actual, data.threadCount), expectedCount);
+    CORRADE_COMPARE_AS(Containers::arrayView(actual),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+
+    /* Runtime-sized items go through a different code path */
+    Containers::Array<Math::Vector<5, Int>> verticesRuntimeSize{NoInit, vertices.size()};
+    for(std::size_t i = 0; i != vertices.size(); ++i)
+        verticesRuntimeSize[i] = Math::Vector<5, Int>::pad(vertices[i]);
+    CORRADE_COMPARE(MeshTools::removeDuplicatesInto(
+        Containers::arrayCast<2, const char>(Containers::arrayView(verticesRuntimeSize)),
+        actual, data.threadCount), expectedCount);
+    CORRADE_COMPARE_AS(Containers::arrayView(actual),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
 template<class T> void RemoveDuplicatesTest::removeDuplicatesIndexedInPlace() {
     setTestCaseTemplateName(Math::TypeTraits<T>::name());
 
@@ -467,6 +662,89 @@ void RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceIntoWrongOutputSize() {
         "MeshTools::removeDuplicatesFuzzyInPlaceInto(): output index array has 7 elements but expected 8\n");
 }
 
+template<class T> void RemoveDuplicatesTest::removeDuplicatesFuzzyGridInPlaceInto() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    Math::Vector2<T> data[]{
+        {T(1.0), T(5.0)},
+        {T(1.05), T(5.0)},  /* close to the first */
+        {T(1.2), T(5.0)},   /* too far from both */
+        {T(0.95), T(5.0)},  /* close to the first */
+        {T(1.0), T(5.05)},  /* close to the first in the other dimension */
+        {T(1.0), T(7.0)},   /* too far in the other dimension */
+        {T(1.19), T(5.0)}   /* close to the third */
+    };
+
+    const T epsilons[]{T(0.1), T(0.1)};
+    UnsignedInt indices[7];
+    std::size_t count = MeshTools::removeDuplicatesFuzzyGridInPlaceInto(
+        Containers::arrayCast<2, T>(Containers::arrayView(data)),
+        indices, epsilons);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices),
+        Containers::arrayView<UnsignedInt>({0, 0, 1, 0, 0, 2, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(data).prefix(count),
+        (Containers::arrayView<Math::Vector2<T>>({
+            {T(1.0), T(5.0)},
+            {T(1.2), T(5.0)},
+            {T(1.0), T(7.0)}
+        })), TestSuite::Compare::Container);
+
+    /* Zero epsilon in the second dimension makes it compared exactly */
+    const T epsilonsExact[]{T(0.1), T(0.0)};
+    count = MeshTools::removeDuplicatesFuzzyGridInPlaceInto(
+        Containers::arrayCast<2, T>(Containers::arrayView(data).prefix(count)),
+        Containers::arrayView(indices).prefix(count), epsilonsExact);
+    CORRADE_COMPARE(count, 3);
+}
+
+template<class T> void RemoveDuplicatesTest::removeDuplicatesFuzzyGridInPlaceIntoCellBoundary() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    /* With epsilon 0.1 the cell size is 0.2, so the second and third item
+       are in different cells but still get merged together, while the first
+       and the last item are too far away from the others */
+    T data[]{T(0.0), T(0.199), T(0.201), T(0.4)};
+
+    const T epsilons[]{T(0.1)};
+    UnsignedInt indices[4];
+    const std::size_t count = MeshTools::removeDuplicatesFuzzyGridInPlaceInto(
+        Containers::arrayCast<2, T>(Containers::arrayView(data)),
+        indices, epsilons);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices),
+        Containers::arrayView<UnsignedInt>({0, 1, 1, 2}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(data).prefix(count),
+        Containers::arrayView<T>({T(0.0), T(0.199), T(0.4)}),
+        TestSuite::Compare::Container);
+}
+
+void RemoveDuplicatesTest::removeDuplicatesFuzzyGridInPlaceIntoInvalidInput() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Vector2 data[8]{};
+    UnsignedInt output[8];
+    UnsignedInt outputWrongSize[7];
+    const Float epsilons[]{0.1f, 0.1f};
+    const Float epsilonsNegative[]{0.1f, -0.1f};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::removeDuplicatesFuzzyGridInPlaceInto(
+        Containers::arrayCast<2, Float>(Containers::arrayView(data)),
+        outputWrongSize, epsilons);
+    MeshTools::removeDuplicatesFuzzyGridInPlaceInto(
+        Containers::arrayCast<2, Float>(Containers::arrayView(data)),
+        output, Containers::arrayView(epsilons).prefix(1));
+    MeshTools::removeDuplicatesFuzzyGridInPlaceInto(
+        Containers::arrayCast<2, Float>(Containers::arrayView(data)),
+        output, epsilonsNegative);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::removeDuplicatesFuzzyGridInPlaceInto(): output index array has 7 elements but expected 8\n"
+        "MeshTools::removeDuplicatesFuzzyGridInPlaceInto(): expected 2 epsilon values but got 1\n"
+        "MeshTools::removeDuplicatesFuzzyGridInPlaceInto(): expected non-negative epsilon values but got -0.1 for dimension 1\n");
+}
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 void RemoveDuplicatesTest::removeDuplicatesFuzzyStl() {
     /* Same but with implicit bloat. HEH HEH */
@@ -653,7 +931,9 @@ void RemoveDuplicatesTest::removeDuplicatesMeshData() {
                 Containers::stridedArrayView(vertexData->data), 2},
     }};
 
-    Trade::MeshData unique = MeshTools::removeDuplicates(mesh);
+    Trade::MeshData unique = data.threadCount == 1 ?
+        MeshTools::removeDuplicates(mesh) :
+        MeshTools::removeDuplicates(mesh, data.threadCount);
     CORRADE_COMPARE(unique.primitive(), MeshPrimitive::Lines);
 
     CORRADE_VERIFY(unique.isIndexed());
@@ -1176,6 +1456,90 @@ void RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyImplementationSpecificVe
         "MeshTools::removeDuplicatesFuzzy(): attribute 1 has an implementation-specific format 0xcaca\n");
 }
 
+void RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyGrid() {
+    /* Deliberately not interleaved to verify that the function will handle
+       this */
+    const struct Vertex {
+        Vector3 positions[6]{
+            {1.0f, 2.0f, 3.0f},
+            /* Gets collapsed to the above */
+            {1.0f + Math::TypeTraits<Float>::epsilon()*2.0f, 2.0f, 3.0f},
+            {4.0f, 5.0f, 6.0f},
+            /* Same position as the first, but different normal */
+            {1.0f, 2.0f, 3.0f},
+            /* Same position and normal as the first, but different ID */
+            {1.0f, 2.0f, 3.0f},
+            /* Same as the first */
+            {1.0f, 2.0f, 3.0f}
+        };
+        Vector3 normals[6]{
+            {0.0f, 0.0f, 1.0f},
+            {0.0f, 0.0f, 1.0f},
+            {0.0f, 0.0f, 1.0f},
+            {0.0f, 1.0f, 0.0f},
+            {0.0f, 0.0f, 1.0f},
+            {0.0f, 0.0f, 1.0f}
+        };
+        UnsignedShort objectIds[6]{
+            3, 3, 3, 3, 4, 3
+        };
+    } vertexData[1]{};
+
+    const UnsignedByte indexData[]{5, 4, 3, 2, 1, 0};
+
+    Trade::MeshData mesh{MeshPrimitive::Points,
+        {}, indexData, Trade::MeshIndexData{indexData},
+        {}, vertexData, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(vertexData->positions)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+                Containers::arrayView(vertexData->normals)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::ObjectId,
+                Containers::arrayView(vertexData->objectIds)}
+    }};
+
+    Trade::MeshData unique = MeshTools::removeDuplicatesFuzzyGrid(mesh);
+    CORRADE_COMPARE(unique.primitive(), MeshPrimitive::Points);
+    CORRADE_VERIFY(unique.isIndexed());
+    CORRADE_COMPARE(unique.indexType(), MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE_AS(unique.indices<UnsignedByte>(),
+        Containers::arrayView<UnsignedByte>({0, 3, 2, 1, 0, 0}),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(unique.vertexCount(), 4);
+    CORRADE_COMPARE(unique.attributeCount(), 3);
+    CORRADE_COMPARE_AS(unique.attribute<Vector3>(Trade::MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {1.0f, 2.0f, 3.0f},
+            {4.0f, 5.0f, 6.0f},
+            {1.0f, 2.0f, 3.0f},
+            {1.0f, 2.0f, 3.0f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(unique.attribute<Vector3>(Trade::MeshAttribute::Normal),
+        Containers::arrayView<Vector3>({
+            {0.0f, 0.0f, 1.0f},
+            {0.0f, 0.0f, 1.0f},
+            {0.0f, 1.0f, 0.0f},
+            {0.0f, 0.0f, 1.0f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(unique.attribute<UnsignedShort>(Trade::MeshAttribute::ObjectId),
+        Containers::arrayView<UnsignedShort>({3, 3, 3, 4}),
+        TestSuite::Compare::Container);
+
+    /* The input shouldn't be modified */
+    CORRADE_COMPARE(vertexData->positions[1], (Vector3{1.0f + Math::TypeTraits<Float>::epsilon()*2.0f, 2.0f, 3.0f}));
+}
+
+void RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyGridAttributeless() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::removeDuplicatesFuzzyGrid(Trade::MeshData{MeshPrimitive::Points, 10});
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::removeDuplicatesFuzzyGrid(): can't remove duplicates in an attributeless mesh\n");
+}
+
 void RemoveDuplicatesTest::soakTest() {
     /* Array of 100 unique items with 10 duplicates each, randomly shuffled */
     UnsignedInt data[1000];
@@ -1218,6 +1582,99 @@ void RemoveDuplicatesTest::benchmark() {
     CORRADE_COMPARE(count, 100);
 }
 
+template<class T> void RemoveDuplicatesTest::benchmarkKeySize() {
+    setTestCaseTemplateName(std::to_string(sizeof(T)));
+
+    /* Array of 10000 unique items with 10 duplicates each, shuffled */
+    Containers::Array<T> data{NoInit, 100000};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = T{Int(i/10)};
+    std::shuffle(data.begin(), data.end(), std::minstd_rand{std::random_device{}()});
+
+    std::size_t count;
+    Containers::Array<UnsignedInt> indices{NoInit, data.size()};
+    CORRADE_BENCHMARK(1)
+        count = MeshTools::removeDuplicatesInto(
+            Containers::arrayCast<2, const char>(Containers::arrayView(data)),
+            indices);
+
+    CORRADE_COMPARE(count, 10000);
+}
+
+template<class T> void RemoveDuplicatesTest::benchmarkKeySizeTable() {
+    setTestCaseTemplateName(std::to_string(sizeof(T)));
+
+    /* Same as above, but with the table memory allocated upfront */
+    Containers::Array<T> data{NoInit, 100000};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = T{Int(i/10)};
+    std::shuffle(data.begin(), data.end(), std::minstd_rand{std::random_device{}()});
+
+    std::size_t count;
+    Containers::Array<UnsignedInt> indices{NoInit, data.size()};
+    Containers::Array<UnsignedInt> table{NoInit, MeshTools::removeDuplicatesTableSize(data.size())};
+    CORRADE_BENCHMARK(1)
+        count = MeshTools::removeDuplicatesInto(
+            Containers::arrayCast<2, const char>(Containers::arrayView(data)),
+            indices, table);
+
+    CORRADE_COMPARE(count, 10000);
+}
+
+template<class T> void RemoveDuplicatesTest::benchmarkKeySizeUnorderedMap() {
+    setTestCaseTemplateName(std::to_string(sizeof(T)));
+
+    /* Same as above, but with the std::unordered_map-based implementation
+       that was used before, for comparison */
+    Containers::Array<T> data{NoInit, 100000};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = T{Int(i/10)};
+    std::shuffle(data.begin(), data.end(), std::minstd_rand{std::random_device{}()});
+
+    struct ArrayEqual {
+        bool operator()(const void* a, const void* b) const {
+            return std::memcmp(a, b, sizeof(T)) == 0;
+        }
+    };
+
+    struct ArrayHash {
+        std::size_t operator()(const void* a) const {
+            return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2{}(static_cast<const char*>(a), sizeof(T)).byteArray());
+        }
+    };
+
+    std::size_t count;
+    Containers::Array<UnsignedInt> indices{NoInit, data.size()};
+    CORRADE_BENCHMARK(1) {
+        std::unordered_map<const void*, UnsignedInt, ArrayHash, ArrayEqual> table{data.size()};
+        for(std::size_t i = 0; i != data.size(); ++i)
+            indices[i] = table.emplace(&data[i], i).first->second;
+        count = table.size();
+    }
+
+    CORRADE_COMPARE(count, 10000);
+}
+
+void RemoveDuplicatesTest::benchmarkThreads() {
+    auto&& data = BenchmarkThreadsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Array of 100k unique items with 10 duplicates each, shuffled */
+    Containers::Array<Vector3i> vertices{NoInit, 1000000};
+    for(std::size_t i = 0; i != vertices.size(); ++i)
+        vertices[i] = Vector3i{Int(i/10)};
+    std::shuffle(vertices.begin(), vertices.end(), std::minstd_rand{std::random_device{}()});
+
+    std::size_t count;
+    Containers::Array<UnsignedInt> indices{NoInit, vertices.size()};
+    CORRADE_BENCHMARK(1)
+        count = MeshTools::removeDuplicatesInto(
+            Containers::arrayCast<2, const char>(Containers::arrayView(vertices)),
+            indices, data.threadCount);
+
+    CORRADE_COMPARE(count, 100000);
+}
+
 void RemoveDuplicatesTest::benchmarkFuzzy() {
     /* Array of 100 unique items with 100 duplicates each, shuffled */
     Vector3 data[10000];
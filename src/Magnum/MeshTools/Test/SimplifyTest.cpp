@@ -0,0 +1,343 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Simplify.h"
+#include "Magnum/Primitives/Grid.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct SimplifyTest: TestSuite::Tester {
+    explicit SimplifyTest();
+
+    template<class T> void planar();
+    void lockBorder();
+    void errorLimit();
+    void attributes();
+    void seam();
+    void empty();
+    void invalid();
+
+    void meshData();
+    void meshDataInvalid();
+
+    void lods();
+    void lodsInvalid();
+};
+
+SimplifyTest::SimplifyTest() {
+    addTests({&SimplifyTest::planar<UnsignedByte>,
+              &SimplifyTest::planar<UnsignedShort>,
+              &SimplifyTest::planar<UnsignedInt>,
+              &SimplifyTest::lockBorder,
+              &SimplifyTest::errorLimit,
+              &SimplifyTest::attributes,
+              &SimplifyTest::seam,
+              &SimplifyTest::empty,
+              &SimplifyTest::invalid,
+
+              &SimplifyTest::meshData,
+              &SimplifyTest::meshDataInvalid,
+
+              &SimplifyTest::lods,
+              &SimplifyTest::lodsInvalid});
+}
+
+/* A planar 5x5 vertex grid facing +Z, vertex 0 is at {-1, -1}, vertex 4 at
+   {1, -1}, vertex 20 at {-1, 1} and vertex 24 at {1, 1} */
+Trade::MeshData grid() {
+    return Primitives::grid3DSolid({4, 4}, {});
+}
+
+template<class T> Containers::Array<T> gridIndices() {
+    const Containers::Array<UnsignedInt> indices = grid().indicesAsArray();
+    Containers::Array<T> out{NoInit, indices.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        out[i] = indices[i];
+    return out;
+}
+
+template<class T> void SimplifyTest::planar() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    const Containers::Array<Vector3> positions = grid().positions3DAsArray();
+    Containers::Array<T> indices = gridIndices<T>();
+    CORRADE_COMPARE(indices.size(), 96);
+
+    /* Everything is coplanar and the border is straight, so it collapses
+       without any error to just the four corners */
+    const Containers::Pair<std::size_t, Float> out = MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, 6, 0.001f);
+    CORRADE_COMPARE(out.first(), 6);
+    CORRADE_COMPARE(out.second(), 0.0f);
+    CORRADE_COMPARE_AS(indices.prefix(out.first()), Containers::arrayView<T>({
+        4, 24, 0, 0, 24, 20
+    }), TestSuite::Compare::Container);
+}
+
+void SimplifyTest::lockBorder() {
+    const Containers::Array<Vector3> positions = grid().positions3DAsArray();
+    Containers::Array<UnsignedInt> indices = gridIndices<UnsignedInt>();
+
+    /* Only the nine inner vertices can be collapsed, the 16 border vertices
+       stay, forming a fan of 14 triangles */
+    const Containers::Pair<std::size_t, Float> out = MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, 0, 0.001f, SimplifyFlag::LockBorder);
+    CORRADE_COMPARE(out.first(), 42);
+    CORRADE_COMPARE(out.second(), 0.0f);
+    CORRADE_COMPARE_AS(indices.prefix(out.first()), Containers::arrayView<UnsignedInt>({
+        3, 9, 2, 3, 4, 9, 2, 14, 1, 2, 9, 14, 1, 19, 0, 1, 14, 19,
+        15, 21, 20, 15, 10, 21, 10, 22, 21, 10, 5, 22, 5, 23, 22, 5, 0, 23,
+        0, 24, 23, 0, 19, 24
+    }), TestSuite::Compare::Container);
+}
+
+void SimplifyTest::errorLimit() {
+    /* Raise the center vertex */
+    Containers::Array<Vector3> positions = grid().positions3DAsArray();
+    positions[12].z() = 0.5f;
+
+    /* With a small error the bump stays, the flat parts around get
+       simplified */
+    {
+        Containers::Array<UnsignedInt> indices = gridIndices<UnsignedInt>();
+        const Containers::Pair<std::size_t, Float> out = MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, 0, 0.01f);
+        CORRADE_COMPARE(out.first(), 54);
+        CORRADE_COMPARE_AS(out.second(), 0.01f, TestSuite::Compare::LessOrEqual);
+
+        bool found = false;
+        for(UnsignedInt i: indices.prefix(out.first()))
+            if(i == 12) found = true;
+        CORRADE_VERIFY(found);
+
+    /* With a large error the bump gets collapsed as well */
+    } {
+        Containers::Array<UnsignedInt> indices = gridIndices<UnsignedInt>();
+        const Containers::Pair<std::size_t, Float> out = MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, 0, 1.0f);
+        CORRADE_COMPARE(out.first(), 6);
+        CORRADE_COMPARE_AS(out.second(), 0.0f, TestSuite::Compare::Greater);
+        CORRADE_COMPARE_AS(out.second(), 1.0f, TestSuite::Compare::LessOrEqual);
+        CORRADE_COMPARE_AS(indices.prefix(out.first()), Containers::arrayView<UnsignedInt>({
+            0, 4, 24, 0, 24, 20
+        }), TestSuite::Compare::Container);
+    }
+}
+
+void SimplifyTest::attributes() {
+    Trade::MeshData mesh = Primitives::grid3DSolid({4, 4}, Primitives::GridFlag::TextureCoordinates);
+    const Containers::Array<Vector3> positions = mesh.positions3DAsArray();
+    const Containers::Array<Vector2> textureCoordinates = mesh.textureCoordinates2DAsArray();
+    const Containers::StridedArrayView2D<const Float> attributes = Containers::arrayCast<2, const Float>(Containers::stridedArrayView(textureCoordinates));
+
+    /* Neighboring texture coordinates differ by 0.25, which is over the
+       error limit */
+    {
+        Containers::Array<UnsignedInt> indices = mesh.indicesAsArray();
+        const Float weights[]{1.0f, 1.0f};
+        const Containers::Pair<std::size_t, Float> out = MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, attributes, Containers::stridedArrayView(weights), 0, 0.1f);
+        CORRADE_COMPARE(out.first(), 96);
+        CORRADE_COMPARE(out.second(), 0.0f);
+
+    /* With zero weights it's the same as if there were no attributes */
+    } {
+        Containers::Array<UnsignedInt> indices = mesh.indicesAsArray();
+        const Float weights[]{0.0f, 0.0f};
+        const Containers::Pair<std::size_t, Float> out = MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, attributes, Containers::stridedArrayView(weights), 0, 0.1f);
+        CORRADE_COMPARE(out.first(), 6);
+        CORRADE_COMPARE(out.second(), 0.0f);
+    }
+}
+
+void SimplifyTest::seam() {
+    /* Duplicate the center vertex and make the upper half of the grid use
+       the duplicate */
+    Containers::Array<Vector3> positions{NoInit, 26};
+    {
+        const Containers::Array<Vector3> gridPositions = grid().positions3DAsArray();
+        for(std::size_t i = 0; i != 25; ++i)
+            positions[i] = gridPositions[i];
+        positions[25] = positions[12];
+    }
+    Containers::Array<UnsignedInt> indices = gridIndices<UnsignedInt>();
+    for(std::size_t i = 48; i != indices.size(); ++i)
+        if(indices[i] == 12) indices[i] = 25;
+
+    /* Neither of the two vertices is moved so they stay together */
+    const Containers::Pair<std::size_t, Float> out = MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, 0, 0.01f);
+    CORRADE_COMPARE(out.first(), 30);
+    CORRADE_COMPARE_AS(indices.prefix(out.first()), Containers::arrayView<UnsignedInt>({
+        5, 0, 11, 0, 12, 11, 0, 13, 12, 0, 4, 13, 4, 24, 13,
+        13, 24, 25, 5, 22, 20, 5, 11, 22, 11, 25, 22, 25, 24, 22
+    }), TestSuite::Compare::Container);
+}
+
+void SimplifyTest::empty() {
+    const Containers::Pair<std::size_t, Float> out = MeshTools::simplifyInPlace(Containers::StridedArrayView1D<UnsignedInt>{}, Containers::StridedArrayView1D<const Vector3>{}, 0, 0.01f);
+    CORRADE_COMPARE(out.first(), 0);
+    CORRADE_COMPARE(out.second(), 0.0f);
+}
+
+void SimplifyTest::invalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedInt indices[]{0, 1, 2, 3, 4, 5};
+    const Vector3 positions[5]{};
+    const Float attributes[5*2]{};
+    const Float weights[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::simplifyInPlace(Containers::stridedArrayView(indices).prefix(5), positions, 0, 0.01f);
+    MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, 0, 0.01f);
+    MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, Containers::StridedArrayView2D<const Float>{attributes, {4, 2}}, Containers::stridedArrayView(weights).prefix(2), 0, 0.01f);
+    MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, Containers::StridedArrayView2D<const Float>{attributes, {5, 2}}, Containers::stridedArrayView(weights), 0, 0.01f);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplifyInPlace(): index count not divisible by 3\n"
+        "MeshTools::simplifyInPlace(): index 5 out of range for 5 vertices\n"
+        "MeshTools::simplifyInPlace(): expected 5 attribute items but got 4\n"
+        "MeshTools::simplifyInPlace(): expected 2 attribute weights but got 3\n");
+}
+
+void SimplifyTest::meshData() {
+    Trade::MeshData mesh = Primitives::grid3DSolid({4, 4}, Primitives::GridFlag::Normals|Primitives::GridFlag::TextureCoordinates);
+
+    /* Normals are all the same so they don't prevent anything, texture
+       coordinates are ignored */
+    Trade::MeshData out = MeshTools::simplify(mesh, 6, 0.001f, {}, 1.0f, 0.0f);
+    CORRADE_COMPARE(out.primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(out.isIndexed());
+    CORRADE_COMPARE(out.indexType(), MeshIndexType::UnsignedInt);
+    CORRADE_COMPARE_AS(out.indices<UnsignedInt>(), Containers::arrayView<UnsignedInt>({
+        0, 1, 2, 2, 1, 3
+    }), TestSuite::Compare::Container);
+
+    /* Only the used vertices are kept, in order of first use */
+    CORRADE_COMPARE(out.vertexCount(), 4);
+    CORRADE_COMPARE(out.attributeCount(), 3);
+    CORRADE_COMPARE_AS(out.attribute<Vector3>(Trade::MeshAttribute::Position), Containers::arrayView<Vector3>({
+        { 1.0f, -1.0f, 0.0f},
+        { 1.0f,  1.0f, 0.0f},
+        {-1.0f, -1.0f, 0.0f},
+        {-1.0f,  1.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<Vector3>(Trade::MeshAttribute::Normal), Containers::arrayView<Vector3>({
+        Vector3::zAxis(), Vector3::zAxis(), Vector3::zAxis(), Vector3::zAxis()
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates), Containers::arrayView<Vector2>({
+        {1.0f, 0.0f},
+        {1.0f, 1.0f},
+        {0.0f, 0.0f},
+        {0.0f, 1.0f}
+    }), TestSuite::Compare::Container);
+
+    /* With texture coordinates taken into account, nothing can be
+       collapsed */
+    Trade::MeshData outTextureCoordinates = MeshTools::simplify(mesh, 6, 0.1f);
+    CORRADE_COMPARE(outTextureCoordinates.indexCount(), 96);
+    CORRADE_COMPARE(outTextureCoordinates.vertexCount(), 25);
+}
+
+void SimplifyTest::meshDataInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Vector3 positions[3]{};
+    const UnsignedShort indices[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::simplify(Trade::MeshData{MeshPrimitive::Lines, 2}, 0, 0.01f);
+    MeshTools::simplify(Trade::MeshData{MeshPrimitive::Triangles,
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+        }}, 0, 0.01f);
+    MeshTools::simplify(Trade::MeshData{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{meshIndexTypeWrap(0xcaca), Containers::stridedArrayView(indices)},
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+        }}, 0, 0.01f);
+    MeshTools::simplify(Trade::MeshData{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices}, 3}, 0, 0.01f);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplify(): expected MeshPrimitive::Triangles but got MeshPrimitive::Lines\n"
+        "MeshTools::simplify(): the mesh is not indexed\n"
+        "MeshTools::simplify(): mesh has an implementation-specific index type 0xcaca\n"
+        "MeshTools::simplify(): the mesh has no positions\n");
+}
+
+void SimplifyTest::lods() {
+    Trade::MeshData mesh = grid();
+
+    /* Each level has roughly half the indices of the previous one, the last
+       requested level would be the same as the previous one so it's not
+       included */
+    Containers::Array<Trade::MeshData> out = MeshTools::simplifyLods(mesh, 10, 0.5f, 0.05f);
+    CORRADE_COMPARE(out.size(), 5);
+    CORRADE_COMPARE(out[0].indexCount(), 96);
+    CORRADE_COMPARE(out[0].vertexCount(), 25);
+    CORRADE_COMPARE(out[1].indexCount(), 48);
+    CORRADE_COMPARE(out[1].vertexCount(), 12);
+    CORRADE_COMPARE(out[2].indexCount(), 24);
+    CORRADE_COMPARE(out[2].vertexCount(), 8);
+    CORRADE_COMPARE(out[3].indexCount(), 9);
+    CORRADE_COMPARE(out[3].vertexCount(), 5);
+    CORRADE_COMPARE(out[4].indexCount(), 6);
+    CORRADE_COMPARE(out[4].vertexCount(), 4);
+
+    /* The first level is a copy of the original */
+    CORRADE_COMPARE_AS(out[0].indices<UnsignedInt>(), mesh.indices<UnsignedInt>(), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out[0].attribute<Vector3>(Trade::MeshAttribute::Position), mesh.attribute<Vector3>(Trade::MeshAttribute::Position), TestSuite::Compare::Container);
+
+    /* Limiting the level count */
+    Containers::Array<Trade::MeshData> outLimited = MeshTools::simplifyLods(mesh, 2, 0.5f, 0.05f);
+    CORRADE_COMPARE(outLimited.size(), 2);
+    CORRADE_COMPARE(outLimited[1].indexCount(), 48);
+}
+
+void SimplifyTest::lodsInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::MeshData mesh = grid();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::simplifyLods(mesh, 0);
+    MeshTools::simplifyLods(mesh, 2, 1.0f);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplifyLods(): expected non-zero level count\n"
+        "MeshTools::simplifyLods(): expected index count ratio to be between 0 and 1 but got 1\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SimplifyTest)
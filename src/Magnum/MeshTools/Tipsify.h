@@ -54,6 +54,7 @@ array for beter usage of post-transform vertex cache. Algorithm used:
 * *Pedro V. Sander, Diego Nehab, and Joshua Barczak --- Fast Triangle Reordering
 for Vertex Locality and Reduced Overdraw, SIGGRAPH 2007,
 https://gfx.cs.princeton.edu/pubs/Sander_2007_%3eTR/tipsy.pdf*.
+@see @ref optimizeVertexCacheInPlace(), @ref vertexCacheStatistics()
 @todo Ability to compute vertex count automatically
 */
 MAGNUM_MESHTOOLS_EXPORT void tipsifyInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, UnsignedInt vertexCount, std::size_t cacheSize);
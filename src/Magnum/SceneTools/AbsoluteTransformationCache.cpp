@@ -0,0 +1,228 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AbsoluteTransformationCache.h"
+
+#include <algorithm>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Trade/SceneData.h"
+#include "Magnum/SceneTools/OrderClusterParents.h"
+
+namespace Magnum { namespace SceneTools {
+
+namespace {
+
+template<UnsignedInt> struct SceneDataDimensionTraits;
+template<> struct SceneDataDimensionTraits<2> {
+    static bool isDimensions(const Trade::SceneData& scene) {
+        return scene.is2D();
+    }
+    static void transformationsInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<UnsignedInt>& mappingDestination, const Containers::StridedArrayView1D<Matrix3>& transformationDestination) {
+        return scene.transformations2DInto(mappingDestination, transformationDestination);
+    }
+};
+template<> struct SceneDataDimensionTraits<3> {
+    static bool isDimensions(const Trade::SceneData& scene) {
+        return scene.is3D();
+    }
+    static void transformationsInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<UnsignedInt>& mappingDestination, const Containers::StridedArrayView1D<Matrix4>& transformationDestination) {
+        return scene.transformations3DInto(mappingDestination, transformationDestination);
+    }
+};
+
+}
+
+template<UnsignedInt dimensions> AbsoluteTransformationCache<dimensions>::AbsoluteTransformationCache(const Trade::SceneData& scene, const MatrixTypeFor<dimensions, Float>& globalTransformation) {
+    CORRADE_ASSERT(SceneDataDimensionTraits<dimensions>::isDimensions(scene),
+        "SceneTools::AbsoluteTransformationCache: the scene is not" << dimensions << Debug::nospace << "D", );
+    const Containers::Optional<UnsignedInt> parentFieldId = scene.findFieldId(Trade::SceneField::Parent);
+    CORRADE_ASSERT(parentFieldId,
+        "SceneTools::AbsoluteTransformationCache: the scene has no hierarchy", );
+
+    const std::size_t objectCount = scene.mappingBound();
+    const std::size_t parentCount = scene.fieldSize(*parentFieldId);
+    _data = Containers::ArrayTuple{
+        {NoInit, objectCount, _localTransformations},
+        {NoInit, objectCount + 1, _absoluteTransformations},
+        {NoInit, objectCount, _parents},
+        {NoInit, objectCount, _depths},
+        {ValueInit, objectCount + 2, _childOffsets},
+        {NoInit, parentCount, _children},
+        {ValueInit, objectCount, _dirty}
+    };
+
+    /* Temporary storage for data extracted from the scene */
+    Containers::ArrayView<Containers::Pair<UnsignedInt, Int>> orderedClusteredParents;
+    Containers::ArrayView<Containers::Pair<UnsignedInt, MatrixTypeFor<dimensions, Float>>> transformations;
+    Containers::ArrayTuple storage{
+        /* Output of orderClusterParentsInto() */
+        {NoInit, parentCount, orderedClusteredParents},
+        /* Output of scene.transformationsXDInto() */
+        {NoInit, scene.transformationFieldSize(), transformations}
+    };
+    orderClusterParentsInto(scene,
+        stridedArrayView(orderedClusteredParents).slice(&decltype(orderedClusteredParents)::Type::first),
+        stridedArrayView(orderedClusteredParents).slice(&decltype(orderedClusteredParents)::Type::second));
+    SceneDataDimensionTraits<dimensions>::transformationsInto(scene,
+        stridedArrayView(transformations).slice(&decltype(transformations)::Type::first),
+        stridedArrayView(transformations).slice(&decltype(transformations)::Type::second));
+
+    /* Local transformations indexed by object ID, identity for objects that
+       don't have any */
+    for(MatrixTypeFor<dimensions, Float>& transformation: _localTransformations)
+        transformation = MatrixTypeFor<dimensions, Float>{};
+    for(const Containers::Pair<UnsignedInt, MatrixTypeFor<dimensions, Float>>& transformation: transformations) {
+        CORRADE_INTERNAL_ASSERT(transformation.first() < objectCount);
+        _localTransformations[transformation.first()] = transformation.second();
+    }
+
+    /* Objects that aren't a part of the hierarchy have the absolute
+       transformation same as local, the rest gets overwritten below */
+    _absoluteTransformations[0] = globalTransformation;
+    for(std::size_t i = 0; i != objectCount; ++i) {
+        _absoluteTransformations[i + 1] = _localTransformations[i];
+        _parents[i] = -2;
+        _depths[i] = 0;
+    }
+
+    /* Calculate the absolute transformations, parent references and depths
+       in a single pass, as parents are always before their children. Count
+       the children of each object at the same time. */
+    for(const Containers::Pair<UnsignedInt, Int>& parentOffset: orderedClusteredParents) {
+        const UnsignedInt object = parentOffset.first();
+        const Int parent = parentOffset.second();
+        _parents[object] = parent;
+        _depths[object] = parent == -1 ? 0 : _depths[parent] + 1;
+        _absoluteTransformations[object + 1] =
+            _absoluteTransformations[parent + 1]*
+            _localTransformations[object];
+        ++_childOffsets[parent + 2];
+    }
+
+    /* Turn the counts into offsets and then fill the children, using the
+       offsets as insertion cursors. Before the fill, _childOffsets[i + 1]
+       points to the start of children of object i, the fill advances it to
+       their end, which is the start of children of object i + 1. Thus after
+       that, children of the root are in [0, _childOffsets[0]) and children
+       of object i in [_childOffsets[i], _childOffsets[i + 1]). */
+    for(std::size_t i = 1; i != _childOffsets.size(); ++i)
+        _childOffsets[i] += _childOffsets[i - 1];
+    for(const Containers::Pair<UnsignedInt, Int>& parentOffset: orderedClusteredParents)
+        _children[_childOffsets[parentOffset.second() + 1]++] = parentOffset.first();
+}
+
+template<UnsignedInt dimensions> AbsoluteTransformationCache<dimensions>::AbsoluteTransformationCache(AbsoluteTransformationCache<dimensions>&&) noexcept = default;
+
+template<UnsignedInt dimensions> AbsoluteTransformationCache<dimensions>::~AbsoluteTransformationCache() = default;
+
+template<UnsignedInt dimensions> AbsoluteTransformationCache<dimensions>& AbsoluteTransformationCache<dimensions>::operator=(AbsoluteTransformationCache<dimensions>&&) noexcept = default;
+
+template<UnsignedInt dimensions> MatrixTypeFor<dimensions, Float> AbsoluteTransformationCache<dimensions>::globalTransformation() const {
+    return _absoluteTransformations[0];
+}
+
+template<UnsignedInt dimensions> AbsoluteTransformationCache<dimensions>& AbsoluteTransformationCache<dimensions>::setGlobalTransformation(const MatrixTypeFor<dimensions, Float>& transformation) {
+    _absoluteTransformations[0] = transformation;
+    for(std::size_t i = 0, end = _childOffsets[0]; i != end; ++i)
+        markDirty(_children[i]);
+    return *this;
+}
+
+template<UnsignedInt dimensions> MatrixTypeFor<dimensions, Float> AbsoluteTransformationCache<dimensions>::localTransformation(const std::size_t object) const {
+    CORRADE_ASSERT(object < _localTransformations.size(),
+        "SceneTools::AbsoluteTransformationCache::localTransformation(): index" << object << "out of range for" << _localTransformations.size() << "objects", {});
+    return _localTransformations[object];
+}
+
+template<UnsignedInt dimensions> AbsoluteTransformationCache<dimensions>& AbsoluteTransformationCache<dimensions>::setLocalTransformation(const std::size_t object, const MatrixTypeFor<dimensions, Float>& transformation) {
+    CORRADE_ASSERT(object < _localTransformations.size(),
+        "SceneTools::AbsoluteTransformationCache::setLocalTransformation(): index" << object << "out of range for" << _localTransformations.size() << "objects", *this);
+    _localTransformations[object] = transformation;
+    markDirty(object);
+    return *this;
+}
+
+template<UnsignedInt dimensions> void AbsoluteTransformationCache<dimensions>::markDirty(const UnsignedInt object) {
+    if(_dirty[object]) return;
+    _dirty[object] = true;
+    arrayAppend(_dirtyObjects, object);
+}
+
+template<UnsignedInt dimensions> std::size_t AbsoluteTransformationCache<dimensions>::update() {
+    /* Process the dirty objects from the top of the hierarchy, so when a
+       subtree gets recalculated, its dirty children are already cleaned and
+       skipped below */
+    std::sort(_dirtyObjects.begin(), _dirtyObjects.end(), [this](const UnsignedInt a, const UnsignedInt b) {
+        return _depths[a] < _depths[b];
+    });
+
+    std::size_t count = 0;
+    for(const UnsignedInt dirtyObject: _dirtyObjects) {
+        if(!_dirty[dirtyObject]) continue;
+
+        /* Not a part of the hierarchy, absolute transformation is the same
+           as local */
+        if(_parents[dirtyObject] == -2) {
+            _absoluteTransformations[dirtyObject + 1] = _localTransformations[dirtyObject];
+            _dirty[dirtyObject] = false;
+            ++count;
+            continue;
+        }
+
+        /* Go through the subtree breadth-first, so parents are always
+           calculated before their children */
+        arrayAppend(_queue, dirtyObject);
+        for(std::size_t i = 0; i != _queue.size(); ++i) {
+            const UnsignedInt object = _queue[i];
+            _absoluteTransformations[object + 1] =
+                _absoluteTransformations[_parents[object] + 1]*
+                _localTransformations[object];
+            _dirty[object] = false;
+            arrayAppend(_queue, _children.slice(_childOffsets[object], _childOffsets[object + 1]));
+        }
+
+        count += _queue.size();
+        /** @todo arrayClear(), ffs */
+        arrayResize(_queue, 0);
+    }
+
+    arrayResize(_dirtyObjects, 0);
+    return count;
+}
+
+template<UnsignedInt dimensions> Containers::StridedArrayView1D<const MatrixTypeFor<dimensions, Float>> AbsoluteTransformationCache<dimensions>::absoluteTransformations() const {
+    return _absoluteTransformations.exceptPrefix(1);
+}
+
+template class MAGNUM_SCENETOOLS_EXPORT AbsoluteTransformationCache<2>;
+template class MAGNUM_SCENETOOLS_EXPORT AbsoluteTransformationCache<3>;
+
+}}
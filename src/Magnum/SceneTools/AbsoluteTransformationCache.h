@@ -0,0 +1,216 @@
+#ifndef Magnum_SceneTools_AbsoluteTransformationCache_h
+#define Magnum_SceneTools_AbsoluteTransformationCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneTools::AbsoluteTransformationCache, typedef @ref Magnum::SceneTools::AbsoluteTransformationCache2D, @ref Magnum::SceneTools::AbsoluteTransformationCache3D
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayTuple.h>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/SceneTools/SceneTools.h"
+#include "Magnum/SceneTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace SceneTools {
+
+/**
+@brief Incrementally updated absolute transformation cache
+@m_since_latest
+
+Keeps local and absolute transformations of all objects in a
+@ref Trade::SceneData hierarchy and, compared to calling
+@ref flattenMeshHierarchy3D() again after every change, recalculates only
+subtrees of objects whose transformation changed. Useful for example in
+editors where a small amount of objects in a large scene gets moved every
+frame:
+
+@code{.cpp}
+Trade::SceneData scene = …;
+SceneTools::AbsoluteTransformationCache3D cache{scene};
+
+cache.setLocalTransformation(17, Matrix4::translation(…));
+cache.setLocalTransformation(25, Matrix4::rotationY(…));
+cache.update();
+
+Containers::StridedArrayView1D<const Matrix4> transformations =
+    cache.absoluteTransformations();
+@endcode
+
+The @ref Trade::SceneField::Parent field is expected to be contained in the
+scene, having no cycles or duplicates, and the scene is expected to have the
+same dimension count as the class. The construction is done in an
+@f$ \mathcal{O}(n) @f$ execution time and memory complexity, with @f$ n @f$
+being @ref Trade::SceneData::mappingBound(). An @ref update() is then done in
+an @f$ \mathcal{O}(d \log d + s) @f$ execution time, where @f$ d @f$ is the
+count of objects marked as dirty and @f$ s @f$ total size of their subtrees.
+
+Objects that aren't a part of the hierarchy have their absolute transformation
+equal to the local one, same as with @ref flattenMeshHierarchy3D(). The
+hierarchy itself is fixed at construction time, changing it requires creating
+a new instance.
+@experimental
+*/
+template<UnsignedInt dimensions> class MAGNUM_SCENETOOLS_EXPORT AbsoluteTransformationCache {
+    public:
+        /**
+         * @brief Constructor
+         * @param scene                 Scene to take the hierarchy and local
+         *      transformations from
+         * @param globalTransformation  Global transformation prepended to all
+         *      root objects
+         *
+         * Copies the hierarchy and local transformations out of @p scene and
+         * calculates absolute transformations for all objects, so the
+         * instance doesn't reference @p scene afterwards.
+         */
+        explicit AbsoluteTransformationCache(const Trade::SceneData& scene, const MatrixTypeFor<dimensions, Float>& globalTransformation = {});
+
+        /** @brief Copying is not allowed */
+        AbsoluteTransformationCache(const AbsoluteTransformationCache<dimensions>&) = delete;
+
+        /** @brief Move constructor */
+        AbsoluteTransformationCache(AbsoluteTransformationCache<dimensions>&&) noexcept;
+
+        ~AbsoluteTransformationCache();
+
+        /** @brief Copying is not allowed */
+        AbsoluteTransformationCache<dimensions>& operator=(const AbsoluteTransformationCache<dimensions>&) = delete;
+
+        /** @brief Move assignment */
+        AbsoluteTransformationCache<dimensions>& operator=(AbsoluteTransformationCache<dimensions>&&) noexcept;
+
+        /**
+         * @brief Object count
+         *
+         * Same as @ref Trade::SceneData::mappingBound() of the scene the
+         * cache was created from.
+         */
+        std::size_t objectCount() const { return _localTransformations.size(); }
+
+        /** @brief Global transformation */
+        MatrixTypeFor<dimensions, Float> globalTransformation() const;
+
+        /**
+         * @brief Set global transformation
+         * @return Reference to self (for method chaining)
+         *
+         * Marks all root objects as dirty.
+         */
+        AbsoluteTransformationCache<dimensions>& setGlobalTransformation(const MatrixTypeFor<dimensions, Float>& transformation);
+
+        /**
+         * @brief Local transformation of given object
+         *
+         * The @p object is expected to be less than @ref objectCount().
+         * Objects that didn't have any transformation in the scene have it
+         * set to an identity.
+         */
+        MatrixTypeFor<dimensions, Float> localTransformation(std::size_t object) const;
+
+        /**
+         * @brief Set local transformation of given object
+         * @return Reference to self (for method chaining)
+         *
+         * The @p object is expected to be less than @ref objectCount().
+         * Marks the object as dirty, its absolute transformation and
+         * absolute transformations of all its children get recalculated on
+         * next @ref update().
+         */
+        AbsoluteTransformationCache<dimensions>& setLocalTransformation(std::size_t object, const MatrixTypeFor<dimensions, Float>& transformation);
+
+        /**
+         * @brief Whether any object is marked as dirty
+         *
+         * @see @ref update()
+         */
+        bool isDirty() const { return !_dirtyObjects.isEmpty(); }
+
+        /**
+         * @brief Recalculate absolute transformations of dirty subtrees
+         * @return Count of objects for which the absolute transformation got
+         *      recalculated
+         *
+         * Dirty objects are processed in order of their depth in the
+         * hierarchy, so a subtree is recalculated just once even if both an
+         * object and some of its children were marked as dirty. If nothing
+         * is dirty, the function is a no-op.
+         */
+        std::size_t update();
+
+        /**
+         * @brief Absolute transformations of all objects
+         *
+         * Indexed by object ID, size is @ref objectCount(). Reflects the
+         * state after the last @ref update(), changes made since are not
+         * visible until @ref update() is called again. The view stays valid
+         * for the whole lifetime of the instance.
+         */
+        Containers::StridedArrayView1D<const MatrixTypeFor<dimensions, Float>> absoluteTransformations() const;
+
+    private:
+        MAGNUM_SCENETOOLS_LOCAL void markDirty(UnsignedInt object);
+
+        Containers::ArrayTuple _data;
+        Containers::ArrayView<MatrixTypeFor<dimensions, Float>> _localTransformations;
+        /* Indexed by object ID + 1, the first item is the global
+           transformation */
+        Containers::ArrayView<MatrixTypeFor<dimensions, Float>> _absoluteTransformations;
+        /* -1 for root objects, -2 for objects not in the hierarchy */
+        Containers::ArrayView<Int> _parents;
+        Containers::ArrayView<UnsignedInt> _depths;
+        /* Children of object i are in _children[_childOffsets[i]] until
+           _childOffsets[i + 1], root objects are from offset 0 until
+           _childOffsets[0] */
+        Containers::ArrayView<UnsignedInt> _childOffsets;
+        Containers::ArrayView<UnsignedInt> _children;
+        Containers::ArrayView<bool> _dirty;
+        Containers::Array<UnsignedInt> _dirtyObjects;
+        Containers::Array<UnsignedInt> _queue;
+};
+
+/**
+@brief Two-dimensional absolute transformation cache
+@m_since_latest
+
+@experimental
+*/
+typedef AbsoluteTransformationCache<2> AbsoluteTransformationCache2D;
+
+/**
+@brief Three-dimensional absolute transformation cache
+@m_since_latest
+
+@experimental
+*/
+typedef AbsoluteTransformationCache<3> AbsoluteTransformationCache3D;
+
+}}
+
+#endif
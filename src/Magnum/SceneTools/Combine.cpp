@@ -0,0 +1,210 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Combine.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayTuple.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Trade/SceneData.h"
+#include "Magnum/SceneTools/Implementation/combine.h"
+
+namespace Magnum { namespace SceneTools {
+
+Trade::SceneData combineFields(const Trade::SceneMappingType mappingType, const UnsignedLong mappingBound, const Containers::ArrayView<const Trade::SceneFieldData> fields) {
+    CORRADE_ASSERT(
+        (mappingType == Trade::SceneMappingType::UnsignedByte && mappingBound <= 0xffull) ||
+        (mappingType == Trade::SceneMappingType::UnsignedShort && mappingBound <= 0xffffull) ||
+        (mappingType == Trade::SceneMappingType::UnsignedInt && mappingBound <= 0xffffffffull) ||
+        mappingType == Trade::SceneMappingType::UnsignedLong,
+        "SceneTools::combineFields():" << mappingType << "is too small for" << mappingBound << "objects",
+        (Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {}}));
+
+    #ifndef CORRADE_NO_ASSERT
+    /* The field count is usually small, so the quadratic check for shared
+       mappings is fine */
+    for(std::size_t i = 0; i != fields.size(); ++i) {
+        CORRADE_ASSERT(!(fields[i].flags() & Trade::SceneFieldFlag::OffsetOnly),
+            "SceneTools::combineFields(): field" << i << "is offset-only",
+            (Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {}}));
+        if(!fields[i].mappingData().data()) continue;
+        for(std::size_t j = 0; j != i; ++j) {
+            CORRADE_ASSERT(fields[j].mappingData().data() != fields[i].mappingData().data() || fields[j].size() == fields[i].size(),
+                "SceneTools::combineFields(): field" << i << "shares mapping with field" << j << "but has" << fields[i].size() << "items instead of" << fields[j].size(),
+                (Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {}}));
+        }
+    }
+    #endif
+
+    return Implementation::combine(mappingType, mappingBound, fields);
+}
+
+Trade::SceneData combineFields(const Trade::SceneMappingType mappingType, const UnsignedLong mappingBound, const std::initializer_list<Trade::SceneFieldData> fields) {
+    return combineFields(mappingType, mappingBound, Containers::arrayView(fields));
+}
+
+namespace {
+
+/* Writes the mapping in the order given by the permutation, returns whether
+   the result is an implicit mapping */
+template<class T> bool combineFieldsCopyMapping(const Containers::ArrayView<const UnsignedInt> mapping, const Containers::ArrayView<const UnsignedInt> permutation, const Containers::StridedArrayView1D<T>& destination) {
+    bool implicit = true;
+    for(std::size_t i = 0; i != permutation.size(); ++i) {
+        const UnsignedInt object = mapping[permutation[i]];
+        if(object != i) implicit = false;
+        destination[i] = T(object);
+    }
+    return implicit;
+}
+
+}
+
+Trade::SceneData combineFields(const Trade::SceneData& scene) {
+    const UnsignedLong mappingBound = scene.mappingBound();
+    Trade::SceneMappingType mappingType;
+    if(mappingBound <= 0xffull)
+        mappingType = Trade::SceneMappingType::UnsignedByte;
+    else if(mappingBound <= 0xffffull)
+        mappingType = Trade::SceneMappingType::UnsignedShort;
+    else if(mappingBound <= 0xffffffffull)
+        mappingType = Trade::SceneMappingType::UnsignedInt;
+    else
+        mappingType = Trade::SceneMappingType::UnsignedLong;
+    const std::size_t mappingTypeSize = sceneMappingTypeSize(mappingType);
+    const std::size_t mappingTypeAlignment = sceneMappingTypeAlignment(mappingType);
+
+    /* Go through all fields, find the ones sharing the same mapping view and
+       collect ArrayTuple allocations for these. Field i shares the mapping
+       with field mappingSource[i], which is i itself for the first field
+       using given mapping view. Similarly to Implementation::combine(), the
+       item views are referenced from ArrayTuple::Item, so not using a
+       growable array to avoid an accidental reallocation. */
+    const UnsignedInt fieldCount = scene.fieldCount();
+    Containers::Array<UnsignedInt> mappingSource{NoInit, fieldCount};
+    Containers::Array<Containers::ArrayTuple::Item> items;
+    Containers::Array<Containers::StridedArrayView2D<char>> itemViews{std::size_t(fieldCount)*2};
+    Containers::Array<Containers::Pair<UnsignedInt, UnsignedInt>> itemViewMappings{NoInit, fieldCount};
+    std::size_t itemViewOffset = 0;
+    std::size_t maxFieldSize = 0;
+    for(UnsignedInt i = 0; i != fieldCount; ++i) {
+        const Containers::StridedArrayView2D<const char> mapping = scene.mapping(i);
+        maxFieldSize = Math::max(maxFieldSize, mapping.size()[0]);
+
+        mappingSource[i] = i;
+        for(UnsignedInt j = 0; j != i; ++j) {
+            const Containers::StridedArrayView2D<const char> otherMapping = scene.mapping(j);
+            if(mapping.data() == otherMapping.data() && mapping.size()[0] == otherMapping.size()[0] && mapping.stride()[0] == otherMapping.stride()[0]) {
+                mappingSource[i] = j;
+                break;
+            }
+        }
+
+        if(mappingSource[i] != i)
+            itemViewMappings[i].first() = itemViewMappings[mappingSource[i]].first();
+        else {
+            itemViewMappings[i].first() = itemViewOffset;
+            arrayAppend(items, InPlaceInit, NoInit, mapping.size()[0], mappingTypeSize, mappingTypeAlignment, itemViews[itemViewOffset]);
+            ++itemViewOffset;
+        }
+
+        itemViewMappings[i].second() = itemViewOffset;
+        arrayAppend(items, InPlaceInit, NoInit, mapping.size()[0], sceneFieldTypeSize(scene.fieldType(i))*(scene.fieldArraySize(i) ? scene.fieldArraySize(i) : 1), sceneFieldTypeAlignment(scene.fieldType(i)), itemViews[itemViewOffset]);
+        ++itemViewOffset;
+    }
+
+    /* Allocate the data */
+    Containers::Array<char> outData = Containers::ArrayTuple{items};
+    CORRADE_INTERNAL_ASSERT(!outData.deleter());
+
+    /* Temporary mapping and sort order, reused for all fields */
+    Containers::ArrayView<UnsignedInt> mappingStorage;
+    Containers::ArrayView<UnsignedInt> permutationStorage;
+    Containers::ArrayTuple storage{
+        {NoInit, maxFieldSize, mappingStorage},
+        {NoInit, maxFieldSize, permutationStorage}
+    };
+
+    Containers::Array<Trade::SceneFieldData> outFields{fieldCount};
+    for(UnsignedInt i = 0; i != fieldCount; ++i) {
+        /* Process each mapping just once, together with all fields that share
+           it */
+        if(mappingSource[i] != i) continue;
+
+        const std::size_t size = scene.fieldSize(i);
+        const Containers::ArrayView<UnsignedInt> mapping = mappingStorage.prefix(size);
+        const Containers::ArrayView<UnsignedInt> permutation = permutationStorage.prefix(size);
+        scene.mappingInto(i, mapping);
+
+        /* Stable sort so multiple entries for the same object stay in the
+           original order. If the mapping is sorted already, which is often
+           the case, the field data can be copied directly. */
+        for(std::size_t j = 0; j != size; ++j)
+            permutation[j] = j;
+        const bool sorted = std::is_sorted(mapping.begin(), mapping.end());
+        if(!sorted) std::stable_sort(permutation.begin(), permutation.end(), [&mapping](const UnsignedInt a, const UnsignedInt b) {
+            return mapping[a] < mapping[b];
+        });
+
+        /* Copy the mapping over and cast it as necessary */
+        const Containers::StridedArrayView2D<char> outMapping = itemViews[itemViewMappings[i].first()];
+        bool implicit;
+        if(mappingType == Trade::SceneMappingType::UnsignedByte)
+            implicit = combineFieldsCopyMapping(mapping, permutation, Containers::arrayCast<1, UnsignedByte>(outMapping));
+        else if(mappingType == Trade::SceneMappingType::UnsignedShort)
+            implicit = combineFieldsCopyMapping(mapping, permutation, Containers::arrayCast<1, UnsignedShort>(outMapping));
+        else if(mappingType == Trade::SceneMappingType::UnsignedInt)
+            implicit = combineFieldsCopyMapping(mapping, permutation, Containers::arrayCast<1, UnsignedInt>(outMapping));
+        else
+            implicit = combineFieldsCopyMapping(mapping, permutation, Containers::arrayCast<1, UnsignedLong>(outMapping));
+        const Trade::SceneFieldFlags mappingFlags = implicit ?
+            Trade::SceneFieldFlag::ImplicitMapping :
+            Trade::SceneFieldFlag::OrderedMapping;
+
+        /* Copy the data of all fields using this mapping in the new order */
+        for(UnsignedInt j = i; j != fieldCount; ++j) {
+            if(mappingSource[j] != i) continue;
+
+            const Containers::StridedArrayView2D<const char> src = scene.field(j);
+            const Containers::StridedArrayView2D<char> dst = itemViews[itemViewMappings[j].second()];
+            if(sorted)
+                Utility::copy(src, dst);
+            else for(std::size_t k = 0; k != size; ++k)
+                std::memcpy(dst[k].data(), src[permutation[k]].data(), dst.size()[1]);
+
+            outFields[j] = Trade::SceneFieldData{scene.fieldName(j), outMapping, scene.fieldType(j), dst, scene.fieldArraySize(j), (scene.fieldFlags(j) & ~(Trade::SceneFieldFlag::OffsetOnly|Trade::SceneFieldFlag::ImplicitMapping))|mappingFlags};
+        }
+    }
+
+    return Trade::SceneData{mappingType, mappingBound, std::move(outData), std::move(outFields), scene.importerState()};
+}
+
+}}
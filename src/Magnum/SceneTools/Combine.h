@@ -0,0 +1,105 @@
+#ifndef Magnum_SceneTools_Combine_h
+#define Magnum_SceneTools_Combine_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::SceneTools::combineFields()
+ * @m_since_latest
+ */
+
+#include <initializer_list>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace SceneTools {
+
+/**
+@brief Combine scene fields together
+@param mappingType      Mapping type of the resulting scene
+@param mappingBound     Mapping bound of the resulting scene
+@param fields           Fields to combine
+@m_since_latest
+
+Creates a scene with all @p fields copied into a single allocation, with each
+mapping and field view tightly packed. The fields can have arbitrary mapping
+types and strides, the mappings get converted to @p mappingType. Fields that
+share the same mapping view in the input share it in the output as well,
+which is needed for example for @ref Trade::SceneField::Mesh and
+@ref Trade::SceneField::MeshMaterial. Flags of the fields are preserved.
+
+If a field has a @cpp nullptr @ce mapping or field data, the data don't get
+copied and only a placeholder gets allocated for them, which can be filled
+later through @ref Trade::SceneData::mutableMapping() and
+@ref Trade::SceneData::mutableField(). The fields are expected to not be
+@ref Trade::SceneFieldFlag::OffsetOnly and fields sharing the same mapping
+view are expected to have the same size. The @p mappingType is expected to be
+large enough for @p mappingBound, see @ref Trade::SceneData for details.
+
+@experimental
+
+@see @ref combineFields(const Trade::SceneData&)
+*/
+MAGNUM_SCENETOOLS_EXPORT Trade::SceneData combineFields(Trade::SceneMappingType mappingType, UnsignedLong mappingBound, Containers::ArrayView<const Trade::SceneFieldData> fields);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_SCENETOOLS_EXPORT Trade::SceneData combineFields(Trade::SceneMappingType mappingType, UnsignedLong mappingBound, std::initializer_list<Trade::SceneFieldData> fields);
+
+/**
+@brief Combine fields of a scene into a tightly packed one
+@m_since_latest
+
+Creates a copy of @p scene with all mapping and field data in a single
+allocation, tightly packed and using the smallest @ref Trade::SceneMappingType
+that can represent @ref Trade::SceneData::mappingBound(). The scene can have
+fields spread across multiple buffers, with arbitrary strides and
+offset-only fields.
+
+Entries of each field are stably sorted by the object they're mapped to, so
+the resulting fields have @ref Trade::SceneFieldFlag::OrderedMapping set and
+fields where the mapping ends up being a contiguous sequence from zero have
+@ref Trade::SceneFieldFlag::ImplicitMapping set. This makes
+@ref Trade::SceneData::findFieldObjectOffset() use a binary search or a direct
+lookup instead of a linear search. Fields sharing the same mapping view are
+sorted the same way and share the mapping view in the output as well, other
+flags are preserved and @ref Trade::SceneData::importerState() is passed
+through.
+
+The operation is done in an @f$ \mathcal{O}(n \log n) @f$ execution time for
+fields that aren't already sorted and @f$ \mathcal{O}(n) @f$ otherwise, with
+@f$ n @f$ being the size of each field.
+
+@experimental
+*/
+MAGNUM_SCENETOOLS_EXPORT Trade::SceneData combineFields(const Trade::SceneData& scene);
+
+}}
+
+#endif
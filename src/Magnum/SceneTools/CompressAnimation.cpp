@@ -0,0 +1,380 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CompressAnimation.h"
+
+#include <cmath>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Math/BitVector.h"
+#include "Magnum/Math/Complex.h"
+#include "Magnum/Math/CubicHermite.h"
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/Trade/AnimationData.h"
+
+namespace Magnum { namespace SceneTools {
+
+namespace {
+
+/* Range of the three smallest components of a normalized quaternion, and the
+   max value a component is quantized to */
+constexpr Float SmallestThreeRange = 0.707106781186547524401f;
+constexpr UnsignedInt SmallestThreeMax = (1 << 10) - 1;
+
+}
+
+UnsignedInt packQuaternionSmallestThree(const Quaternion& quaternion) {
+    CORRADE_ASSERT(quaternion.isNormalized(),
+        "SceneTools::packQuaternionSmallestThree():" << quaternion << "is not normalized", {});
+
+    const Vector4 data{quaternion.vector(), quaternion.scalar()};
+    UnsignedInt largest = 0;
+    for(UnsignedInt i = 1; i != 4; ++i)
+        if(Math::abs(data[i]) > Math::abs(data[largest])) largest = i;
+
+    /* Flip the quaternion so the largest component is positive, which allows
+       it to be reconstructed from the other three */
+    const Float sign = data[largest] < 0.0f ? -1.0f : 1.0f;
+
+    UnsignedInt out = largest << 30;
+    Int shift = 20;
+    for(UnsignedInt i = 0; i != 4; ++i) {
+        if(i == largest) continue;
+        const Float normalized = Math::clamp(sign*data[i]/(2.0f*SmallestThreeRange) + 0.5f, 0.0f, 1.0f);
+        out |= UnsignedInt(normalized*SmallestThreeMax + 0.5f) << shift;
+        shift -= 10;
+    }
+
+    return out;
+}
+
+Quaternion unpackQuaternionSmallestThree(const UnsignedInt packed) {
+    const UnsignedInt largest = packed >> 30;
+
+    Vector4 data{NoInit};
+    Float lengthSquared = 0.0f;
+    Int shift = 20;
+    for(UnsignedInt i = 0; i != 4; ++i) {
+        if(i == largest) continue;
+        data[i] = (Float((packed >> shift) & SmallestThreeMax)/SmallestThreeMax - 0.5f)*(2.0f*SmallestThreeRange);
+        lengthSquared += data[i]*data[i];
+        shift -= 10;
+    }
+    data[largest] = std::sqrt(Math::max(1.0f - lengthSquared, 0.0f));
+
+    /* Renormalize to get rid of the quantization error */
+    return Quaternion{data.xyz(), data.w()}.normalized();
+}
+
+Quaternion selectSmallestThree(const UnsignedInt& a, const UnsignedInt& b, const Float t) {
+    return unpackQuaternionSmallestThree(Math::select(a, b, t));
+}
+
+Quaternion slerpShortestPathSmallestThree(const UnsignedInt& a, const UnsignedInt& b, const Float t) {
+    return Math::slerpShortestPath(unpackQuaternionSmallestThree(a), unpackQuaternionSmallestThree(b), t);
+}
+
+namespace {
+
+/* Error metrics for keyframe removal. The interpolated values aren't
+   guaranteed to be normalized, so not using Math::angle() which expects
+   that. NaNs resulting from zero-length values make the keyframe kept. */
+Float keyframeError(const Float a, const Float b) {
+    return Math::abs(a - b);
+}
+
+template<std::size_t size> Float keyframeError(const Math::Vector<size, Float>& a, const Math::Vector<size, Float>& b) {
+    return (a - b).length();
+}
+
+Float keyframeError(const Complex& a, const Complex& b) {
+    return std::acos(Math::clamp(Math::dot(a, b)/(a.length()*b.length()), -1.0f, 1.0f));
+}
+
+Float keyframeError(const Quaternion& a, const Quaternion& b) {
+    /* A quaternion and its negation represent the same rotation */
+    return 2.0f*std::acos(Math::min(Math::abs(Math::dot(a, b))/(a.length()*b.length()), 1.0f));
+}
+
+/* Greedily removes keyframes from the candidate list as long as interpolating
+   their kept neighbors reproduces them within the tolerance. The `times`
+   and `indices` are parallel, with `indices` pointing to the original track
+   values. */
+template<class T> void removeKeyframes(const Animation::TrackView<const Float, const T, T>& track, Containers::Array<Float>& times, Containers::Array<UnsignedInt>& indices, const Float tolerance) {
+    if(indices.size() <= 2) return;
+
+    const Containers::StridedArrayView1D<const T> values = track.values();
+    const typename Animation::TrackView<const Float, const T, T>::Interpolator interpolator = track.interpolator();
+
+    /* The output is never larger than the input, so the compaction can be
+       done in-place. The first keyframe is always kept. */
+    std::size_t outputSize = 1;
+    std::size_t from = 0;
+    for(std::size_t to = 2; to < indices.size(); ++to) {
+        bool removable = true;
+        for(std::size_t i = from + 1; i != to; ++i) {
+            const Float factor = Math::lerpInverted(times[from], times[to], times[i]);
+            if(!(keyframeError(interpolator(values[indices[from]], values[indices[to]], factor), values[indices[i]]) <= tolerance)) {
+                removable = false;
+                break;
+            }
+        }
+
+        if(removable) continue;
+
+        /* If the keyframes between can't be removed, keep the one right
+           before and continue from there. It's written to the output right
+           away, which is safe to do in-place -- the output position is never
+           past `from` and the loop only reads keyframes from `from` on. */
+        from = to - 1;
+        times[outputSize] = times[from];
+        indices[outputSize] = indices[from];
+        ++outputSize;
+    }
+
+    /* The last keyframe is always kept as well */
+    times[outputSize] = times.back();
+    indices[outputSize] = indices.back();
+    ++outputSize;
+
+    arrayResize(times, outputSize);
+    arrayResize(indices, outputSize);
+}
+
+std::size_t animationTrackTypeSize(const Trade::AnimationTrackType type) {
+    switch(type) {
+        /* LCOV_EXCL_START */
+        #define _c(type_, T) case Trade::AnimationTrackType::type_: return sizeof(T);
+        _c(Bool, bool)
+        _c(Float, Float)
+        _c(UnsignedInt, UnsignedInt)
+        _c(Int, Int)
+        _c(BitVector2, BitVector2)
+        _c(BitVector3, BitVector3)
+        _c(BitVector4, BitVector4)
+        _c(Vector2, Vector2)
+        _c(Vector2ui, Vector2ui)
+        _c(Vector2i, Vector2i)
+        _c(Vector3, Vector3)
+        _c(Vector3ui, Vector3ui)
+        _c(Vector3i, Vector3i)
+        _c(Vector4, Vector4)
+        _c(Vector4ui, Vector4ui)
+        _c(Vector4i, Vector4i)
+        _c(Complex, Complex)
+        _c(Quaternion, Quaternion)
+        _c(DualQuaternion, DualQuaternion)
+        _c(CubicHermite1D, CubicHermite1D)
+        _c(CubicHermite2D, CubicHermite2D)
+        _c(CubicHermite3D, CubicHermite3D)
+        _c(CubicHermiteComplex, CubicHermiteComplex)
+        _c(CubicHermiteQuaternion, CubicHermiteQuaternion)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* Copies the kept values and creates the output track. The original
+   interpolator is passed through as-is --- the type it's cast to doesn't
+   matter as the result type is stored separately. */
+template<class T> Trade::AnimationTrackData copyTrack(const Trade::AnimationData& animation, const UnsignedInt id, const Containers::ArrayView<const UnsignedInt> indices, const Containers::ArrayView<const Float> keys, const Containers::ArrayView<char> valueData) {
+    const Animation::TrackView<const Float, const T, T>& track = static_cast<const Animation::TrackView<const Float, const T, T>&>(animation.track(id));
+    const Containers::StridedArrayView1D<const T> values = track.values();
+
+    const Containers::ArrayView<T> outputValues = Containers::arrayCast<T>(valueData);
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        outputValues[i] = values[indices[i]];
+
+    return Trade::AnimationTrackData{animation.trackType(id), animation.trackResultType(id), animation.trackTargetType(id), animation.trackTarget(id),
+        Animation::TrackView<const Float, const T, T>{
+            Containers::StridedArrayView1D<const Float>{keys},
+            Containers::StridedArrayView1D<const T>{outputValues},
+            track.interpolation(), track.interpolator(),
+            track.before(), track.after()}};
+}
+
+struct OutputTrack {
+    Containers::Array<Float> keys;
+    Containers::Array<UnsignedInt> indices;
+    bool quantize;
+};
+
+}
+
+Trade::AnimationData compressAnimation(const Trade::AnimationData& animation, const Float translationTolerance, const Rad rotationTolerance, const Float scalingTolerance, const Float frameRate, const CompressAnimationFlags flags) {
+    CORRADE_ASSERT(frameRate >= 0.0f,
+        "SceneTools::compressAnimation(): expected a non-negative frame rate, got" << frameRate, (Trade::AnimationData{nullptr, nullptr}));
+
+    Containers::Array<OutputTrack> outputTracks{animation.trackCount()};
+    std::size_t dataSize = 0;
+    for(UnsignedInt i = 0; i != animation.trackCount(); ++i) {
+        OutputTrack& out = outputTracks[i];
+        const Animation::TrackViewStorage<const Float>& track = animation.track(i);
+        const Containers::StridedArrayView1D<const Float> keys = track.keys();
+
+        /* Snap the keys to the frame rate, if there are multiple keys
+           snapped to the same time, keep only the last one */
+        arrayReserve(out.keys, keys.size());
+        arrayReserve(out.indices, keys.size());
+        for(UnsignedInt j = 0; j != keys.size(); ++j) {
+            const Float key = frameRate > 0.0f ? Math::round(keys[j]*frameRate)/frameRate : keys[j];
+            if(frameRate > 0.0f && !out.keys.isEmpty() && out.keys.back() == key) {
+                out.indices.back() = j;
+                continue;
+            }
+
+            arrayAppend(out.keys, key);
+            arrayAppend(out.indices, j);
+        }
+
+        /* Tolerance based on the target */
+        Float tolerance;
+        switch(animation.trackTargetType(i)) {
+            case Trade::AnimationTrackTargetType::Translation2D:
+            case Trade::AnimationTrackTargetType::Translation3D:
+                tolerance = translationTolerance;
+                break;
+            case Trade::AnimationTrackTargetType::Rotation2D:
+            case Trade::AnimationTrackTargetType::Rotation3D:
+                tolerance = Float(rotationTolerance);
+                break;
+            case Trade::AnimationTrackTargetType::Scaling2D:
+            case Trade::AnimationTrackTargetType::Scaling3D:
+                tolerance = scalingTolerance;
+                break;
+            default:
+                tolerance = 0.0f;
+        }
+
+        /* Remove keyframes for supported types. The result type has to be
+           the same as the value type, which excludes spline tracks. */
+        const Trade::AnimationTrackType type = animation.trackType(i);
+        if(type == animation.trackResultType(i)) switch(type) {
+            #define _c(type) case Trade::AnimationTrackType::type:          \
+                removeKeyframes(animation.track<type>(i), out.keys, out.indices, tolerance); \
+                break;
+            _c(Float)
+            _c(Vector2)
+            _c(Vector3)
+            _c(Vector4)
+            _c(Complex)
+            _c(Quaternion)
+            #undef _c
+            default: break;
+        }
+
+        out.quantize = (flags & CompressAnimationFlag::QuantizeRotations) &&
+            animation.trackTargetType(i) == Trade::AnimationTrackTargetType::Rotation3D &&
+            type == Trade::AnimationTrackType::Quaternion &&
+            animation.trackResultType(i) == Trade::AnimationTrackType::Quaternion &&
+            (track.interpolation() == Animation::Interpolation::Constant ||
+             track.interpolation() == Animation::Interpolation::Linear);
+
+        /* Keys and values, each aligned to four bytes */
+        const std::size_t valueSize = out.quantize ? sizeof(UnsignedInt) : animationTrackTypeSize(type);
+        dataSize += out.keys.size()*sizeof(Float);
+        dataSize += (out.keys.size()*valueSize + 3) & ~std::size_t{3};
+    }
+
+    /* Copy the data */
+    Containers::Array<char> data{ValueInit, dataSize};
+    Containers::Array<Trade::AnimationTrackData> tracks{animation.trackCount()};
+    std::size_t offset = 0;
+    for(UnsignedInt i = 0; i != animation.trackCount(); ++i) {
+        const OutputTrack& in = outputTracks[i];
+        const Trade::AnimationTrackType type = animation.trackType(i);
+
+        const Containers::ArrayView<Float> keys = Containers::arrayCast<Float>(data.slice(offset, offset + in.keys.size()*sizeof(Float)));
+        Utility::copy(in.keys, keys);
+        offset += keys.size()*sizeof(Float);
+
+        if(in.quantize) {
+            const Animation::TrackView<const Float, const Quaternion>& track = animation.track<Quaternion>(i);
+            const Containers::StridedArrayView1D<const Quaternion> values = track.values();
+            const Containers::ArrayView<UnsignedInt> outputValues = Containers::arrayCast<UnsignedInt>(data.slice(offset, offset + in.keys.size()*sizeof(UnsignedInt)));
+            for(std::size_t j = 0; j != in.indices.size(); ++j)
+                outputValues[j] = packQuaternionSmallestThree(values[in.indices[j]].normalized());
+            offset += outputValues.size()*sizeof(UnsignedInt);
+
+            tracks[i] = Trade::AnimationTrackData{animation.trackTargetType(i), animation.trackTarget(i),
+                Animation::TrackView<const Float, const UnsignedInt, Quaternion>{
+                    Containers::StridedArrayView1D<const Float>{keys},
+                    Containers::StridedArrayView1D<const UnsignedInt>{outputValues},
+                    track.interpolation(),
+                    track.interpolation() == Animation::Interpolation::Constant ?
+                        selectSmallestThree : slerpShortestPathSmallestThree,
+                    track.before(), track.after()}};
+            continue;
+        }
+
+        const std::size_t valueSize = in.keys.size()*animationTrackTypeSize(type);
+        const Containers::ArrayView<char> valueData = data.slice(offset, offset + valueSize);
+        offset += (valueSize + 3) & ~std::size_t{3};
+
+        switch(type) {
+            #define _c(type_, T) case Trade::AnimationTrackType::type_:     \
+                tracks[i] = copyTrack<T>(animation, i, in.indices, keys, valueData); \
+                break;
+            _c(Bool, bool)
+            _c(Float, Float)
+            _c(UnsignedInt, UnsignedInt)
+            _c(Int, Int)
+            _c(BitVector2, BitVector2)
+            _c(BitVector3, BitVector3)
+            _c(BitVector4, BitVector4)
+            _c(Vector2, Vector2)
+            _c(Vector2ui, Vector2ui)
+            _c(Vector2i, Vector2i)
+            _c(Vector3, Vector3)
+            _c(Vector3ui, Vector3ui)
+            _c(Vector3i, Vector3i)
+            _c(Vector4, Vector4)
+            _c(Vector4ui, Vector4ui)
+            _c(Vector4i, Vector4i)
+            _c(Complex, Complex)
+            _c(Quaternion, Quaternion)
+            _c(DualQuaternion, DualQuaternion)
+            _c(CubicHermite1D, CubicHermite1D)
+            _c(CubicHermite2D, CubicHermite2D)
+            _c(CubicHermite3D, CubicHermite3D)
+            _c(CubicHermiteComplex, CubicHermiteComplex)
+            _c(CubicHermiteQuaternion, CubicHermiteQuaternion)
+            #undef _c
+        }
+    }
+
+    CORRADE_INTERNAL_ASSERT(offset == data.size());
+
+    return Trade::AnimationData{std::move(data), std::move(tracks), animation.duration()};
+}
+
+}}
@@ -0,0 +1,182 @@
+#ifndef Magnum_SceneTools_CompressAnimation_h
+#define Magnum_SceneTools_CompressAnimation_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::SceneTools::compressAnimation(), @ref Magnum::SceneTools::packQuaternionSmallestThree(), @ref Magnum::SceneTools::unpackQuaternionSmallestThree(), @ref Magnum::SceneTools::selectSmallestThree(), @ref Magnum::SceneTools::slerpShortestPathSmallestThree(), enum @ref Magnum::SceneTools::CompressAnimationFlag, enum set @ref Magnum::SceneTools::CompressAnimationFlags
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace SceneTools {
+
+/**
+@brief Animation compression flag
+@m_since_latest
+
+@see @ref CompressAnimationFlags, @ref compressAnimation()
+*/
+enum class CompressAnimationFlag: UnsignedByte {
+    /**
+     * Quantize @ref Trade::AnimationTrackTargetType::Rotation3D tracks of
+     * @ref Trade::AnimationTrackType::Quaternion with
+     * @ref Animation::Interpolation::Constant or
+     * @relativeref{Animation::Interpolation,Linear} interpolation to
+     * @ref Trade::AnimationTrackType::UnsignedInt values using
+     * @ref packQuaternionSmallestThree(). The result type stays
+     * @ref Trade::AnimationTrackType::Quaternion, with the interpolator
+     * being @ref selectSmallestThree() or
+     * @ref slerpShortestPathSmallestThree(), respectively. Makes the values
+     * take a quarter of the original size.
+     */
+    QuantizeRotations = 1 << 0
+};
+
+/**
+@brief Animation compression flags
+@m_since_latest
+
+@see @ref compressAnimation()
+*/
+typedef Containers::EnumSet<CompressAnimationFlag> CompressAnimationFlags;
+
+CORRADE_ENUMSET_OPERATORS(CompressAnimationFlags)
+
+/**
+@brief Compress an animation
+@param animation            Input animation
+@param translationTolerance Max distance error for
+    @ref Trade::AnimationTrackTargetType::Translation2D and
+    @relativeref{Trade::AnimationTrackTargetType,Translation3D} tracks
+@param rotationTolerance    Max angle error for
+    @ref Trade::AnimationTrackTargetType::Rotation2D and
+    @relativeref{Trade::AnimationTrackTargetType,Rotation3D} tracks
+@param scalingTolerance     Max distance error for
+    @ref Trade::AnimationTrackTargetType::Scaling2D and
+    @relativeref{Trade::AnimationTrackTargetType,Scaling3D} tracks
+@param frameRate            Frame rate to snap the keys to. If
+    @cpp 0.0f @ce, the keys are left unchanged.
+@param flags                Flags
+@m_since_latest
+
+Returns a copy of @p animation with redundant keyframes removed. If
+@p frameRate is non-zero, all keys are first rounded to the nearest multiple
+of @cpp 1.0f/frameRate @ce and if multiple keys round to the same value, only
+the last of them is kept. Uniformly spaced keys then allow for example
+@ref Animation::KeyframeSearch::Uniform to be used when playing the
+animation back.
+
+Then, for tracks of @ref Trade::AnimationTrackType::Float,
+@relativeref{Trade::AnimationTrackType,Vector2},
+@relativeref{Trade::AnimationTrackType,Vector3},
+@relativeref{Trade::AnimationTrackType,Vector4},
+@relativeref{Trade::AnimationTrackType,Complex} and
+@relativeref{Trade::AnimationTrackType,Quaternion} types that have the same
+result type, keyframes are removed greedily as long as interpolating the
+remaining neighbors with the track's own interpolator at the times of all
+removed keyframes is within the tolerance corresponding to the track
+@ref Trade::AnimationTrackTargetType. Distance is used as the error metric for
+vector types and angle for complex numbers and quaternions, with a quaternion
+and its negation being treated as equal. Tracks with
+@ref Trade::AnimationTrackTargetType::Custom targets use a zero tolerance,
+i.e. only keyframes that are exactly reproduced by the interpolator are
+removed. The first and last keyframe of each track is always kept, so the
+track duration and extrapolation behavior don't change. Tracks of other
+types, including spline-interpolated tracks, are only affected by the frame
+rate snapping.
+
+Lastly, if @ref CompressAnimationFlag::QuantizeRotations is set, rotation
+tracks are quantized as described in the flag documentation. The resulting
+@ref Trade::AnimationData has all track data packed together in a single
+allocation, has the same @ref Trade::AnimationData::duration() as the input
+and no importer state. Note that the tracks reference interpolator functions
+from the original animation and from this library, so the returned instance
+is only valid as long as these are loaded.
+
+With @f$ n @f$ being the keyframe count of a track, the keyframe removal is
+done in an @f$ \mathcal{O}(n) @f$ execution time if no keyframes get
+removed, and @f$ \mathcal{O}(n^2) @f$ in the worst case where large runs of
+keyframes get removed. The operation uses @f$ \mathcal{O}(n) @f$ temporary
+memory.
+@experimental
+*/
+MAGNUM_SCENETOOLS_EXPORT Trade::AnimationData compressAnimation(const Trade::AnimationData& animation, Float translationTolerance, Rad rotationTolerance, Float scalingTolerance, Float frameRate = 0.0f, CompressAnimationFlags flags = {});
+
+/**
+@brief Pack a quaternion into the smallest-three representation
+@m_since_latest
+
+Finds the component with the largest absolute value, negates the quaternion
+if that component is negative, and stores the remaining three components
+quantized to 10 bits each from the @f$ [-\frac{1}{\sqrt{2}}, \frac{1}{\sqrt{2}}] @f$
+range together with a 2-bit index of the omitted component. The largest
+component is reconstructed from the other three in
+@ref unpackQuaternionSmallestThree(). The max reconstruction error is around
+@cpp 0.001f @ce per component. Expects that the quaternion is normalized.
+@see @ref Math::Quaternion::isNormalized(), @ref compressAnimation()
+*/
+MAGNUM_SCENETOOLS_EXPORT UnsignedInt packQuaternionSmallestThree(const Quaternion& quaternion);
+
+/**
+@brief Unpack a quaternion from the smallest-three representation
+@m_since_latest
+
+Inverse to @ref packQuaternionSmallestThree(). The returned quaternion is
+normalized.
+*/
+MAGNUM_SCENETOOLS_EXPORT Quaternion unpackQuaternionSmallestThree(UnsignedInt packed);
+
+/**
+@brief Constant interpolation of smallest-three packed quaternions
+@m_since_latest
+
+Equivalent to calling @ref Math::select() on the unpacked quaternions. Used
+by @ref compressAnimation() for quantized tracks with
+@ref Animation::Interpolation::Constant.
+@see @ref unpackQuaternionSmallestThree()
+*/
+MAGNUM_SCENETOOLS_EXPORT Quaternion selectSmallestThree(const UnsignedInt& a, const UnsignedInt& b, Float t);
+
+/**
+@brief Linear interpolation of smallest-three packed quaternions
+@m_since_latest
+
+Equivalent to calling @ref Math::slerpShortestPath() on the unpacked
+quaternions. Since the packing may negate the quaternion, there's no
+non-shortest-path variant. Used by @ref compressAnimation() for quantized
+tracks with @ref Animation::Interpolation::Linear.
+@see @ref unpackQuaternionSmallestThree()
+*/
+MAGNUM_SCENETOOLS_EXPORT Quaternion slerpShortestPathSmallestThree(const UnsignedInt& a, const UnsignedInt& b, Float t);
+
+}}
+
+#endif
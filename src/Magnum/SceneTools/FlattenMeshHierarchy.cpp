@@ -25,16 +25,22 @@
 
 #include "FlattenMeshHierarchy.h"
 
+#include <algorithm>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayTuple.h>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/Triple.h>
+#include <Corrade/Utility/Algorithms.h>
 
 #include "Magnum/DimensionTraits.h"
+#include "Magnum/Implementation/parallelFor.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/MatrixBatch.h"
 #include "Magnum/Trade/SceneData.h"
 #include "Magnum/SceneTools/OrderClusterParents.h"
 
@@ -44,6 +50,8 @@ namespace {
 
 template<UnsignedInt> struct SceneDataDimensionTraits;
 template<> struct SceneDataDimensionTraits<2> {
+    typedef Matrix3x2 AffineMatrix;
+
     static bool isDimensions(const Trade::SceneData& scene) {
         return scene.is2D();
     }
@@ -52,6 +60,8 @@ template<> struct SceneDataDimensionTraits<2> {
     }
 };
 template<> struct SceneDataDimensionTraits<3> {
+    typedef Matrix4x3 AffineMatrix;
+
     static bool isDimensions(const Trade::SceneData& scene) {
         return scene.is3D();
     }
@@ -60,30 +70,55 @@ template<> struct SceneDataDimensionTraits<3> {
     }
 };
 
-template<UnsignedInt dimensions>
-Containers::Array<Containers::Triple<UnsignedInt, Int, MatrixTypeFor<dimensions, Float>>> flattenMeshHierarchyImplementation(const Trade::SceneData& scene, const MatrixTypeFor<dimensions, Float>& globalTransformation) {
-    CORRADE_ASSERT(SceneDataDimensionTraits<dimensions>::isDimensions(scene),
-        "SceneTools::flattenMeshHierarchy(): the scene is not" << dimensions << Debug::nospace << "D", {});
-    const Containers::Optional<UnsignedInt> parentFieldId = scene.findFieldId(Trade::SceneField::Parent);
-    CORRADE_ASSERT(parentFieldId,
-        "SceneTools::flattenMeshHierarchy(): the scene has no hierarchy", {});
+/* Affine matrices with the bottom row omitted are multiplied with the batch
+   Math::multiplyInto(), which has a dedicated kernel for them */
+inline Matrix3 multiply(const Matrix3& a, const Matrix3& b) { return a*b; }
+inline Matrix4 multiply(const Matrix4& a, const Matrix4& b) { return a*b; }
+template<class T> inline T affineMultiply(const T& a, const T& b) {
+    T out{NoInit};
+    Math::multiplyInto(
+        Containers::arrayView(&a, 1),
+        Containers::arrayView(&b, 1),
+        Containers::arrayView(&out, 1));
+    return out;
+}
+inline Matrix3x2 multiply(const Matrix3x2& a, const Matrix3x2& b) {
+    return affineMultiply(a, b);
+}
+inline Matrix4x3 multiply(const Matrix4x3& a, const Matrix4x3& b) {
+    return affineMultiply(a, b);
+}
 
-    /* If there's no mesh field in the file, nothing to do. Another case is
-       that there is a mesh field but it's empty, then for simplicity we still
-       go through everything. */
-    if(!scene.hasField(Trade::SceneField::Mesh)) return {};
+/* Splitting work on less items than this across threads isn't worth it */
+constexpr std::size_t MinItemsPerThread = 4096;
+
+/* Calls f(begin, end) for consecutive ranges covering [0, size), in parallel
+   if there's enough items */
+template<class F> void parallelRanges(const UnsignedInt threadCount, const std::size_t size, F&& f) {
+    const std::size_t chunkCount = Math::max(Math::min(std::size_t(threadCount), size/MinItemsPerThread), std::size_t{1});
+    Implementation::parallelFor(threadCount, chunkCount, [&](const std::size_t chunk) {
+        f(chunk*size/chunkCount, (chunk + 1)*size/chunkCount);
+    });
+}
 
-    /* Allocate a single storage for all temporary data */
+/* Calculates absolute transformations for all objects up to mapping bound
+   and then picks the ones that have a mesh */
+template<UnsignedInt dimensions, class T> void flattenMeshHierarchyDenseInto(const Trade::SceneData& scene, const UnsignedInt parentFieldId, const MatrixTypeFor<dimensions, Float>& globalTransformation, const UnsignedInt threadCount, const Containers::StridedArrayView1D<const UnsignedInt>& meshMapping, const Containers::StridedArrayView1D<MatrixTypeFor<dimensions, Float>>& meshTransformations) {
+    /* Allocate a single storage for all temporary data. Object depths are
+       needed only for splitting the work into levels for multiple threads. */
     Containers::ArrayView<Containers::Pair<UnsignedInt, Int>> orderedClusteredParents;
     Containers::ArrayView<Containers::Pair<UnsignedInt, MatrixTypeFor<dimensions, Float>>> transformations;
-    Containers::ArrayView<MatrixTypeFor<dimensions, Float>> absoluteTransformations;
+    Containers::ArrayView<T> absoluteTransformations;
+    Containers::ArrayView<UnsignedInt> depths;
     Containers::ArrayTuple storage{
         /* Output of orderClusterParentsInto() */
-        {NoInit, scene.fieldSize(*parentFieldId), orderedClusteredParents},
+        {NoInit, scene.fieldSize(parentFieldId), orderedClusteredParents},
         /* Output of scene.transformationsXDInto() */
         {NoInit, scene.transformationFieldSize(), transformations},
         /* Above transformations but indexed by object ID */
-        {ValueInit, std::size_t(scene.mappingBound() + 1), absoluteTransformations}
+        {NoInit, std::size_t(scene.mappingBound() + 1), absoluteTransformations},
+        /* Depth of each object in the hierarchy, again indexed by object ID */
+        {NoInit, threadCount > 1 ? std::size_t(scene.mappingBound() + 1) : 0, depths}
     };
     orderClusterParentsInto(scene,
         stridedArrayView(orderedClusteredParents).slice(&decltype(orderedClusteredParents)::Type::first),
@@ -94,36 +129,190 @@ Containers::Array<Containers::Triple<UnsignedInt, Int, MatrixTypeFor<dimensions,
 
     /* Retrieve transformations of all objects, indexed by object ID. Since not
        all nodes in the hierarchy may have a transformation assigned, the whole
-       array got initialized to identity first. */
+       array gets initialized to identity first. */
     /** @todo switch to a hashmap eventually? */
-    absoluteTransformations[0] = globalTransformation;
+    parallelRanges(threadCount, absoluteTransformations.size(), [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i)
+            absoluteTransformations[i] = T{IdentityInit};
+    });
+    absoluteTransformations[0] = T{globalTransformation};
     for(const Containers::Pair<UnsignedInt, MatrixTypeFor<dimensions, Float>>& transformation: transformations) {
         CORRADE_INTERNAL_ASSERT(transformation.first() < scene.mappingBound());
-        absoluteTransformations[transformation.first() + 1] = transformation.second();
+        absoluteTransformations[transformation.first() + 1] = T{transformation.second()};
     }
 
     /* Turn the transformations into absolute */
-    for(const Containers::Pair<UnsignedInt, Int>& parentOffset: orderedClusteredParents) {
-        absoluteTransformations[parentOffset.first() + 1] =
-            absoluteTransformations[parentOffset.second() + 1]*
-            absoluteTransformations[parentOffset.first() + 1];
+    const auto makeAbsolute = [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) {
+            const Containers::Pair<UnsignedInt, Int>& parentOffset = orderedClusteredParents[i];
+            absoluteTransformations[parentOffset.first() + 1] = multiply(
+                absoluteTransformations[parentOffset.second() + 1],
+                absoluteTransformations[parentOffset.first() + 1]);
+        }
+    };
+    if(threadCount == 1) makeAbsolute(0, orderedClusteredParents.size());
+
+    /* The parents are ordered breadth-first, meaning objects of the same
+       depth are next to each other and depend only on objects from the
+       previous levels. Find the level boundaries and process each level in
+       parallel. */
+    else {
+        depths[0] = 0;
+        std::size_t levelBegin = 0;
+        for(std::size_t i = 0; i != orderedClusteredParents.size(); ++i) {
+            const Containers::Pair<UnsignedInt, Int>& parentOffset = orderedClusteredParents[i];
+            const UnsignedInt depth = depths[parentOffset.first() + 1] = depths[parentOffset.second() + 1] + 1;
+            if(i && depth != depths[orderedClusteredParents[i - 1].first() + 1]) {
+                parallelRanges(threadCount, i - levelBegin, [&](const std::size_t begin, const std::size_t end) {
+                    makeAbsolute(levelBegin + begin, levelBegin + end);
+                });
+                levelBegin = i;
+            }
+        }
+        parallelRanges(threadCount, orderedClusteredParents.size() - levelBegin, [&](const std::size_t begin, const std::size_t end) {
+            makeAbsolute(levelBegin + begin, levelBegin + end);
+        });
     }
 
+    /* Assign absolute transformations to each mesh. The mapping aliases the
+       transformation memory, but it's always read before being overwritten
+       at the same index. */
+    parallelRanges(threadCount, meshMapping.size(), [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) {
+            CORRADE_INTERNAL_ASSERT(meshMapping[i] < scene.mappingBound());
+            meshTransformations[i] = MatrixTypeFor<dimensions, Float>{absoluteTransformations[meshMapping[i] + 1]};
+        }
+    });
+}
+
+/* Walks the parent chain of each mesh independently, without any temporary
+   storage proportional to mapping bound. Meshes that aren't a part of the
+   hierarchy get marked in the output bool array. */
+template<UnsignedInt dimensions, class T> void flattenMeshHierarchySparseInto(const Trade::SceneData& scene, const UnsignedInt parentFieldId, const MatrixTypeFor<dimensions, Float>& globalTransformation, const UnsignedInt threadCount, const Containers::StridedArrayView1D<const UnsignedInt>& meshMapping, const Containers::StridedArrayView1D<MatrixTypeFor<dimensions, Float>>& meshTransformations, const Containers::ArrayView<bool>& inHierarchy) {
+    Containers::ArrayView<Containers::Pair<UnsignedInt, Int>> parents;
+    Containers::ArrayView<Containers::Pair<UnsignedInt, MatrixTypeFor<dimensions, Float>>> transformations;
+    Containers::ArrayTuple storage{
+        {NoInit, scene.fieldSize(parentFieldId), parents},
+        {NoInit, scene.transformationFieldSize(), transformations}
+    };
+    scene.parentsInto(
+        stridedArrayView(parents).slice(&decltype(parents)::Type::first),
+        stridedArrayView(parents).slice(&decltype(parents)::Type::second));
+    SceneDataDimensionTraits<dimensions>::transformationsInto(scene,
+        stridedArrayView(transformations).slice(&decltype(transformations)::Type::first),
+        stridedArrayView(transformations).slice(&decltype(transformations)::Type::second));
+
+    /* Sort both by object ID for binary search. The transformation sort is
+       stable so the last transformation of an object can be picked in case
+       of duplicates, consistently with the dense variant. */
+    std::sort(parents.begin(), parents.end(), [](const Containers::Pair<UnsignedInt, Int>& a, const Containers::Pair<UnsignedInt, Int>& b) {
+        return a.first() < b.first();
+    });
+    std::stable_sort(transformations.begin(), transformations.end(), [](const Containers::Pair<UnsignedInt, MatrixTypeFor<dimensions, Float>>& a, const Containers::Pair<UnsignedInt, MatrixTypeFor<dimensions, Float>>& b) {
+        return a.first() < b.first();
+    });
+
+    const auto findParent = [&](const UnsignedInt object) -> const Containers::Pair<UnsignedInt, Int>* {
+        const Containers::Pair<UnsignedInt, Int>* found = std::lower_bound(parents.begin(), parents.end(), object, [](const Containers::Pair<UnsignedInt, Int>& a, const UnsignedInt b) {
+            return a.first() < b;
+        });
+        return found != parents.end() && found->first() == object ? found : nullptr;
+    };
+    const auto findTransformation = [&](const UnsignedInt object) -> T {
+        const Containers::Pair<UnsignedInt, MatrixTypeFor<dimensions, Float>>* found = std::upper_bound(transformations.begin(), transformations.end(), object, [](const UnsignedInt a, const Containers::Pair<UnsignedInt, MatrixTypeFor<dimensions, Float>>& b) {
+            return a < b.first();
+        });
+        if(found != transformations.begin() && (found - 1)->first() == object)
+            return T{(found - 1)->second()};
+        return T{IdentityInit};
+    };
+
+    const T global{globalTransformation};
+    parallelRanges(threadCount, meshMapping.size(), [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) {
+            const UnsignedInt object = meshMapping[i];
+            const Containers::Pair<UnsignedInt, Int>* parent = findParent(object);
+            if(!parent) {
+                inHierarchy[i] = false;
+                continue;
+            }
+
+            /* Walk up to the root. If the chain is longer than the count of
+               all parents, it's cyclic. */
+            T transformation = findTransformation(object);
+            for(std::size_t depth = 0; ; ++depth) {
+                if(parent->second() == -1) {
+                    transformation = multiply(global, transformation);
+                    inHierarchy[i] = true;
+                    break;
+                }
+
+                const UnsignedInt parentObject = parent->second();
+                parent = findParent(parentObject);
+                if(!parent || depth == parents.size()) {
+                    inHierarchy[i] = false;
+                    break;
+                }
+
+                transformation = multiply(findTransformation(parentObject), transformation);
+            }
+
+            meshTransformations[i] = MatrixTypeFor<dimensions, Float>{transformation};
+        }
+    });
+}
+
+template<UnsignedInt dimensions>
+Containers::Array<Containers::Triple<UnsignedInt, Int, MatrixTypeFor<dimensions, Float>>> flattenMeshHierarchyImplementation(const Trade::SceneData& scene, const MatrixTypeFor<dimensions, Float>& globalTransformation, const FlattenMeshHierarchyFlags flags, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(SceneDataDimensionTraits<dimensions>::isDimensions(scene),
+        "SceneTools::flattenMeshHierarchy(): the scene is not" << dimensions << Debug::nospace << "D", {});
+    const Containers::Optional<UnsignedInt> parentFieldId = scene.findFieldId(Trade::SceneField::Parent);
+    CORRADE_ASSERT(parentFieldId,
+        "SceneTools::flattenMeshHierarchy(): the scene has no hierarchy", {});
+
+    /* If there's no mesh field in the file, nothing to do. Another case is
+       that there is a mesh field but it's empty, then for simplicity we still
+       go through everything. */
+    if(!scene.hasField(Trade::SceneField::Mesh)) return {};
+
     /* Allocate the output array, retrieve mesh & material IDs and assign
        absolute transformations to each. The matrix location is abused for
        object mapping, which is subsequently replaced by the absolute object
        transformation for given mesh. */
-    /** @todo skip meshes that aren't part of the hierarchy once we have a
-        BitArray to efficiently mark what's in the hierarchy and what not */
     Containers::Array<Containers::Triple<UnsignedInt, Int, MatrixTypeFor<dimensions, Float>>> out{NoInit, scene.fieldSize(Trade::SceneField::Mesh)};
     const auto matrices = stridedArrayView(out).slice(&decltype(out)::Type::third);
     const auto mapping = Containers::arrayCast<UnsignedInt>(matrices);
     scene.meshesMaterialsInto(mapping,
         stridedArrayView(out).slice(&decltype(out)::Type::first),
         stridedArrayView(out).slice(&decltype(out)::Type::second));
-    for(std::size_t i = 0; i != out.size(); ++i) {
-        CORRADE_INTERNAL_ASSERT(mapping[i] < scene.mappingBound());
-        matrices[i] = absoluteTransformations[mapping[i] + 1];
+
+    const UnsignedInt usedThreadCount = Implementation::parallelThreadCount(threadCount);
+    typedef typename SceneDataDimensionTraits<dimensions>::AffineMatrix AffineMatrix;
+
+    if(!(flags & FlattenMeshHierarchyFlag::Sparse)) {
+        /** @todo skip meshes that aren't part of the hierarchy once we have a
+            BitArray to efficiently mark what's in the hierarchy and what not */
+        if(flags & FlattenMeshHierarchyFlag::Affine)
+            flattenMeshHierarchyDenseInto<dimensions, AffineMatrix>(scene, *parentFieldId, globalTransformation, usedThreadCount, mapping, matrices);
+        else
+            flattenMeshHierarchyDenseInto<dimensions, MatrixTypeFor<dimensions, Float>>(scene, *parentFieldId, globalTransformation, usedThreadCount, mapping, matrices);
+        return out;
+    }
+
+    Containers::Array<bool> inHierarchy{NoInit, out.size()};
+    if(flags & FlattenMeshHierarchyFlag::Affine)
+        flattenMeshHierarchySparseInto<dimensions, AffineMatrix>(scene, *parentFieldId, globalTransformation, usedThreadCount, mapping, matrices, inHierarchy);
+    else
+        flattenMeshHierarchySparseInto<dimensions, MatrixTypeFor<dimensions, Float>>(scene, *parentFieldId, globalTransformation, usedThreadCount, mapping, matrices, inHierarchy);
+
+    /* Remove meshes that aren't a part of the hierarchy, preserving order */
+    std::size_t outputSize = 0;
+    for(std::size_t i = 0; i != out.size(); ++i)
+        if(inHierarchy[i]) out[outputSize++] = out[i];
+    if(outputSize != out.size()) {
+        Containers::Array<Containers::Triple<UnsignedInt, Int, MatrixTypeFor<dimensions, Float>>> compacted{NoInit, outputSize};
+        Utility::copy(out.prefix(outputSize), compacted);
+        out = std::move(compacted);
     }
 
     return out;
@@ -132,19 +321,27 @@ Containers::Array<Containers::Triple<UnsignedInt, Int, MatrixTypeFor<dimensions,
 }
 
 Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix3>> flattenMeshHierarchy2D(const Trade::SceneData& scene, const Matrix3& globalTransformation) {
-    return flattenMeshHierarchyImplementation<2>(scene, globalTransformation);
+    return flattenMeshHierarchyImplementation<2>(scene, globalTransformation, {}, 1);
 }
 
 Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix3>> flattenMeshHierarchy2D(const Trade::SceneData& scene) {
-    return flattenMeshHierarchyImplementation<2>(scene, {});
+    return flattenMeshHierarchyImplementation<2>(scene, {}, {}, 1);
+}
+
+Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix3>> flattenMeshHierarchy2D(const Trade::SceneData& scene, const Matrix3& globalTransformation, const FlattenMeshHierarchyFlags flags, const UnsignedInt threadCount) {
+    return flattenMeshHierarchyImplementation<2>(scene, globalTransformation, flags, threadCount);
 }
 
 Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix4>> flattenMeshHierarchy3D(const Trade::SceneData& scene, const Matrix4& globalTransformation) {
-    return flattenMeshHierarchyImplementation<3>(scene, globalTransformation);
+    return flattenMeshHierarchyImplementation<3>(scene, globalTransformation, {}, 1);
 }
 
 Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix4>> flattenMeshHierarchy3D(const Trade::SceneData& scene) {
-    return flattenMeshHierarchyImplementation<3>(scene, {});
+    return flattenMeshHierarchyImplementation<3>(scene, {}, {}, 1);
+}
+
+Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix4>> flattenMeshHierarchy3D(const Trade::SceneData& scene, const Matrix4& globalTransformation, const FlattenMeshHierarchyFlags flags, const UnsignedInt threadCount) {
+    return flattenMeshHierarchyImplementation<3>(scene, globalTransformation, flags, threadCount);
 }
 
 }}
@@ -26,16 +26,63 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::SceneTools::flattenMeshHierarchy2D(), @ref Magnum::SceneTools::flattenMeshHierarchy3D()
+ * @brief Function @ref Magnum::SceneTools::flattenMeshHierarchy2D(), @ref Magnum::SceneTools::flattenMeshHierarchy3D(), enum @ref Magnum::SceneTools::FlattenMeshHierarchyFlag, enum set @ref Magnum::SceneTools::FlattenMeshHierarchyFlags
  * @m_since_latest
  */
 
+#include <Corrade/Containers/EnumSet.h>
+
 #include "Magnum/Magnum.h"
 #include "Magnum/SceneTools/visibility.h"
 #include "Magnum/Trade/Trade.h"
 
 namespace Magnum { namespace SceneTools {
 
+/**
+@brief Mesh hierarchy flattening flag
+@m_since_latest
+
+@see @ref FlattenMeshHierarchyFlags,
+    @ref flattenMeshHierarchy2D(const Trade::SceneData&, const Matrix3&, FlattenMeshHierarchyFlags, UnsignedInt),
+    @ref flattenMeshHierarchy3D(const Trade::SceneData&, const Matrix4&, FlattenMeshHierarchyFlags, UnsignedInt)
+*/
+enum class FlattenMeshHierarchyFlag: UnsignedByte {
+    /**
+     * Assume all transformations, including the global transformation, are
+     * affine and calculate with @ref Matrix3x2 / @ref Matrix4x3 instead of
+     * full @ref Matrix3 / @ref Matrix4. The bottom row of the input matrices
+     * is ignored and the returned matrices have it set to
+     * @f$ (0, 0, 1) @f$ / @f$ (0, 0, 0, 1) @f$. Needs a quarter less memory
+     * for the temporary per-object storage and roughly half of the
+     * multiplications.
+     */
+    Affine = 1 << 0,
+
+    /**
+     * Calculate absolute transformations only for objects that have a mesh,
+     * by walking up their parent chain, instead of calculating them for all
+     * objects up to @ref Trade::SceneData::mappingBound(). Doesn't need any
+     * temporary storage proportional to the mapping bound, which is
+     * beneficial if only a small fraction of objects has a mesh. Meshes
+     * attached to objects that aren't a part of the hierarchy are not
+     * included in the output, and the hierarchy isn't checked for cycles ---
+     * objects whose parent chain doesn't end in a root are treated as not
+     * being a part of the hierarchy.
+     */
+    Sparse = 1 << 1
+};
+
+/**
+@brief Mesh hierarchy flattening flags
+@m_since_latest
+
+@see @ref flattenMeshHierarchy2D(const Trade::SceneData&, const Matrix3&, FlattenMeshHierarchyFlags, UnsignedInt),
+    @ref flattenMeshHierarchy3D(const Trade::SceneData&, const Matrix4&, FlattenMeshHierarchyFlags, UnsignedInt)
+*/
+typedef Containers::EnumSet<FlattenMeshHierarchyFlag> FlattenMeshHierarchyFlags;
+
+CORRADE_ENUMSET_OPERATORS(FlattenMeshHierarchyFlags)
+
 /**
 @brief Flatten a 2D mesh hierarchy
 @m_since_latest
@@ -72,6 +119,22 @@ Same as above with @p globalTransformation set to an identity matrix.
 */
 MAGNUM_SCENETOOLS_EXPORT Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix3>> flattenMeshHierarchy2D(const Trade::SceneData& scene);
 
+/**
+@brief Flatten a 2D mesh hierarchy with flags and multiple threads
+@m_since_latest
+
+Same as @ref flattenMeshHierarchy2D(const Trade::SceneData&, const Matrix3&),
+but with behavior controlled by @p flags and the work split across
+@p threadCount threads. If @p threadCount is @cpp 0 @ce, uses all hardware
+threads, if the platform doesn't support threads or @p threadCount is
+@cpp 1 @ce, everything is done on the calling thread. See
+@ref flattenMeshHierarchy3D(const Trade::SceneData&, const Matrix4&, FlattenMeshHierarchyFlags, UnsignedInt)
+for more information.
+
+@experimental
+*/
+MAGNUM_SCENETOOLS_EXPORT Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix3>> flattenMeshHierarchy2D(const Trade::SceneData& scene, const Matrix3& globalTransformation, FlattenMeshHierarchyFlags flags, UnsignedInt threadCount = 1);
+
 /**
 @brief Flatten a 3D mesh hierarchy
 @m_since_latest
@@ -108,6 +171,36 @@ Same as above with @p globalTransformation set to an identity matrix.
 */
 MAGNUM_SCENETOOLS_EXPORT Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix4>> flattenMeshHierarchy3D(const Trade::SceneData& scene);
 
+/**
+@brief Flatten a 3D mesh hierarchy with flags and multiple threads
+@m_since_latest
+
+Same as @ref flattenMeshHierarchy3D(const Trade::SceneData&, const Matrix4&),
+but with behavior controlled by @p flags and the work split across
+@p threadCount threads. If @p threadCount is @cpp 0 @ce, uses all hardware
+threads, if the platform doesn't support threads or @p threadCount is
+@cpp 1 @ce, everything is done on the calling thread. The output is the same
+independently of the thread count.
+
+Without @ref FlattenMeshHierarchyFlag::Sparse, the output of
+@ref orderClusterParents() is split into levels of objects having the same
+depth in the hierarchy. Objects in each level depend only on the previous
+level, so each sufficiently large level is processed in parallel. Compared to
+the single-threaded variant, this additionally allocates a four-byte value
+for every object up to @ref Trade::SceneData::mappingBound(). With
+@ref FlattenMeshHierarchyFlag::Sparse, the parent chain of each mesh is
+walked independently, making the operation done in an
+@f$ \mathcal{O}(p \log p + t \log t + m d (\log p + \log t)) @f$
+execution time and @f$ \mathcal{O}(m + p + t) @f$ memory complexity, with
+@f$ m @f$ being size of the @ref Trade::SceneField::Mesh field, @f$ p @f$
+size of the @ref Trade::SceneField::Parent field, @f$ t @f$ size of the
+@ref Trade::SceneField::Transformation field and @f$ d @f$ the hierarchy
+depth.
+
+@experimental
+*/
+MAGNUM_SCENETOOLS_EXPORT Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix4>> flattenMeshHierarchy3D(const Trade::SceneData& scene, const Matrix4& globalTransformation, FlattenMeshHierarchyFlags flags, UnsignedInt threadCount = 1);
+
 }}
 
 #endif
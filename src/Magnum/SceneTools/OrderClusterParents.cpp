@@ -113,10 +113,9 @@ void orderClusterParentsInto(const Trade::SceneData& scene, const Containers::St
     for(std::size_t i = 0; i != outputOffset + 1; ++i) {
         const Int objectId = parentsToProcess[i];
         for(std::size_t j = childrenOffsets[objectId + 1], jMax = childrenOffsets[objectId + 2]; j != jMax; ++j) {
-            /** @todo better diagnostic once we can use a BitArray to detect
-                which nodes are parented more than once (OTOH maybe that's
-                unnecessary extra work which isn't desired to be done here but
-                should be instead in a dedicated cycle/sparse checker utility?) */
+            /* Detailed diagnostic of which nodes are parented more than
+               once is done by validateHierarchy(), not doing that extra work
+               here */
             CORRADE_ASSERT(outputOffset < parents.size(),
                 "SceneTools::orderClusterParents(): hierarchy is cyclic", );
             parentsToProcess[outputOffset + 1] = children[j];
@@ -126,9 +125,7 @@ void orderClusterParentsInto(const Trade::SceneData& scene, const Containers::St
         }
     }
 
-    /** @todo better diagnostic once we can use a BitArray to detect which
-        nodes are unreachable from root (OTOH again maybe that's undesirable
-        extra work that doesn't belong here?) */
+    /* Same here, validateHierarchy() reports which nodes are unreachable */
     CORRADE_ASSERT(outputOffset == parents.size(),
         "SceneTools::orderClusterParents(): hierarchy is sparse", );
 }
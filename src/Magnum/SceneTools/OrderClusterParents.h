@@ -55,7 +55,9 @@ The operation is done in an @f$ \mathcal{O}(n) @f$ execution time and memory
 complexity, with @f$ n @f$ being @ref Trade::SceneData::mappingBound(). The
 @ref Trade::SceneField::Parent field is expected to be contained in the scene,
 having no cycles (i.e., every node listed just once) and not being sparse
-(i.e., every node listed in the field reachable from the root).
+(i.e., every node listed in the field reachable from the root). Use
+@ref validateHierarchy() to check these conditions for scenes coming from
+untrusted sources.
 
 @experimental
 
@@ -30,11 +30,21 @@
  * @m_since_latest
  */
 
-#include "Magnum/configure.h"
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Types.h"
 
 namespace Magnum { namespace SceneTools {
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
+template<UnsignedInt> class AbsoluteTransformationCache;
+typedef AbsoluteTransformationCache<2> AbsoluteTransformationCache2D;
+typedef AbsoluteTransformationCache<3> AbsoluteTransformationCache3D;
+
+enum class CompressAnimationFlag: UnsignedByte;
+typedef Containers::EnumSet<CompressAnimationFlag> CompressAnimationFlags;
+
+enum class HierarchyIssue: UnsignedByte;
 #endif
 
 }}
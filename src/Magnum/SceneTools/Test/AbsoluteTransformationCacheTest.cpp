@@ -0,0 +1,380 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneTools/AbsoluteTransformationCache.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace SceneTools { namespace Test { namespace {
+
+struct AbsoluteTransformationCacheTest: TestSuite::Tester {
+    explicit AbsoluteTransformationCacheTest();
+
+    void construct2D();
+    void construct3D();
+    void constructNotMatchingDimensions();
+    void constructNoParentField();
+    void constructCopy();
+    void constructMove();
+
+    void updateLocal();
+    void updateLocalChildAndParent();
+    void updateGlobal();
+    void updateNotInHierarchy();
+    void updateNothing();
+
+    void invalidObject();
+};
+
+using namespace Math::Literals;
+
+/*
+    1T       4
+   / \       |         0T 6
+  5T  2T     11
+ / \
+3   7T
+
+    Objects 0 and 6 are not a part of the hierarchy, 8, 9 and 10 are not
+    referenced at all.
+*/
+const struct Data {
+    struct Parent {
+        UnsignedInt object;
+        Int parent;
+    } parents[7];
+
+    struct Transformation2D {
+        UnsignedInt object;
+        Matrix3 transformation;
+    } transformations2D[5];
+
+    struct Transformation3D {
+        UnsignedInt object;
+        Matrix4 transformation;
+    } transformations3D[5];
+} SceneDataData[]{{
+    {{3, 5},
+     {11, 4},
+     {5, 1},
+     {1, -1},
+     {7, 5},
+     {2, 1},
+     {4, -1}},
+    {{1, Matrix3::translation({1.0f, -1.5f})},
+     {5, Matrix3::rotation(35.0_degf)},
+     {2, Matrix3::scaling({3.0f, 5.0f})},
+     {7, Matrix3::scaling({2.0f, 1.0f})},
+     {0, Matrix3::translation({0.5f, 2.0f})}},
+    {{1, Matrix4::translation({1.0f, -1.5f, 0.5f})},
+     {5, Matrix4::rotationZ(35.0_degf)},
+     {2, Matrix4::scaling({3.0f, 5.0f, 2.0f})},
+     {7, Matrix4::scaling({2.0f, 1.0f, 0.5f})},
+     {0, Matrix4::translation({0.5f, 2.0f, 1.0f})}}
+}};
+
+Trade::SceneData scene2D() {
+    return Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 12, {}, SceneDataData, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(SceneDataData->parents)
+                .slice(&Data::Parent::object),
+            Containers::stridedArrayView(SceneDataData->parents)
+                .slice(&Data::Parent::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::stridedArrayView(SceneDataData->transformations2D)
+                .slice(&Data::Transformation2D::object),
+            Containers::stridedArrayView(SceneDataData->transformations2D)
+                .slice(&Data::Transformation2D::transformation)}
+    }};
+}
+
+Trade::SceneData scene3D() {
+    return Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 12, {}, SceneDataData, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(SceneDataData->parents)
+                .slice(&Data::Parent::object),
+            Containers::stridedArrayView(SceneDataData->parents)
+                .slice(&Data::Parent::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::stridedArrayView(SceneDataData->transformations3D)
+                .slice(&Data::Transformation3D::object),
+            Containers::stridedArrayView(SceneDataData->transformations3D)
+                .slice(&Data::Transformation3D::transformation)}
+    }};
+}
+
+AbsoluteTransformationCacheTest::AbsoluteTransformationCacheTest() {
+    addTests({&AbsoluteTransformationCacheTest::construct2D,
+              &AbsoluteTransformationCacheTest::construct3D,
+              &AbsoluteTransformationCacheTest::constructNotMatchingDimensions,
+              &AbsoluteTransformationCacheTest::constructNoParentField,
+              &AbsoluteTransformationCacheTest::constructCopy,
+              &AbsoluteTransformationCacheTest::constructMove,
+
+              &AbsoluteTransformationCacheTest::updateLocal,
+              &AbsoluteTransformationCacheTest::updateLocalChildAndParent,
+              &AbsoluteTransformationCacheTest::updateGlobal,
+              &AbsoluteTransformationCacheTest::updateNotInHierarchy,
+              &AbsoluteTransformationCacheTest::updateNothing,
+
+              &AbsoluteTransformationCacheTest::invalidObject});
+}
+
+void AbsoluteTransformationCacheTest::construct2D() {
+    const Matrix3 global = Matrix3::scaling(Vector2{0.5f});
+    AbsoluteTransformationCache2D cache{scene2D(), global};
+    CORRADE_COMPARE(cache.objectCount(), 12);
+    CORRADE_VERIFY(!cache.isDirty());
+    CORRADE_COMPARE(cache.globalTransformation(), global);
+    CORRADE_COMPARE(cache.localTransformation(5), Matrix3::rotation(35.0_degf));
+    CORRADE_COMPARE(cache.localTransformation(3), Matrix3{});
+
+    Containers::StridedArrayView1D<const Matrix3> absolute = cache.absoluteTransformations();
+    CORRADE_COMPARE(absolute.size(), 12);
+    CORRADE_COMPARE(absolute[1], global*
+        Matrix3::translation({1.0f, -1.5f}));
+    CORRADE_COMPARE(absolute[2], global*
+        Matrix3::translation({1.0f, -1.5f})*
+        Matrix3::scaling({3.0f, 5.0f}));
+    CORRADE_COMPARE(absolute[3], global*
+        Matrix3::translation({1.0f, -1.5f})*
+        Matrix3::rotation(35.0_degf));
+    CORRADE_COMPARE(absolute[7], global*
+        Matrix3::translation({1.0f, -1.5f})*
+        Matrix3::rotation(35.0_degf)*
+        Matrix3::scaling({2.0f, 1.0f}));
+    CORRADE_COMPARE(absolute[4], global);
+    CORRADE_COMPARE(absolute[11], global);
+    /* Not a part of the hierarchy, global transformation not applied */
+    CORRADE_COMPARE(absolute[0], Matrix3::translation({0.5f, 2.0f}));
+    CORRADE_COMPARE(absolute[6], Matrix3{});
+}
+
+void AbsoluteTransformationCacheTest::construct3D() {
+    const Matrix4 global = Matrix4::scaling(Vector3{0.5f});
+    AbsoluteTransformationCache3D cache{scene3D(), global};
+    CORRADE_COMPARE(cache.objectCount(), 12);
+    CORRADE_VERIFY(!cache.isDirty());
+    CORRADE_COMPARE(cache.globalTransformation(), global);
+    CORRADE_COMPARE(cache.localTransformation(5), Matrix4::rotationZ(35.0_degf));
+    CORRADE_COMPARE(cache.localTransformation(3), Matrix4{});
+
+    Containers::StridedArrayView1D<const Matrix4> absolute = cache.absoluteTransformations();
+    CORRADE_COMPARE(absolute.size(), 12);
+    CORRADE_COMPARE(absolute[1], global*
+        Matrix4::translation({1.0f, -1.5f, 0.5f}));
+    CORRADE_COMPARE(absolute[2], global*
+        Matrix4::translation({1.0f, -1.5f, 0.5f})*
+        Matrix4::scaling({3.0f, 5.0f, 2.0f}));
+    CORRADE_COMPARE(absolute[3], global*
+        Matrix4::translation({1.0f, -1.5f, 0.5f})*
+        Matrix4::rotationZ(35.0_degf));
+    CORRADE_COMPARE(absolute[7], global*
+        Matrix4::translation({1.0f, -1.5f, 0.5f})*
+        Matrix4::rotationZ(35.0_degf)*
+        Matrix4::scaling({2.0f, 1.0f, 0.5f}));
+    CORRADE_COMPARE(absolute[4], global);
+    CORRADE_COMPARE(absolute[11], global);
+    /* Not a part of the hierarchy, global transformation not applied */
+    CORRADE_COMPARE(absolute[0], Matrix4::translation({0.5f, 2.0f, 1.0f}));
+    CORRADE_COMPARE(absolute[6], Matrix4{});
+}
+
+void AbsoluteTransformationCacheTest::constructNotMatchingDimensions() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    AbsoluteTransformationCache2D{scene};
+    AbsoluteTransformationCache3D{scene2D()};
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::AbsoluteTransformationCache: the scene is not 2D\n"
+        "SceneTools::AbsoluteTransformationCache: the scene is not 3D\n");
+}
+
+void AbsoluteTransformationCacheTest::constructNoParentField() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {
+        Trade::SceneFieldData{Trade::SceneField::Transformation, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Matrix3x3, nullptr}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    AbsoluteTransformationCache2D{scene};
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::AbsoluteTransformationCache: the scene has no hierarchy\n");
+}
+
+void AbsoluteTransformationCacheTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<AbsoluteTransformationCache3D>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<AbsoluteTransformationCache3D>{});
+}
+
+void AbsoluteTransformationCacheTest::constructMove() {
+    AbsoluteTransformationCache3D a{scene3D()};
+    a.setLocalTransformation(2, Matrix4::translation(Vector3::zAxis(3.0f)));
+
+    AbsoluteTransformationCache3D b{std::move(a)};
+    CORRADE_COMPARE(b.objectCount(), 12);
+    CORRADE_VERIFY(b.isDirty());
+    CORRADE_COMPARE(b.update(), 1);
+    CORRADE_COMPARE(b.absoluteTransformations()[2],
+        Matrix4::translation({1.0f, -1.5f, 3.5f}));
+
+    AbsoluteTransformationCache3D c{scene3D()};
+    c = std::move(b);
+    CORRADE_COMPARE(c.objectCount(), 12);
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_COMPARE(c.absoluteTransformations()[2],
+        Matrix4::translation({1.0f, -1.5f, 3.5f}));
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<AbsoluteTransformationCache3D>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<AbsoluteTransformationCache3D>::value);
+}
+
+void AbsoluteTransformationCacheTest::updateLocal() {
+    AbsoluteTransformationCache3D cache{scene3D()};
+
+    cache.setLocalTransformation(5, Matrix4::rotationX(90.0_degf));
+    CORRADE_VERIFY(cache.isDirty());
+    CORRADE_COMPARE(cache.localTransformation(5), Matrix4::rotationX(90.0_degf));
+
+    /* Not updated until update() is called */
+    CORRADE_COMPARE(cache.absoluteTransformations()[3],
+        Matrix4::translation({1.0f, -1.5f, 0.5f})*
+        Matrix4::rotationZ(35.0_degf));
+
+    /* Object 5 and its children 3 and 7 */
+    CORRADE_COMPARE(cache.update(), 3);
+    CORRADE_VERIFY(!cache.isDirty());
+
+    Containers::StridedArrayView1D<const Matrix4> absolute = cache.absoluteTransformations();
+    CORRADE_COMPARE(absolute[5],
+        Matrix4::translation({1.0f, -1.5f, 0.5f})*
+        Matrix4::rotationX(90.0_degf));
+    CORRADE_COMPARE(absolute[3],
+        Matrix4::translation({1.0f, -1.5f, 0.5f})*
+        Matrix4::rotationX(90.0_degf));
+    CORRADE_COMPARE(absolute[7],
+        Matrix4::translation({1.0f, -1.5f, 0.5f})*
+        Matrix4::rotationX(90.0_degf)*
+        Matrix4::scaling({2.0f, 1.0f, 0.5f}));
+    /* Siblings stay the same */
+    CORRADE_COMPARE(absolute[2],
+        Matrix4::translation({1.0f, -1.5f, 0.5f})*
+        Matrix4::scaling({3.0f, 5.0f, 2.0f}));
+}
+
+void AbsoluteTransformationCacheTest::updateLocalChildAndParent() {
+    AbsoluteTransformationCache3D cache{scene3D()};
+
+    /* Child marked as dirty before the parent, the subtree should be still
+       recalculated just once. Setting the same object twice doesn't result
+       in it being calculated twice either. */
+    cache.setLocalTransformation(7, Matrix4::translation(Vector3::yAxis(2.0f)))
+         .setLocalTransformation(1, Matrix4::translation(Vector3::xAxis(4.0f)))
+         .setLocalTransformation(7, Matrix4::translation(Vector3::yAxis(3.0f)))
+         .setLocalTransformation(11, Matrix4::translation(Vector3::zAxis(1.0f)));
+
+    /* Objects 1, 5, 2, 3, 7 and 11 */
+    CORRADE_COMPARE(cache.update(), 6);
+
+    Containers::StridedArrayView1D<const Matrix4> absolute = cache.absoluteTransformations();
+    CORRADE_COMPARE(absolute[7],
+        Matrix4::translation(Vector3::xAxis(4.0f))*
+        Matrix4::rotationZ(35.0_degf)*
+        Matrix4::translation(Vector3::yAxis(3.0f)));
+    CORRADE_COMPARE(absolute[2],
+        Matrix4::translation(Vector3::xAxis(4.0f))*
+        Matrix4::scaling({3.0f, 5.0f, 2.0f}));
+    CORRADE_COMPARE(absolute[11],
+        Matrix4::translation(Vector3::zAxis(1.0f)));
+}
+
+void AbsoluteTransformationCacheTest::updateGlobal() {
+    AbsoluteTransformationCache2D cache{scene2D()};
+
+    const Matrix3 global = Matrix3::translation({-3.0f, 0.5f});
+    cache.setGlobalTransformation(global);
+    CORRADE_VERIFY(cache.isDirty());
+    CORRADE_COMPARE(cache.globalTransformation(), global);
+
+    /* All objects that are a part of the hierarchy */
+    CORRADE_COMPARE(cache.update(), 7);
+
+    Containers::StridedArrayView1D<const Matrix3> absolute = cache.absoluteTransformations();
+    CORRADE_COMPARE(absolute[7], global*
+        Matrix3::translation({1.0f, -1.5f})*
+        Matrix3::rotation(35.0_degf)*
+        Matrix3::scaling({2.0f, 1.0f}));
+    CORRADE_COMPARE(absolute[11], global);
+    CORRADE_COMPARE(absolute[0], Matrix3::translation({0.5f, 2.0f}));
+}
+
+void AbsoluteTransformationCacheTest::updateNotInHierarchy() {
+    AbsoluteTransformationCache2D cache{scene2D()};
+
+    cache.setLocalTransformation(6, Matrix3::scaling({2.0f, 3.0f}));
+    CORRADE_COMPARE(cache.update(), 1);
+    CORRADE_COMPARE(cache.absoluteTransformations()[6], Matrix3::scaling({2.0f, 3.0f}));
+}
+
+void AbsoluteTransformationCacheTest::updateNothing() {
+    AbsoluteTransformationCache3D cache{scene3D()};
+    CORRADE_VERIFY(!cache.isDirty());
+    CORRADE_COMPARE(cache.update(), 0);
+
+    /* Second update after an actual change does nothing again */
+    cache.setLocalTransformation(4, Matrix4::translation(Vector3::zAxis(1.0f)));
+    CORRADE_COMPARE(cache.update(), 2);
+    CORRADE_COMPARE(cache.update(), 0);
+}
+
+void AbsoluteTransformationCacheTest::invalidObject() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    AbsoluteTransformationCache3D cache{scene3D()};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.localTransformation(12);
+    cache.setLocalTransformation(12, {});
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::AbsoluteTransformationCache::localTransformation(): index 12 out of range for 12 objects\n"
+        "SceneTools::AbsoluteTransformationCache::setLocalTransformation(): index 12 out of range for 12 objects\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneTools::Test::AbsoluteTransformationCacheTest)
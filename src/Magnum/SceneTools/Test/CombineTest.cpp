@@ -23,13 +23,20 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Math/Complex.h"
 #include "Magnum/Math/Vector2.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/SceneTools/Combine.h"
 #include "Magnum/SceneTools/Implementation/combine.h"
+#include "Magnum/Trade/SceneData.h"
 
 namespace Magnum { namespace SceneTools { namespace Test { namespace {
 
@@ -41,6 +48,18 @@ struct CombineTest: TestSuite::Tester {
     void objectsShared();
     void objectsPlaceholderFieldPlaceholder();
     void objectSharedFieldPlaceholder();
+
+    void fields();
+    void fieldsInvalidMappingType();
+    void fieldsOffsetOnly();
+    void fieldsSharedMappingDifferentSize();
+
+    void scene();
+    void sceneMappingType();
+    void sceneAlreadySorted();
+    void sceneSharedMapping();
+    void sceneOffsetOnly();
+    void sceneEmpty();
 };
 
 struct {
@@ -53,6 +72,18 @@ struct {
     {"UnsignedLong output", Trade::SceneMappingType::UnsignedLong},
 };
 
+const struct {
+    const char* name;
+    UnsignedLong mappingBound;
+    Trade::SceneMappingType expected;
+} SceneMappingTypeData[]{
+    {"UnsignedByte", 0xff, Trade::SceneMappingType::UnsignedByte},
+    {"UnsignedShort", 0x100, Trade::SceneMappingType::UnsignedShort},
+    {"UnsignedShort max", 0xffff, Trade::SceneMappingType::UnsignedShort},
+    {"UnsignedInt", 0x10000, Trade::SceneMappingType::UnsignedInt},
+    {"UnsignedLong", 0x100000000ull, Trade::SceneMappingType::UnsignedLong},
+};
+
 CombineTest::CombineTest() {
     addInstancedTests({&CombineTest::test},
         Containers::arraySize(TestData));
@@ -61,6 +92,21 @@ CombineTest::CombineTest() {
               &CombineTest::objectsShared,
               &CombineTest::objectsPlaceholderFieldPlaceholder,
               &CombineTest::objectSharedFieldPlaceholder});
+
+    addTests({&CombineTest::fields,
+              &CombineTest::fieldsInvalidMappingType,
+              &CombineTest::fieldsOffsetOnly,
+              &CombineTest::fieldsSharedMappingDifferentSize,
+
+              &CombineTest::scene});
+
+    addInstancedTests({&CombineTest::sceneMappingType},
+        Containers::arraySize(SceneMappingTypeData));
+
+    addTests({&CombineTest::sceneAlreadySorted,
+              &CombineTest::sceneSharedMapping,
+              &CombineTest::sceneOffsetOnly,
+              &CombineTest::sceneEmpty});
 }
 
 using namespace Math::Literals;
@@ -324,6 +370,345 @@ void CombineTest::objectSharedFieldPlaceholder() {
     CORRADE_COMPARE(scene.field(Trade::SceneField::MeshMaterial).stride()[0], 4);
 }
 
+void CombineTest::fields() {
+    /* Just verifies the public wrapper, the internals are tested above */
+    const UnsignedInt meshMappingData[]{45, 78, 23};
+    const UnsignedByte meshFieldData[]{3, 5, 17};
+    const UnsignedByte parentMappingData[]{0, 1};
+    const Short parentData[]{-1, 0};
+
+    Trade::SceneData scene = combineFields(Trade::SceneMappingType::UnsignedShort, 167, {
+        Trade::SceneFieldData{Trade::SceneField::Mesh, Containers::arrayView(meshMappingData), Containers::arrayView(meshFieldData)},
+        Trade::SceneFieldData{Trade::SceneField::Parent, Containers::arrayView(parentMappingData), Containers::arrayView(parentData), Trade::SceneFieldFlag::ImplicitMapping}
+    });
+
+    CORRADE_COMPARE(scene.dataFlags(), Trade::DataFlag::Owned|Trade::DataFlag::Mutable);
+    CORRADE_COMPARE(scene.mappingType(), Trade::SceneMappingType::UnsignedShort);
+    CORRADE_COMPARE(scene.mappingBound(), 167);
+    CORRADE_COMPARE(scene.fieldCount(), 2);
+
+    CORRADE_COMPARE(scene.fieldName(0), Trade::SceneField::Mesh);
+    CORRADE_COMPARE(scene.fieldFlags(0), Trade::SceneFieldFlags{});
+    CORRADE_COMPARE_AS(scene.mapping<UnsignedShort>(0), Containers::arrayView<UnsignedShort>({
+        45, 78, 23
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene.field<UnsignedByte>(0),
+        Containers::arrayView(meshFieldData),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(scene.fieldName(1), Trade::SceneField::Parent);
+    CORRADE_COMPARE(scene.fieldFlags(1), Trade::SceneFieldFlag::ImplicitMapping);
+    CORRADE_COMPARE_AS(scene.mapping<UnsignedShort>(1), Containers::arrayView<UnsignedShort>({
+        0, 1
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene.field<Short>(1),
+        Containers::arrayView(parentData),
+        TestSuite::Compare::Container);
+}
+
+void CombineTest::fieldsInvalidMappingType() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    combineFields(Trade::SceneMappingType::UnsignedByte, 0x100, {});
+    combineFields(Trade::SceneMappingType::UnsignedShort, 0x10000, {});
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::combineFields(): Trade::SceneMappingType::UnsignedByte is too small for 256 objects\n"
+        "SceneTools::combineFields(): Trade::SceneMappingType::UnsignedShort is too small for 65536 objects\n");
+}
+
+void CombineTest::fieldsOffsetOnly() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt meshMappingData[]{45, 78, 23};
+    const UnsignedByte meshFieldData[]{3, 5, 17};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    combineFields(Trade::SceneMappingType::UnsignedInt, 167, {
+        Trade::SceneFieldData{Trade::SceneField::Mesh, Containers::arrayView(meshMappingData), Containers::arrayView(meshFieldData)},
+        Trade::SceneFieldData{Trade::SceneField::Parent, 2, Trade::SceneMappingType::UnsignedInt, 0, 4, Trade::SceneFieldType::Int, 8, 4}
+    });
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::combineFields(): field 1 is offset-only\n");
+}
+
+void CombineTest::fieldsSharedMappingDifferentSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt meshMappingData[]{45, 78, 23};
+    const UnsignedByte meshFieldData[]{3, 5, 17};
+    const Int meshMaterialFieldData[]{2, 7};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    combineFields(Trade::SceneMappingType::UnsignedInt, 167, {
+        Trade::SceneFieldData{Trade::SceneField::Mesh, Containers::arrayView(meshMappingData), Containers::arrayView(meshFieldData)},
+        Trade::SceneFieldData{Trade::SceneField::MeshMaterial, Containers::arrayView(meshMappingData).prefix(2), Containers::arrayView(meshMaterialFieldData)}
+    });
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::combineFields(): field 1 shares mapping with field 0 but has 2 items instead of 3\n");
+}
+
+void CombineTest::scene() {
+    /* Mapping and field data interleaved, with an UnsignedInt mapping type
+       even though the mapping bound fits into a byte */
+    struct Mesh {
+        UnsignedInt mapping;
+        UnsignedShort mesh;
+    };
+    struct Parent {
+        UnsignedInt mapping;
+        Int parent;
+    };
+    struct Foo {
+        UnsignedInt mapping;
+        Float foo[2];
+    };
+    struct Data {
+        Mesh meshes[5];
+        Parent parents[5];
+        Foo foos[2];
+    } data[]{{
+        {{7, 0},
+         {2, 1},
+         {7, 2},
+         {0, 3},
+         {2, 4}},
+        {{2, -1},
+         {0, 2},
+         {1, 2},
+         {7, -1},
+         {3, 7}},
+        {{5, {1.0f, 2.0f}},
+         {1, {3.0f, 4.0f}}}
+    }};
+    Containers::StridedArrayView1D<Mesh> meshes = data->meshes;
+    Containers::StridedArrayView1D<Parent> parents = data->parents;
+    Containers::StridedArrayView1D<Foo> foos = data->foos;
+
+    int state;
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 8, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Mesh, meshes.slice(&Mesh::mapping), meshes.slice(&Mesh::mesh)},
+        Trade::SceneFieldData{Trade::SceneField::Parent, parents.slice(&Parent::mapping), parents.slice(&Parent::parent)},
+        Trade::SceneFieldData{Trade::sceneFieldCustom(15), foos.slice(&Foo::mapping), Containers::arrayCast<2, Float>(foos.slice(&Foo::foo))}
+    }, &state};
+
+    Trade::SceneData combined = combineFields(scene);
+    CORRADE_COMPARE(combined.dataFlags(), Trade::DataFlag::Owned|Trade::DataFlag::Mutable);
+    CORRADE_COMPARE(combined.mappingType(), Trade::SceneMappingType::UnsignedByte);
+    CORRADE_COMPARE(combined.mappingBound(), 8);
+    CORRADE_COMPARE(combined.fieldCount(), 3);
+    CORRADE_COMPARE(combined.importerState(), &state);
+
+    /* Entries for the same object stay in the original order */
+    CORRADE_COMPARE(combined.fieldName(0), Trade::SceneField::Mesh);
+    CORRADE_COMPARE(combined.fieldFlags(0), Trade::SceneFieldFlag::OrderedMapping);
+    CORRADE_COMPARE(combined.fieldType(0), Trade::SceneFieldType::UnsignedShort);
+    CORRADE_COMPARE_AS(combined.mapping<UnsignedByte>(0), Containers::arrayView<UnsignedByte>({
+        0, 2, 2, 7, 7
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(combined.field<UnsignedShort>(0), Containers::arrayView<UnsignedShort>({
+        3, 1, 4, 0, 2
+    }), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(combined.fieldName(1), Trade::SceneField::Parent);
+    CORRADE_COMPARE(combined.fieldFlags(1), Trade::SceneFieldFlag::OrderedMapping);
+    CORRADE_COMPARE(combined.fieldType(1), Trade::SceneFieldType::Int);
+    CORRADE_COMPARE_AS(combined.mapping<UnsignedByte>(1), Containers::arrayView<UnsignedByte>({
+        0, 1, 2, 3, 7
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(combined.field<Int>(1), Containers::arrayView<Int>({
+        2, 2, -1, 7, -1
+    }), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(combined.fieldName(2), Trade::sceneFieldCustom(15));
+    CORRADE_COMPARE(combined.fieldFlags(2), Trade::SceneFieldFlag::OrderedMapping);
+    CORRADE_COMPARE(combined.fieldType(2), Trade::SceneFieldType::Float);
+    CORRADE_COMPARE(combined.fieldArraySize(2), 2);
+    CORRADE_COMPARE_AS(combined.mapping<UnsignedByte>(2), Containers::arrayView<UnsignedByte>({
+        1, 5
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS((combined.field<Float[]>(2).transposed<0, 1>()[0]), Containers::arrayView<Float>({
+        3.0f, 1.0f
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS((combined.field<Float[]>(2).transposed<0, 1>()[1]), Containers::arrayView<Float>({
+        4.0f, 2.0f
+    }), TestSuite::Compare::Container);
+
+    /* Everything is tightly packed */
+    CORRADE_COMPARE(combined.mapping(0).stride()[0], 1);
+    CORRADE_COMPARE(combined.field(0).stride()[0], 2);
+    CORRADE_COMPARE(combined.field(2).stride()[0], 8);
+}
+
+void CombineTest::sceneMappingType() {
+    auto&& data = SceneMappingTypeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const struct Field {
+        UnsignedLong mapping;
+        Int parent;
+    } fields[]{
+        {0, -1}
+    };
+    Containers::StridedArrayView1D<const Field> view = fields;
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedLong, data.mappingBound, {}, fields, {
+        Trade::SceneFieldData{Trade::SceneField::Parent, view.slice(&Field::mapping), view.slice(&Field::parent)}
+    }};
+
+    Trade::SceneData combined = combineFields(scene);
+    CORRADE_COMPARE(combined.mappingType(), data.expected);
+    CORRADE_COMPARE(combined.mappingBound(), data.mappingBound);
+    CORRADE_COMPARE_AS(combined.mappingAsArray(0), Containers::arrayView<UnsignedInt>({
+        0
+    }), TestSuite::Compare::Container);
+}
+
+void CombineTest::sceneAlreadySorted() {
+    /* Sorted with duplicates, sorted contiguous from 0 and sorted with a
+       flag already */
+    const struct Data {
+        UnsignedShort meshMapping[4];
+        UnsignedInt mesh[4];
+        UnsignedShort parentMapping[4];
+        Int parent[4];
+        UnsignedShort lightMapping[2];
+        UnsignedInt light[2];
+    } data[]{{
+        {1, 1, 4, 6},
+        {3, 4, 5, 6},
+        {0, 1, 2, 3},
+        {-1, 0, 0, 1},
+        {1, 2},
+        {0, 1}
+    }};
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedShort, 7, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Mesh, Containers::arrayView(data->meshMapping), Containers::arrayView(data->mesh)},
+        Trade::SceneFieldData{Trade::SceneField::Parent, Containers::arrayView(data->parentMapping), Containers::arrayView(data->parent)},
+        Trade::SceneFieldData{Trade::SceneField::Light, Containers::arrayView(data->lightMapping), Containers::arrayView(data->light), Trade::SceneFieldFlag::OrderedMapping}
+    }};
+
+    Trade::SceneData combined = combineFields(scene);
+    CORRADE_COMPARE(combined.mappingType(), Trade::SceneMappingType::UnsignedByte);
+
+    CORRADE_COMPARE(combined.fieldFlags(0), Trade::SceneFieldFlag::OrderedMapping);
+    CORRADE_COMPARE_AS(combined.mapping<UnsignedByte>(0), Containers::arrayView<UnsignedByte>({
+        1, 1, 4, 6
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(combined.field<UnsignedInt>(0),
+        Containers::arrayView(data->mesh),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(combined.fieldFlags(1), Trade::SceneFieldFlag::ImplicitMapping);
+    CORRADE_COMPARE_AS(combined.mapping<UnsignedByte>(1), Containers::arrayView<UnsignedByte>({
+        0, 1, 2, 3
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(combined.field<Int>(1),
+        Containers::arrayView(data->parent),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(combined.fieldFlags(2), Trade::SceneFieldFlag::OrderedMapping);
+    CORRADE_COMPARE_AS(combined.field<UnsignedInt>(2),
+        Containers::arrayView(data->light),
+        TestSuite::Compare::Container);
+}
+
+void CombineTest::sceneSharedMapping() {
+    const struct Data {
+        UnsignedInt meshMapping[3];
+        UnsignedInt mesh[3];
+        Int meshMaterial[3];
+        UnsignedInt trsMapping[2];
+        Vector3 translation[2];
+        Vector3 scaling[2];
+    } data[]{{
+        {5, 1, 3},
+        {0, 1, 2},
+        {7, -1, 8},
+        {1, 0},
+        {{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}},
+        {{2.0f, 2.0f, 2.0f}, {0.5f, 0.5f, 0.5f}}
+    }};
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 6, {}, data, {
+        /* Deliberately in an arbitrary order to avoid false assumptions like
+           fields sharing the same object mapping always being after each
+           other */
+        Trade::SceneFieldData{Trade::SceneField::Mesh, Containers::arrayView(data->meshMapping), Containers::arrayView(data->mesh)},
+        Trade::SceneFieldData{Trade::SceneField::Translation, Containers::arrayView(data->trsMapping), Containers::arrayView(data->translation)},
+        Trade::SceneFieldData{Trade::SceneField::MeshMaterial, Containers::arrayView(data->meshMapping), Containers::arrayView(data->meshMaterial)},
+        Trade::SceneFieldData{Trade::SceneField::Scaling, Containers::arrayView(data->trsMapping), Containers::arrayView(data->scaling)}
+    }};
+
+    Trade::SceneData combined = combineFields(scene);
+    CORRADE_COMPARE(combined.mapping(Trade::SceneField::Mesh).data(), combined.mapping(Trade::SceneField::MeshMaterial).data());
+    CORRADE_COMPARE(combined.mapping(Trade::SceneField::Translation).data(), combined.mapping(Trade::SceneField::Scaling).data());
+
+    CORRADE_COMPARE(combined.fieldFlags(Trade::SceneField::Mesh), Trade::SceneFieldFlag::OrderedMapping);
+    CORRADE_COMPARE(combined.fieldFlags(Trade::SceneField::MeshMaterial), Trade::SceneFieldFlag::OrderedMapping);
+    CORRADE_COMPARE_AS(combined.mapping<UnsignedByte>(Trade::SceneField::Mesh), Containers::arrayView<UnsignedByte>({
+        1, 3, 5
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(combined.field<UnsignedInt>(Trade::SceneField::Mesh), Containers::arrayView<UnsignedInt>({
+        1, 2, 0
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(combined.field<Int>(Trade::SceneField::MeshMaterial), Containers::arrayView<Int>({
+        -1, 8, 7
+    }), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(combined.fieldFlags(Trade::SceneField::Translation), Trade::SceneFieldFlag::ImplicitMapping);
+    CORRADE_COMPARE(combined.fieldFlags(Trade::SceneField::Scaling), Trade::SceneFieldFlag::ImplicitMapping);
+    CORRADE_COMPARE_AS(combined.field<Vector3>(Trade::SceneField::Translation), Containers::arrayView<Vector3>({
+        {4.0f, 5.0f, 6.0f}, {1.0f, 2.0f, 3.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(combined.field<Vector3>(Trade::SceneField::Scaling), Containers::arrayView<Vector3>({
+        {0.5f, 0.5f, 0.5f}, {2.0f, 2.0f, 2.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void CombineTest::sceneOffsetOnly() {
+    const struct Data {
+        UnsignedShort mapping[3];
+        UnsignedShort mesh[3];
+    } data[]{{
+        {2, 0, 1},
+        {5, 6, 7}
+    }};
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedShort, 3, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Mesh, 3, Trade::SceneMappingType::UnsignedShort, offsetof(Data, mapping), 2, Trade::SceneFieldType::UnsignedShort, offsetof(Data, mesh), 2}
+    }};
+
+    Trade::SceneData combined = combineFields(scene);
+    CORRADE_COMPARE(combined.fieldFlags(0), Trade::SceneFieldFlag::ImplicitMapping);
+    CORRADE_COMPARE_AS(combined.mapping<UnsignedByte>(0), Containers::arrayView<UnsignedByte>({
+        0, 1, 2
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(combined.field<UnsignedShort>(0), Containers::arrayView<UnsignedShort>({
+        6, 7, 5
+    }), TestSuite::Compare::Container);
+}
+
+void CombineTest::sceneEmpty() {
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 5, nullptr, {
+        Trade::SceneFieldData{Trade::SceneField::Mesh, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::UnsignedInt, nullptr},
+        Trade::SceneFieldData{Trade::SceneField::Parent, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Int, nullptr}
+    }};
+
+    Trade::SceneData combined = combineFields(scene);
+    CORRADE_COMPARE(combined.mappingType(), Trade::SceneMappingType::UnsignedByte);
+    CORRADE_COMPARE(combined.mappingBound(), 5);
+    CORRADE_COMPARE(combined.fieldCount(), 2);
+    CORRADE_COMPARE(combined.fieldSize(0), 0);
+    CORRADE_COMPARE(combined.fieldSize(1), 0);
+    CORRADE_COMPARE(combined.data().size(), 0);
+}
+
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::SceneTools::Test::CombineTest)
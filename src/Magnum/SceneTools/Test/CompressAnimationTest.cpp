@@ -0,0 +1,327 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/CubicHermite.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/SceneTools/CompressAnimation.h"
+#include "Magnum/Trade/AnimationData.h"
+
+namespace Magnum { namespace SceneTools { namespace Test { namespace {
+
+struct CompressAnimationTest: TestSuite::Tester {
+    explicit CompressAnimationTest();
+
+    void packQuaternion();
+    void packQuaternionNotNormalized();
+
+    void removeLinearKeyframes();
+    void removeRotationKeyframes();
+    void keepCustomTarget();
+    void frameRate();
+    void quantizeRotations();
+    void splinePassthrough();
+    void invalidFrameRate();
+};
+
+using namespace Math::Literals;
+
+const struct {
+    const char* name;
+    Quaternion rotation;
+} PackQuaternionData[]{
+    {"identity", Quaternion{}},
+    {"negative identity", -Quaternion{}},
+    {"X axis", Quaternion::rotation(35.0_degf, Vector3::xAxis())},
+    {"Y axis", Quaternion::rotation(-120.0_degf, Vector3::yAxis())},
+    {"Z axis", Quaternion::rotation(179.0_degf, Vector3::zAxis())},
+    {"arbitrary axis", Quaternion::rotation(72.5_degf, Vector3{0.3f, -1.0f, 0.7f}.normalized())},
+    {"all components equal", Quaternion{{0.5f, 0.5f, -0.5f}, 0.5f}}
+};
+
+CompressAnimationTest::CompressAnimationTest() {
+    addInstancedTests({&CompressAnimationTest::packQuaternion},
+        Containers::arraySize(PackQuaternionData));
+
+    addTests({&CompressAnimationTest::packQuaternionNotNormalized,
+
+              &CompressAnimationTest::removeLinearKeyframes,
+              &CompressAnimationTest::removeRotationKeyframes,
+              &CompressAnimationTest::keepCustomTarget,
+              &CompressAnimationTest::frameRate,
+              &CompressAnimationTest::quantizeRotations,
+              &CompressAnimationTest::splinePassthrough,
+              &CompressAnimationTest::invalidFrameRate});
+}
+
+void CompressAnimationTest::packQuaternion() {
+    auto&& data = PackQuaternionData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Quaternion unpacked = unpackQuaternionSmallestThree(packQuaternionSmallestThree(data.rotation));
+    CORRADE_VERIFY(unpacked.isNormalized());
+
+    /* The quaternion may get negated, which represents the same rotation.
+       With 10 bits per component the error should be well below 0.2°, which
+       is 0.1° in the quaternion half-angle space. */
+    CORRADE_COMPARE_AS(Float(Deg(Math::angle(unpacked, Math::dot(unpacked, data.rotation) < 0.0f ? -data.rotation : data.rotation))), 0.1f,
+        TestSuite::Compare::LessOrEqual);
+}
+
+void CompressAnimationTest::packQuaternionNotNormalized() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    packQuaternionSmallestThree(Quaternion{{1.0f, 2.0f, 3.0f}, 4.0f});
+    CORRADE_COMPARE(out.str(), "SceneTools::packQuaternionSmallestThree(): Quaternion({1, 2, 3}, 4) is not normalized\n");
+}
+
+void CompressAnimationTest::removeLinearKeyframes() {
+    /* Keys 1 and 2 lie on a line between 0 and 3, key 4 is within the
+       tolerance, key 5 is not */
+    const struct Keyframe {
+        Float time;
+        Vector3 value;
+    } keyframes[]{
+        {0.0f, {0.0f, 0.0f, 0.0f}},
+        {1.0f, {1.0f, 2.0f, 0.0f}},
+        {2.0f, {2.0f, 4.0f, 0.0f}},
+        {3.0f, {3.0f, 6.0f, 0.0f}},
+        {4.0f, {3.0f, 6.0f, 0.005f}},
+        {5.0f, {3.0f, 6.0f, 0.0f}},
+        {6.0f, {3.0f, 6.0f, 1.0f}},
+        {7.0f, {3.0f, 6.0f, 1.0f}}
+    };
+    Containers::StridedArrayView1D<const Keyframe> view = keyframes;
+
+    Trade::AnimationData animation{nullptr, {
+        Trade::AnimationTrackData{Trade::AnimationTrackTargetType::Translation3D, 7,
+            Animation::TrackView<const Float, const Vector3>{
+                view.slice(&Keyframe::time),
+                view.slice(&Keyframe::value),
+                Animation::Interpolation::Linear,
+                Animation::Extrapolation::DefaultConstructed,
+                Animation::Extrapolation::Constant}}
+    }, {-1.0f, 10.0f}};
+
+    Trade::AnimationData compressed = compressAnimation(animation, 0.01f, 0.0_degf, 0.0f);
+    CORRADE_COMPARE(compressed.duration(), (Range1D{-1.0f, 10.0f}));
+    CORRADE_COMPARE(compressed.trackCount(), 1);
+    CORRADE_COMPARE(compressed.trackType(0), Trade::AnimationTrackType::Vector3);
+    CORRADE_COMPARE(compressed.trackResultType(0), Trade::AnimationTrackType::Vector3);
+    CORRADE_COMPARE(compressed.trackTargetType(0), Trade::AnimationTrackTargetType::Translation3D);
+    CORRADE_COMPARE(compressed.trackTarget(0), 7);
+
+    Animation::TrackView<const Float, const Vector3> track = compressed.track<Vector3>(0);
+    CORRADE_COMPARE(track.interpolation(), Animation::Interpolation::Linear);
+    CORRADE_COMPARE(track.before(), Animation::Extrapolation::DefaultConstructed);
+    CORRADE_COMPARE(track.after(), Animation::Extrapolation::Constant);
+    CORRADE_COMPARE_AS(track.keys(), Containers::arrayView({
+        0.0f, 3.0f, 5.0f, 6.0f, 7.0f
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(track.values(), Containers::arrayView<Vector3>({
+        {0.0f, 0.0f, 0.0f},
+        {3.0f, 6.0f, 0.0f},
+        {3.0f, 6.0f, 0.0f},
+        {3.0f, 6.0f, 1.0f},
+        {3.0f, 6.0f, 1.0f}
+    }), TestSuite::Compare::Container);
+
+    /* With a tight tolerance only the collinear keyframes get removed */
+    Trade::AnimationData tight = compressAnimation(animation, 0.0001f, 0.0_degf, 0.0f);
+    CORRADE_COMPARE_AS(tight.track<Vector3>(0).keys(), Containers::arrayView({
+        0.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f
+    }), TestSuite::Compare::Container);
+}
+
+void CompressAnimationTest::removeRotationKeyframes() {
+    /* A rotation sampled at a constant angular velocity, with the fourth
+       sample slightly off and the middle one negated, which is the same
+       rotation */
+    const Float keys[]{0.0f, 1.0f, 2.0f, 3.0f, 4.0f};
+    const Quaternion values[]{
+        Quaternion::rotation(0.0_degf, Vector3::yAxis()),
+        Quaternion::rotation(10.0_degf, Vector3::yAxis()),
+        -Quaternion::rotation(20.0_degf, Vector3::yAxis()),
+        Quaternion::rotation(30.6_degf, Vector3::yAxis()),
+        Quaternion::rotation(40.0_degf, Vector3::yAxis())
+    };
+
+    Trade::AnimationData animation{nullptr, {
+        Trade::AnimationTrackData{Trade::AnimationTrackTargetType::Rotation3D, 0,
+            Animation::TrackView<const Float, const Quaternion>{keys, values, Animation::Interpolation::Linear}}
+    }};
+
+    /* Interpolating from the first to the fourth keyframe gives an error of
+       0.4° at most, interpolating from the first to the last an error of
+       0.6°, which is over the tolerance */
+    Trade::AnimationData compressed = compressAnimation(animation, 0.0f, Rad{0.5_degf}, 0.0f);
+    CORRADE_COMPARE_AS(compressed.track<Quaternion>(0).keys(), Containers::arrayView({
+        0.0f, 3.0f, 4.0f
+    }), TestSuite::Compare::Container);
+
+    /* With tolerance of 1° everything in the middle is removed */
+    Trade::AnimationData compressedMore = compressAnimation(animation, 0.0f, Rad{1.0_degf}, 0.0f);
+    CORRADE_COMPARE_AS(compressedMore.track<Quaternion>(0).keys(), Containers::arrayView({
+        0.0f, 4.0f
+    }), TestSuite::Compare::Container);
+}
+
+void CompressAnimationTest::keepCustomTarget() {
+    const Float keys[]{0.0f, 1.0f, 2.0f, 3.0f};
+    const Float values[]{0.0f, 0.5f, 1.001f, 1.5f};
+
+    Trade::AnimationData animation{nullptr, {
+        Trade::AnimationTrackData{Trade::AnimationTrackTargetType::Custom, 0,
+            Animation::TrackView<const Float, const Float>{keys, values, Animation::Interpolation::Linear}},
+        Trade::AnimationTrackData{Trade::AnimationTrackTargetType::Scaling2D, 0,
+            Animation::TrackView<const Float, const Float>{keys, values, Animation::Interpolation::Linear}}
+    }};
+
+    /* Custom targets are compressed only losslessly, the tolerance applies
+       only to the scaling target */
+    Trade::AnimationData compressed = compressAnimation(animation, 1.0f, 1.0_radf, 0.01f);
+    CORRADE_COMPARE_AS(compressed.track<Float>(0).keys(), Containers::arrayView({
+        0.0f, 1.0f, 2.0f, 3.0f
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(compressed.track<Float>(1).keys(), Containers::arrayView({
+        0.0f, 3.0f
+    }), TestSuite::Compare::Container);
+}
+
+void CompressAnimationTest::frameRate() {
+    const Float keys[]{0.0f, 0.02f, 0.03f, 0.051f, 0.1f};
+    const Int values[]{0, 1, 2, 3, 4};
+
+    Trade::AnimationData animation{nullptr, {
+        Trade::AnimationTrackData{Trade::AnimationTrackTargetType::Custom, 0,
+            Animation::TrackView<const Float, const Int>{keys, values, Animation::Interpolation::Constant}}
+    }};
+
+    /* Integer tracks aren't subject to keyframe removal, they're only
+       snapped. At 20 FPS 0.02 snaps to 0.0 and 0.03 with 0.051 to 0.05, in
+       which case the last keyframe is kept. */
+    Trade::AnimationData compressed = compressAnimation(animation, 0.0f, 0.0_degf, 0.0f, 20.0f);
+    CORRADE_COMPARE(compressed.trackType(0), Trade::AnimationTrackType::Int);
+    CORRADE_COMPARE_AS(compressed.track<Int>(0).keys(), Containers::arrayView({
+        0.0f, 0.05f, 0.1f
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(compressed.track<Int>(0).values(), Containers::arrayView({
+        1, 3, 4
+    }), TestSuite::Compare::Container);
+}
+
+void CompressAnimationTest::quantizeRotations() {
+    const Float keys[]{0.0f, 1.0f, 2.0f};
+    const Quaternion values[]{
+        Quaternion::rotation(0.0_degf, Vector3::xAxis()),
+        Quaternion::rotation(90.0_degf, Vector3::xAxis()),
+        Quaternion::rotation(90.0_degf, Vector3::zAxis())
+    };
+
+    Trade::AnimationData animation{nullptr, {
+        Trade::AnimationTrackData{Trade::AnimationTrackTargetType::Rotation3D, 5,
+            Animation::TrackView<const Float, const Quaternion>{keys, values, Animation::Interpolation::Linear}},
+        /* Not a 3D rotation, not quantized */
+        Trade::AnimationTrackData{Trade::AnimationTrackTargetType::Custom, 0,
+            Animation::TrackView<const Float, const Quaternion>{keys, values, Animation::Interpolation::Linear}}
+    }};
+
+    Trade::AnimationData compressed = compressAnimation(animation, 0.0f, 0.0_degf, 0.0f, 0.0f, CompressAnimationFlag::QuantizeRotations);
+    CORRADE_COMPARE(compressed.trackCount(), 2);
+    CORRADE_COMPARE(compressed.trackType(0), Trade::AnimationTrackType::UnsignedInt);
+    CORRADE_COMPARE(compressed.trackResultType(0), Trade::AnimationTrackType::Quaternion);
+    CORRADE_COMPARE(compressed.trackTargetType(0), Trade::AnimationTrackTargetType::Rotation3D);
+    CORRADE_COMPARE(compressed.trackTarget(0), 5);
+    CORRADE_COMPARE(compressed.trackType(1), Trade::AnimationTrackType::Quaternion);
+    CORRADE_COMPARE(compressed.trackResultType(1), Trade::AnimationTrackType::Quaternion);
+
+    const auto track = compressed.track<UnsignedInt, Quaternion>(0);
+    CORRADE_COMPARE(track.size(), 3);
+    CORRADE_COMPARE(track.interpolation(), Animation::Interpolation::Linear);
+    CORRADE_VERIFY(track.interpolator() == slerpShortestPathSmallestThree);
+
+    /* The interpolated result should be close to the original */
+    const auto original = animation.track<Quaternion>(0);
+    for(Float time: {0.0f, 0.25f, 0.5f, 1.0f, 1.75f, 2.0f}) {
+        CORRADE_ITERATION(time);
+        const Quaternion expected = original.at(time);
+        const Quaternion actual = track.at(time);
+        CORRADE_COMPARE_AS(Float(Deg(Math::angle(actual, Math::dot(actual, expected) < 0.0f ? -expected : expected))), 0.1f,
+            TestSuite::Compare::LessOrEqual);
+    }
+}
+
+void CompressAnimationTest::splinePassthrough() {
+    const Float keys[]{0.0f, 1.0f, 2.0f};
+    const CubicHermite3D values[]{
+        {{}, {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}},
+        {{1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}},
+        {{1.0f, 0.0f, 0.0f}, {2.0f, 0.0f, 0.0f}, {}}
+    };
+
+    Trade::AnimationData animation{nullptr, {
+        Trade::AnimationTrackData{Trade::AnimationTrackTargetType::Translation3D, 1,
+            Animation::TrackView<const Float, const CubicHermite3D>{keys, values, Animation::Interpolation::Spline}}
+    }};
+
+    /* Even though the middle keyframe is redundant, spline tracks are passed
+       through unchanged */
+    Trade::AnimationData compressed = compressAnimation(animation, 1.0f, 0.0_degf, 0.0f);
+    CORRADE_COMPARE(compressed.trackType(0), Trade::AnimationTrackType::CubicHermite3D);
+    CORRADE_COMPARE(compressed.trackResultType(0), Trade::AnimationTrackType::Vector3);
+
+    const auto track = compressed.track<CubicHermite3D>(0);
+    CORRADE_COMPARE(track.interpolation(), Animation::Interpolation::Spline);
+    CORRADE_COMPARE_AS(track.keys(), Containers::arrayView(keys),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(track.values(), Containers::arrayView(values),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(track.at(0.5f), animation.track<CubicHermite3D>(0).at(0.5f));
+}
+
+void CompressAnimationTest::invalidFrameRate() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::AnimationData animation{nullptr, nullptr};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    compressAnimation(animation, 0.0f, 0.0_degf, 0.0f, -1.0f);
+    CORRADE_COMPARE(out.str(), "SceneTools::compressAnimation(): expected a non-negative frame rate, got -1\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneTools::Test::CompressAnimationTest)
@@ -24,6 +24,8 @@
 */
 
 #include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/Triple.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
@@ -41,6 +43,7 @@ struct FlattenMeshHierarchyTest: TestSuite::Tester {
 
     void test2D();
     void test3D();
+    void multipleThreads();
     void not2DNot3D();
     void noParentField();
     void noMeshField();
@@ -54,29 +57,66 @@ struct {
     Matrix4 globalTransformation3D;
     std::size_t parentsToExclude, transformationsToExclude, meshesToExclude;
     std::size_t expectedOutputSize;
+    FlattenMeshHierarchyFlags flags;
+    UnsignedInt threadCount;
 } TestData[]{
     {"", {}, {},
         0, 2, 3,
-        5},
+        5, {}, 1},
     {"global transformation",
         Matrix3::scaling(Vector2{0.5f}), Matrix4::scaling(Vector3{0.5f}),
         0, 2, 3,
-        5},
+        5, {}, 1},
     {"transformations not part of the hierarchy", {}, {},
         0, 0, 3,
-        5},
+        5, {}, 1},
     {"meshes not part of the hierarchy", {}, {},
         0, 2, 0,
-        5},
+        5, {}, 1},
     {"transformations and meshes not part of the hierarchy", {}, {},
         0, 0, 0,
-        5},
+        5, {}, 1},
     {"no parents", {}, {},
         9, 2, 3,
-        0},
+        0, {}, 1},
     {"no meshes", {}, {},
         0, 2, 8,
-        0},
+        0, {}, 1},
+    {"affine", {}, {},
+        0, 2, 3,
+        5, FlattenMeshHierarchyFlag::Affine, 1},
+    {"affine, global transformation",
+        Matrix3::scaling(Vector2{0.5f}), Matrix4::scaling(Vector3{0.5f}),
+        0, 2, 3,
+        5, FlattenMeshHierarchyFlag::Affine, 1},
+    {"sparse", {}, {},
+        0, 2, 3,
+        5, FlattenMeshHierarchyFlag::Sparse, 1},
+    {"sparse, transformations and meshes not part of the hierarchy", {}, {},
+        0, 0, 0,
+        5, FlattenMeshHierarchyFlag::Sparse, 1},
+    {"sparse, no parents", {}, {},
+        9, 2, 3,
+        0, FlattenMeshHierarchyFlag::Sparse, 1},
+    {"sparse, affine, global transformation",
+        Matrix3::scaling(Vector2{0.5f}), Matrix4::scaling(Vector3{0.5f}),
+        0, 2, 0,
+        5, FlattenMeshHierarchyFlag::Sparse|FlattenMeshHierarchyFlag::Affine, 1},
+    {"multiple threads", {}, {},
+        0, 2, 3,
+        5, {}, 4},
+    {"sparse, multiple threads", {}, {},
+        0, 2, 0,
+        5, FlattenMeshHierarchyFlag::Sparse, 4},
+};
+
+struct {
+    const char* name;
+    FlattenMeshHierarchyFlags flags;
+} MultipleThreadsData[]{
+    {"", {}},
+    {"affine", FlattenMeshHierarchyFlag::Affine},
+    {"sparse", FlattenMeshHierarchyFlag::Sparse},
 };
 
 FlattenMeshHierarchyTest::FlattenMeshHierarchyTest() {
@@ -84,6 +124,9 @@ FlattenMeshHierarchyTest::FlattenMeshHierarchyTest() {
                        &FlattenMeshHierarchyTest::test3D},
         Containers::arraySize(TestData));
 
+    addInstancedTests({&FlattenMeshHierarchyTest::multipleThreads},
+        Containers::arraySize(MultipleThreadsData));
+
     addTests({&FlattenMeshHierarchyTest::not2DNot3D,
               &FlattenMeshHierarchyTest::noParentField,
               &FlattenMeshHierarchyTest::noMeshField});
@@ -202,12 +245,14 @@ void FlattenMeshHierarchyTest::test2D() {
 
     Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix3>> out;
     /* To test the parameter-less overload also */
-    if(instanceData.globalTransformation2D != Matrix3{})
+    if(instanceData.flags || instanceData.threadCount != 1)
+        out = flattenMeshHierarchy2D(scene, instanceData.globalTransformation2D, instanceData.flags, instanceData.threadCount);
+    else if(instanceData.globalTransformation2D != Matrix3{})
         out = flattenMeshHierarchy2D(scene, instanceData.globalTransformation2D);
     else
         out = flattenMeshHierarchy2D(scene);
 
-    CORRADE_EXPECT_FAIL_IF(instanceData.meshesToExclude == 0 || instanceData.parentsToExclude != 0,
+    CORRADE_EXPECT_FAIL_IF(!(instanceData.flags & FlattenMeshHierarchyFlag::Sparse) && (instanceData.meshesToExclude == 0 || instanceData.parentsToExclude != 0),
         "Meshes that are not part of the hierarchy are not excluded at the moment.");
     CORRADE_COMPARE_AS(out, (Containers::arrayView<Containers::Triple<UnsignedInt, Int, Matrix3>>({
         {113, 96, instanceData.globalTransformation2D*
@@ -342,12 +387,14 @@ void FlattenMeshHierarchyTest::test3D() {
 
     Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix4>> out;
     /* To test the parameter-less overload also */
-    if(instanceData.globalTransformation3D != Matrix4{})
+    if(instanceData.flags || instanceData.threadCount != 1)
+        out = flattenMeshHierarchy3D(scene, instanceData.globalTransformation3D, instanceData.flags, instanceData.threadCount);
+    else if(instanceData.globalTransformation3D != Matrix4{})
         out = flattenMeshHierarchy3D(scene, instanceData.globalTransformation3D);
     else
         out = flattenMeshHierarchy3D(scene);
 
-    CORRADE_EXPECT_FAIL_IF(instanceData.meshesToExclude == 0 || instanceData.parentsToExclude != 0,
+    CORRADE_EXPECT_FAIL_IF(!(instanceData.flags & FlattenMeshHierarchyFlag::Sparse) && (instanceData.meshesToExclude == 0 || instanceData.parentsToExclude != 0),
         "Meshes that are not part of the hierarchy are not excluded at the moment.");
     CORRADE_COMPARE_AS(out, (Containers::arrayView<Containers::Triple<UnsignedInt, Int, Matrix4>>({
         {113, 96, instanceData.globalTransformation3D*
@@ -366,6 +413,49 @@ void FlattenMeshHierarchyTest::test3D() {
     })).prefix(instanceData.expectedOutputSize), TestSuite::Compare::Container);
 }
 
+void FlattenMeshHierarchyTest::multipleThreads() {
+    auto&& data = MultipleThreadsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* A hierarchy large enough for the levels to get split across threads,
+       with each object having four children and every other object a mesh.
+       The output should be the same as when done on a single thread. */
+    struct Object {
+        UnsignedInt object;
+        Int parent;
+        UnsignedInt mesh;
+        Matrix4 transformation;
+    };
+    Containers::Array<Object> objects{NoInit, 100000};
+    for(std::size_t i = 0; i != objects.size(); ++i) {
+        objects[i].object = i;
+        objects[i].parent = i ? (i - 1)/4 : -1;
+        objects[i].mesh = i*3;
+        objects[i].transformation =
+            Matrix4::translation(Vector3::xAxis(0.25f + (i % 7)*0.125f))*
+            Matrix4::rotationY(Deg(Float(i % 11)*15.0f));
+    }
+
+    const auto view = stridedArrayView(objects);
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, objects.size(), {}, objects, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            view.slice(&Object::object),
+            view.slice(&Object::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            view.slice(&Object::object),
+            view.slice(&Object::transformation)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            view.slice(&Object::object).every(2),
+            view.slice(&Object::mesh).every(2)},
+    }};
+
+    Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix4>> expected = flattenMeshHierarchy3D(scene);
+    CORRADE_COMPARE(expected.size(), objects.size()/2);
+
+    Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix4>> out = flattenMeshHierarchy3D(scene, Matrix4{}, data.flags, 4);
+    CORRADE_COMPARE_AS(out, expected, TestSuite::Compare::Container);
+}
+
 void FlattenMeshHierarchyTest::not2DNot3D() {
     CORRADE_SKIP_IF_NO_ASSERT();
 
@@ -0,0 +1,290 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/SceneTools/ValidateHierarchy.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace SceneTools { namespace Test { namespace {
+
+struct ValidateHierarchyTest: TestSuite::Tester {
+    explicit ValidateHierarchyTest();
+
+    void debugIssue();
+    void debugIssuePacked();
+
+    void valid();
+    void noParentField();
+    void emptyParentField();
+
+    void invalidParent();
+    void multipleParents();
+    void cyclic();
+    void cyclicDeep();
+    void unreachable();
+    void unreachableFromCycle();
+    void multipleParentsReachableCycle();
+};
+
+ValidateHierarchyTest::ValidateHierarchyTest() {
+    addTests({&ValidateHierarchyTest::debugIssue,
+              &ValidateHierarchyTest::debugIssuePacked,
+
+              &ValidateHierarchyTest::valid,
+              &ValidateHierarchyTest::noParentField,
+              &ValidateHierarchyTest::emptyParentField,
+
+              &ValidateHierarchyTest::invalidParent,
+              &ValidateHierarchyTest::multipleParents,
+              &ValidateHierarchyTest::cyclic,
+              &ValidateHierarchyTest::cyclicDeep,
+              &ValidateHierarchyTest::unreachable,
+              &ValidateHierarchyTest::unreachableFromCycle,
+              &ValidateHierarchyTest::multipleParentsReachableCycle});
+}
+
+void ValidateHierarchyTest::debugIssue() {
+    std::ostringstream out;
+    Debug{&out} << HierarchyIssue::Cyclic << HierarchyIssue(0xde);
+    CORRADE_COMPARE(out.str(), "SceneTools::HierarchyIssue::Cyclic SceneTools::HierarchyIssue(0xde)\n");
+}
+
+void ValidateHierarchyTest::debugIssuePacked() {
+    std::ostringstream out;
+    /* Second is not packed, the first should not make any flags persistent */
+    Debug{&out} << Debug::packed << HierarchyIssue::Unreachable << HierarchyIssue::MultipleParents;
+    CORRADE_COMPARE(out.str(), "Unreachable SceneTools::HierarchyIssue::MultipleParents\n");
+}
+
+struct Field {
+    UnsignedInt object;
+    Int parent;
+};
+
+Trade::SceneData sceneWithParents(Containers::ArrayView<Field> data, UnsignedLong mappingBound) {
+    Containers::StridedArrayView1D<Field> view = data;
+    return Trade::SceneData{Trade::SceneMappingType::UnsignedInt, mappingBound, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent, view.slice(&Field::object), view.slice(&Field::parent)}
+    }};
+}
+
+void ValidateHierarchyTest::valid() {
+    struct SmallField {
+        /* To verify we don't have unnecessarily hardcoded 32-bit types */
+        UnsignedShort object;
+        Byte parent;
+    } data[]{
+        {5, 1},
+        /* Forward parent reference */
+        {6, 9},
+        {3, -1},
+        {1, -1},
+        {9, 10},
+        {10, 3},
+        {7, 3},
+        {157, 3},
+        {143, 6}
+        /* Elements 0, 2, 4, 8, 11-142, 144-156 deliberately not used */
+    };
+    Containers::StridedArrayView1D<SmallField> view = data;
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedShort, 158, {}, data, {
+        /* To verify it doesn't just pick the first field ever */
+        Trade::SceneFieldData{Trade::SceneField::Mesh, Trade::SceneMappingType::UnsignedShort, nullptr, Trade::SceneFieldType::UnsignedInt, nullptr},
+        Trade::SceneFieldData{Trade::SceneField::Parent, view.slice(&SmallField::object), view.slice(&SmallField::parent)}
+    }};
+
+    CORRADE_COMPARE_AS(validateHierarchy(scene),
+        (Containers::ArrayView<const Containers::Pair<UnsignedInt, HierarchyIssue>>{}),
+        TestSuite::Compare::Container);
+}
+
+void ValidateHierarchyTest::noParentField() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedByte, 0, nullptr, {}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    validateHierarchy(scene);
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::validateHierarchy(): the scene has no hierarchy\n");
+}
+
+void ValidateHierarchyTest::emptyParentField() {
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {
+        Trade::SceneFieldData{Trade::SceneField::Parent, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Int, nullptr}
+    }};
+
+    CORRADE_COMPARE_AS(validateHierarchy(scene),
+        (Containers::ArrayView<const Containers::Pair<UnsignedInt, HierarchyIssue>>{}),
+        TestSuite::Compare::Container);
+}
+
+void ValidateHierarchyTest::invalidParent() {
+    Field data[]{
+        {0, -1},
+        {1, 0},
+        /* Out of bounds */
+        {2, 16},
+        /* Negative but not -1 */
+        {3, -2},
+        /* Child of an object with an invalid parent */
+        {4, 2}
+    };
+
+    CORRADE_COMPARE_AS(validateHierarchy(sceneWithParents(data, 16)), (Containers::arrayView<Containers::Pair<UnsignedInt, HierarchyIssue>>({
+        {2, HierarchyIssue::InvalidParent},
+        {3, HierarchyIssue::InvalidParent},
+        {4, HierarchyIssue::Unreachable}
+    })), TestSuite::Compare::Container);
+}
+
+void ValidateHierarchyTest::multipleParents() {
+    Field data[]{
+        {3, -1},
+        {1, 3},
+        {5, -1},
+        /* Listed twice with different parents, then twice with the same */
+        {1, 5},
+        {7, 5},
+        {7, 5}
+    };
+
+    CORRADE_COMPARE_AS(validateHierarchy(sceneWithParents(data, 8)), (Containers::arrayView<Containers::Pair<UnsignedInt, HierarchyIssue>>({
+        {1, HierarchyIssue::MultipleParents},
+        {7, HierarchyIssue::MultipleParents}
+    })), TestSuite::Compare::Container);
+}
+
+void ValidateHierarchyTest::cyclic() {
+    Field data[]{
+        {2, -1},
+        {3, 2},
+        /* Cycle of length 1 */
+        {5, 5},
+        /* Cycle of length 2 */
+        {7, 6},
+        {6, 7}
+    };
+
+    CORRADE_COMPARE_AS(validateHierarchy(sceneWithParents(data, 8)), (Containers::arrayView<Containers::Pair<UnsignedInt, HierarchyIssue>>({
+        {5, HierarchyIssue::Cyclic},
+        {6, HierarchyIssue::Cyclic},
+        {7, HierarchyIssue::Cyclic}
+    })), TestSuite::Compare::Container);
+}
+
+void ValidateHierarchyTest::cyclicDeep() {
+    Field data[]{
+        {0, -1},
+        /* Cycle of length 5, with a tail leading into it */
+        {13, 2},
+        {2, 11},
+        {11, 4},
+        {4, 9},
+        {9, 13},
+        {1, 5},
+        {5, 13}
+    };
+
+    CORRADE_COMPARE_AS(validateHierarchy(sceneWithParents(data, 14)), (Containers::arrayView<Containers::Pair<UnsignedInt, HierarchyIssue>>({
+        {1, HierarchyIssue::Unreachable},
+        {2, HierarchyIssue::Cyclic},
+        {4, HierarchyIssue::Cyclic},
+        {5, HierarchyIssue::Unreachable},
+        {9, HierarchyIssue::Cyclic},
+        {11, HierarchyIssue::Cyclic},
+        {13, HierarchyIssue::Cyclic}
+    })), TestSuite::Compare::Container);
+}
+
+void ValidateHierarchyTest::unreachable() {
+    Field data[]{
+        {2, -1},
+        /* Parent 6 isn't listed in the field */
+        {15, 6},
+        {3, 15},
+        {4, 3},
+        {7, 2}
+    };
+
+    CORRADE_COMPARE_AS(validateHierarchy(sceneWithParents(data, 16)), (Containers::arrayView<Containers::Pair<UnsignedInt, HierarchyIssue>>({
+        {3, HierarchyIssue::Unreachable},
+        {4, HierarchyIssue::Unreachable},
+        {15, HierarchyIssue::Unreachable}
+    })), TestSuite::Compare::Container);
+}
+
+void ValidateHierarchyTest::unreachableFromCycle() {
+    Field data[]{
+        /* The children get processed first, before the cycle is found */
+        {0, 1},
+        {1, 2},
+        {2, 3},
+        {3, 2},
+        /* Another subtree attached to the same cycle, processed after */
+        {5, 3},
+        {6, -1}
+    };
+
+    CORRADE_COMPARE_AS(validateHierarchy(sceneWithParents(data, 7)), (Containers::arrayView<Containers::Pair<UnsignedInt, HierarchyIssue>>({
+        {0, HierarchyIssue::Unreachable},
+        {1, HierarchyIssue::Unreachable},
+        {2, HierarchyIssue::Cyclic},
+        {3, HierarchyIssue::Cyclic},
+        {5, HierarchyIssue::Unreachable}
+    })), TestSuite::Compare::Container);
+}
+
+void ValidateHierarchyTest::multipleParentsReachableCycle() {
+    /* Same as OrderClusterParentsTest::sparseAndCyclic(), which
+       orderClusterParents() can't diagnose properly */
+    Field data[]{
+        {2, -1},
+        {3, 2},
+        {7, -1},
+        /* Object 13 is a root and also a child of 3 */
+        {13, -1},
+        {5, 13},
+        {13, 3},
+        /* Not reachable from root */
+        {15, 6}
+    };
+
+    CORRADE_COMPARE_AS(validateHierarchy(sceneWithParents(data, 16)), (Containers::arrayView<Containers::Pair<UnsignedInt, HierarchyIssue>>({
+        {13, HierarchyIssue::MultipleParents},
+        {15, HierarchyIssue::Unreachable}
+    })), TestSuite::Compare::Container);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneTools::Test::ValidateHierarchyTest)
@@ -0,0 +1,228 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ValidateHierarchy.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayTuple.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace SceneTools {
+
+Debug& operator<<(Debug& debug, const HierarchyIssue value) {
+    const bool packed = debug.immediateFlags() >= Debug::Flag::Packed;
+
+    if(!packed)
+        debug << "SceneTools::HierarchyIssue" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case HierarchyIssue::value: return debug << (packed ? "" : "::") << Debug::nospace << #value;
+        _c(InvalidParent)
+        _c(MultipleParents)
+        _c(Cyclic)
+        _c(Unreachable)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << (packed ? "" : "(") << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << (packed ? "" : ")");
+}
+
+namespace {
+
+/** @todo switch to a BitArray once it exists */
+inline bool bit(const Containers::ArrayView<const UnsignedInt> bits, const std::size_t i) {
+    return bits[i >> 5] & (1u << (i & 31));
+}
+
+inline void setBit(const Containers::ArrayView<UnsignedInt> bits, const std::size_t i) {
+    bits[i >> 5] |= 1u << (i & 31);
+}
+
+}
+
+Containers::Array<Containers::Pair<UnsignedInt, HierarchyIssue>> validateHierarchy(const Trade::SceneData& scene) {
+    const Containers::Optional<UnsignedInt> parentFieldId = scene.findFieldId(Trade::SceneField::Parent);
+    CORRADE_ASSERT(parentFieldId,
+        "SceneTools::validateHierarchy(): the scene has no hierarchy", {});
+
+    const std::size_t parentFieldSize = scene.fieldSize(*parentFieldId);
+    const std::size_t objectCount = scene.mappingBound();
+    const std::size_t bitWordCount = (objectCount + 31)/32;
+
+    /* Allocate a single storage for all temporary data */
+    Containers::ArrayView<Containers::Pair<UnsignedInt, Int>> parents;
+    Containers::ArrayView<Int> parentOf;
+    Containers::ArrayView<UnsignedInt> childrenOffsets;
+    Containers::ArrayView<UnsignedInt> children;
+    Containers::ArrayView<Int> queue;
+    Containers::ArrayView<UnsignedInt> listed;
+    Containers::ArrayView<UnsignedInt> duplicate;
+    Containers::ArrayView<UnsignedInt> invalid;
+    Containers::ArrayView<UnsignedInt> reachable;
+    Containers::ArrayView<UnsignedInt> inPath;
+    Containers::ArrayView<UnsignedInt> done;
+    Containers::ArrayView<UnsignedInt> cyclic;
+    Containers::ArrayTuple storage{
+        /* Output of scene.parentsInto() */
+        {NoInit, parentFieldSize, parents},
+        /* Parent of each listed object, from its first occurrence */
+        {NoInit, objectCount, parentOf},
+        /* Running children offset (+1) for each node including root (+1),
+           plus one more element when the array is shifted by one below */
+        {ValueInit, objectCount + 3, childrenOffsets},
+        {NoInit, parentFieldSize, children},
+        /* Objects to process in the breadth-first traversal from the root,
+           reused for the parent chain walks later. Each object gets there at
+           most once, plus one more element for the root. */
+        {NoInit, parentFieldSize + 1, queue},
+        /* Bits for each object */
+        {ValueInit, bitWordCount, listed},
+        {ValueInit, bitWordCount, duplicate},
+        {ValueInit, bitWordCount, invalid},
+        {ValueInit, bitWordCount, reachable},
+        {ValueInit, bitWordCount, inPath},
+        {ValueInit, bitWordCount, done},
+        {ValueInit, bitWordCount, cyclic}
+    };
+
+    scene.parentsInto(
+        stridedArrayView(parents).slice(&decltype(parents)::Type::first),
+        stridedArrayView(parents).slice(&decltype(parents)::Type::second)
+    );
+
+    /* Mark listed, duplicate and invalid objects and count children of each
+       valid parent, again with parent.second() being -1 for root objects */
+    for(const Containers::Pair<UnsignedInt, Int>& parent: parents) {
+        CORRADE_INTERNAL_ASSERT(parent.first() < objectCount);
+        const bool isValid = parent.second() >= -1 && (parent.second() == -1 || std::size_t(parent.second()) < objectCount);
+        if(!isValid)
+            setBit(invalid, parent.first());
+        if(bit(listed, parent.first()))
+            setBit(duplicate, parent.first());
+        else {
+            setBit(listed, parent.first());
+            parentOf[parent.first()] = parent.second();
+        }
+        if(isValid)
+            ++childrenOffsets[parent.second() + 2];
+    }
+
+    /* Convert the counts to a running offset and then fill the children
+       ranges, the same as in orderClusterParentsInto(). Afterwards
+       `[childrenOffsets[i + 1], childrenOffsets[i + 2])` contains a range in
+       which the `children` array contains a list of children for `i`. */
+    UnsignedInt offset = 0;
+    for(UnsignedInt& i: childrenOffsets) {
+        const UnsignedInt nextOffset = offset + i;
+        i = offset;
+        offset = nextOffset;
+    }
+    for(const Containers::Pair<UnsignedInt, Int>& parent: parents) {
+        if(parent.second() >= -1 && (parent.second() == -1 || std::size_t(parent.second()) < objectCount))
+            children[childrenOffsets[parent.second() + 2]++] = parent.first();
+    }
+
+    /* Go breadth-first from the root, marking everything that's reachable.
+       An object that's reachable through more than one parent is visited
+       just once, which also means cycles reachable through such objects
+       terminate. */
+    std::size_t queueSize = 1;
+    queue[0] = -1;
+    for(std::size_t i = 0; i != queueSize; ++i) {
+        const Int objectId = queue[i];
+        for(std::size_t j = childrenOffsets[objectId + 1], jMax = childrenOffsets[objectId + 2]; j != jMax; ++j) {
+            if(bit(reachable, children[j])) continue;
+            setBit(reachable, children[j]);
+            queue[queueSize++] = children[j];
+        }
+    }
+
+    /* For every listed object that isn't reachable, walk up its parent chain
+       until reaching an object that was already classified, an object that's
+       not listed or an object that's already on the current path. In the
+       last case, the objects on the path starting from that object form a
+       cycle, all other objects on the path are just unreachable. Each object
+       is on a path just once, so this is linear as well. */
+    for(std::size_t object = 0; object != objectCount; ++object) {
+        if(!bit(listed, object) || bit(reachable, object) || bit(done, object))
+            continue;
+
+        std::size_t pathSize = 0;
+        Int cycleBegin = -1;
+        for(Int current = Int(object); ; ) {
+            setBit(inPath, current);
+            queue[pathSize++] = current;
+
+            const Int parent = parentOf[current];
+            if(bit(invalid, current) || parent == -1 || !bit(listed, parent) || bit(reachable, parent) || bit(done, parent))
+                break;
+            if(bit(inPath, parent)) {
+                cycleBegin = parent;
+                break;
+            }
+            current = parent;
+        }
+
+        bool isCyclic = false;
+        for(std::size_t i = 0; i != pathSize; ++i) {
+            if(queue[i] == cycleBegin) isCyclic = true;
+            if(isCyclic) setBit(cyclic, queue[i]);
+            setBit(done, queue[i]);
+        }
+    }
+
+    /* Gather the issues, sorted by object ID */
+    const auto issue = [&](const std::size_t object) -> HierarchyIssue {
+        if(bit(duplicate, object))
+            return HierarchyIssue::MultipleParents;
+        if(bit(invalid, object))
+            return HierarchyIssue::InvalidParent;
+        if(bit(listed, object) && !bit(reachable, object))
+            return bit(cyclic, object) ? HierarchyIssue::Cyclic : HierarchyIssue::Unreachable;
+        return HierarchyIssue{};
+    };
+    std::size_t issueCount = 0;
+    for(std::size_t object = 0; object != objectCount; ++object)
+        if(issue(object) != HierarchyIssue{}) ++issueCount;
+
+    Containers::Array<Containers::Pair<UnsignedInt, HierarchyIssue>> out{NoInit, issueCount};
+    std::size_t outOffset = 0;
+    for(std::size_t object = 0; object != objectCount; ++object) {
+        const HierarchyIssue objectIssue = issue(object);
+        if(objectIssue != HierarchyIssue{})
+            out[outOffset++] = {UnsignedInt(object), objectIssue};
+    }
+    CORRADE_INTERNAL_ASSERT(outOffset == issueCount);
+
+    return out;
+}
+
+}}
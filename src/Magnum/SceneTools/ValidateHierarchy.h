@@ -0,0 +1,110 @@
+#ifndef Magnum_SceneTools_ValidateHierarchy_h
+#define Magnum_SceneTools_ValidateHierarchy_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Enum @ref Magnum::SceneTools::HierarchyIssue, function @ref Magnum::SceneTools::validateHierarchy()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace SceneTools {
+
+/**
+@brief Scene hierarchy issue
+@m_since_latest
+
+@see @ref validateHierarchy()
+*/
+enum class HierarchyIssue: UnsignedByte {
+    /**
+     * Parent of the object is neither @cpp -1 @ce nor less than
+     * @ref Trade::SceneData::mappingBound().
+     */
+    InvalidParent = 1,
+
+    /**
+     * The object is listed in the @ref Trade::SceneField::Parent field more
+     * than once.
+     */
+    MultipleParents,
+
+    /** The object is its own ancestor. */
+    Cyclic,
+
+    /**
+     * The object isn't reachable from the root, for example because its
+     * parent isn't listed in the @ref Trade::SceneField::Parent field or
+     * because its parent is a part of a cycle.
+     */
+    Unreachable
+};
+
+/**
+@debugoperatorenum{HierarchyIssue}
+@m_since_latest
+*/
+MAGNUM_SCENETOOLS_EXPORT Debug& operator<<(Debug& debug, HierarchyIssue value);
+
+/**
+@brief Validate a scene hierarchy
+@m_since_latest
+
+Checks that the @ref Trade::SceneField::Parent field in @p scene forms a
+valid hierarchy and returns a list of objects that violate it, sorted by
+object ID. Each object is listed at most once. An object listed in the field
+more than once is reported as @ref HierarchyIssue::MultipleParents and
+otherwise an object with an invalid parent as
+@ref HierarchyIssue::InvalidParent, regardless of whether it's reachable from
+the root. Remaining objects that aren't reachable from the root are reported
+as either @ref HierarchyIssue::Cyclic or @ref HierarchyIssue::Unreachable.
+If the returned array is empty, the hierarchy satisfies the requirements of
+@ref orderClusterParents(), @ref flattenMeshHierarchy3D() and other
+algorithms that process it.
+
+Compared to the assertions in @ref orderClusterParents(), which are meant to
+catch programmer errors, this function is meant for cheaply rejecting scenes
+coming from untrusted sources before running more expensive processing on
+them. The operation is done in an @f$ \mathcal{O}(n) @f$ execution time and
+memory complexity, with @f$ n @f$ being @ref Trade::SceneData::mappingBound(),
+using a single bit per object for each tracked state. The
+@ref Trade::SceneField::Parent field is expected to be contained in the
+scene.
+
+@experimental
+
+@see @ref Trade::SceneData::hasField()
+*/
+MAGNUM_SCENETOOLS_EXPORT Containers::Array<Containers::Pair<UnsignedInt, HierarchyIssue>> validateHierarchy(const Trade::SceneData& scene);
+
+}}
+
+#endif
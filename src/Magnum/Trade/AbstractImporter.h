@@ -117,7 +117,23 @@ enum class ImporterFlag: UnsignedByte {
      */
     Verbose = 1 << 0,
 
-    /** @todo ~~Y flip~~ Y up for images, "I want to import just once, don't copy" ... */
+    /**
+     * Avoid copying data if possible. If the importer was opened via
+     * @ref AbstractImporter::openMemory() and the imported data can be used
+     * as-is, the returned @ref ImageData, @ref MeshData etc. reference the
+     * opened memory directly and have @ref DataFlag::ExternallyOwned set,
+     * instead of being a copy. It's then the user responsibility to keep the
+     * memory in scope for as long as the returned data are used. If the data
+     * need any kind of processing or the importer was opened in a different
+     * way, a copy is made as usual.
+     *
+     * Importers that don't support this flag ignore it, see documentation of
+     * particular plugins for more information.
+     * @m_since_latest
+     */
+    ZeroCopy = 1 << 1,
+
+    /** @todo ~~Y flip~~ Y up for images ... */
 };
 
 /**
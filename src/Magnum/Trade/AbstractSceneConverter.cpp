@@ -34,6 +34,7 @@
 
 #include "Magnum/Trade/ArrayAllocator.h"
 #include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
 
 #ifdef MAGNUM_BUILD_DEPRECATED
 /* needed by deprecated convertToFile() that takes a std::string */
@@ -57,7 +58,7 @@ using namespace Containers::Literals;
 Containers::StringView AbstractSceneConverter::pluginInterface() {
     return
 /* [interface] */
-"cz.mosra.magnum.Trade.AbstractSceneConverter/0.1.2"_s
+"cz.mosra.magnum.Trade.AbstractSceneConverter/0.1.3"_s
 /* [interface] */
     ;
 }
@@ -195,6 +196,43 @@ bool AbstractSceneConverter::doConvertToFile(const MeshData& mesh, const Contain
     return true;
 }
 
+Containers::Optional<Containers::Array<char>> AbstractSceneConverter::convertToData(const SceneData& scene) {
+    CORRADE_ASSERT(features() >= SceneConverterFeature::ConvertSceneToData,
+        "Trade::AbstractSceneConverter::convertToData(): scene conversion not supported", {});
+
+    Containers::Optional<Containers::Array<char>> out = doConvertToData(scene);
+    CORRADE_ASSERT(!out || !out->deleter() || out->deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || out->deleter() == ArrayAllocator<char>::deleter,
+        "Trade::AbstractSceneConverter::convertToData(): implementation is not allowed to use a custom Array deleter", {});
+
+    return out;
+}
+
+Containers::Optional<Containers::Array<char>> AbstractSceneConverter::doConvertToData(const SceneData&) {
+    CORRADE_ASSERT_UNREACHABLE("Trade::AbstractSceneConverter::convertToData(): scene conversion advertised but not implemented", {});
+}
+
+bool AbstractSceneConverter::convertToFile(const SceneData& scene, const Containers::StringView filename) {
+    CORRADE_ASSERT(features() >= SceneConverterFeature::ConvertSceneToFile,
+        "Trade::AbstractSceneConverter::convertToFile(): scene conversion not supported", {});
+
+    return doConvertToFile(scene, filename);
+}
+
+bool AbstractSceneConverter::doConvertToFile(const SceneData& scene, const Containers::StringView filename) {
+    CORRADE_ASSERT(features() >= SceneConverterFeature::ConvertSceneToData, "Trade::AbstractSceneConverter::convertToFile(): scene conversion advertised but not implemented", false);
+
+    const Containers::Optional<Containers::Array<char>> data = doConvertToData(scene);
+    /* No deleter checks as it doesn't matter here */
+    if(!data) return false;
+
+    if(!Utility::Path::write(filename, *data)) {
+        Error() << "Trade::AbstractSceneConverter::convertToFile(): cannot write to file" << filename;
+        return false;
+    }
+
+    return true;
+}
+
 Debug& operator<<(Debug& debug, const SceneConverterFeature value) {
     debug << "Trade::SceneConverterFeature" << Debug::nospace;
 
@@ -205,6 +243,8 @@ Debug& operator<<(Debug& debug, const SceneConverterFeature value) {
         _c(ConvertMeshInPlace)
         _c(ConvertMeshToData)
         _c(ConvertMeshToFile)
+        _c(ConvertSceneToData)
+        _c(ConvertSceneToFile)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -218,7 +258,10 @@ Debug& operator<<(Debug& debug, const SceneConverterFeatures value) {
         SceneConverterFeature::ConvertMeshInPlace,
         SceneConverterFeature::ConvertMeshToData,
         /* Implied by ConvertMeshToData, has to be after */
-        SceneConverterFeature::ConvertMeshToFile});
+        SceneConverterFeature::ConvertMeshToFile,
+        SceneConverterFeature::ConvertSceneToData,
+        /* Implied by ConvertSceneToData, has to be after */
+        SceneConverterFeature::ConvertSceneToFile});
 }
 
 Debug& operator<<(Debug& debug, const SceneConverterFlag value) {
@@ -77,7 +77,22 @@ enum class SceneConverterFeature: UnsignedByte {
      * @ref AbstractSceneConverter::convertToData(const MeshData&). Implies
      * @ref SceneConverterFeature::ConvertMeshToFile.
      */
-    ConvertMeshToData = ConvertMeshToFile|(1 << 3)
+    ConvertMeshToData = ConvertMeshToFile|(1 << 3),
+
+    /**
+     * Converting a scene to a file with
+     * @ref AbstractSceneConverter::convertToFile(const SceneData&, Containers::StringView).
+     * @m_since_latest
+     */
+    ConvertSceneToFile = 1 << 4,
+
+    /**
+     * Converting a scene to raw data with
+     * @ref AbstractSceneConverter::convertToData(const SceneData&). Implies
+     * @ref SceneConverterFeature::ConvertSceneToFile.
+     * @m_since_latest
+     */
+    ConvertSceneToData = ConvertSceneToFile|(1 << 5)
 };
 
 /**
@@ -171,6 +186,11 @@ advertising support for a subset of them via @ref features():
     data to a common format like OBJ or PLY in order to be used with an
     external tool. Advertised with @ref SceneConverterFeature::ConvertMeshToFile
     or @ref SceneConverterFeature::ConvertMeshToData
+-   Saving a scene to a file / data using
+    @ref convertToFile(const SceneData&, Containers::StringView) /
+    @ref convertToData(const SceneData&). Advertised with
+    @ref SceneConverterFeature::ConvertSceneToFile or
+    @ref SceneConverterFeature::ConvertSceneToData.
 -   Performing an operation on the mesh data itself using
     @ref convert(const MeshData&), from which you get a @ref MeshData again.
     This includes operations like mesh decimation or topology cleanup.
@@ -278,6 +298,11 @@ checked by the implementation:
 -   The @ref doConvertToFile(const MeshData&, Containers::StringView) function
     is called only if @ref SceneConverterFeature::ConvertMeshToFile is
     supported.
+-   The @ref doConvertToData(const SceneData&) function is called only if
+    @ref SceneConverterFeature::ConvertSceneToData is supported.
+-   The @ref doConvertToFile(const SceneData&, Containers::StringView)
+    function is called only if @ref SceneConverterFeature::ConvertSceneToFile
+    is supported.
 
 @m_class{m-block m-warning}
 
@@ -432,6 +457,31 @@ class MAGNUM_TRADE_EXPORT AbstractSceneConverter: public PluginManager::Abstract
         CORRADE_DEPRECATED("use convertToFile(const MeshData&, Containers::StringView) instead") bool convertToFile(const std::string& filename, const MeshData& mesh);
         #endif
 
+        /**
+         * @brief Convert a scene to a raw data
+         * @m_since_latest
+         *
+         * Depending on the plugin, can convert the scene to a file format
+         * that can be saved to disk. Available only if
+         * @ref SceneConverterFeature::ConvertSceneToData is supported. On
+         * failure prints a message to @relativeref{Magnum,Error} and returns
+         * @ref Containers::NullOpt.
+         * @see @ref features(), @ref convertToFile(const SceneData&, Containers::StringView)
+         */
+        Containers::Optional<Containers::Array<char>> convertToData(const SceneData& scene);
+
+        /**
+         * @brief Convert a scene to a file
+         * @m_since_latest
+         *
+         * Available only if @ref SceneConverterFeature::ConvertSceneToFile or
+         * @ref SceneConverterFeature::ConvertSceneToData is supported. On
+         * failure prints a message to @relativeref{Magnum,Error} and returns
+         * @cpp false @ce.
+         * @see @ref features(), @ref convertToData(const SceneData&)
+         */
+        bool convertToFile(const SceneData& scene, Containers::StringView filename);
+
     protected:
         /**
          * @brief Implementation for @ref convertToFile(const MeshData&, Containers::StringView)
@@ -445,6 +495,19 @@ class MAGNUM_TRADE_EXPORT AbstractSceneConverter: public PluginManager::Abstract
          */
         virtual bool doConvertToFile(const MeshData& mesh, Containers::StringView filename);
 
+        /**
+         * @brief Implementation for @ref convertToFile(const SceneData&, Containers::StringView)
+         * @m_since_latest
+         *
+         * If @ref SceneConverterFeature::ConvertSceneToData is supported,
+         * default implementation calls @ref doConvertToData(const SceneData&)
+         * and saves the result to given file. It is allowed to call this
+         * function from your @ref doConvertToFile() implementation, for
+         * example when you only need to do format detection based on file
+         * extension.
+         */
+        virtual bool doConvertToFile(const SceneData& scene, Containers::StringView filename);
+
     private:
         /**
          * @brief Implementation for @ref features()
@@ -477,6 +540,12 @@ class MAGNUM_TRADE_EXPORT AbstractSceneConverter: public PluginManager::Abstract
         /** @brief Implementation for @ref convertToData(const MeshData&) */
         virtual Containers::Optional<Containers::Array<char>> doConvertToData(const MeshData& mesh);
 
+        /**
+         * @brief Implementation for @ref convertToData(const SceneData&)
+         * @m_since_latest
+         */
+        virtual Containers::Optional<Containers::Array<char>> doConvertToData(const SceneData& scene);
+
         SceneConverterFlags _flags;
 };
 
@@ -942,9 +942,84 @@ template<class T> std::size_t findObject(const SceneFieldFlags flags, const Cont
     return max;
 }
 
+inline std::size_t objectIndexBucket(const UnsignedLong object, const UnsignedInt hashShift) {
+    /* Fibonacci hashing, i.e. taking the top bits of a multiplication with
+       2^64 divided by the golden ratio. Gives a good spread for sequential
+       IDs, which is the common case. */
+    return hashShift ? std::size_t((object*0x9e3779b97f4a7c15ull) >> hashShift) : std::size_t(object);
+}
+
+/* Unlike findObject(), the mapping view is not adjusted for offset, as the
+   index contains absolute offsets */
+template<class T> std::size_t findObjectIndexed(const Containers::StridedArrayView1D<const void>& mapping, const Containers::ArrayView<const UnsignedInt> bucketOffsets, const Containers::ArrayView<const UnsignedInt> offsets, const UnsignedInt hashShift, const std::size_t offset, const UnsignedLong object) {
+    const Containers::StridedArrayView1D<const T> mappingT = Containers::arrayCast<const T>(mapping);
+    const std::size_t bucket = objectIndexBucket(object, hashShift);
+    if(bucket + 1 >= bucketOffsets.size()) return mapping.size();
+
+    /* Entries in the bucket are sorted by offset, so skip the ones before
+       `offset` with a binary search in case the object is there many times.
+       In a hashed index the bucket can contain other objects as well, so
+       check the actual mapping. */
+    const UnsignedInt* const end = offsets.data() + bucketOffsets[bucket + 1];
+    for(const UnsignedInt* i = std::lower_bound(offsets.data() + bucketOffsets[bucket], end, offset); i != end; ++i)
+        if(mappingT[*i] == object) return *i;
+    return mapping.size();
+}
+
+template<class T> void createObjectIndex(const Containers::StridedArrayView1D<const void>& mapping, const UnsignedLong mappingBound, const UnsignedInt hashShift, const Containers::ArrayView<UnsignedInt> bucketOffsets, const Containers::ArrayView<UnsignedInt> offsets) {
+    const Containers::StridedArrayView1D<const T> mappingT = Containers::arrayCast<const T>(mapping);
+
+    /* Count entries in each bucket, shifted by one. In case of a dense index,
+       objects that are out of bounds are skipped, as they can't be looked up
+       anyway. */
+    std::size_t count = 0;
+    for(const T object: mappingT) {
+        if(!hashShift && object >= mappingBound) continue;
+        ++bucketOffsets[objectIndexBucket(object, hashShift) + 1];
+        ++count;
+    }
+
+    /* Turn the counts into offsets of each bucket */
+    for(std::size_t i = 1; i < bucketOffsets.size(); ++i)
+        bucketOffsets[i] += bucketOffsets[i - 1];
+
+    /* Put the entries into their buckets, using bucketOffsets[i] as an
+       insertion cursor. Going in order so each bucket ends up sorted. After
+       this, bucketOffsets[i] contains the original bucketOffsets[i + 1]. */
+    for(std::size_t i = 0; i != mappingT.size(); ++i) {
+        const T object = mappingT[i];
+        if(!hashShift && object >= mappingBound) continue;
+        offsets[bucketOffsets[objectIndexBucket(object, hashShift)]++] = i;
+    }
+
+    /* Shift the offsets back */
+    for(std::size_t i = bucketOffsets.size() - 1; i > 0; --i)
+        bucketOffsets[i] = bucketOffsets[i - 1];
+    bucketOffsets[0] = 0;
+    CORRADE_INTERNAL_ASSERT(bucketOffsets[bucketOffsets.size() - 1] == count);
+}
+
 }
 
 std::size_t SceneData::findFieldObjectOffsetInternal(const SceneFieldData& field, const UnsignedLong object, const std::size_t offset) const {
+    /* Use the index if there's any. Fields with an implicit mapping never
+       have an index created. */
+    if(!_fieldObjectIndices.isEmpty()) {
+        const FieldObjectIndex& index = _fieldObjectIndices[&field - _fields.data()];
+        if(!index.bucketOffsets.isEmpty()) {
+            const Containers::StridedArrayView1D<const void> mapping = fieldDataMappingViewInternal(field);
+            if(field._mappingType == SceneMappingType::UnsignedInt)
+                return findObjectIndexed<UnsignedInt>(mapping, index.bucketOffsets, index.offsets, index.hashShift, offset, object);
+            else if(field._mappingType == SceneMappingType::UnsignedShort)
+                return findObjectIndexed<UnsignedShort>(mapping, index.bucketOffsets, index.offsets, index.hashShift, offset, object);
+            else if(field._mappingType == SceneMappingType::UnsignedByte)
+                return findObjectIndexed<UnsignedByte>(mapping, index.bucketOffsets, index.offsets, index.hashShift, offset, object);
+            else if(field._mappingType == SceneMappingType::UnsignedLong)
+                return findObjectIndexed<UnsignedLong>(mapping, index.bucketOffsets, index.offsets, index.hashShift, offset, object);
+            else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+        }
+    }
+
     const Containers::StridedArrayView1D<const void> mapping = fieldDataMappingViewInternal(field, offset, field._size - offset);
     if(field._mappingType == SceneMappingType::UnsignedInt)
         return offset + findObject<UnsignedInt>(field._flags, mapping, offset, object);
@@ -1043,6 +1118,74 @@ bool SceneData::hasFieldObject(const SceneField fieldName, const UnsignedLong ob
     return findFieldObjectOffsetInternal(field, object, 0) != field._size;
 }
 
+void SceneData::createFieldObjectIndexInternal(const UnsignedInt fieldId) {
+    const SceneFieldData& field = _fields[fieldId];
+    CORRADE_ASSERT(field._size <= 0xffffffffull,
+        "Trade::SceneData::createFieldObjectIndex(): expected field size to fit into 32 bits but got" << field._size, );
+
+    /* Implicit mapping is already an O(1) lookup */
+    if(field._flags >= SceneFieldFlag::ImplicitMapping) return;
+
+    if(_fieldObjectIndices.isEmpty())
+        _fieldObjectIndices = Containers::Array<FieldObjectIndex>{ValueInit, _fields.size()};
+    FieldObjectIndex& index = _fieldObjectIndices[fieldId];
+
+    /* If the mapping bound is not too large compared to the field size, use
+       the object ID directly as the bucket. Otherwise hash it into a
+       power-of-two bucket count that's at least the field size, which means
+       there's less than one object per bucket on average. */
+    std::size_t bucketCount;
+    if(_mappingBound <= 4ull*field._size) {
+        bucketCount = _mappingBound;
+        index.hashShift = 0;
+    } else {
+        UnsignedInt bits = 1;
+        while((std::size_t{1} << bits) < field._size) ++bits;
+        bucketCount = std::size_t{1} << bits;
+        index.hashShift = 64 - bits;
+    }
+
+    index.bucketOffsets = Containers::Array<UnsignedInt>{ValueInit, bucketCount + 1};
+    index.offsets = Containers::Array<UnsignedInt>{NoInit, field._size};
+
+    const Containers::StridedArrayView1D<const void> mapping = fieldDataMappingViewInternal(field);
+    if(field._mappingType == SceneMappingType::UnsignedInt)
+        createObjectIndex<UnsignedInt>(mapping, _mappingBound, index.hashShift, index.bucketOffsets, index.offsets);
+    else if(field._mappingType == SceneMappingType::UnsignedShort)
+        createObjectIndex<UnsignedShort>(mapping, _mappingBound, index.hashShift, index.bucketOffsets, index.offsets);
+    else if(field._mappingType == SceneMappingType::UnsignedByte)
+        createObjectIndex<UnsignedByte>(mapping, _mappingBound, index.hashShift, index.bucketOffsets, index.offsets);
+    else if(field._mappingType == SceneMappingType::UnsignedLong)
+        createObjectIndex<UnsignedLong>(mapping, _mappingBound, index.hashShift, index.bucketOffsets, index.offsets);
+    else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+void SceneData::createFieldObjectIndex(const UnsignedInt fieldId) {
+    CORRADE_ASSERT(fieldId < _fields.size(),
+        "Trade::SceneData::createFieldObjectIndex(): index" << fieldId << "out of range for" << _fields.size() << "fields", );
+    createFieldObjectIndexInternal(fieldId);
+}
+
+void SceneData::createFieldObjectIndex(const SceneField fieldName) {
+    const UnsignedInt fieldId = findFieldIdInternal(fieldName);
+    CORRADE_ASSERT(fieldId != ~UnsignedInt{},
+        "Trade::SceneData::createFieldObjectIndex(): field" << fieldName << "not found", );
+    createFieldObjectIndexInternal(fieldId);
+}
+
+bool SceneData::hasFieldObjectIndex(const UnsignedInt fieldId) const {
+    CORRADE_ASSERT(fieldId < _fields.size(),
+        "Trade::SceneData::hasFieldObjectIndex(): index" << fieldId << "out of range for" << _fields.size() << "fields", {});
+    return !_fieldObjectIndices.isEmpty() && !_fieldObjectIndices[fieldId].bucketOffsets.isEmpty();
+}
+
+bool SceneData::hasFieldObjectIndex(const SceneField fieldName) const {
+    const UnsignedInt fieldId = findFieldIdInternal(fieldName);
+    CORRADE_ASSERT(fieldId != ~UnsignedInt{},
+        "Trade::SceneData::hasFieldObjectIndex(): field" << fieldName << "not found", {});
+    return !_fieldObjectIndices.isEmpty() && !_fieldObjectIndices[fieldId].bucketOffsets.isEmpty();
+}
+
 SceneFieldFlags SceneData::fieldFlags(const SceneField name) const {
     const UnsignedInt fieldId = findFieldIdInternal(name);
     CORRADE_ASSERT(fieldId != ~UnsignedInt{}, "Trade::SceneData::fieldFlags(): field" << name << "not found", {});
@@ -2422,11 +2565,14 @@ std::vector<UnsignedInt> SceneData::children3D() const {
 Containers::Array<SceneFieldData> SceneData::releaseFieldData() {
     Containers::Array<SceneFieldData> out = std::move(_fields);
     _fields = {};
+    /* The indices have an entry for each field, so they have to go too */
+    _fieldObjectIndices = {};
     return out;
 }
 
 Containers::Array<char> SceneData::releaseData() {
     _fields = {};
+    _fieldObjectIndices = {};
     Containers::Array<char> out = std::move(_data);
     _data = {};
     return out;
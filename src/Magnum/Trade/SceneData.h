@@ -1100,7 +1100,10 @@ depending on what @ref SceneFieldFlags are present for given field, it can be
 done in constant, logarithmic or, worst case, linear time. As such, for general
 scene representations these are suited mainly for introspection and debugging
 purposes and retrieving field data for many objects is better achieved by
-accessing the field data directly.
+accessing the field data directly. If many per-object queries are needed on a
+field without @ref SceneFieldFlag::ImplicitMapping, calling
+@ref createFieldObjectIndex() on it first makes the lookups constant-time at
+the cost of extra memory.
 
 @section Trade-SceneData-usage-mutable Mutable data access
 
@@ -1503,10 +1506,12 @@ class MAGNUM_TRADE_EXPORT SceneData {
          * @ref fieldSize(UnsignedInt) const.
          *
          * If the field has @ref SceneFieldFlag::ImplicitMapping, the lookup is
-         * done in an @f$ \mathcal{O}(1) @f$ complexity. Otherwise, if the
-         * field has @ref SceneFieldFlag::OrderedMapping, the lookup is done in
-         * an @f$ \mathcal{O}(\log{} n) @f$ complexity with @f$ n @f$ being the
-         * size of the field. Otherwise, the lookup is done in an
+         * done in an @f$ \mathcal{O}(1) @f$ complexity. Otherwise, if
+         * @ref createFieldObjectIndex() was called for the field, the lookup
+         * is done in an expected @f$ \mathcal{O}(1) @f$ complexity. Otherwise,
+         * if the field has @ref SceneFieldFlag::OrderedMapping, the lookup is
+         * done in an @f$ \mathcal{O}(\log{} n) @f$ complexity with @f$ n @f$
+         * being the size of the field. Otherwise, the lookup is done in an
          * @f$ \mathcal{O}(n) @f$ complexity.
          *
          * You can also use @ref findFieldObjectOffset(SceneField, UnsignedLong, std::size_t) const
@@ -1525,9 +1530,10 @@ class MAGNUM_TRADE_EXPORT SceneData {
          * exist, @p object is expected to be smaller than @ref mappingBound()
          * and @p offset not be larger than @ref fieldSize(SceneField) const.
          *
-         * If the field has @ref SceneFieldFlag::ImplicitMapping, the lookup is
-         * done in an @f$ \mathcal{O}(m) @f$ complexity with @f$ m @f$ being
-         * the * field count. Otherwise, if the field has
+         * If the field has @ref SceneFieldFlag::ImplicitMapping or if
+         * @ref createFieldObjectIndex() was called for the field, the lookup
+         * is done in an @f$ \mathcal{O}(m) @f$ complexity with @f$ m @f$
+         * being the field count. Otherwise, if the field has
          * @ref SceneFieldFlag::OrderedMapping, the lookup is done in an
          * @f$ \mathcal{O}(m + \log{} n) @f$ complexity with @f$ m @f$ being
          * the field count and @f$ n @f$ the size of the field. Otherwise, the
@@ -1580,6 +1586,68 @@ class MAGNUM_TRADE_EXPORT SceneData {
          */
         bool hasFieldObject(SceneField fieldName, UnsignedLong object) const;
 
+        /**
+         * @brief Create an object index for given field
+         * @m_since_latest
+         *
+         * Builds an index from object IDs to offsets in @p fieldId, which is
+         * then used by @ref findFieldObjectOffset(), @ref fieldObjectOffset(),
+         * @ref hasFieldObject() and all per-object convenience accessors such
+         * as @ref parentFor() to perform the lookup in an expected
+         * @f$ \mathcal{O}(1) @f$ complexity even if the field doesn't have
+         * @ref SceneFieldFlag::OrderedMapping set. The index is created in an
+         * @f$ \mathcal{O}(n) @f$ execution time with @f$ n @f$ being the
+         * field size.
+         *
+         * If @ref mappingBound() is at most four times the field size, the
+         * index is a dense array indexed by object ID, taking
+         * @f$ 4(b + n) @f$ bytes with @f$ b @f$ being the mapping bound.
+         * Otherwise it's a hash table taking at most @f$ 12n @f$ bytes. If the
+         * field has @ref SceneFieldFlag::ImplicitMapping, the lookup is
+         * @f$ \mathcal{O}(1) @f$ already and this function does nothing.
+         * Calling this function again rebuilds the index.
+         *
+         * The index is not updated when the mapping data are modified through
+         * @ref mutableMapping(), in that case you need to call this function
+         * again. The @p fieldId is expected to be smaller than
+         * @ref fieldCount() and the field size is expected to fit into 32
+         * bits.
+         * @see @ref hasFieldObjectIndex(),
+         *      @ref createFieldObjectIndex(SceneField)
+         */
+        void createFieldObjectIndex(UnsignedInt fieldId);
+
+        /**
+         * @brief Create an object index for given named field
+         * @m_since_latest
+         *
+         * Like @ref createFieldObjectIndex(UnsignedInt), but the @p fieldName
+         * is expected to exist.
+         * @see @ref hasField()
+         */
+        void createFieldObjectIndex(SceneField fieldName);
+
+        /**
+         * @brief Whether given field has an object index
+         * @m_since_latest
+         *
+         * Returns @cpp true @ce if @ref createFieldObjectIndex() was called
+         * for @p fieldId and the field doesn't have
+         * @ref SceneFieldFlag::ImplicitMapping, @cpp false @ce otherwise. The
+         * @p fieldId is expected to be smaller than @ref fieldCount().
+         */
+        bool hasFieldObjectIndex(UnsignedInt fieldId) const;
+
+        /**
+         * @brief Whether given named field has an object index
+         * @m_since_latest
+         *
+         * Like @ref hasFieldObjectIndex(UnsignedInt) const, but the
+         * @p fieldName is expected to exist.
+         * @see @ref hasField()
+         */
+        bool hasFieldObjectIndex(SceneField fieldName) const;
+
         /**
          * @brief Field flags
          * @m_since_latest
@@ -2830,7 +2898,9 @@ class MAGNUM_TRADE_EXPORT SceneData {
 
         /* Returns the offset at which `object` is for field at index `id`, or
            the end offset if the object is not found. The returned offset can
-           be then passed to fieldData{Mapping,Field}ViewInternal(). */
+           be then passed to fieldData{Mapping,Field}ViewInternal(). The
+           `field` is expected to be a reference into _fields, its position is
+           used to look up the object index, if any. */
         MAGNUM_TRADE_LOCAL std::size_t findFieldObjectOffsetInternal(const SceneFieldData& field, UnsignedLong object, std::size_t offset) const;
 
         /* Like objects() / field(), but returning just a 1D view, sliced from
@@ -2858,6 +2928,18 @@ class MAGNUM_TRADE_EXPORT SceneData {
         MAGNUM_TRADE_LOCAL Containers::Array<Containers::Pair<UnsignedInt, UnsignedInt>> unsignedIndexFieldAsArrayInternal(const UnsignedInt fieldId) const;
         MAGNUM_TRADE_LOCAL void meshesMaterialsIntoInternal(UnsignedInt fieldId, std::size_t offset, const Containers::StridedArrayView1D<UnsignedInt>& meshDestination, const Containers::StridedArrayView1D<Int>& meshMaterialDestination) const;
         MAGNUM_TRADE_LOCAL void importerStateIntoInternal(const UnsignedInt fieldId, std::size_t offset, const Containers::StridedArrayView1D<const void*>& destination) const;
+        MAGNUM_TRADE_LOCAL void createFieldObjectIndexInternal(UnsignedInt fieldId);
+
+        /* Created by createFieldObjectIndex(). Offsets of entries in bucket i
+           are offsets[bucketOffsets[i]] until offsets[bucketOffsets[i + 1]],
+           in an ascending order. If hashShift is 0, the bucket is directly
+           the object ID, otherwise it's the top bits of a multiplicative hash
+           of the object ID. Empty bucketOffsets means there's no index. */
+        struct FieldObjectIndex {
+            Containers::Array<UnsignedInt> bucketOffsets;
+            Containers::Array<UnsignedInt> offsets;
+            UnsignedInt hashShift;
+        };
 
         DataFlags _dataFlags;
         SceneMappingType _mappingType;
@@ -2867,6 +2949,8 @@ class MAGNUM_TRADE_EXPORT SceneData {
         const void* _importerState;
         Containers::Array<SceneFieldData> _fields;
         Containers::Array<char> _data;
+        /* Either empty or having an entry for each field */
+        Containers::Array<FieldObjectIndex> _fieldObjectIndices;
 };
 
 namespace Implementation {
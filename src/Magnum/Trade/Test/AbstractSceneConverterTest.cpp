@@ -38,6 +38,7 @@
 #include "Magnum/Trade/ArrayAllocator.h"
 #include "Magnum/Trade/AbstractSceneConverter.h"
 #include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
 
 #include "configure.h"
 
@@ -80,6 +81,16 @@ struct AbstractSceneConverterTest: TestSuite::Tester {
     void convertMeshToFileThroughDataNotWritable();
     void convertMeshToFileNotImplemented();
 
+    void convertSceneToData();
+    void convertSceneToDataFailed();
+    void convertSceneToDataNotImplemented();
+    void convertSceneToDataCustomDeleter();
+
+    void convertSceneToFile();
+    void convertSceneToFileThroughData();
+    void convertSceneToFileThroughDataFailed();
+    void convertSceneToFileNotImplemented();
+
     void debugFeature();
     void debugFeatures();
     void debugFeaturesSupersets();
@@ -122,6 +133,16 @@ AbstractSceneConverterTest::AbstractSceneConverterTest() {
               &AbstractSceneConverterTest::convertMeshToFileThroughDataNotWritable,
               &AbstractSceneConverterTest::convertMeshToFileNotImplemented,
 
+              &AbstractSceneConverterTest::convertSceneToData,
+              &AbstractSceneConverterTest::convertSceneToDataFailed,
+              &AbstractSceneConverterTest::convertSceneToDataNotImplemented,
+              &AbstractSceneConverterTest::convertSceneToDataCustomDeleter,
+
+              &AbstractSceneConverterTest::convertSceneToFile,
+              &AbstractSceneConverterTest::convertSceneToFileThroughData,
+              &AbstractSceneConverterTest::convertSceneToFileThroughDataFailed,
+              &AbstractSceneConverterTest::convertSceneToFileNotImplemented,
+
               &AbstractSceneConverterTest::debugFeature,
               &AbstractSceneConverterTest::debugFeatures,
               &AbstractSceneConverterTest::debugFeaturesSupersets,
@@ -199,6 +220,7 @@ void AbstractSceneConverterTest::thingNotSupported() {
     } converter;
 
     MeshData mesh{MeshPrimitive::Triangles, 3};
+    SceneData scene{SceneMappingType::UnsignedInt, 3, nullptr, {}};
 
     std::ostringstream out;
     Error redirectError{&out};
@@ -206,11 +228,15 @@ void AbstractSceneConverterTest::thingNotSupported() {
     converter.convertInPlace(mesh);
     converter.convertToData(mesh);
     converter.convertToFile(mesh, Utility::Path::join(TRADE_TEST_OUTPUT_DIR, "mesh.out"));
+    converter.convertToData(scene);
+    converter.convertToFile(scene, Utility::Path::join(TRADE_TEST_OUTPUT_DIR, "scene.out"));
     CORRADE_COMPARE(out.str(),
         "Trade::AbstractSceneConverter::convert(): mesh conversion not supported\n"
         "Trade::AbstractSceneConverter::convertInPlace(): mesh conversion not supported\n"
         "Trade::AbstractSceneConverter::convertToData(): mesh conversion not supported\n"
-        "Trade::AbstractSceneConverter::convertToFile(): mesh conversion not supported\n");
+        "Trade::AbstractSceneConverter::convertToFile(): mesh conversion not supported\n"
+        "Trade::AbstractSceneConverter::convertToData(): scene conversion not supported\n"
+        "Trade::AbstractSceneConverter::convertToFile(): scene conversion not supported\n");
 }
 
 void AbstractSceneConverterTest::convertMesh() {
@@ -642,6 +668,145 @@ void AbstractSceneConverterTest::convertMeshToFileNotImplemented() {
     CORRADE_COMPARE(out.str(), "Trade::AbstractSceneConverter::convertToFile(): mesh conversion advertised but not implemented\n");
 }
 
+void AbstractSceneConverterTest::convertSceneToData() {
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override { return SceneConverterFeature::ConvertSceneToData; }
+
+        Containers::Optional<Containers::Array<char>> doConvertToData(const SceneData& scene) override {
+            return Containers::Array<char>{nullptr, std::size_t(scene.mappingBound())};
+        }
+    } converter;
+
+    Containers::Optional<Containers::Array<char>> data = converter.convertToData(SceneData{SceneMappingType::UnsignedInt, 6, nullptr, {}});
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data->size(), 6);
+}
+
+void AbstractSceneConverterTest::convertSceneToDataFailed() {
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override {
+            return SceneConverterFeature::ConvertSceneToData;
+        }
+
+        Containers::Optional<Containers::Array<char>> doConvertToData(const SceneData&) override {
+            return {};
+        }
+    } converter;
+
+    /* The implementation is expected to print an error message on its own */
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter.convertToData(SceneData{SceneMappingType::UnsignedInt, 0, nullptr, {}}));
+    CORRADE_COMPARE(out.str(), "");
+}
+
+void AbstractSceneConverterTest::convertSceneToDataNotImplemented() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override { return SceneConverterFeature::ConvertSceneToData; }
+    } converter;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.convertToData(SceneData{SceneMappingType::UnsignedInt, 6, nullptr, {}});
+    CORRADE_COMPARE(out.str(), "Trade::AbstractSceneConverter::convertToData(): scene conversion advertised but not implemented\n");
+}
+
+void AbstractSceneConverterTest::convertSceneToDataCustomDeleter() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override { return SceneConverterFeature::ConvertSceneToData; }
+
+        Containers::Optional<Containers::Array<char>> doConvertToData(const SceneData&) override {
+            return Containers::Array<char>{data, 1, [](char*, std::size_t) {}};
+        }
+
+        char data[1];
+    } converter;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.convertToData(SceneData{SceneMappingType::UnsignedInt, 6, nullptr, {}});
+    CORRADE_COMPARE(out.str(), "Trade::AbstractSceneConverter::convertToData(): implementation is not allowed to use a custom Array deleter\n");
+}
+
+void AbstractSceneConverterTest::convertSceneToFile() {
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override { return SceneConverterFeature::ConvertSceneToFile; }
+
+        bool doConvertToFile(const SceneData& scene, Containers::StringView filename) override {
+            return Utility::Path::write(filename, Containers::arrayView({char(scene.mappingBound())}));
+        }
+    } converter;
+
+    /* Remove previous file, if any */
+    Containers::String filename = Utility::Path::join(TRADE_TEST_OUTPUT_DIR, "scene.out");
+    if(Utility::Path::exists(filename))
+        CORRADE_VERIFY(Utility::Path::remove(filename));
+
+    CORRADE_VERIFY(converter.convertToFile(SceneData{SceneMappingType::UnsignedInt, 0xef, nullptr, {}}, filename));
+    CORRADE_COMPARE_AS(filename,
+        "\xef", TestSuite::Compare::FileToString);
+}
+
+void AbstractSceneConverterTest::convertSceneToFileThroughData() {
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override { return SceneConverterFeature::ConvertSceneToData; }
+
+        Containers::Optional<Containers::Array<char>> doConvertToData(const SceneData& scene) override {
+            return Containers::array({char(scene.mappingBound())});
+        }
+    } converter;
+
+    /* Remove previous file, if any */
+    Containers::String filename = Utility::Path::join(TRADE_TEST_OUTPUT_DIR, "scene.out");
+    if(Utility::Path::exists(filename))
+        CORRADE_VERIFY(Utility::Path::remove(filename));
+
+    /* doConvertToFile() should call doConvertToData() */
+    CORRADE_VERIFY(converter.convertToFile(SceneData{SceneMappingType::UnsignedInt, 0xef, nullptr, {}}, filename));
+    CORRADE_COMPARE_AS(filename,
+        "\xef", TestSuite::Compare::FileToString);
+}
+
+void AbstractSceneConverterTest::convertSceneToFileThroughDataFailed() {
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override { return SceneConverterFeature::ConvertSceneToData; }
+
+        Containers::Optional<Containers::Array<char>> doConvertToData(const SceneData&) override {
+            return {};
+        }
+    } converter;
+
+    /* Remove previous file, if any */
+    Containers::String filename = Utility::Path::join(TRADE_TEST_OUTPUT_DIR, "scene.out");
+    if(Utility::Path::exists(filename))
+        CORRADE_VERIFY(Utility::Path::remove(filename));
+
+    /* Function should fail, no file should get written and no error output
+       should be printed (the base implementation assumes the plugin does it) */
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter.convertToFile(SceneData{SceneMappingType::UnsignedInt, 0xef, nullptr, {}}, filename));
+    CORRADE_VERIFY(!Utility::Path::exists(filename));
+    CORRADE_COMPARE(out.str(), "");
+}
+
+void AbstractSceneConverterTest::convertSceneToFileNotImplemented() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override { return SceneConverterFeature::ConvertSceneToFile; }
+    } converter;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.convertToFile(SceneData{SceneMappingType::UnsignedInt, 6, nullptr, {}}, Utility::Path::join(TRADE_TEST_OUTPUT_DIR, "scene.out"));
+    CORRADE_COMPARE(out.str(), "Trade::AbstractSceneConverter::convertToFile(): scene conversion advertised but not implemented\n");
+}
+
 void AbstractSceneConverterTest::debugFeature() {
     std::ostringstream out;
 
@@ -664,6 +829,14 @@ void AbstractSceneConverterTest::debugFeaturesSupersets() {
         Debug{&out} << (SceneConverterFeature::ConvertMeshToData|SceneConverterFeature::ConvertMeshToFile);
         CORRADE_COMPARE(out.str(), "Trade::SceneConverterFeature::ConvertMeshToData\n");
     }
+
+    /* ConvertSceneToData is a superset of ConvertSceneToFile, so only one
+       should be printed */
+    {
+        std::ostringstream out;
+        Debug{&out} << (SceneConverterFeature::ConvertSceneToData|SceneConverterFeature::ConvertSceneToFile);
+        CORRADE_COMPARE(out.str(), "Trade::SceneConverterFeature::ConvertSceneToData\n");
+    }
 }
 
 void AbstractSceneConverterTest::debugFlag() {
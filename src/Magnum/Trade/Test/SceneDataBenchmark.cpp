@@ -0,0 +1,162 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct SceneDataBenchmark: TestSuite::Tester {
+    explicit SceneDataBenchmark();
+
+    void findFieldObjectOffsetUnordered();
+    void findFieldObjectOffsetOrdered();
+    void findFieldObjectOffsetIndex();
+    void createFieldObjectIndex();
+};
+
+/* Each benchmark iteration does LookupCount lookups, spread over the whole
+   object range. Kept small as the unordered variant is linear. */
+enum: std::size_t { LookupCount = 100 };
+
+const struct {
+    const char* name;
+    std::size_t objectCount;
+    /* Mapping bound is objectCount*sparsity, which for larger values results
+       in a hashed index instead of a dense one */
+    std::size_t sparsity;
+} FindData[]{
+    {"10k objects", 10000, 1},
+    {"100k objects", 100000, 1},
+    {"1M objects", 1000000, 1},
+    {"10M objects", 10000000, 1},
+    {"10k objects, sparse", 10000, 16},
+    {"100k objects, sparse", 100000, 16},
+    {"1M objects, sparse", 1000000, 16},
+    {"10M objects, sparse", 10000000, 16},
+};
+
+SceneDataBenchmark::SceneDataBenchmark() {
+    addInstancedBenchmarks({&SceneDataBenchmark::findFieldObjectOffsetUnordered,
+                            &SceneDataBenchmark::findFieldObjectOffsetOrdered,
+                            &SceneDataBenchmark::findFieldObjectOffsetIndex,
+                            &SceneDataBenchmark::createFieldObjectIndex}, 5,
+        Containers::arraySize(FindData));
+}
+
+struct Field {
+    UnsignedInt mapping;
+    UnsignedInt mesh;
+};
+
+/* Objects in a pseudo-random order, each object present exactly once. The
+   multiplier is coprime with all the counts above, so it's a permutation. */
+Containers::Array<Field> fieldData(const std::size_t objectCount, const std::size_t sparsity, const bool ordered) {
+    Containers::Array<Field> out{NoInit, objectCount};
+    for(std::size_t i = 0; i != objectCount; ++i) {
+        const std::size_t object = ordered ? i : (i*7919)%objectCount;
+        out[i].mapping = UnsignedInt(object*sparsity);
+        out[i].mesh = UnsignedInt(object);
+    }
+    return out;
+}
+
+SceneData sceneFor(const Containers::ArrayView<Field> data, const std::size_t objectCount, const std::size_t sparsity, const SceneFieldFlags flags) {
+    Containers::StridedArrayView1D<Field> view = data;
+    return SceneData{SceneMappingType::UnsignedInt, objectCount*sparsity, {}, data, {
+        SceneFieldData{SceneField::Mesh, view.slice(&Field::mapping), view.slice(&Field::mesh), flags}
+    }};
+}
+
+void SceneDataBenchmark::findFieldObjectOffsetUnordered() {
+    auto&& data = FindData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<Field> fields = fieldData(data.objectCount, data.sparsity, false);
+    const SceneData scene = sceneFor(fields, data.objectCount, data.sparsity, {});
+
+    std::size_t found = 0;
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != LookupCount; ++i)
+            found += !!scene.findFieldObjectOffset(0, i*(data.objectCount/LookupCount)*data.sparsity);
+    }
+
+    CORRADE_COMPARE(found, std::size_t(LookupCount));
+}
+
+void SceneDataBenchmark::findFieldObjectOffsetOrdered() {
+    auto&& data = FindData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<Field> fields = fieldData(data.objectCount, data.sparsity, true);
+    const SceneData scene = sceneFor(fields, data.objectCount, data.sparsity, SceneFieldFlag::OrderedMapping);
+
+    std::size_t found = 0;
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != LookupCount; ++i)
+            found += !!scene.findFieldObjectOffset(0, i*(data.objectCount/LookupCount)*data.sparsity);
+    }
+
+    CORRADE_COMPARE(found, std::size_t(LookupCount));
+}
+
+void SceneDataBenchmark::findFieldObjectOffsetIndex() {
+    auto&& data = FindData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<Field> fields = fieldData(data.objectCount, data.sparsity, false);
+    SceneData scene = sceneFor(fields, data.objectCount, data.sparsity, {});
+    scene.createFieldObjectIndex(0);
+
+    std::size_t found = 0;
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != LookupCount; ++i)
+            found += !!scene.findFieldObjectOffset(0, i*(data.objectCount/LookupCount)*data.sparsity);
+    }
+
+    CORRADE_COMPARE(found, std::size_t(LookupCount));
+}
+
+void SceneDataBenchmark::createFieldObjectIndex() {
+    auto&& data = FindData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<Field> fields = fieldData(data.objectCount, data.sparsity, false);
+    SceneData scene = sceneFor(fields, data.objectCount, data.sparsity, {});
+
+    CORRADE_BENCHMARK(1) {
+        scene.createFieldObjectIndex(0);
+    }
+
+    CORRADE_VERIFY(scene.hasFieldObjectIndex(0));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::SceneDataBenchmark)
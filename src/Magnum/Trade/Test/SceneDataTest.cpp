@@ -124,7 +124,10 @@ struct SceneDataTest: TestSuite::Tester {
 
     void findFieldId();
     template<class T> void findFieldObjectOffset();
+    template<class T> void findFieldObjectOffsetIndex();
     void findFieldObjectOffsetInvalidOffset();
+    void fieldObjectIndexMultipleEntries();
+    void fieldObjectIndexRecreate();
     void fieldObjectOffsetNotFound();
 
     template<class T> void mappingAsArrayByIndex();
@@ -433,7 +436,16 @@ SceneDataTest::SceneDataTest() {
         &SceneDataTest::findFieldObjectOffset<UnsignedLong>
     }, Containers::arraySize(FindFieldObjectOffsetData));
 
+    addInstancedTests<SceneDataTest>({
+        &SceneDataTest::findFieldObjectOffsetIndex<UnsignedByte>,
+        &SceneDataTest::findFieldObjectOffsetIndex<UnsignedShort>,
+        &SceneDataTest::findFieldObjectOffsetIndex<UnsignedInt>,
+        &SceneDataTest::findFieldObjectOffsetIndex<UnsignedLong>
+    }, Containers::arraySize(FindFieldObjectOffsetData));
+
     addTests({&SceneDataTest::findFieldObjectOffsetInvalidOffset,
+              &SceneDataTest::fieldObjectIndexMultipleEntries,
+              &SceneDataTest::fieldObjectIndexRecreate,
               &SceneDataTest::fieldObjectOffsetNotFound,
 
               &SceneDataTest::mappingAsArrayByIndex<UnsignedByte>,
@@ -2292,6 +2304,122 @@ template<class T> void SceneDataTest::findFieldObjectOffset() {
     }
 }
 
+template<class T> void SceneDataTest::findFieldObjectOffsetIndex() {
+    setTestCaseTemplateName(NameTraits<T>::name());
+
+    auto&& data = FindFieldObjectOffsetData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    struct Field {
+        T object;
+        UnsignedInt mesh;
+    } fields[5]{
+        {T(data.mapping[0]), 0},
+        {T(data.mapping[1]), 0},
+        {T(data.mapping[2]), 0},
+        {T(data.mapping[3]), 0},
+        {T(data.mapping[4]), 0}
+    };
+    Containers::StridedArrayView1D<Field> view = fields;
+
+    /* Small mapping bound results in a dense index, large in a hashed one */
+    for(const UnsignedLong mappingBound: {7ull, 255ull}) {
+        CORRADE_ITERATION(mappingBound);
+
+        SceneData scene{Implementation::sceneMappingTypeFor<T>(), mappingBound, {}, fields, {
+            /* Test also with a completely empty field */
+            SceneFieldData{SceneField::Parent, Implementation::sceneMappingTypeFor<T>(), nullptr, SceneFieldType::Int, nullptr},
+            SceneFieldData{SceneField::Mesh, view.slice(&Field::object), view.slice(&Field::mesh), data.flags}
+        }};
+        CORRADE_VERIFY(!scene.hasFieldObjectIndex(0));
+        CORRADE_VERIFY(!scene.hasFieldObjectIndex(SceneField::Mesh));
+
+        scene.createFieldObjectIndex(0);
+        scene.createFieldObjectIndex(SceneField::Mesh);
+        CORRADE_VERIFY(scene.hasFieldObjectIndex(SceneField::Parent));
+        /* Implicit mapping doesn't need any index */
+        CORRADE_COMPARE(scene.hasFieldObjectIndex(1), !(data.flags >= SceneFieldFlag::ImplicitMapping));
+
+        if(data.offset == 0) {
+            CORRADE_COMPARE(scene.findFieldObjectOffset(0, data.object), Containers::NullOpt);
+            CORRADE_VERIFY(!scene.hasFieldObject(SceneField::Parent, data.object));
+        }
+
+        CORRADE_COMPARE(scene.findFieldObjectOffset(1, data.object, data.offset), data.expected);
+        CORRADE_COMPARE(scene.findFieldObjectOffset(SceneField::Mesh, data.object, data.offset), data.expected);
+        if(data.offset == 0)
+            CORRADE_COMPARE(scene.hasFieldObject(1, data.object), !!data.expected);
+        if(data.expected)
+            CORRADE_COMPARE(scene.fieldObjectOffset(SceneField::Mesh, data.object, data.offset), *data.expected);
+    }
+}
+
+void SceneDataTest::fieldObjectIndexMultipleEntries() {
+    /* Enough entries for a single object to exercise the binary search
+       within a bucket */
+    struct Data {
+        UnsignedInt mapping[11];
+        UnsignedInt mesh[11];
+    } data[]{{
+        {3, 1, 3, 3, 0, 3, 2, 3, 3, 1, 3},
+        {}
+    }};
+
+    SceneData scene{SceneMappingType::UnsignedInt, 1000000, {}, data, {
+        SceneFieldData{SceneField::Mesh, Containers::arrayView(data->mapping), Containers::arrayView(data->mesh)}
+    }};
+    scene.createFieldObjectIndex(SceneField::Mesh);
+
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 3), 0);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 3, 1), 2);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 3, 3), 3);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 3, 4), 5);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 3, 6), 7);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 3, 9), 10);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 3, 11), Containers::NullOpt);
+
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 1), 1);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 1, 2), 9);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 1, 10), Containers::NullOpt);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 0), 4);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 2), 6);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 4), Containers::NullOpt);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 999999), Containers::NullOpt);
+}
+
+void SceneDataTest::fieldObjectIndexRecreate() {
+    struct Data {
+        UnsignedInt mapping[3];
+        UnsignedInt mesh[3];
+    } data[]{{
+        {3, 1, 2},
+        {}
+    }};
+
+    SceneData scene{SceneMappingType::UnsignedInt, 5, DataFlag::Mutable, data, {
+        SceneFieldData{SceneField::Mesh, Containers::arrayView(data->mapping), Containers::arrayView(data->mesh)}
+    }};
+    scene.createFieldObjectIndex(0);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 1), 1);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 4), Containers::NullOpt);
+
+    /* The index isn't updated on a change, the mapping is always checked so
+       it doesn't return a wrong offset but it doesn't find it either */
+    scene.mutableMapping<UnsignedInt>(0)[1] = 4;
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 1), Containers::NullOpt);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 4), Containers::NullOpt);
+
+    /* Recreating it makes it work again */
+    scene.createFieldObjectIndex(0);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 1), Containers::NullOpt);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 4), 1);
+
+    /* The index survives a move */
+    SceneData moved = std::move(scene);
+    CORRADE_VERIFY(moved.hasFieldObjectIndex(0));
+    CORRADE_COMPARE(moved.findFieldObjectOffset(0, 4), 1);
+}
+
 void SceneDataTest::findFieldObjectOffsetInvalidOffset() {
     CORRADE_SKIP_IF_NO_ASSERT();
 
@@ -4636,6 +4764,8 @@ void SceneDataTest::fieldNotFound() {
     scene.findFieldObjectOffset(2, 0);
     scene.fieldObjectOffset(2, 0);
     scene.hasFieldObject(2, 0);
+    scene.createFieldObjectIndex(2);
+    scene.hasFieldObjectIndex(2);
     scene.fieldData(2);
     scene.fieldName(2);
     scene.fieldFlags(2);
@@ -4654,6 +4784,8 @@ void SceneDataTest::fieldNotFound() {
     scene.findFieldObjectOffset(sceneFieldCustom(666), 0);
     scene.fieldObjectOffset(sceneFieldCustom(666), 0);
     scene.hasFieldObject(sceneFieldCustom(666), 0);
+    scene.createFieldObjectIndex(sceneFieldCustom(666));
+    scene.hasFieldObjectIndex(sceneFieldCustom(666));
     scene.fieldType(sceneFieldCustom(666));
     scene.fieldSize(sceneFieldCustom(666));
     scene.fieldArraySize(sceneFieldCustom(666));
@@ -4699,6 +4831,8 @@ void SceneDataTest::fieldNotFound() {
         "Trade::SceneData::findFieldObjectOffset(): index 2 out of range for 2 fields\n"
         "Trade::SceneData::fieldObjectOffset(): index 2 out of range for 2 fields\n"
         "Trade::SceneData::hasFieldObject(): index 2 out of range for 2 fields\n"
+        "Trade::SceneData::createFieldObjectIndex(): index 2 out of range for 2 fields\n"
+        "Trade::SceneData::hasFieldObjectIndex(): index 2 out of range for 2 fields\n"
         "Trade::SceneData::fieldData(): index 2 out of range for 2 fields\n"
         "Trade::SceneData::fieldName(): index 2 out of range for 2 fields\n"
         "Trade::SceneData::fieldFlags(): index 2 out of range for 2 fields\n"
@@ -4717,6 +4851,8 @@ void SceneDataTest::fieldNotFound() {
         "Trade::SceneData::findFieldObjectOffset(): field Trade::SceneField::Custom(666) not found\n"
         "Trade::SceneData::fieldObjectOffset(): field Trade::SceneField::Custom(666) not found\n"
         "Trade::SceneData::hasFieldObject(): field Trade::SceneField::Custom(666) not found\n"
+        "Trade::SceneData::createFieldObjectIndex(): field Trade::SceneField::Custom(666) not found\n"
+        "Trade::SceneData::hasFieldObjectIndex(): field Trade::SceneField::Custom(666) not found\n"
         "Trade::SceneData::fieldType(): field Trade::SceneField::Custom(666) not found\n"
         "Trade::SceneData::fieldSize(): field Trade::SceneField::Custom(666) not found\n"
         "Trade::SceneData::fieldArraySize(): field Trade::SceneField::Custom(666) not found\n"
@@ -5535,6 +5671,13 @@ void SceneDataTest::releaseFieldData() {
 
     SceneData scene{SceneMappingType::UnsignedByte, 50, std::move(data), std::move(fields)};
 
+    /* Create an object index so it's released together with the fields. Not
+       observable through the public API afterwards as there are no fields to
+       query it for, but memory checkers would catch it leaking or being
+       accessed. */
+    scene.createFieldObjectIndex(SceneField::Mesh);
+    CORRADE_VERIFY(scene.hasFieldObjectIndex(SceneField::Mesh));
+
     Containers::Array<SceneFieldData> released = scene.releaseFieldData();
     CORRADE_COMPARE(released.data(), originalFields);
     CORRADE_COMPARE(released.size(), 2);
@@ -5564,6 +5707,13 @@ void SceneDataTest::releaseData() {
         SceneFieldData{SceneField::Mesh, view.slice(&Field::object), view.slice(&Field::mesh)}
     }};
 
+    /* Create an object index so it's released together with the fields. Not
+       observable through the public API afterwards as there are no fields to
+       query it for, but memory checkers would catch it leaking or being
+       accessed. */
+    scene.createFieldObjectIndex(SceneField::Mesh);
+    CORRADE_VERIFY(scene.hasFieldObjectIndex(SceneField::Mesh));
+
     Containers::Array<char> released = scene.releaseData();
     CORRADE_COMPARE(released.data(), view.data());
     CORRADE_COMPARE(released.size(), 3*sizeof(Field));
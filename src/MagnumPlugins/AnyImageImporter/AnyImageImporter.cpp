@@ -167,7 +167,7 @@ void AnyImageImporter::doOpenFile(const Containers::StringView filename) {
     _in = std::move(importer);
 }
 
-void AnyImageImporter::doOpenData(Containers::Array<char>&& data, DataFlags) {
+void AnyImageImporter::doOpenData(Containers::Array<char>&& data, const DataFlags dataFlags) {
     using namespace Containers::Literals;
 
     CORRADE_INTERNAL_ASSERT(manager());
@@ -278,8 +278,11 @@ void AnyImageImporter::doOpenData(Containers::Array<char>&& data, DataFlags) {
     Magnum::Implementation::propagateConfiguration("Trade::AnyImageImporter::openData():", {}, metadata->name(), configuration(), importer->configuration());
 
     /* Try to open the file (error output should be printed by the plugin
-       itself) */
-    if(!importer->openData(data)) return;
+       itself). If the memory is guaranteed to stay in scope, pass that
+       guarantee further so the plugin can avoid copies. */
+    if(dataFlags & DataFlag::ExternallyOwned) {
+        if(!importer->openMemory(data)) return;
+    } else if(!importer->openData(data)) return;
 
     /* Success, save the instance */
     _in = std::move(importer);
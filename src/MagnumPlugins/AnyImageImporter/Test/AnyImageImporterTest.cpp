@@ -29,6 +29,7 @@
 #include <Corrade/Containers/StringView.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/FormatStl.h>
@@ -62,6 +63,8 @@ struct AnyImageImporterTest: TestSuite::Tester {
        plugins have configuration subgroups as well */
     void propagateFileCallback();
 
+    void zeroCopy();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
@@ -189,7 +192,9 @@ AnyImageImporterTest::AnyImageImporterTest() {
     addInstancedTests({&AnyImageImporterTest::propagateConfigurationUnknown},
         Containers::arraySize(Load2DData));
 
-    addTests({&AnyImageImporterTest::propagateFileCallback});
+    addTests({&AnyImageImporterTest::propagateFileCallback,
+
+              &AnyImageImporterTest::zeroCopy});
 
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
@@ -449,6 +454,38 @@ void AnyImageImporterTest::propagateFileCallback() {
     CORRADE_VERIFY(!importer->isOpened());
 }
 
+void AnyImageImporterTest::zeroCopy() {
+    if(!(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TgaImporter plugin not enabled, cannot test");
+
+    /* Uncompressed grayscale TGA, which is what TgaImporter can reference
+       directly */
+    const char grayscale[]{
+        0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+        1, 2,
+        3, 4,
+        5, 6
+    };
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnyImageImporter");
+    importer->setFlags(ImporterFlag::ZeroCopy);
+    CORRADE_VERIFY(importer->openMemory(grayscale));
+
+    /* The memory guarantee and the flag should get propagated to the
+       concrete plugin, which then returns a view on the original memory */
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->format(), PixelFormat::R8Unorm);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::ExternallyOwned);
+    CORRADE_COMPARE(image->data().data(), grayscale + 18);
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView<char>({
+        1, 2,
+        3, 4,
+        5, 6
+    }), TestSuite::Compare::Container);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::AnyImageImporterTest)
@@ -0,0 +1,122 @@
+#ifndef Magnum_Trade_BlobFormat_h
+#define Magnum_Trade_BlobFormat_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Types.h"
+
+/* Used by both BlobImporter and BlobSceneConverter, which is why it isn't
+   directly inside BlobImporter.cpp. OTOH it doesn't need to be exposed
+   publicly, which is why it has no docblocks. The layout is described in the
+   BlobImporter class documentation. */
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+enum: UnsignedByte { BlobVersion = 1 };
+
+/* All chunks and all data regions inside them are aligned to this, which is
+   enough for any type MeshData and SceneData can describe */
+enum: std::size_t { BlobAlignment = 8 };
+
+enum class BlobChunkType: UnsignedShort {
+    Mesh = 1,
+    Scene = 2
+};
+
+/* Common header of every chunk. A file is a sequence of chunks, so blobs can
+   be simply concatenated. */
+struct BlobChunkHeader {
+    char magic[4];          /* "MGNB" */
+    UnsignedByte version;   /* BlobVersion */
+    char endianness;        /* 'L' for little endian, 'B' for big endian */
+    UnsignedShort type;     /* BlobChunkType */
+    UnsignedLong size;      /* Size including this header and padding */
+};
+
+static_assert(sizeof(BlobChunkHeader) == 16, "BlobChunkHeader size is not 16 bytes");
+
+/* Follows BlobChunkHeader in a BlobChunkType::Mesh chunk, after it is
+   attributeCount BlobMeshAttribute entries. All offsets are relative to the
+   chunk begin. */
+struct BlobMeshHeader {
+    UnsignedInt primitive;      /* MeshPrimitive */
+    UnsignedInt indexType;      /* MeshIndexType, 0 if not indexed */
+    UnsignedInt indexCount;
+    UnsignedInt vertexCount;
+    UnsignedInt attributeCount;
+    Short indexStride;
+    UnsignedByte padding[2];
+    UnsignedLong indexDataOffset;
+    UnsignedLong indexDataSize;
+    UnsignedLong indexOffset;   /* Relative to index data begin */
+    UnsignedLong vertexDataOffset;
+    UnsignedLong vertexDataSize;
+};
+
+static_assert(sizeof(BlobMeshHeader) == 64, "BlobMeshHeader size is not 64 bytes");
+
+struct BlobMeshAttribute {
+    UnsignedInt format;         /* VertexFormat */
+    UnsignedShort name;         /* MeshAttribute */
+    UnsignedShort arraySize;
+    Short stride;
+    UnsignedByte padding[6];
+    UnsignedLong offset;        /* Relative to vertex data begin */
+};
+
+static_assert(sizeof(BlobMeshAttribute) == 24, "BlobMeshAttribute size is not 24 bytes");
+
+/* Follows BlobChunkHeader in a BlobChunkType::Scene chunk, after it is
+   fieldCount BlobSceneField entries. The data offset is relative to the
+   chunk begin. */
+struct BlobSceneHeader {
+    UnsignedLong mappingBound;
+    UnsignedLong dataOffset;
+    UnsignedLong dataSize;
+    UnsignedInt fieldCount;
+    UnsignedByte mappingType;   /* SceneMappingType */
+    UnsignedByte padding[3];
+};
+
+static_assert(sizeof(BlobSceneHeader) == 32, "BlobSceneHeader size is not 32 bytes");
+
+struct BlobSceneField {
+    UnsignedInt name;           /* SceneField */
+    UnsignedShort type;         /* SceneFieldType */
+    UnsignedShort arraySize;
+    UnsignedLong size;
+    UnsignedLong mappingOffset; /* Relative to scene data begin */
+    UnsignedLong fieldOffset;   /* Relative to scene data begin */
+    Short mappingStride;
+    Short fieldStride;
+    UnsignedByte flags;         /* SceneFieldFlags, without OffsetOnly */
+    UnsignedByte padding[3];
+};
+
+static_assert(sizeof(BlobSceneField) == 40, "BlobSceneField size is not 40 bytes");
+
+}}}
+
+#endif
@@ -0,0 +1,443 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BlobImporter.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Endianness.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+#include "MagnumPlugins/BlobImporter/BlobFormat.h"
+
+namespace Magnum { namespace Trade {
+
+struct BlobImporter::State {
+    Containers::Array<char> data;
+    /* If set, the data is a view on externally owned memory and the returned
+       MeshData / SceneData can reference it directly */
+    bool externallyOwned = false;
+    Containers::Array<Containers::ArrayView<const char>> meshes;
+    Containers::Array<Containers::ArrayView<const char>> scenes;
+};
+
+namespace {
+
+/* Data regions have to be aligned and fit into the chunk */
+bool regionFits(const std::size_t chunkSize, const UnsignedLong offset, const UnsignedLong size) {
+    return offset % Implementation::BlobAlignment == 0 &&
+        offset <= chunkSize && size <= chunkSize - offset;
+}
+
+/* Checks that `count` items of `itemSize` bytes, with the first at `offset`
+   and separated by `stride` bytes, fit into a region of `regionSize` bytes.
+   Same calculation as in the MeshData and SceneData constructors, but done
+   with overflow-safe unsigned arithmetic on untrusted input. */
+bool stridedRangeFits(const UnsignedLong regionSize, const UnsignedLong offset, const UnsignedLong count, const Short stride, const UnsignedLong itemSize) {
+    if(!count) return true;
+    if(offset > regionSize) return false;
+    /* With a nonzero stride the span is at least count - 1 bytes, bail early
+       to avoid overflows in the multiplication below */
+    if(stride && count - 1 > regionSize) return false;
+
+    const UnsignedLong span = (count - 1)*UnsignedLong(stride < 0 ? -Int(stride) : Int(stride));
+    /* For a negative stride the first item is the last in memory */
+    if(stride < 0) return span <= offset && offset + itemSize <= regionSize;
+    return offset + span + itemSize <= regionSize;
+}
+
+/* Returns 2 or 3 for transformation fields, 0 otherwise. The type is
+   expected to be already checked for compatibility with the field. */
+UnsignedInt transformationFieldDimensions(const SceneField name, const SceneFieldType type) {
+    if(name == SceneField::Transformation) {
+        if(type == SceneFieldType::Matrix3x3 ||
+           type == SceneFieldType::Matrix3x3d ||
+           type == SceneFieldType::Matrix3x2 ||
+           type == SceneFieldType::Matrix3x2d ||
+           type == SceneFieldType::DualComplex ||
+           type == SceneFieldType::DualComplexd)
+            return 2;
+        return 3;
+    }
+    if(name == SceneField::Translation || name == SceneField::Scaling)
+        return type == SceneFieldType::Vector2 || type == SceneFieldType::Vector2d ? 2 : 3;
+    if(name == SceneField::Rotation)
+        return type == SceneFieldType::Complex || type == SceneFieldType::Complexd ? 2 : 3;
+    return 0;
+}
+
+}
+
+BlobImporter::BlobImporter() = default;
+
+BlobImporter::BlobImporter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): AbstractImporter{manager, plugin} {}
+
+BlobImporter::~BlobImporter() = default;
+
+ImporterFeatures BlobImporter::doFeatures() const { return ImporterFeature::OpenData; }
+
+bool BlobImporter::doIsOpened() const { return !!_state; }
+
+void BlobImporter::doClose() { _state = nullptr; }
+
+void BlobImporter::doOpenData(Containers::Array<char>&& data, const DataFlags dataFlags) {
+    if(data.isEmpty()) {
+        Error{} << "Trade::BlobImporter::openData(): the file is empty";
+        return;
+    }
+
+    Containers::Pointer<State> state{InPlaceInit};
+
+    /* Reference externally owned memory or take over the owned array if
+       they're aligned enough for the data inside, copy the data to a new
+       allocation otherwise. Default allocations are aligned to at least 8
+       bytes. */
+    if(reinterpret_cast<std::uintptr_t>(data.data()) % Implementation::BlobAlignment == 0 && (dataFlags & (DataFlag::Owned|DataFlag::ExternallyOwned))) {
+        state->externallyOwned = !(dataFlags & DataFlag::Owned);
+        state->data = std::move(data);
+    } else {
+        state->data = Containers::Array<char>{NoInit, data.size()};
+        Utility::copy(data, state->data);
+    }
+
+    /* Go through the chunk headers. The contents get checked only once a
+       particular mesh or scene is accessed. */
+    constexpr char expectedEndianness = Utility::Endianness::isBigEndian() ? 'B' : 'L';
+    Containers::ArrayView<const char> in = state->data;
+    while(!in.isEmpty()) {
+        if(in.size() < sizeof(Implementation::BlobChunkHeader)) {
+            Error{} << "Trade::BlobImporter::openData(): expected at least" << sizeof(Implementation::BlobChunkHeader) << "bytes for a chunk header but got only" << in.size();
+            return;
+        }
+
+        const auto& header = *reinterpret_cast<const Implementation::BlobChunkHeader*>(in.data());
+        if(std::memcmp(header.magic, "MGNB", 4) != 0) {
+            Error{} << "Trade::BlobImporter::openData(): invalid chunk signature";
+            return;
+        }
+        if(header.version != Implementation::BlobVersion) {
+            Error{} << "Trade::BlobImporter::openData(): unsupported chunk version" << header.version << Debug::nospace << ", expected" << UnsignedInt(Implementation::BlobVersion);
+            return;
+        }
+        if(header.endianness != expectedEndianness) {
+            Error{} << "Trade::BlobImporter::openData(): expected a" << (expectedEndianness == 'B' ? "big-endian" : "little-endian") << "chunk";
+            return;
+        }
+        if(header.size < sizeof(Implementation::BlobChunkHeader) || header.size % Implementation::BlobAlignment || header.size > in.size()) {
+            Error{} << "Trade::BlobImporter::openData(): invalid chunk size" << header.size << "for" << in.size() << "remaining bytes";
+            return;
+        }
+
+        const Containers::ArrayView<const char> chunk = in.prefix(std::size_t(header.size));
+        if(header.type == UnsignedShort(Implementation::BlobChunkType::Mesh))
+            arrayAppend(state->meshes, chunk);
+        else if(header.type == UnsignedShort(Implementation::BlobChunkType::Scene))
+            arrayAppend(state->scenes, chunk);
+        /* Unknown chunk types are skipped for forward compatibility */
+
+        in = in.exceptPrefix(chunk.size());
+    }
+
+    _state = std::move(state);
+}
+
+UnsignedInt BlobImporter::doSceneCount() const { return _state->scenes.size(); }
+
+Containers::Optional<SceneData> BlobImporter::doScene(const UnsignedInt id) {
+    const Containers::ArrayView<const char> chunk = _state->scenes[id];
+
+    constexpr std::size_t headerSize = sizeof(Implementation::BlobChunkHeader) + sizeof(Implementation::BlobSceneHeader);
+    if(chunk.size() < headerSize) {
+        Error{} << "Trade::BlobImporter::scene(): expected at least" << headerSize << "bytes for a scene header but got only" << chunk.size();
+        return {};
+    }
+
+    const auto& header = *reinterpret_cast<const Implementation::BlobSceneHeader*>(chunk.data() + sizeof(Implementation::BlobChunkHeader));
+    if(UnsignedLong(header.fieldCount)*sizeof(Implementation::BlobSceneField) > chunk.size() - headerSize) {
+        Error{} << "Trade::BlobImporter::scene(): chunk of" << chunk.size() << "bytes too short for" << header.fieldCount << "fields";
+        return {};
+    }
+
+    const SceneMappingType mappingType = SceneMappingType(header.mappingType);
+    if(!header.mappingType || header.mappingType > UnsignedByte(SceneMappingType::UnsignedLong)) {
+        Error{} << "Trade::BlobImporter::scene(): invalid mapping type" << mappingType;
+        return {};
+    }
+    if(mappingType != SceneMappingType::UnsignedLong && header.mappingBound > (1ull << (8*sceneMappingTypeSize(mappingType))) - 1) {
+        Error{} << "Trade::BlobImporter::scene():" << mappingType << "is too small for" << header.mappingBound << "objects";
+        return {};
+    }
+    if(!regionFits(chunk.size(), header.dataOffset, header.dataSize)) {
+        Error{} << "Trade::BlobImporter::scene(): data of" << header.dataSize << "bytes at offset" << header.dataOffset << "are misaligned or out of range for a chunk of" << chunk.size() << "bytes";
+        return {};
+    }
+
+    const auto* const fieldHeaders = reinterpret_cast<const Implementation::BlobSceneField*>(chunk.data() + headerSize);
+    const UnsignedInt mappingTypeSize = sceneMappingTypeSize(mappingType);
+    Containers::Array<SceneFieldData> fields{header.fieldCount};
+    for(UnsignedInt i = 0; i != header.fieldCount; ++i) {
+        const Implementation::BlobSceneField& field = fieldHeaders[i];
+        const SceneField name = SceneField(field.name);
+        const SceneFieldType type = SceneFieldType(field.type);
+
+        if(!isSceneFieldCustom(name) && (!field.name || field.name > UnsignedInt(SceneField::ImporterState))) {
+            Error{} << "Trade::BlobImporter::scene(): invalid field" << i << "name" << name;
+            return {};
+        }
+        if(!field.type || field.type > UnsignedShort(SceneFieldType::MutablePointer)) {
+            Error{} << "Trade::BlobImporter::scene(): invalid field" << i << "type" << type;
+            return {};
+        }
+        /* Pointers can't be meaningfully stored in a file */
+        if(type == SceneFieldType::Pointer || type == SceneFieldType::MutablePointer) {
+            Error{} << "Trade::BlobImporter::scene(): field" << i << "has an unsupported type" << type;
+            return {};
+        }
+        if(!Implementation::isSceneFieldTypeCompatibleWithField(name, type)) {
+            Error{} << "Trade::BlobImporter::scene():" << type << "is not a valid type for field" << i << "of type" << name;
+            return {};
+        }
+        if(field.arraySize && !Implementation::isSceneFieldArrayAllowed(name)) {
+            Error{} << "Trade::BlobImporter::scene(): field" << i << "of type" << name << "can't be an array";
+            return {};
+        }
+        if(field.flags & ~UnsignedByte(SceneFieldFlag::ImplicitMapping)) {
+            Error{} << "Trade::BlobImporter::scene(): invalid field" << i << "flags" << SceneFieldFlags{SceneFieldFlag(field.flags)};
+            return {};
+        }
+        if(!stridedRangeFits(header.dataSize, field.mappingOffset, field.size, field.mappingStride, mappingTypeSize) ||
+           !stridedRangeFits(header.dataSize, field.fieldOffset, field.size, field.fieldStride, sceneFieldTypeSize(type)*(field.arraySize ? field.arraySize : 1))) {
+            Error{} << "Trade::BlobImporter::scene(): field" << i << "is out of range for" << header.dataSize << "bytes of scene data";
+            return {};
+        }
+
+        fields[i] = SceneFieldData{name, std::size_t(field.size), mappingType, std::size_t(field.mappingOffset), field.mappingStride, type, std::size_t(field.fieldOffset), field.fieldStride, field.arraySize, SceneFieldFlag(field.flags)};
+    }
+
+    /* Check also the constraints SceneData asserts on, as a malformed file
+       shouldn't be able to abort the application. First, field names have to
+       be unique. Sorting instead of an O(n^2) comparison as the field count
+       comes from the file. */
+    {
+        Containers::Array<UnsignedInt> names{NoInit, header.fieldCount};
+        for(UnsignedInt i = 0; i != header.fieldCount; ++i)
+            names[i] = fieldHeaders[i].name;
+        std::sort(names.begin(), names.end());
+        for(UnsignedInt i = 1; i < header.fieldCount; ++i) if(names[i] == names[i - 1]) {
+            Error{} << "Trade::BlobImporter::scene(): duplicate field" << SceneField(names[i]);
+            return {};
+        }
+    }
+
+    /* Transformation fields have to be all either 2D or 3D, and a skin
+       needs some transformation field to disambiguate between the two */
+    UnsignedInt dimensions = 0;
+    UnsignedInt translationField = ~UnsignedInt{};
+    UnsignedInt rotationField = ~UnsignedInt{};
+    UnsignedInt scalingField = ~UnsignedInt{};
+    UnsignedInt meshField = ~UnsignedInt{};
+    UnsignedInt meshMaterialField = ~UnsignedInt{};
+    UnsignedInt skinField = ~UnsignedInt{};
+    for(UnsignedInt i = 0; i != header.fieldCount; ++i) {
+        const SceneField name = SceneField(fieldHeaders[i].name);
+        const SceneFieldType type = SceneFieldType(fieldHeaders[i].type);
+        if(const UnsignedInt fieldDimensions = transformationFieldDimensions(name, type)) {
+            if(dimensions && dimensions != fieldDimensions) {
+                Error{} << "Trade::BlobImporter::scene(): expected a" << dimensions << Debug::nospace << "D field" << i << "of type" << name << "but got" << type;
+                return {};
+            }
+            dimensions = fieldDimensions;
+        }
+
+        if(name == SceneField::Translation) translationField = i;
+        else if(name == SceneField::Rotation) rotationField = i;
+        else if(name == SceneField::Scaling) scalingField = i;
+        else if(name == SceneField::Mesh) meshField = i;
+        else if(name == SceneField::MeshMaterial) meshMaterialField = i;
+        else if(name == SceneField::Skin) skinField = i;
+    }
+    if(skinField != ~UnsignedInt{} && !dimensions) {
+        Error{} << "Trade::BlobImporter::scene(): a skin field requires some transformation field to be present";
+        return {};
+    }
+
+    /* TRS fields and mesh with material fields have to share the object
+       mapping. The fields are all offset-only with the same mapping type, so
+       it's enough to compare the offsets and sizes. */
+    const Containers::Pair<UnsignedInt, UnsignedInt> sharedMappingFields[]{
+        {translationField, rotationField},
+        {translationField, scalingField},
+        {rotationField, scalingField},
+        {meshField, meshMaterialField}
+    };
+    for(const Containers::Pair<UnsignedInt, UnsignedInt>& fieldPair: sharedMappingFields) {
+        if(fieldPair.first() == ~UnsignedInt{} || fieldPair.second() == ~UnsignedInt{})
+            continue;
+        const Implementation::BlobSceneField& a = fieldHeaders[fieldPair.first()];
+        const Implementation::BlobSceneField& b = fieldHeaders[fieldPair.second()];
+        if(a.mappingOffset != b.mappingOffset || a.size != b.size) {
+            Error{} << "Trade::BlobImporter::scene():" << SceneField(b.name) << "mapping doesn't match" << SceneField(a.name);
+            return {};
+        }
+    }
+
+    const Containers::ArrayView<const char> data = chunk.slice(std::size_t(header.dataOffset), std::size_t(header.dataOffset + header.dataSize));
+
+    /* Reference the memory directly if possible, the fields are offset-only
+       so there's nothing else to patch */
+    if(_state->externallyOwned)
+        return SceneData{mappingType, header.mappingBound, DataFlag::ExternallyOwned, data, std::move(fields)};
+
+    Containers::Array<char> dataCopy{NoInit, data.size()};
+    Utility::copy(data, dataCopy);
+    return SceneData{mappingType, header.mappingBound, std::move(dataCopy), std::move(fields)};
+}
+
+UnsignedInt BlobImporter::doMeshCount() const { return _state->meshes.size(); }
+
+Containers::Optional<MeshData> BlobImporter::doMesh(const UnsignedInt id, UnsignedInt) {
+    const Containers::ArrayView<const char> chunk = _state->meshes[id];
+
+    constexpr std::size_t headerSize = sizeof(Implementation::BlobChunkHeader) + sizeof(Implementation::BlobMeshHeader);
+    if(chunk.size() < headerSize) {
+        Error{} << "Trade::BlobImporter::mesh(): expected at least" << headerSize << "bytes for a mesh header but got only" << chunk.size();
+        return {};
+    }
+
+    const auto& header = *reinterpret_cast<const Implementation::BlobMeshHeader*>(chunk.data() + sizeof(Implementation::BlobChunkHeader));
+    if(UnsignedLong(header.attributeCount)*sizeof(Implementation::BlobMeshAttribute) > chunk.size() - headerSize) {
+        Error{} << "Trade::BlobImporter::mesh(): chunk of" << chunk.size() << "bytes too short for" << header.attributeCount << "attributes";
+        return {};
+    }
+
+    const MeshPrimitive primitive = MeshPrimitive(header.primitive);
+    if(!isMeshPrimitiveImplementationSpecific(primitive) && (!header.primitive || header.primitive > UnsignedInt(MeshPrimitive::Meshlets))) {
+        Error{} << "Trade::BlobImporter::mesh(): invalid primitive" << primitive;
+        return {};
+    }
+    if(header.vertexCount == MeshData::ImplicitVertexCount) {
+        Error{} << "Trade::BlobImporter::mesh(): invalid vertex count" << header.vertexCount;
+        return {};
+    }
+    if(!regionFits(chunk.size(), header.indexDataOffset, header.indexDataSize) ||
+       !regionFits(chunk.size(), header.vertexDataOffset, header.vertexDataSize)) {
+        Error{} << "Trade::BlobImporter::mesh(): index or vertex data are misaligned or out of range for a chunk of" << chunk.size() << "bytes";
+        return {};
+    }
+
+    const MeshIndexType indexType = MeshIndexType(header.indexType);
+    if(header.indexType) {
+        if(header.indexType > UnsignedInt(MeshIndexType::UnsignedInt)) {
+            Error{} << "Trade::BlobImporter::mesh(): invalid index type" << indexType;
+            return {};
+        }
+        if(!stridedRangeFits(header.indexDataSize, header.indexOffset, header.indexCount, header.indexStride, meshIndexTypeSize(indexType))) {
+            Error{} << "Trade::BlobImporter::mesh():" << header.indexCount << "indices are out of range for" << header.indexDataSize << "bytes of index data";
+            return {};
+        }
+    } else if(header.indexCount) {
+        Error{} << "Trade::BlobImporter::mesh(): index count specified for a non-indexed mesh";
+        return {};
+    }
+    if(!header.indexCount && header.indexDataSize) {
+        Error{} << "Trade::BlobImporter::mesh(): index data specified for a mesh with no indices";
+        return {};
+    }
+
+    const auto* const attributeHeaders = reinterpret_cast<const Implementation::BlobMeshAttribute*>(chunk.data() + headerSize);
+    Containers::Array<MeshAttributeData> attributes{header.attributeCount};
+    for(UnsignedInt i = 0; i != header.attributeCount; ++i) {
+        const Implementation::BlobMeshAttribute& attribute = attributeHeaders[i];
+        const MeshAttribute name = MeshAttribute(attribute.name);
+        const VertexFormat format = VertexFormat(attribute.format);
+
+        if(!isMeshAttributeCustom(name) && (!attribute.name || attribute.name > UnsignedShort(MeshAttribute::ObjectId))) {
+            Error{} << "Trade::BlobImporter::mesh(): invalid attribute" << i << "name" << name;
+            return {};
+        }
+        /* Implementation-specific formats are not produced by the converter
+           as their size is unknown and thus can't be checked here */
+        if(isVertexFormatImplementationSpecific(format) || !attribute.format || attribute.format > UnsignedInt(VertexFormat::Matrix4x3sNormalizedAligned)) {
+            Error{} << "Trade::BlobImporter::mesh(): invalid attribute" << i << "format" << format;
+            return {};
+        }
+        if(!Implementation::isVertexFormatCompatibleWithAttribute(name, format)) {
+            Error{} << "Trade::BlobImporter::mesh():" << format << "is not a valid format for attribute" << i << "of type" << name;
+            return {};
+        }
+        if(attribute.arraySize && !Implementation::isAttributeArrayAllowed(name)) {
+            Error{} << "Trade::BlobImporter::mesh(): attribute" << i << "of type" << name << "can't be an array";
+            return {};
+        }
+        if(!stridedRangeFits(header.vertexDataSize, attribute.offset, header.vertexCount, attribute.stride, vertexFormatSize(format)*(attribute.arraySize ? attribute.arraySize : 1))) {
+            Error{} << "Trade::BlobImporter::mesh(): attribute" << i << "is out of range for" << header.vertexDataSize << "bytes of vertex data";
+            return {};
+        }
+
+        attributes[i] = MeshAttributeData{name, format, std::size_t(attribute.offset), header.vertexCount, attribute.stride, attribute.arraySize};
+    }
+
+    const Containers::ArrayView<const char> indexData = chunk.slice(std::size_t(header.indexDataOffset), std::size_t(header.indexDataOffset + header.indexDataSize));
+    const Containers::ArrayView<const char> vertexData = chunk.slice(std::size_t(header.vertexDataOffset), std::size_t(header.vertexDataOffset + header.vertexDataSize));
+
+    /* Attributes are offset-only, but the index view has to point to the
+       actual memory */
+    const auto indicesFor = [&](const Containers::ArrayView<const char> data) -> MeshIndexData {
+        if(!header.indexType) return MeshIndexData{};
+        return MeshIndexData{indexType, Containers::StridedArrayView1D<const void>{data, data.data() + (header.indexCount ? header.indexOffset : 0), header.indexCount, header.indexStride}};
+    };
+
+    /* Reference the memory directly if possible */
+    if(_state->externallyOwned) {
+        const MeshIndexData indices = indicesFor(indexData);
+        return MeshData{primitive,
+            DataFlag::ExternallyOwned, indexData, indices,
+            DataFlag::ExternallyOwned, vertexData,
+            std::move(attributes), header.vertexCount};
+    }
+
+    Containers::Array<char> indexDataCopy{NoInit, indexData.size()};
+    Containers::Array<char> vertexDataCopy{NoInit, vertexData.size()};
+    Utility::copy(indexData, indexDataCopy);
+    Utility::copy(vertexData, vertexDataCopy);
+    const MeshIndexData indices = indicesFor(indexDataCopy);
+    return MeshData{primitive,
+        std::move(indexDataCopy), indices,
+        std::move(vertexDataCopy), std::move(attributes), header.vertexCount};
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(BlobImporter, Magnum::Trade::BlobImporter,
+    "cz.mosra.magnum.Trade.AbstractImporter/0.5")
@@ -0,0 +1,164 @@
+#ifndef Magnum_Trade_BlobImporter_h
+#define Magnum_Trade_BlobImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::BlobImporter
+ * @m_since_latest
+ */
+
+#include <Corrade/Utility/VisibilityMacros.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+
+#include "MagnumPlugins/BlobImporter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_BLOBIMPORTER_BUILD_STATIC
+    #ifdef BlobImporter_EXPORTS
+        #define MAGNUM_BLOBIMPORTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_BLOBIMPORTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_BLOBIMPORTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_BLOBIMPORTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_BLOBIMPORTER_EXPORT
+#define MAGNUM_BLOBIMPORTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Magnum blob importer plugin
+@m_since_latest
+
+Imports meshes and scenes from the Magnum blob format (`*.blob`) produced by
+@ref BlobSceneConverter. The format is a direct serialization of the
+@ref MeshData and @ref SceneData memory layout, so importing it is just a
+matter of validating a few headers and pointing the returned instances into
+the file contents.
+
+@section Trade-BlobImporter-usage Usage
+
+This plugin depends on the @ref Trade library and is built if
+`MAGNUM_WITH_BLOBIMPORTER` is enabled when building Magnum. To use as a dynamic
+plugin, load @cpp "BlobImporter" @ce via @ref Corrade::PluginManager::Manager.
+
+Additionally, if you're using Magnum as a CMake subproject, do the following:
+
+@code{.cmake}
+set(MAGNUM_WITH_BLOBIMPORTER ON CACHE BOOL "" FORCE)
+add_subdirectory(magnum EXCLUDE_FROM_ALL)
+
+# So the dynamically loaded plugin gets built implicitly
+add_dependencies(your-app Magnum::BlobImporter)
+@endcode
+
+To use as a static plugin or use this as a dependency of another plugin with
+CMake, you need to request the `BlobImporter` component of the `Magnum`
+package and link to the `Magnum::BlobImporter` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED BlobImporter)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::BlobImporter)
+@endcode
+
+See @ref building, @ref cmake, @ref plugins and @ref file-formats for more
+information.
+
+@section Trade-BlobImporter-behavior Behavior and limitations
+
+When the file is opened with @ref openMemory(), for example with a
+memory-mapped file from @relativeref{Corrade,Utility::Path::mapRead()}, the
+@ref MeshData and @ref SceneData instances returned from @ref mesh() and
+@ref scene() reference the memory directly, with
+@ref DataFlag::ExternallyOwned set on the index, vertex and scene data, and no
+data is copied. It's the user responsibility to keep the memory alive and
+unchanged for as long as the returned instances are used. If the memory isn't
+aligned to 8 bytes, it's copied to an internal buffer on opening.
+
+When opened with @ref openData() or @ref openFile(), the data are kept in an
+internal buffer and every @ref mesh() and @ref scene() call returns a copy of
+the index, vertex and scene data with @ref DataFlag::Owned and
+@ref DataFlag::Mutable set. Attribute and field metadata are always allocated.
+
+The file consists of a sequence of chunks, each starting with a header
+containing a `MGNB` signature, a version, an endianness marker, a chunk type
+and a chunk size. Every chunk and every data region inside it is aligned to 8
+bytes, which means files can be simply concatenated. Each mesh chunk is
+imported as a separate mesh and each scene chunk as a separate scene, in the
+order they appear in the file. Chunks of unknown type are skipped to allow
+forward compatibility.
+
+Only the chunk headers are checked in @ref openData(), the mesh and scene
+metadata get checked on every @ref mesh() and @ref scene() call --- data
+regions and index, attribute and field views are checked to be in bounds and
+enum values in valid ranges and consistent with each other. Files with a
+different version or endianness than the current platform are rejected.
+Consistency across fields that isn't related to memory safety, such as
+uniqueness of scene fields or matching object mapping of TRS fields, is checked
+only by assertions in the @ref SceneData constructor, as such files can't be
+produced by @ref BlobSceneConverter.
+
+The importer doesn't provide any mesh, scene or object names and
+@ref objectCount() is not implemented, use @ref SceneData::mappingBound() to
+get the object count of a particular scene.
+*/
+class MAGNUM_BLOBIMPORTER_EXPORT BlobImporter: public AbstractImporter {
+    public:
+        /** @brief Default constructor */
+        explicit BlobImporter();
+
+        /** @brief Plugin manager constructor */
+        explicit BlobImporter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin);
+
+        ~BlobImporter();
+
+    private:
+        struct State;
+
+        MAGNUM_BLOBIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
+        MAGNUM_BLOBIMPORTER_LOCAL bool doIsOpened() const override;
+        MAGNUM_BLOBIMPORTER_LOCAL void doOpenData(Containers::Array<char>&& data, DataFlags dataFlags) override;
+        MAGNUM_BLOBIMPORTER_LOCAL void doClose() override;
+
+        MAGNUM_BLOBIMPORTER_LOCAL UnsignedInt doSceneCount() const override;
+        MAGNUM_BLOBIMPORTER_LOCAL Containers::Optional<SceneData> doScene(UnsignedInt id) override;
+
+        MAGNUM_BLOBIMPORTER_LOCAL UnsignedInt doMeshCount() const override;
+        MAGNUM_BLOBIMPORTER_LOCAL Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt level) override;
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
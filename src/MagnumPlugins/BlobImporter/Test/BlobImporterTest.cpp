@@ -0,0 +1,618 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h> /** @todo remove once Debug is stream-free */
+#include <Corrade/Utility/Endianness.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AbstractSceneConverter.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+#include "MagnumPlugins/BlobImporter/BlobFormat.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct BlobImporterTest: TestSuite::Tester {
+    explicit BlobImporterTest();
+
+    void openEmpty();
+    void invalidChunk();
+    void unknownChunkSkipped();
+
+    void mesh();
+    void meshInvalid();
+    void scene();
+    void sceneInvalid();
+
+    void multipleChunks();
+    void openMemoryMisaligned();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+    PluginManager::Manager<AbstractSceneConverter> _converterManager{"nonexistent"};
+};
+
+const struct {
+    const char* name;
+    void(*patch)(Implementation::BlobChunkHeader&);
+    std::size_t size;
+    const char* message;
+} InvalidChunkData[]{
+    {"too short", nullptr, 8,
+        "expected at least 16 bytes for a chunk header but got only 8"},
+    {"invalid signature", [](Implementation::BlobChunkHeader& header) {
+            header.magic[3] = 'b';
+        }, 16,
+        "invalid chunk signature"},
+    {"unsupported version", [](Implementation::BlobChunkHeader& header) {
+            header.version = 2;
+        }, 16,
+        "unsupported chunk version 2, expected 1"},
+    {"different endianness", [](Implementation::BlobChunkHeader& header) {
+            header.endianness = Utility::Endianness::isBigEndian() ? 'L' : 'B';
+        }, 16,
+        Utility::Endianness::isBigEndian() ?
+            "expected a big-endian chunk" :
+            "expected a little-endian chunk"},
+    {"size too small", [](Implementation::BlobChunkHeader& header) {
+            header.size = 8;
+        }, 16,
+        "invalid chunk size 8 for 16 remaining bytes"},
+    {"size too large", [](Implementation::BlobChunkHeader& header) {
+            header.size = 24;
+        }, 16,
+        "invalid chunk size 24 for 16 remaining bytes"},
+    {"size misaligned", [](Implementation::BlobChunkHeader& header) {
+            header.size = 20;
+        }, 24,
+        "invalid chunk size 20 for 24 remaining bytes"},
+};
+
+/* Same as in BlobSceneConverterTest. The first index is unused to verify the
+   offset gets preserved. */
+const UnsignedShort IndexData[]{0xdead, 0, 2, 1, 1, 2, 3};
+const struct Vertex {
+    Vector3 position;
+    Vector2 textureCoordinates;
+} VertexData[]{
+    {{1.0f, 2.0f, 3.0f}, {0.0f, 0.5f}},
+    {{4.0f, 5.0f, 6.0f}, {0.5f, 1.0f}},
+    {{7.0f, 8.0f, 9.0f}, {1.0f, 0.5f}},
+    {{0.0f, 1.0f, 2.0f}, {0.5f, 0.0f}}
+};
+
+const struct SceneStorage {
+    UnsignedInt parentMapping[3];
+    Int parents[3];
+    UnsignedInt meshMapping[2];
+    UnsignedShort meshes[2];
+    Int meshMaterials[2];
+} SceneStorageData[]{{
+    {0, 1, 2},
+    {-1, 0, 0},
+    {1, 2},
+    {5, 7},
+    {3, -1}
+}};
+
+Containers::Optional<Containers::Array<char>> convertMesh(AbstractSceneConverter& converter) {
+    const Containers::StridedArrayView1D<const Vertex> vertices = VertexData;
+    return converter.convertToData(MeshData{MeshPrimitive::Triangles,
+        {}, IndexData, MeshIndexData{Containers::arrayView(IndexData).exceptPrefix(1)},
+        {}, VertexData, {
+            MeshAttributeData{MeshAttribute::Position, vertices.slice(&Vertex::position)},
+            MeshAttributeData{MeshAttribute::TextureCoordinates, vertices.slice(&Vertex::textureCoordinates)}
+        }});
+}
+
+Containers::Optional<Containers::Array<char>> convertScene(AbstractSceneConverter& converter) {
+    return converter.convertToData(SceneData{SceneMappingType::UnsignedInt, 3, {}, SceneStorageData, {
+        SceneFieldData{SceneField::Parent, Containers::arrayView(SceneStorageData->parentMapping), Containers::arrayView(SceneStorageData->parents), SceneFieldFlag::ImplicitMapping},
+        SceneFieldData{SceneField::Mesh, Containers::arrayView(SceneStorageData->meshMapping), Containers::arrayView(SceneStorageData->meshes)},
+        SceneFieldData{SceneField::MeshMaterial, Containers::arrayView(SceneStorageData->meshMapping), Containers::arrayView(SceneStorageData->meshMaterials)}
+    }});
+}
+
+const struct {
+    const char* name;
+    bool(*open)(AbstractImporter&, Containers::ArrayView<const void>);
+    DataFlags expectedDataFlags;
+} OpenMemoryData[]{
+    {"data", [](AbstractImporter& importer, Containers::ArrayView<const void> data) {
+        /* Copy to ensure the original memory isn't referenced */
+        Containers::Array<char> copy{NoInit, data.size()};
+        Utility::copy(Containers::arrayCast<const char>(data), copy);
+        return importer.openData(copy);
+    }, DataFlag::Owned|DataFlag::Mutable},
+    {"memory", [](AbstractImporter& importer, Containers::ArrayView<const void> data) {
+        return importer.openMemory(data);
+    }, DataFlag::ExternallyOwned},
+};
+
+/* The header is at offset 16, attributes at 80, index data at 128 and vertex
+   data at 144, as verified in BlobSceneConverterTest */
+const struct {
+    const char* name;
+    void(*patch)(Implementation::BlobMeshHeader&, Implementation::BlobMeshAttribute*);
+    const char* message;
+} MeshInvalidData[]{
+    {"too many attributes", [](Implementation::BlobMeshHeader& header, Implementation::BlobMeshAttribute*) {
+            header.attributeCount = 7;
+        }, "chunk of 224 bytes too short for 7 attributes"},
+    {"invalid primitive", [](Implementation::BlobMeshHeader& header, Implementation::BlobMeshAttribute*) {
+            header.primitive = 0;
+        }, "invalid primitive MeshPrimitive(0x0)"},
+    {"invalid vertex count", [](Implementation::BlobMeshHeader& header, Implementation::BlobMeshAttribute*) {
+            header.vertexCount = ~UnsignedInt{};
+        }, "invalid vertex count 4294967295"},
+    {"vertex data out of range", [](Implementation::BlobMeshHeader& header, Implementation::BlobMeshAttribute*) {
+            header.vertexDataSize = 88;
+        }, "index or vertex data are misaligned or out of range for a chunk of 224 bytes"},
+    {"index data misaligned", [](Implementation::BlobMeshHeader& header, Implementation::BlobMeshAttribute*) {
+            header.indexDataOffset = 130;
+            header.indexDataSize = 12;
+        }, "index or vertex data are misaligned or out of range for a chunk of 224 bytes"},
+    {"invalid index type", [](Implementation::BlobMeshHeader& header, Implementation::BlobMeshAttribute*) {
+            header.indexType = 0xff;
+        }, "invalid index type MeshIndexType(0xff)"},
+    {"indices out of range", [](Implementation::BlobMeshHeader& header, Implementation::BlobMeshAttribute*) {
+            header.indexCount = 7;
+        }, "7 indices are out of range for 14 bytes of index data"},
+    {"indices out of range with a negative stride", [](Implementation::BlobMeshHeader& header, Implementation::BlobMeshAttribute*) {
+            header.indexStride = -2;
+        }, "6 indices are out of range for 14 bytes of index data"},
+    {"index count for a non-indexed mesh", [](Implementation::BlobMeshHeader& header, Implementation::BlobMeshAttribute*) {
+            header.indexType = 0;
+        }, "index count specified for a non-indexed mesh"},
+    {"index data for a mesh with no indices", [](Implementation::BlobMeshHeader& header, Implementation::BlobMeshAttribute*) {
+            header.indexCount = 0;
+        }, "index data specified for a mesh with no indices"},
+    {"invalid attribute name", [](Implementation::BlobMeshHeader&, Implementation::BlobMeshAttribute* attributes) {
+            attributes[1].name = 0;
+        }, "invalid attribute 1 name Trade::MeshAttribute(0x0)"},
+    {"invalid attribute format", [](Implementation::BlobMeshHeader&, Implementation::BlobMeshAttribute* attributes) {
+            attributes[1].format = 0xcaca;
+        }, "invalid attribute 1 format VertexFormat(0xcaca)"},
+    {"incompatible attribute format", [](Implementation::BlobMeshHeader&, Implementation::BlobMeshAttribute* attributes) {
+            attributes[0].format = UnsignedInt(VertexFormat::UnsignedInt);
+        }, "VertexFormat::UnsignedInt is not a valid format for attribute 0 of type Trade::MeshAttribute::Position"},
+    {"attribute can't be an array", [](Implementation::BlobMeshHeader&, Implementation::BlobMeshAttribute* attributes) {
+            attributes[0].arraySize = 3;
+        }, "attribute 0 of type Trade::MeshAttribute::Position can't be an array"},
+    {"attribute out of range", [](Implementation::BlobMeshHeader&, Implementation::BlobMeshAttribute* attributes) {
+            attributes[1].offset = 16;
+        }, "attribute 1 is out of range for 80 bytes of vertex data"},
+};
+
+/* The header is at offset 16, fields at 48 and data at 168, as verified in
+   BlobSceneConverterTest */
+const struct {
+    const char* name;
+    void(*patch)(Implementation::BlobSceneHeader&, Implementation::BlobSceneField*);
+    const char* message;
+} SceneInvalidData[]{
+    {"too many fields", [](Implementation::BlobSceneHeader& header, Implementation::BlobSceneField*) {
+            header.fieldCount = 5;
+        }, "chunk of 216 bytes too short for 5 fields"},
+    {"invalid mapping type", [](Implementation::BlobSceneHeader& header, Implementation::BlobSceneField*) {
+            header.mappingType = 0;
+        }, "invalid mapping type Trade::SceneMappingType(0x0)"},
+    {"mapping type too small", [](Implementation::BlobSceneHeader& header, Implementation::BlobSceneField*) {
+            header.mappingType = UnsignedByte(SceneMappingType::UnsignedByte);
+            header.mappingBound = 256;
+        }, "Trade::SceneMappingType::UnsignedByte is too small for 256 objects"},
+    {"data out of range", [](Implementation::BlobSceneHeader& header, Implementation::BlobSceneField*) {
+            header.dataSize = 56;
+        }, "data of 56 bytes at offset 168 are misaligned or out of range for a chunk of 216 bytes"},
+    {"invalid field name", [](Implementation::BlobSceneHeader&, Implementation::BlobSceneField* fields) {
+            fields[2].name = 0;
+        }, "invalid field 2 name Trade::SceneField(0x0)"},
+    {"invalid field type", [](Implementation::BlobSceneHeader&, Implementation::BlobSceneField* fields) {
+            fields[1].type = 0xcaca;
+        }, "invalid field 1 type Trade::SceneFieldType(0xcaca)"},
+    {"pointer field type", [](Implementation::BlobSceneHeader&, Implementation::BlobSceneField* fields) {
+            fields[1].type = UnsignedShort(SceneFieldType::Pointer);
+        }, "field 1 has an unsupported type Trade::SceneFieldType::Pointer"},
+    {"incompatible field type", [](Implementation::BlobSceneHeader&, Implementation::BlobSceneField* fields) {
+            fields[0].type = UnsignedShort(SceneFieldType::Float);
+        }, "Trade::SceneFieldType::Float is not a valid type for field 0 of type Trade::SceneField::Parent"},
+    {"field can't be an array", [](Implementation::BlobSceneHeader&, Implementation::BlobSceneField* fields) {
+            fields[0].arraySize = 2;
+        }, "field 0 of type Trade::SceneField::Parent can't be an array"},
+    {"invalid field flags", [](Implementation::BlobSceneHeader&, Implementation::BlobSceneField* fields) {
+            fields[0].flags = UnsignedByte(SceneFieldFlag::OffsetOnly);
+        }, "invalid field 0 flags Trade::SceneFieldFlag::OffsetOnly"},
+    {"mapping out of range", [](Implementation::BlobSceneHeader&, Implementation::BlobSceneField* fields) {
+            fields[1].mappingStride = 20;
+        }, "field 1 is out of range for 44 bytes of scene data"},
+    {"field out of range", [](Implementation::BlobSceneHeader&, Implementation::BlobSceneField* fields) {
+            fields[2].fieldOffset = 40;
+        }, "field 2 is out of range for 44 bytes of scene data"},
+    {"duplicate field", [](Implementation::BlobSceneHeader&, Implementation::BlobSceneField* fields) {
+            fields[2].name = UnsignedInt(SceneField::Mesh);
+            fields[2].type = UnsignedShort(SceneFieldType::UnsignedInt);
+        }, "duplicate field Trade::SceneField::Mesh"},
+    {"mixed 2D and 3D transformation fields", [](Implementation::BlobSceneHeader&, Implementation::BlobSceneField* fields) {
+            fields[0].name = UnsignedInt(SceneField::Translation);
+            fields[0].type = UnsignedShort(SceneFieldType::Vector3);
+            /* Same mapping as the translation to not fail on that */
+            fields[1].name = UnsignedInt(SceneField::Rotation);
+            fields[1].type = UnsignedShort(SceneFieldType::Complex);
+            fields[1].size = 3;
+            fields[1].mappingOffset = 0;
+        }, "expected a 3D field 1 of type Trade::SceneField::Rotation but got Trade::SceneFieldType::Complex"},
+    {"skin without a transformation", [](Implementation::BlobSceneHeader&, Implementation::BlobSceneField* fields) {
+            fields[1].name = UnsignedInt(SceneField::Skin);
+        }, "a skin field requires some transformation field to be present"},
+    {"TRS mapping mismatch", [](Implementation::BlobSceneHeader&, Implementation::BlobSceneField* fields) {
+            fields[0].name = UnsignedInt(SceneField::Translation);
+            fields[0].type = UnsignedShort(SceneFieldType::Vector2);
+            fields[1].name = UnsignedInt(SceneField::Rotation);
+            fields[1].type = UnsignedShort(SceneFieldType::Complex);
+        }, "Trade::SceneField::Rotation mapping doesn't match Trade::SceneField::Translation"},
+    {"mesh and material mapping mismatch", [](Implementation::BlobSceneHeader&, Implementation::BlobSceneField* fields) {
+            fields[2].size = 1;
+        }, "Trade::SceneField::MeshMaterial mapping doesn't match Trade::SceneField::Mesh"},
+};
+
+BlobImporterTest::BlobImporterTest() {
+    addTests({&BlobImporterTest::openEmpty});
+
+    addInstancedTests({&BlobImporterTest::invalidChunk},
+        Containers::arraySize(InvalidChunkData));
+
+    addTests({&BlobImporterTest::unknownChunkSkipped});
+
+    addInstancedTests({&BlobImporterTest::mesh},
+        Containers::arraySize(OpenMemoryData));
+
+    addInstancedTests({&BlobImporterTest::meshInvalid},
+        Containers::arraySize(MeshInvalidData));
+
+    addInstancedTests({&BlobImporterTest::scene},
+        Containers::arraySize(OpenMemoryData));
+
+    addInstancedTests({&BlobImporterTest::sceneInvalid},
+        Containers::arraySize(SceneInvalidData));
+
+    addTests({&BlobImporterTest::multipleChunks,
+              &BlobImporterTest::openMemoryMisaligned});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef BLOBIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(BLOBIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+    /* Optional plugins that don't have to be here */
+    #ifdef BLOBSCENECONVERTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_converterManager.load(BLOBSCENECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void BlobImporterTest::openEmpty() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("BlobImporter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    char a{};
+    /* Explicitly checking non-null but empty view */
+    CORRADE_VERIFY(!importer->openData({&a, 0}));
+    CORRADE_COMPARE(out.str(), "Trade::BlobImporter::openData(): the file is empty\n");
+}
+
+void BlobImporterTest::invalidChunk() {
+    auto&& data = InvalidChunkData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("BlobImporter");
+
+    /* An unknown chunk type, which would be otherwise skipped */
+    Implementation::BlobChunkHeader headers[2]{};
+    Implementation::BlobChunkHeader& header = headers[0];
+    header.magic[0] = 'M';
+    header.magic[1] = 'G';
+    header.magic[2] = 'N';
+    header.magic[3] = 'B';
+    header.version = Implementation::BlobVersion;
+    header.endianness = Utility::Endianness::isBigEndian() ? 'B' : 'L';
+    header.type = 0xffff;
+    header.size = sizeof(Implementation::BlobChunkHeader);
+    if(data.patch) data.patch(header);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(Containers::arrayCast<const char>(Containers::arrayView(headers)).prefix(data.size)));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::BlobImporter::openData(): {}\n", data.message));
+}
+
+void BlobImporterTest::unknownChunkSkipped() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("BlobImporter");
+
+    Implementation::BlobChunkHeader header{};
+    header.magic[0] = 'M';
+    header.magic[1] = 'G';
+    header.magic[2] = 'N';
+    header.magic[3] = 'B';
+    header.version = Implementation::BlobVersion;
+    header.endianness = Utility::Endianness::isBigEndian() ? 'B' : 'L';
+    header.type = 0xffff;
+    header.size = sizeof(Implementation::BlobChunkHeader);
+
+    CORRADE_VERIFY(importer->openData(Containers::arrayView(reinterpret_cast<const char*>(&header), sizeof(header))));
+    CORRADE_COMPARE(importer->meshCount(), 0);
+    CORRADE_COMPARE(importer->sceneCount(), 0);
+}
+
+void BlobImporterTest::mesh() {
+    auto&& data = OpenMemoryData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!(_converterManager.loadState("BlobSceneConverter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("BlobSceneConverter plugin not enabled, can't test");
+
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("BlobSceneConverter");
+    Containers::Optional<Containers::Array<char>> blob = convertMesh(*converter);
+    CORRADE_VERIFY(blob);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("BlobImporter");
+    CORRADE_VERIFY(data.open(*importer, *blob));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+    CORRADE_COMPARE(importer->sceneCount(), 0);
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indexDataFlags(), data.expectedDataFlags);
+    CORRADE_COMPARE(mesh->vertexDataFlags(), data.expectedDataFlags);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+
+    CORRADE_VERIFY(mesh->isIndexed());
+    CORRADE_COMPARE(mesh->indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(mesh->indexOffset(), 2);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedShort>(),
+        Containers::arrayView(IndexData).exceptPrefix(1),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(mesh->vertexCount(), 4);
+    CORRADE_COMPARE(mesh->attributeCount(), 2);
+    CORRADE_COMPARE(mesh->attributeName(0), MeshAttribute::Position);
+    CORRADE_COMPARE(mesh->attributeFormat(0), VertexFormat::Vector3);
+    CORRADE_COMPARE(mesh->attributeOffset(0), 0);
+    CORRADE_COMPARE(mesh->attributeStride(0), sizeof(Vertex));
+    CORRADE_COMPARE(mesh->attributeName(1), MeshAttribute::TextureCoordinates);
+    CORRADE_COMPARE(mesh->attributeFormat(1), VertexFormat::Vector2);
+    CORRADE_COMPARE(mesh->attributeOffset(1), sizeof(Vector3));
+    CORRADE_COMPARE(mesh->attributeStride(1), sizeof(Vertex));
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::stridedArrayView(VertexData).slice(&Vertex::position),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        Containers::stridedArrayView(VertexData).slice(&Vertex::textureCoordinates),
+        TestSuite::Compare::Container);
+
+    /* With openMemory() the data are referenced directly */
+    if(data.expectedDataFlags & DataFlag::ExternallyOwned) {
+        CORRADE_VERIFY(mesh->indexData().data() == blob->data() + 128);
+        CORRADE_VERIFY(mesh->vertexData().data() == blob->data() + 144);
+    } else {
+        CORRADE_VERIFY(mesh->indexData().data() != blob->data() + 128);
+        CORRADE_VERIFY(mesh->vertexData().data() != blob->data() + 144);
+    }
+}
+
+void BlobImporterTest::meshInvalid() {
+    auto&& data = MeshInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!(_converterManager.loadState("BlobSceneConverter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("BlobSceneConverter plugin not enabled, can't test");
+
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("BlobSceneConverter");
+    Containers::Optional<Containers::Array<char>> blob = convertMesh(*converter);
+    CORRADE_VERIFY(blob);
+    CORRADE_COMPARE(blob->size(), 224);
+
+    data.patch(
+        *reinterpret_cast<Implementation::BlobMeshHeader*>(blob->data() + sizeof(Implementation::BlobChunkHeader)),
+        reinterpret_cast<Implementation::BlobMeshAttribute*>(blob->data() + sizeof(Implementation::BlobChunkHeader) + sizeof(Implementation::BlobMeshHeader)));
+
+    /* The chunk itself is still valid, the contents get checked only when
+       importing */
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("BlobImporter");
+    CORRADE_VERIFY(importer->openData(*blob));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::BlobImporter::mesh(): {}\n", data.message));
+}
+
+void BlobImporterTest::scene() {
+    auto&& data = OpenMemoryData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!(_converterManager.loadState("BlobSceneConverter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("BlobSceneConverter plugin not enabled, can't test");
+
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("BlobSceneConverter");
+    Containers::Optional<Containers::Array<char>> blob = convertScene(*converter);
+    CORRADE_VERIFY(blob);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("BlobImporter");
+    CORRADE_VERIFY(data.open(*importer, *blob));
+    CORRADE_COMPARE(importer->meshCount(), 0);
+    CORRADE_COMPARE(importer->sceneCount(), 1);
+
+    Containers::Optional<SceneData> scene = importer->scene(0);
+    CORRADE_VERIFY(scene);
+    CORRADE_COMPARE(scene->dataFlags(), data.expectedDataFlags);
+    CORRADE_COMPARE(scene->mappingType(), SceneMappingType::UnsignedInt);
+    CORRADE_COMPARE(scene->mappingBound(), 3);
+    CORRADE_COMPARE(scene->fieldCount(), 3);
+
+    CORRADE_COMPARE(scene->fieldName(0), SceneField::Parent);
+    CORRADE_COMPARE(scene->fieldType(0), SceneFieldType::Int);
+    CORRADE_COMPARE(scene->fieldFlags(0), SceneFieldFlag::OffsetOnly|SceneFieldFlag::ImplicitMapping);
+    CORRADE_COMPARE_AS(scene->mapping<UnsignedInt>(0),
+        Containers::arrayView(SceneStorageData->parentMapping),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene->field<Int>(0),
+        Containers::arrayView(SceneStorageData->parents),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(scene->fieldName(1), SceneField::Mesh);
+    CORRADE_COMPARE(scene->fieldType(1), SceneFieldType::UnsignedShort);
+    CORRADE_COMPARE(scene->fieldFlags(1), SceneFieldFlag::OffsetOnly);
+    CORRADE_COMPARE_AS(scene->mapping<UnsignedInt>(1),
+        Containers::arrayView(SceneStorageData->meshMapping),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene->field<UnsignedShort>(1),
+        Containers::arrayView(SceneStorageData->meshes),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(scene->fieldName(2), SceneField::MeshMaterial);
+    CORRADE_COMPARE(scene->fieldType(2), SceneFieldType::Int);
+    CORRADE_COMPARE_AS(scene->mapping<UnsignedInt>(2),
+        Containers::arrayView(SceneStorageData->meshMapping),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene->field<Int>(2),
+        Containers::arrayView(SceneStorageData->meshMaterials),
+        TestSuite::Compare::Container);
+
+    /* With openMemory() the data are referenced directly */
+    if(data.expectedDataFlags & DataFlag::ExternallyOwned)
+        CORRADE_VERIFY(scene->data().data() == blob->data() + 168);
+    else
+        CORRADE_VERIFY(scene->data().data() != blob->data() + 168);
+}
+
+void BlobImporterTest::sceneInvalid() {
+    auto&& data = SceneInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!(_converterManager.loadState("BlobSceneConverter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("BlobSceneConverter plugin not enabled, can't test");
+
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("BlobSceneConverter");
+    Containers::Optional<Containers::Array<char>> blob = convertScene(*converter);
+    CORRADE_VERIFY(blob);
+    CORRADE_COMPARE(blob->size(), 216);
+
+    data.patch(
+        *reinterpret_cast<Implementation::BlobSceneHeader*>(blob->data() + sizeof(Implementation::BlobChunkHeader)),
+        reinterpret_cast<Implementation::BlobSceneField*>(blob->data() + sizeof(Implementation::BlobChunkHeader) + sizeof(Implementation::BlobSceneHeader)));
+
+    /* The chunk itself is still valid, the contents get checked only when
+       importing */
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("BlobImporter");
+    CORRADE_VERIFY(importer->openData(*blob));
+    CORRADE_COMPARE(importer->sceneCount(), 1);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->scene(0));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::BlobImporter::scene(): {}\n", data.message));
+}
+
+void BlobImporterTest::multipleChunks() {
+    if(!(_converterManager.loadState("BlobSceneConverter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("BlobSceneConverter plugin not enabled, can't test");
+
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("BlobSceneConverter");
+    Containers::Optional<Containers::Array<char>> meshBlob = convertMesh(*converter);
+    Containers::Optional<Containers::Array<char>> sceneBlob = convertScene(*converter);
+    CORRADE_VERIFY(meshBlob);
+    CORRADE_VERIFY(sceneBlob);
+
+    /* Chunk sizes are always a multiple of the alignment, so the chunks can
+       be simply concatenated */
+    Containers::Array<char> blob{NoInit, 2*meshBlob->size() + sceneBlob->size()};
+    Utility::copy(*meshBlob, blob.prefix(meshBlob->size()));
+    Utility::copy(*sceneBlob, blob.slice(meshBlob->size(), meshBlob->size() + sceneBlob->size()));
+    Utility::copy(*meshBlob, blob.exceptPrefix(meshBlob->size() + sceneBlob->size()));
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("BlobImporter");
+    CORRADE_VERIFY(importer->openMemory(blob));
+    CORRADE_COMPARE(importer->meshCount(), 2);
+    CORRADE_COMPARE(importer->sceneCount(), 1);
+
+    Containers::Optional<MeshData> mesh1 = importer->mesh(1);
+    CORRADE_VERIFY(mesh1);
+    CORRADE_COMPARE(mesh1->vertexData().data(), blob.data() + meshBlob->size() + sceneBlob->size() + 144);
+    CORRADE_COMPARE_AS(mesh1->attribute<Vector3>(MeshAttribute::Position),
+        Containers::stridedArrayView(VertexData).slice(&Vertex::position),
+        TestSuite::Compare::Container);
+
+    Containers::Optional<SceneData> scene = importer->scene(0);
+    CORRADE_VERIFY(scene);
+    CORRADE_COMPARE(scene->data().data(), blob.data() + meshBlob->size() + 168);
+    CORRADE_COMPARE_AS(scene->field<Int>(SceneField::Parent),
+        Containers::arrayView(SceneStorageData->parents),
+        TestSuite::Compare::Container);
+}
+
+void BlobImporterTest::openMemoryMisaligned() {
+    if(!(_converterManager.loadState("BlobSceneConverter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("BlobSceneConverter plugin not enabled, can't test");
+
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("BlobSceneConverter");
+    Containers::Optional<Containers::Array<char>> meshBlob = convertMesh(*converter);
+    CORRADE_VERIFY(meshBlob);
+
+    /* Shift the data by one byte so they're not aligned anymore */
+    Containers::Array<char> blob{NoInit, meshBlob->size() + 1};
+    Utility::copy(*meshBlob, blob.exceptPrefix(1));
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("BlobImporter");
+    CORRADE_VERIFY(importer->openMemory(blob.exceptPrefix(1)));
+
+    /* The data get copied and thus are owned by the mesh */
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedShort>(),
+        Containers::arrayView(IndexData).exceptPrefix(1),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        Containers::stridedArrayView(VertexData).slice(&Vertex::textureCoordinates),
+        TestSuite::Compare::Container);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::BlobImporterTest)
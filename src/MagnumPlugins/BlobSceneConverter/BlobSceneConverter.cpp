@@ -0,0 +1,188 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BlobSceneConverter.h"
+
+#include <cstring>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Endianness.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+#include "MagnumPlugins/BlobImporter/BlobFormat.h"
+
+namespace Magnum { namespace Trade {
+
+BlobSceneConverter::BlobSceneConverter() = default;
+
+BlobSceneConverter::BlobSceneConverter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): AbstractSceneConverter{manager, plugin} {}
+
+BlobSceneConverter::~BlobSceneConverter() = default;
+
+SceneConverterFeatures BlobSceneConverter::doFeatures() const {
+    return SceneConverterFeature::ConvertMeshToData|SceneConverterFeature::ConvertSceneToData;
+}
+
+namespace {
+
+std::size_t alignedOffset(const std::size_t offset) {
+    return (offset + Implementation::BlobAlignment - 1)/Implementation::BlobAlignment*Implementation::BlobAlignment;
+}
+
+void writeChunkHeader(const Containers::ArrayView<char> out, const Implementation::BlobChunkType type) {
+    auto& header = *reinterpret_cast<Implementation::BlobChunkHeader*>(out.data());
+    std::memcpy(header.magic, "MGNB", 4);
+    header.version = Implementation::BlobVersion;
+    header.endianness = Utility::Endianness::isBigEndian() ? 'B' : 'L';
+    header.type = UnsignedShort(type);
+    header.size = out.size();
+}
+
+}
+
+Containers::Optional<Containers::Array<char>> BlobSceneConverter::doConvertToData(const MeshData& mesh) {
+    /* The importer needs to know the index and attribute sizes in order to
+       check the ranges */
+    if(mesh.isIndexed() && isMeshIndexTypeImplementationSpecific(mesh.indexType())) {
+        Error{} << "Trade::BlobSceneConverter::convertToData(): implementation-specific index type" << mesh.indexType() << "can't be saved";
+        return {};
+    }
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        if(isVertexFormatImplementationSpecific(mesh.attributeFormat(i))) {
+            Error{} << "Trade::BlobSceneConverter::convertToData(): implementation-specific format" << mesh.attributeFormat(i) << "of attribute" << i << "can't be saved";
+            return {};
+        }
+    }
+
+    const Containers::ArrayView<const char> indexData = mesh.indexData();
+    const Containers::ArrayView<const char> vertexData = mesh.vertexData();
+
+    /* The header sizes are all multiples of 8, so the index data offset is
+       aligned already */
+    const std::size_t indexDataOffset = sizeof(Implementation::BlobChunkHeader) + sizeof(Implementation::BlobMeshHeader) + mesh.attributeCount()*sizeof(Implementation::BlobMeshAttribute);
+    const std::size_t vertexDataOffset = alignedOffset(indexDataOffset + indexData.size());
+    Containers::Array<char> out{ValueInit, alignedOffset(vertexDataOffset + vertexData.size())};
+    writeChunkHeader(out, Implementation::BlobChunkType::Mesh);
+
+    auto& header = *reinterpret_cast<Implementation::BlobMeshHeader*>(out.data() + sizeof(Implementation::BlobChunkHeader));
+    header.primitive = UnsignedInt(mesh.primitive());
+    if(mesh.isIndexed()) {
+        header.indexType = UnsignedInt(mesh.indexType());
+        header.indexCount = mesh.indexCount();
+        header.indexStride = mesh.indexStride();
+        /* With no indices the view can point anywhere */
+        header.indexOffset = mesh.indexCount() ? mesh.indexOffset() : 0;
+    }
+    header.vertexCount = mesh.vertexCount();
+    header.attributeCount = mesh.attributeCount();
+    header.indexDataOffset = indexDataOffset;
+    header.indexDataSize = indexData.size();
+    header.vertexDataOffset = vertexDataOffset;
+    header.vertexDataSize = vertexData.size();
+
+    auto* const attributes = reinterpret_cast<Implementation::BlobMeshAttribute*>(out.data() + sizeof(Implementation::BlobChunkHeader) + sizeof(Implementation::BlobMeshHeader));
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        attributes[i].format = UnsignedInt(mesh.attributeFormat(i));
+        attributes[i].name = UnsignedShort(mesh.attributeName(i));
+        attributes[i].arraySize = mesh.attributeArraySize(i);
+        attributes[i].stride = mesh.attributeStride(i);
+        /* With no vertices the attributes can point anywhere */
+        attributes[i].offset = mesh.vertexCount() ? mesh.attributeOffset(i) : 0;
+    }
+
+    Utility::copy(indexData, out.slice(indexDataOffset, indexDataOffset + indexData.size()));
+    Utility::copy(vertexData, out.slice(vertexDataOffset, vertexDataOffset + vertexData.size()));
+
+    /* GCC 4.8 needs extra help here */
+    return Containers::optional(std::move(out));
+}
+
+Containers::Optional<Containers::Array<char>> BlobSceneConverter::doConvertToData(const SceneData& scene) {
+    /* Pointers have no meaning outside of the process, skip such fields */
+    Containers::Array<UnsignedInt> fieldIds;
+    arrayReserve(fieldIds, scene.fieldCount());
+    for(UnsignedInt i = 0; i != scene.fieldCount(); ++i) {
+        const SceneFieldType type = scene.fieldType(i);
+        if(type == SceneFieldType::Pointer || type == SceneFieldType::MutablePointer) {
+            Warning{} << "Trade::BlobSceneConverter::convertToData(): skipping field" << scene.fieldName(i) << "of type" << type;
+            continue;
+        }
+
+        arrayAppend(fieldIds, i);
+    }
+
+    const Containers::ArrayView<const char> data = scene.data();
+
+    /* The header sizes are all multiples of 8, so the data offset is aligned
+       already */
+    const std::size_t dataOffset = sizeof(Implementation::BlobChunkHeader) + sizeof(Implementation::BlobSceneHeader) + fieldIds.size()*sizeof(Implementation::BlobSceneField);
+    Containers::Array<char> out{ValueInit, alignedOffset(dataOffset + data.size())};
+    writeChunkHeader(out, Implementation::BlobChunkType::Scene);
+
+    auto& header = *reinterpret_cast<Implementation::BlobSceneHeader*>(out.data() + sizeof(Implementation::BlobChunkHeader));
+    header.mappingBound = scene.mappingBound();
+    header.dataOffset = dataOffset;
+    header.dataSize = data.size();
+    header.fieldCount = fieldIds.size();
+    header.mappingType = UnsignedByte(scene.mappingType());
+
+    auto* const fields = reinterpret_cast<Implementation::BlobSceneField*>(out.data() + sizeof(Implementation::BlobChunkHeader) + sizeof(Implementation::BlobSceneHeader));
+    for(std::size_t i = 0; i != fieldIds.size(); ++i) {
+        const UnsignedInt id = fieldIds[i];
+        Implementation::BlobSceneField& field = fields[i];
+        field.name = UnsignedInt(scene.fieldName(id));
+        field.type = UnsignedShort(scene.fieldType(id));
+        field.arraySize = scene.fieldArraySize(id);
+        field.size = scene.fieldSize(id);
+        /* The importer always creates offset-only fields */
+        field.flags = UnsignedByte(scene.fieldFlags(id) & ~SceneFieldFlag::OffsetOnly);
+
+        /* With no entries the views can point anywhere, keep the offsets and
+           strides zero in that case */
+        if(!field.size) continue;
+
+        const Containers::StridedArrayView2D<const char> mapping = scene.mapping(id);
+        const Containers::StridedArrayView2D<const char> fieldData = scene.field(id);
+        field.mappingOffset = static_cast<const char*>(mapping.data()) - data.data();
+        field.mappingStride = Short(mapping.stride()[0]);
+        field.fieldOffset = static_cast<const char*>(fieldData.data()) - data.data();
+        field.fieldStride = Short(fieldData.stride()[0]);
+    }
+
+    Utility::copy(data, out.slice(dataOffset, dataOffset + data.size()));
+
+    /* GCC 4.8 needs extra help here */
+    return Containers::optional(std::move(out));
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(BlobSceneConverter, Magnum::Trade::BlobSceneConverter,
+    "cz.mosra.magnum.Trade.AbstractSceneConverter/0.1.3")
@@ -0,0 +1,129 @@
+#ifndef Magnum_Trade_BlobSceneConverter_h
+#define Magnum_Trade_BlobSceneConverter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::BlobSceneConverter
+ * @m_since_latest
+ */
+
+#include "Magnum/Trade/AbstractSceneConverter.h"
+#include "MagnumPlugins/BlobSceneConverter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_BLOBSCENECONVERTER_BUILD_STATIC
+    #ifdef BlobSceneConverter_EXPORTS
+        #define MAGNUM_BLOBSCENECONVERTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_BLOBSCENECONVERTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_BLOBSCENECONVERTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_BLOBSCENECONVERTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_BLOBSCENECONVERTER_EXPORT
+#define MAGNUM_BLOBSCENECONVERTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Magnum blob scene converter plugin
+@m_since_latest
+
+Saves a @ref MeshData or a @ref SceneData to the Magnum blob format
+(`*.blob`), which can be imported back with @ref BlobImporter without any
+parsing or copying. See the @ref Trade-BlobImporter-behavior "BlobImporter documentation"
+for details about the format.
+
+@section Trade-BlobSceneConverter-usage Usage
+
+This plugin depends on the @ref Trade library and is built if
+`MAGNUM_WITH_BLOBSCENECONVERTER` is enabled when building Magnum. To use as a
+dynamic plugin, load @cpp "BlobSceneConverter" @ce via
+@ref Corrade::PluginManager::Manager.
+
+Additionally, if you're using Magnum as a CMake subproject, do the following:
+
+@code{.cmake}
+set(MAGNUM_WITH_BLOBSCENECONVERTER ON CACHE BOOL "" FORCE)
+add_subdirectory(magnum EXCLUDE_FROM_ALL)
+
+# So the dynamically loaded plugin gets built implicitly
+add_dependencies(your-app Magnum::BlobSceneConverter)
+@endcode
+
+To use as a static plugin or use this as a dependency of another plugin with
+CMake, you need to request the `BlobSceneConverter` component of the `Magnum`
+package and link to the `Magnum::BlobSceneConverter` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED BlobSceneConverter)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::BlobSceneConverter)
+@endcode
+
+See @ref building, @ref cmake, @ref plugins and @ref file-formats for more
+information.
+
+@section Trade-BlobSceneConverter-behavior Behavior and limitations
+
+The index, vertex and scene data are copied to the output as-is, including any
+padding or unreferenced bytes, only placed at an offset aligned to 8 bytes.
+Because of that, the data are expected to have their original alignment
+relative to the beginning of @ref MeshData::indexData(),
+@ref MeshData::vertexData() or @ref SceneData::data(), which is always the
+case for data allocated with the default allocator. The output is stored in
+the endianness of the current platform. Output of multiple conversions can be
+concatenated together to form a file with multiple meshes and scenes.
+
+Meshes with implementation-specific index types or vertex formats can't be
+saved, as their size isn't known. Scene fields of
+@ref SceneFieldType::Pointer and @relativeref{SceneFieldType,MutablePointer}
+types are skipped with a warning, as pointers can't be meaningfully stored in
+a file. Importer state and names are not saved.
+*/
+class MAGNUM_BLOBSCENECONVERTER_EXPORT BlobSceneConverter: public AbstractSceneConverter {
+    public:
+        /** @brief Default constructor */
+        explicit BlobSceneConverter();
+
+        /** @brief Plugin manager constructor */
+        explicit BlobSceneConverter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin);
+
+        ~BlobSceneConverter();
+
+    private:
+        MAGNUM_BLOBSCENECONVERTER_LOCAL SceneConverterFeatures doFeatures() const override;
+        MAGNUM_BLOBSCENECONVERTER_LOCAL Containers::Optional<Containers::Array<char>> doConvertToData(const MeshData& mesh) override;
+        MAGNUM_BLOBSCENECONVERTER_LOCAL Containers::Optional<Containers::Array<char>> doConvertToData(const SceneData& scene) override;
+};
+
+}}
+
+#endif
@@ -0,0 +1,318 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h> /** @todo remove once Debug is stream-free */
+#include <Corrade/Utility/Endianness.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/AbstractSceneConverter.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+#include "MagnumPlugins/BlobImporter/BlobFormat.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct BlobSceneConverterTest: TestSuite::Tester {
+    explicit BlobSceneConverterTest();
+
+    void mesh();
+    void meshNotIndexed();
+    void meshImplementationSpecificIndexType();
+    void meshImplementationSpecificVertexFormat();
+
+    void scene();
+    void scenePointerField();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractSceneConverter> _manager{"nonexistent"};
+};
+
+BlobSceneConverterTest::BlobSceneConverterTest() {
+    addTests({&BlobSceneConverterTest::mesh,
+              &BlobSceneConverterTest::meshNotIndexed,
+              &BlobSceneConverterTest::meshImplementationSpecificIndexType,
+              &BlobSceneConverterTest::meshImplementationSpecificVertexFormat,
+
+              &BlobSceneConverterTest::scene,
+              &BlobSceneConverterTest::scenePointerField});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef BLOBSCENECONVERTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(BLOBSCENECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void BlobSceneConverterTest::mesh() {
+    Containers::Pointer<AbstractSceneConverter> converter = _manager.instantiate("BlobSceneConverter");
+    CORRADE_COMPARE(converter->features(), SceneConverterFeature::ConvertMeshToData|SceneConverterFeature::ConvertSceneToData);
+
+    /* The first index is unused to verify the offset gets preserved */
+    const UnsignedShort indexData[]{0xdead, 0, 2, 1, 1, 2, 3};
+    const struct Vertex {
+        Vector3 position;
+        Vector2 textureCoordinates;
+    } vertexData[]{
+        {{1.0f, 2.0f, 3.0f}, {0.0f, 0.5f}},
+        {{4.0f, 5.0f, 6.0f}, {0.5f, 1.0f}},
+        {{7.0f, 8.0f, 9.0f}, {1.0f, 0.5f}},
+        {{0.0f, 1.0f, 2.0f}, {0.5f, 0.0f}}
+    };
+    const Containers::StridedArrayView1D<const Vertex> vertices = vertexData;
+
+    Containers::Optional<Containers::Array<char>> out = converter->convertToData(MeshData{MeshPrimitive::Triangles,
+        {}, indexData, MeshIndexData{Containers::arrayView(indexData).exceptPrefix(1)},
+        {}, vertexData, {
+            MeshAttributeData{MeshAttribute::Position, vertices.slice(&Vertex::position)},
+            MeshAttributeData{MeshAttribute::TextureCoordinates, vertices.slice(&Vertex::textureCoordinates)}
+        }});
+    CORRADE_VERIFY(out);
+    /* 16 + 64 + 2*24 bytes of headers, 14 bytes of index data padded to 16,
+       80 bytes of vertex data */
+    CORRADE_COMPARE(out->size(), 224);
+
+    const auto& chunk = *reinterpret_cast<const Implementation::BlobChunkHeader*>(out->data());
+    CORRADE_COMPARE((Containers::StringView{chunk.magic, 4}), "MGNB");
+    CORRADE_COMPARE(chunk.version, 1);
+    CORRADE_COMPARE(chunk.endianness, Utility::Endianness::isBigEndian() ? 'B' : 'L');
+    CORRADE_COMPARE(chunk.type, UnsignedShort(Implementation::BlobChunkType::Mesh));
+    CORRADE_COMPARE(chunk.size, 224);
+
+    const auto& header = *reinterpret_cast<const Implementation::BlobMeshHeader*>(out->data() + sizeof(Implementation::BlobChunkHeader));
+    CORRADE_COMPARE(MeshPrimitive(header.primitive), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(MeshIndexType(header.indexType), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(header.indexCount, 6);
+    CORRADE_COMPARE(header.indexStride, 2);
+    CORRADE_COMPARE(header.indexOffset, 2);
+    CORRADE_COMPARE(header.vertexCount, 4);
+    CORRADE_COMPARE(header.attributeCount, 2);
+    CORRADE_COMPARE(header.indexDataOffset, 128);
+    CORRADE_COMPARE(header.indexDataSize, 14);
+    CORRADE_COMPARE(header.vertexDataOffset, 144);
+    CORRADE_COMPARE(header.vertexDataSize, 80);
+
+    const auto* attributes = reinterpret_cast<const Implementation::BlobMeshAttribute*>(out->data() + sizeof(Implementation::BlobChunkHeader) + sizeof(Implementation::BlobMeshHeader));
+    CORRADE_COMPARE(MeshAttribute(attributes[0].name), MeshAttribute::Position);
+    CORRADE_COMPARE(VertexFormat(attributes[0].format), VertexFormat::Vector3);
+    CORRADE_COMPARE(attributes[0].arraySize, 0);
+    CORRADE_COMPARE(attributes[0].offset, 0);
+    CORRADE_COMPARE(attributes[0].stride, 20);
+    CORRADE_COMPARE(MeshAttribute(attributes[1].name), MeshAttribute::TextureCoordinates);
+    CORRADE_COMPARE(VertexFormat(attributes[1].format), VertexFormat::Vector2);
+    CORRADE_COMPARE(attributes[1].arraySize, 0);
+    CORRADE_COMPARE(attributes[1].offset, 12);
+    CORRADE_COMPARE(attributes[1].stride, 20);
+
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedShort>(out->slice(128, 142)),
+        Containers::arrayView(indexData),
+        TestSuite::Compare::Container);
+    const Containers::StridedArrayView1D<const Vertex> outVertices = Containers::arrayCast<const Vertex>(out->slice(144, 224));
+    CORRADE_COMPARE_AS(outVertices.slice(&Vertex::position),
+        vertices.slice(&Vertex::position),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(outVertices.slice(&Vertex::textureCoordinates),
+        vertices.slice(&Vertex::textureCoordinates),
+        TestSuite::Compare::Container);
+}
+
+void BlobSceneConverterTest::meshNotIndexed() {
+    Containers::Pointer<AbstractSceneConverter> converter = _manager.instantiate("BlobSceneConverter");
+
+    const Vector3 positions[]{
+        {1.0f, 2.0f, 3.0f},
+        {4.0f, 5.0f, 6.0f},
+        {7.0f, 8.0f, 9.0f}
+    };
+
+    Containers::Optional<Containers::Array<char>> out = converter->convertToData(MeshData{MeshPrimitive::Points,
+        {}, positions, {
+            MeshAttributeData{MeshAttribute::Position, Containers::arrayView(positions)}
+        }});
+    CORRADE_VERIFY(out);
+    /* 16 + 64 + 24 bytes of headers, 36 bytes of vertex data padded to 40 */
+    CORRADE_COMPARE(out->size(), 144);
+
+    const auto& header = *reinterpret_cast<const Implementation::BlobMeshHeader*>(out->data() + sizeof(Implementation::BlobChunkHeader));
+    CORRADE_COMPARE(MeshPrimitive(header.primitive), MeshPrimitive::Points);
+    CORRADE_COMPARE(header.indexType, 0);
+    CORRADE_COMPARE(header.indexCount, 0);
+    CORRADE_COMPARE(header.indexDataOffset, 104);
+    CORRADE_COMPARE(header.indexDataSize, 0);
+    CORRADE_COMPARE(header.vertexDataOffset, 104);
+    CORRADE_COMPARE(header.vertexDataSize, 36);
+    CORRADE_COMPARE(header.vertexCount, 3);
+    CORRADE_COMPARE(header.attributeCount, 1);
+}
+
+void BlobSceneConverterTest::meshImplementationSpecificIndexType() {
+    Containers::Pointer<AbstractSceneConverter> converter = _manager.instantiate("BlobSceneConverter");
+
+    const char indexData[6]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->convertToData(MeshData{MeshPrimitive::Triangles,
+        {}, indexData, MeshIndexData{meshIndexTypeWrap(0xcaca), Containers::StridedArrayView1D<const char>{indexData, 3, 2}}, 1}));
+    CORRADE_COMPARE(out.str(), "Trade::BlobSceneConverter::convertToData(): implementation-specific index type MeshIndexType::ImplementationSpecific(0xcaca) can't be saved\n");
+}
+
+void BlobSceneConverterTest::meshImplementationSpecificVertexFormat() {
+    Containers::Pointer<AbstractSceneConverter> converter = _manager.instantiate("BlobSceneConverter");
+
+    const struct Vertex {
+        Vector3 position;
+        UnsignedInt normal;
+    } vertexData[3]{};
+    const Containers::StridedArrayView1D<const Vertex> vertices = vertexData;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->convertToData(MeshData{MeshPrimitive::Triangles,
+        {}, vertexData, {
+            MeshAttributeData{MeshAttribute::Position, vertices.slice(&Vertex::position)},
+            MeshAttributeData{MeshAttribute::Normal, vertexFormatWrap(0xcaca), vertices.slice(&Vertex::normal)}
+        }}));
+    CORRADE_COMPARE(out.str(), "Trade::BlobSceneConverter::convertToData(): implementation-specific format VertexFormat::ImplementationSpecific(0xcaca) of attribute 1 can't be saved\n");
+}
+
+void BlobSceneConverterTest::scene() {
+    Containers::Pointer<AbstractSceneConverter> converter = _manager.instantiate("BlobSceneConverter");
+
+    const struct Data {
+        UnsignedInt parentMapping[3];
+        Int parents[3];
+        UnsignedInt meshMapping[2];
+        UnsignedShort meshes[2];
+        Int meshMaterials[2];
+    } data[]{{
+        {0, 1, 2},
+        {-1, 0, 0},
+        {1, 2},
+        {5, 7},
+        {3, -1}
+    }};
+
+    Containers::Optional<Containers::Array<char>> out = converter->convertToData(SceneData{SceneMappingType::UnsignedInt, 3, {}, data, {
+        SceneFieldData{SceneField::Parent, Containers::arrayView(data->parentMapping), Containers::arrayView(data->parents), SceneFieldFlag::ImplicitMapping},
+        SceneFieldData{SceneField::Mesh, Containers::arrayView(data->meshMapping), Containers::arrayView(data->meshes)},
+        SceneFieldData{SceneField::MeshMaterial, Containers::arrayView(data->meshMapping), Containers::arrayView(data->meshMaterials)}
+    }});
+    CORRADE_VERIFY(out);
+    /* 16 + 32 + 3*40 bytes of headers, 44 bytes of data padded to 48 */
+    CORRADE_COMPARE(out->size(), 216);
+
+    const auto& chunk = *reinterpret_cast<const Implementation::BlobChunkHeader*>(out->data());
+    CORRADE_COMPARE((Containers::StringView{chunk.magic, 4}), "MGNB");
+    CORRADE_COMPARE(chunk.type, UnsignedShort(Implementation::BlobChunkType::Scene));
+    CORRADE_COMPARE(chunk.size, 216);
+
+    const auto& header = *reinterpret_cast<const Implementation::BlobSceneHeader*>(out->data() + sizeof(Implementation::BlobChunkHeader));
+    CORRADE_COMPARE(header.mappingBound, 3);
+    CORRADE_COMPARE(SceneMappingType(header.mappingType), SceneMappingType::UnsignedInt);
+    CORRADE_COMPARE(header.fieldCount, 3);
+    CORRADE_COMPARE(header.dataOffset, 168);
+    CORRADE_COMPARE(header.dataSize, sizeof(Data));
+
+    const auto* fields = reinterpret_cast<const Implementation::BlobSceneField*>(out->data() + sizeof(Implementation::BlobChunkHeader) + sizeof(Implementation::BlobSceneHeader));
+    CORRADE_COMPARE(SceneField(fields[0].name), SceneField::Parent);
+    CORRADE_COMPARE(SceneFieldType(fields[0].type), SceneFieldType::Int);
+    CORRADE_COMPARE(fields[0].arraySize, 0);
+    CORRADE_COMPARE(fields[0].size, 3);
+    CORRADE_COMPARE(fields[0].mappingOffset, offsetof(Data, parentMapping));
+    CORRADE_COMPARE(fields[0].mappingStride, 4);
+    CORRADE_COMPARE(fields[0].fieldOffset, offsetof(Data, parents));
+    CORRADE_COMPARE(fields[0].fieldStride, 4);
+    /* OffsetOnly isn't saved */
+    CORRADE_COMPARE(SceneFieldFlags{SceneFieldFlag(fields[0].flags)}, SceneFieldFlag::ImplicitMapping);
+
+    CORRADE_COMPARE(SceneField(fields[1].name), SceneField::Mesh);
+    CORRADE_COMPARE(SceneFieldType(fields[1].type), SceneFieldType::UnsignedShort);
+    CORRADE_COMPARE(fields[1].size, 2);
+    CORRADE_COMPARE(fields[1].mappingOffset, offsetof(Data, meshMapping));
+    CORRADE_COMPARE(fields[1].mappingStride, 4);
+    CORRADE_COMPARE(fields[1].fieldOffset, offsetof(Data, meshes));
+    CORRADE_COMPARE(fields[1].fieldStride, 2);
+    CORRADE_COMPARE(SceneFieldFlags{SceneFieldFlag(fields[1].flags)}, SceneFieldFlags{});
+
+    /* Shares the mapping with meshes */
+    CORRADE_COMPARE(SceneField(fields[2].name), SceneField::MeshMaterial);
+    CORRADE_COMPARE(SceneFieldType(fields[2].type), SceneFieldType::Int);
+    CORRADE_COMPARE(fields[2].size, 2);
+    CORRADE_COMPARE(fields[2].mappingOffset, offsetof(Data, meshMapping));
+    CORRADE_COMPARE(fields[2].fieldOffset, offsetof(Data, meshMaterials));
+    CORRADE_COMPARE(fields[2].fieldStride, 4);
+
+    CORRADE_COMPARE_AS(out->slice(168, 168 + sizeof(Data)),
+        Containers::arrayCast<const char>(Containers::arrayView(data)),
+        TestSuite::Compare::Container);
+}
+
+void BlobSceneConverterTest::scenePointerField() {
+    Containers::Pointer<AbstractSceneConverter> converter = _manager.instantiate("BlobSceneConverter");
+
+    const struct Data {
+        UnsignedInt mapping[2];
+        const void* importerState[2];
+        UnsignedInt meshes[2];
+    } data[]{{
+        {0, 1},
+        {nullptr, nullptr},
+        {3, 4}
+    }};
+
+    std::ostringstream out;
+    Containers::Optional<Containers::Array<char>> blob;
+    {
+        Warning redirectWarning{&out};
+        blob = converter->convertToData(SceneData{SceneMappingType::UnsignedInt, 2, {}, data, {
+            SceneFieldData{SceneField::ImporterState, Containers::arrayView(data->mapping), Containers::arrayView(data->importerState)},
+            SceneFieldData{SceneField::Mesh, Containers::arrayView(data->mapping), Containers::arrayView(data->meshes)}
+        }});
+    }
+    CORRADE_VERIFY(blob);
+    CORRADE_COMPARE(out.str(), "Trade::BlobSceneConverter::convertToData(): skipping field Trade::SceneField::ImporterState of type Trade::SceneFieldType::Pointer\n");
+
+    const auto& header = *reinterpret_cast<const Implementation::BlobSceneHeader*>(blob->data() + sizeof(Implementation::BlobChunkHeader));
+    CORRADE_COMPARE(header.fieldCount, 1);
+
+    const auto& field = *reinterpret_cast<const Implementation::BlobSceneField*>(blob->data() + sizeof(Implementation::BlobChunkHeader) + sizeof(Implementation::BlobSceneHeader));
+    CORRADE_COMPARE(SceneField(field.name), SceneField::Mesh);
+    CORRADE_COMPARE(field.fieldOffset, offsetof(Data, meshes));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::BlobSceneConverterTest)
@@ -25,60 +25,519 @@
 
 #include "ObjImporter.h"
 
-#include <fstream>
+#include <cmath>
+#include <cstring>
 #include <limits>
-#include <sstream>
 #include <unordered_map>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/String.h>
-#include <Corrade/Containers/StringStl.h> /** @todo remove once iostream is dropped */
+#include <Corrade/Containers/StringStl.h> /** @todo remove once std::unordered_map is dropped */
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
-#include <Corrade/Utility/String.h>
 
 #include "Magnum/Mesh.h"
-#include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/Math/Color.h"
+#include "Magnum/Trade/ArrayAllocator.h"
 #include "Magnum/Trade/MeshData.h"
+#include "Magnum/Implementation/parallelFor.h"
 
 namespace Magnum { namespace Trade {
 
+using namespace Containers::Literals;
+
 struct ObjImporter::File {
+    struct Mesh {
+        /* Byte range of the mesh in the file */
+        std::size_t begin, end;
+        UnsignedInt positionIndexOffset,
+            textureCoordinateIndexOffset,
+            normalIndexOffset;
+    };
+
+    /* Either an owned copy of the data or, if opened with openMemory(), a
+       non-owning view on the external memory */
+    Containers::Array<char> data;
     std::unordered_map<std::string, UnsignedInt> meshesForName;
-    std::vector<std::string> meshNames;
-    std::vector<std::tuple<std::streampos, std::streampos, UnsignedInt, UnsignedInt, UnsignedInt>> meshes;
-    Containers::Pointer<std::istream> in;
+    Containers::Array<Containers::String> meshNames;
+    Containers::Array<Mesh> meshes;
 };
 
 namespace {
 
-void ignoreLine(std::istream& in) {
-    in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+/* Newlines are handled separately, everything else that's a whitespace
+   separates tokens on a line */
+inline bool isSpace(const char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline const char* skipSpaces(const char* it, const char* const end) {
+    while(it != end && isSpace(*it)) ++it;
+    return it;
+}
+
+inline const char* findSpace(const char* it, const char* const end) {
+    while(it != end && !isSpace(*it)) ++it;
+    return it;
+}
+
+inline const char* findLineEnd(const char* const it, const char* const end) {
+    const void* const found = std::memchr(it, '\n', end - it);
+    return found ? static_cast<const char*>(found) : end;
+}
+
+/* Returns the next whitespace-separated token on a line and advances the
+   iterator past it. Empty view if there are no more tokens. */
+inline Containers::StringView nextToken(const char*& it, const char* const end) {
+    const char* const begin = skipSpaces(it, end);
+    it = findSpace(begin, end);
+    return {begin, std::size_t(it - begin)};
+}
+
+inline bool isDigit(const char c) {
+    return UnsignedInt(c - '0') < 10;
+}
+
+/* Exactly representable powers of ten, larger exponents go through
+   std::pow() */
+constexpr Double PowersOfTen[]{
+    1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7, 1.0e8, 1.0e9,
+    1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15, 1.0e16, 1.0e17, 1.0e18,
+    1.0e19, 1.0e20, 1.0e21, 1.0e22
+};
+
+/* A decimal float parser, converting the whole token or failing. The
+   significant digits are accumulated in an integer that's exactly
+   representable as a double and then scaled by a power of ten, which for
+   the usual OBJ data gives results within one ULP of std::strtof() at a
+   fraction of the cost, with no locale dependency and no need for a
+   null-terminated input. */
+bool parseFloat(const Containers::StringView token, Float& out) {
+    const char* it = token.begin();
+    const char* const end = token.end();
+
+    bool negative = false;
+    if(it != end && (*it == '-' || *it == '+')) {
+        negative = *it == '-';
+        ++it;
+    }
+
+    /* Digits that would overflow the 53-bit mantissa only affect the
+       exponent */
+    constexpr UnsignedLong MaxMantissa = (1ull << 53)/10 - 1;
+    UnsignedLong mantissa = 0;
+    Int exponent = 0;
+    bool hasDigits = false;
+    for(; it != end && isDigit(*it); ++it) {
+        hasDigits = true;
+        if(mantissa < MaxMantissa) mantissa = mantissa*10 + (*it - '0');
+        else ++exponent;
+    }
+    if(it != end && *it == '.') {
+        ++it;
+        for(; it != end && isDigit(*it); ++it) {
+            hasDigits = true;
+            if(mantissa < MaxMantissa) {
+                mantissa = mantissa*10 + (*it - '0');
+                --exponent;
+            }
+        }
+    }
+    if(!hasDigits) return false;
+
+    if(it != end && (*it == 'e' || *it == 'E')) {
+        ++it;
+        bool negativeExponent = false;
+        if(it != end && (*it == '-' || *it == '+')) {
+            negativeExponent = *it == '-';
+            ++it;
+        }
+        if(it == end || !isDigit(*it)) return false;
+
+        Int explicitExponent = 0;
+        for(; it != end && isDigit(*it); ++it)
+            if(explicitExponent < 10000)
+                explicitExponent = explicitExponent*10 + (*it - '0');
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+
+    /* Trailing garbage */
+    if(it != end) return false;
+
+    /* Zero stays zero for any exponent, the scale could be infinite which
+       would make it a NaN */
+    Double value = Double(mantissa);
+    if(mantissa) {
+        const Int absExponent = exponent < 0 ? -exponent : exponent;
+        const Double scale = absExponent < Int(Containers::arraySize(PowersOfTen)) ?
+            PowersOfTen[absExponent] : std::pow(10.0, absExponent);
+        if(exponent < 0) value /= scale;
+        else value *= scale;
+    }
+
+    /* Values that don't fit into a float (including an infinite scale from
+       an excessive exponent) are an error, same as with std::stof() */
+    if(value > Double(std::numeric_limits<Float>::max())) return false;
+
+    out = Float(negative ? -value : value);
+    return true;
+}
+
+bool parseUnsignedInt(const Containers::StringView token, UnsignedInt& out) {
+    if(token.isEmpty()) return false;
+
+    UnsignedLong value = 0;
+    for(const char c: token) {
+        if(!isDigit(c)) return false;
+        value = value*10 + (c - '0');
+        if(value > 0xffffffffull) return false;
+    }
+
+    out = UnsignedInt(value);
+    return true;
+}
+
+/* Parsing happens in chunks that can run on multiple threads, so errors are
+   recorded and printed only after, in the order they'd be encountered by a
+   sequential parser */
+enum class ParseError: UnsignedByte {
+    None,
+    FloatArraySize,
+    NumericData,
+    HomogeneousCoordinates,
+    TextureCoordinates3D,
+    MixedPrimitive,
+    PointIndexCount,
+    LineIndexCount,
+    TriangleIndexCount,
+    Polygon,
+    IndexData,
+    UnknownKeyword
+};
+
+constexpr UnsignedInt EmptySlot = ~UnsignedInt{};
+
+/* Open-addressing hash table with linear probing for welding position /
+   normal / texture coordinate index tuples, storing just indices into an
+   array of unique tuples. Similar to the table used by
+   MeshTools::removeDuplicates(), except that it grows as the tuples get
+   parsed, as their count isn't known upfront. */
+class TupleTable {
+    public:
+        /* If a tuple equal to `tuple` is already in `tuples`, returns its
+           index, otherwise appends it and returns the new index */
+        UnsignedInt findOrInsert(Containers::Array<Vector3ui>& tuples, const Vector3ui& tuple) {
+            /* Keep the load factor at most 1/2 */
+            if((tuples.size() + 1)*2 > _slots.size()) grow(tuples);
+
+            const std::size_t mask = _slots.size() - 1;
+            std::size_t slot = hash(tuple) & mask;
+            for(;;) {
+                const UnsignedInt existing = _slots[slot];
+                if(existing == EmptySlot) {
+                    arrayAppend(tuples, tuple);
+                    return _slots[slot] = UnsignedInt(tuples.size() - 1);
+                }
+                if(tuples[existing] == tuple)
+                    return existing;
+                slot = (slot + 1) & mask;
+            }
+        }
+
+    private:
+        /* 64-bit multiply-xorshift, same as in MeshTools::removeDuplicates() */
+        static std::size_t hash(const Vector3ui& tuple) {
+            UnsignedLong h = 0x9e3779b97f4a7c15ull;
+            for(std::size_t i = 0; i != 3; ++i) {
+                h = (h ^ tuple[i])*0xff51afd7ed558ccdull;
+                h ^= h >> 32;
+            }
+            return std::size_t(h);
+        }
+
+        void grow(const Containers::ArrayView<const Vector3ui> tuples) {
+            _slots = Containers::Array<UnsignedInt>{DirectInit, _slots.isEmpty() ? std::size_t{1024} : _slots.size()*2, EmptySlot};
+
+            const std::size_t mask = _slots.size() - 1;
+            for(std::size_t i = 0; i != tuples.size(); ++i) {
+                std::size_t slot = hash(tuples[i]) & mask;
+                while(_slots[slot] != EmptySlot) slot = (slot + 1) & mask;
+                _slots[slot] = UnsignedInt(i);
+            }
+        }
+
+        Containers::Array<UnsignedInt> _slots;
+};
+
+/* Newline-aligned part of a mesh and the data parsed from it. The indices
+   are absolute, with just the per-mesh offset subtracted, which means
+   concatenating the vertex data of all chunks in order makes them valid
+   without any further fixup. */
+struct Chunk {
+    const char* begin;
+    const char* end;
+
+    Containers::Array<Vector3> positions;
+    Containers::Array<Vector3> normals;
+    Containers::Array<Vector2> textureCoordinates;
+    /* Index tuples get welded directly during parsing, so instead of a tuple
+       for every face corner there's just a list of unique tuples and a
+       32-bit index into it. Taking a shortcut as there's fortunately nothing
+       else than just 3 types of data. First positions, then normals, then
+       texture coordinates. The indices use the Trade::ArrayAllocator so the
+       array can be passed to MeshData directly if there's just one chunk. */
+    Containers::Array<Vector3ui> tuples;
+    TupleTable tupleTable;
+    Containers::Array<UnsignedInt> indices;
+    std::size_t textureCoordinateIndexCount;
+    std::size_t normalIndexCount;
+
+    /* Primitive of the first index line in the chunk, needed to check for
+       mixed primitives across chunks */
+    Containers::Optional<MeshPrimitive> firstPrimitive;
+    Containers::Optional<MeshPrimitive> primitive;
+
+    ParseError error;
+    /* The offending primitive for ParseError::MixedPrimitive, the offending
+       keyword for ParseError::UnknownKeyword */
+    MeshPrimitive errorPrimitive;
+    Containers::StringView errorKeyword;
+};
+
+void printError(const Chunk& chunk, const MeshPrimitive primitive) {
+    Error e;
+    e << "Trade::ObjImporter::mesh():";
+    switch(chunk.error) {
+        case ParseError::FloatArraySize:
+            e << "invalid float array size";
+            return;
+        case ParseError::NumericData:
+            e << "error while converting numeric data";
+            return;
+        case ParseError::HomogeneousCoordinates:
+            e << "homogeneous coordinates are not supported";
+            return;
+        case ParseError::TextureCoordinates3D:
+            e << "3D texture coordinates are not supported";
+            return;
+        case ParseError::MixedPrimitive:
+            e << "mixed primitive" << primitive << "and" << chunk.errorPrimitive;
+            return;
+        case ParseError::PointIndexCount:
+            e << "wrong index count for point";
+            return;
+        case ParseError::LineIndexCount:
+            e << "wrong index count for line";
+            return;
+        case ParseError::TriangleIndexCount:
+            e << "wrong index count for triangle";
+            return;
+        case ParseError::Polygon:
+            e << "polygons are not supported";
+            return;
+        case ParseError::IndexData:
+            e << "invalid index data";
+            return;
+        case ParseError::UnknownKeyword:
+            e << "unknown keyword" << chunk.errorKeyword;
+            return;
+        /* LCOV_EXCL_START */
+        case ParseError::None:
+            break;
+        /* LCOV_EXCL_STOP */
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* Parses `size` floats, optionally followed by an extra one, from the rest
+   of the line. The token count is checked before any conversion happens. */
+template<std::size_t size> ParseError extractFloatData(const char* it, const char* const end, Math::Vector<size, Float>& out, Float* const extra = nullptr) {
+    Containers::StringView tokens[size + 2];
+    std::size_t count = 0;
+    for(Containers::StringView token; count != size + 2 && !(token = nextToken(it, end)).isEmpty(); )
+        tokens[count++] = token;
+
+    if(count < size || count > size + (extra ? 1 : 0))
+        return ParseError::FloatArraySize;
+
+    for(std::size_t i = 0; i != count; ++i)
+        if(!parseFloat(tokens[i], i < size ? out[i] : *extra))
+            return ParseError::NumericData;
+
+    return ParseError::None;
 }
 
-template<std::size_t size> Math::Vector<size, Float> extractFloatData(const std::string& str, Float* extra = nullptr) {
-    std::vector<std::string> data = Utility::String::splitWithoutEmptyParts(str, ' ');
-    if(data.size() < size || data.size() > size + (extra ? 1 : 0)) {
-        Error() << "Trade::ObjImporter::mesh(): invalid float array size";
-        throw 0;
+/* Parses vertex data and indices from the chunk until the end or the first
+   error */
+ParseError parseChunk(Chunk& chunk, const UnsignedInt positionIndexOffset, const UnsignedInt textureCoordinateIndexOffset, const UnsignedInt normalIndexOffset) {
+    /* Checks that we don't mix the primitives in one mesh */
+    auto setPrimitive = [&chunk](const MeshPrimitive primitive) {
+        if(chunk.primitive && *chunk.primitive != primitive) {
+            chunk.errorPrimitive = primitive;
+            return false;
+        }
+        if(!chunk.firstPrimitive) chunk.firstPrimitive = primitive;
+        chunk.primitive = primitive;
+        return true;
+    };
+
+    for(const char* it = chunk.begin; it < chunk.end; ) {
+        const char* const lineEnd = findLineEnd(it, chunk.end);
+        const char* const next = lineEnd == chunk.end ? chunk.end : lineEnd + 1;
+
+        /* Ignore empty lines and comments */
+        const Containers::StringView keyword = nextToken(it, lineEnd);
+        if(keyword.isEmpty() || keyword[0] == '#') {
+            it = next;
+            continue;
+        }
+
+        /* Vertex position */
+        if(keyword == "v"_s) {
+            Vector3 data{NoInit};
+            Float extra{1.0f};
+            const ParseError error = extractFloatData<3>(it, lineEnd, data, &extra);
+            if(error != ParseError::None) return error;
+            if(!Math::TypeTraits<Float>::equals(extra, 1.0f))
+                return ParseError::HomogeneousCoordinates;
+
+            arrayAppend(chunk.positions, data);
+
+        /* Texture coordinate */
+        } else if(keyword == "vt"_s) {
+            Vector2 data{NoInit};
+            Float extra{0.0f};
+            const ParseError error = extractFloatData<2>(it, lineEnd, data, &extra);
+            if(error != ParseError::None) return error;
+            if(!Math::TypeTraits<Float>::equals(extra, 0.0f))
+                return ParseError::TextureCoordinates3D;
+
+            arrayAppend(chunk.textureCoordinates, data);
+
+        /* Normal */
+        } else if(keyword == "vn"_s) {
+            Vector3 data{NoInit};
+            const ParseError error = extractFloatData<3>(it, lineEnd, data);
+            if(error != ParseError::None) return error;
+
+            arrayAppend(chunk.normals, data);
+
+        /* Indices */
+        } else if(keyword == "p"_s || keyword == "l"_s || keyword == "f"_s) {
+            /* Count the index tuples first to check the primitive */
+            std::size_t indexTupleCount = 0;
+            for(const char* tupleIt = it; !nextToken(tupleIt, lineEnd).isEmpty(); )
+                ++indexTupleCount;
+
+            /* Points */
+            if(keyword == "p"_s) {
+                if(!setPrimitive(MeshPrimitive::Points))
+                    return ParseError::MixedPrimitive;
+
+                /* Check vertex count per primitive */
+                if(indexTupleCount != 1)
+                    return ParseError::PointIndexCount;
+
+            /* Lines */
+            } else if(keyword == "l"_s) {
+                if(!setPrimitive(MeshPrimitive::Lines))
+                    return ParseError::MixedPrimitive;
+
+                /* Check vertex count per primitive */
+                if(indexTupleCount != 2)
+                    return ParseError::LineIndexCount;
+
+            /* Faces */
+            } else if(keyword == "f"_s) {
+                if(!setPrimitive(MeshPrimitive::Triangles))
+                    return ParseError::MixedPrimitive;
+
+                /* Check vertex count per primitive */
+                if(indexTupleCount < 3)
+                    return ParseError::TriangleIndexCount;
+                else if(indexTupleCount != 3)
+                    return ParseError::Polygon;
+
+            } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+            for(Containers::StringView indexTuple; !(indexTuple = nextToken(it, lineEnd)).isEmpty(); ) {
+                /* Split the tuple on slashes, at most three parts */
+                Containers::StringView indexStrings[3];
+                std::size_t indexStringCount = 0;
+                const char* partBegin = indexTuple.begin();
+                for(const char* c = indexTuple.begin(); ; ++c) {
+                    if(c != indexTuple.end() && *c != '/') continue;
+
+                    if(indexStringCount == 3)
+                        return ParseError::IndexData;
+
+                    indexStrings[indexStringCount++] = {partBegin, std::size_t(c - partBegin)};
+                    if(c == indexTuple.end()) break;
+                    partBegin = c + 1;
+                }
+
+                Vector3ui index;
+
+                /* Position indices */
+                if(!parseUnsignedInt(indexStrings[0], index[0]))
+                    return ParseError::NumericData;
+                index[0] -= positionIndexOffset;
+
+                /* Texture coordinates */
+                if(indexStringCount == 2 || (indexStringCount == 3 && !indexStrings[1].isEmpty())) {
+                    if(!parseUnsignedInt(indexStrings[1], index[2]))
+                        return ParseError::NumericData;
+                    index[2] -= textureCoordinateIndexOffset;
+                    ++chunk.textureCoordinateIndexCount;
+                }
+
+                /* Normal indices */
+                if(indexStringCount == 3) {
+                    if(!parseUnsignedInt(indexStrings[2], index[1]))
+                        return ParseError::NumericData;
+                    index[1] -= normalIndexOffset;
+                    ++chunk.normalIndexCount;
+                }
+
+                arrayAppend<ArrayAllocator>(chunk.indices, chunk.tupleTable.findOrInsert(chunk.tuples, index));
+            }
+
+        /* Ignore unsupported keywords, error out on unknown keywords */
+        } else if(keyword != "mtllib"_s && keyword != "usemtl"_s && keyword != "g"_s && keyword != "s"_s) {
+            chunk.errorKeyword = keyword;
+            return ParseError::UnknownKeyword;
+        }
+
+        it = next;
     }
 
-    Math::Vector<size, Float> output;
+    return ParseError::None;
+}
+
+/* Chunks smaller than this aren't worth the threading overhead */
+constexpr std::size_t MinChunkSize = 256*1024;
 
-    for(std::size_t i = 0; i != size; ++i)
-        output[i] = std::stof(data[i]);
+/* Concatenates data of all chunks. Moves the array if there's just one
+   chunk. */
+template<class T> Containers::Array<T> concatenate(Containers::ArrayView<Chunk> chunks, Containers::Array<T> Chunk::*member) {
+    if(chunks.size() == 1) return std::move(chunks[0].*member);
 
-    if(data.size() == size+1) {
-        /* This should be obvious from the first if, but add this just to make
-           Clang Analyzer happy */
-        CORRADE_INTERNAL_ASSERT(extra);
+    std::size_t size = 0;
+    for(const Chunk& chunk: chunks) size += (chunk.*member).size();
 
-        *extra = std::stof(data.back());
+    Containers::Array<T> out{NoInit, size};
+    std::size_t offset = 0;
+    for(Chunk& chunk: chunks) {
+        Utility::copy(chunk.*member, out.slice(offset, offset + (chunk.*member).size()));
+        offset += (chunk.*member).size();
+        chunk.*member = nullptr;
     }
 
-    return output;
+    return out;
 }
 
 }
@@ -95,118 +554,99 @@ void ObjImporter::doClose() { _file.reset(); }
 
 bool ObjImporter::doIsOpened() const { return !!_file; }
 
-void ObjImporter::doOpenFile(const Containers::StringView filename) {
-    /** @todo ARGH clean this up, won't work with UTF-8 */
-    Containers::Pointer<std::istream> in{new std::ifstream{filename, std::ios::binary}};
-    if(!in->good()) {
-        Error() << "Trade::ObjImporter::openFile(): cannot open file" << filename;
-        return;
-    }
-
+void ObjImporter::doOpenData(Containers::Array<char>&& data, const DataFlags dataFlags) {
     _file.reset(new File);
-    _file->in = std::move(in);
-    parseMeshNames();
-}
 
-void ObjImporter::doOpenData(Containers::Array<char>&& data, DataFlags) {
-    _file.reset(new File);
-    /** @todo ARGH MY EYES what is this cursed thing, burn it to the ground */
-    _file->in.reset(new std::istringstream{{data.begin(), data.size()}});
+    /* Take over the existing array or copy the data if we can't */
+    if(dataFlags & (DataFlag::Owned|DataFlag::ExternallyOwned)) {
+        _file->data = std::move(data);
+    } else {
+        _file->data = Containers::Array<char>{NoInit, data.size()};
+        Utility::copy(data, _file->data);
+    }
 
     parseMeshNames();
 }
 
 void ObjImporter::parseMeshNames() {
+    const char* const begin = _file->data.begin();
+    const char* const end = _file->data.end();
+
     /* First mesh starts at the beginning, its indices start from 1. The end
        offset will be updated to proper value later. */
     UnsignedInt positionIndexOffset = 1;
     UnsignedInt normalIndexOffset = 1;
     UnsignedInt textureCoordinateIndexOffset = 1;
-    _file->meshes.emplace_back(0, 0, positionIndexOffset, normalIndexOffset, textureCoordinateIndexOffset);
+    arrayAppend(_file->meshes, InPlaceInit, 0, 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset);
 
     /* The first mesh doesn't have name by default but we might find it later,
        so we need to track whether there are any data before first name */
     bool thisIsFirstMeshAndItHasNoData = true;
-    _file->meshNames.emplace_back();
+    arrayAppend(_file->meshNames, InPlaceInit);
 
-    while(_file->in->good()) {
+    for(const char* it = begin; it != end; ) {
         /* The previous object might end at the beginning of this line */
-        const std::streampos end = _file->in->tellg();
-
-        /* Comment line */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
-        }
+        const char* const lineBegin = it;
+        const char* const lineEnd = findLineEnd(it, end);
+        const char* const next = lineEnd == end ? end : lineEnd + 1;
 
-        /* Parse the keyword */
-        std::string keyword;
-        *_file->in >> keyword;
+        /* Parse the keyword. Comment lines are skipped by this as well. */
+        const Containers::StringView keyword = nextToken(it, lineEnd);
 
         /* Mesh name */
-        if(keyword == "o") {
-            std::string name;
-            std::getline(*_file->in, name);
-            name = Utility::String::trim(name);
+        if(keyword == "o"_s) {
+            const Containers::StringView name = Containers::StringView{it, std::size_t(lineEnd - it)}.trimmed();
 
             /* This is the name of first mesh */
             if(thisIsFirstMeshAndItHasNoData) {
                 thisIsFirstMeshAndItHasNoData = false;
 
                 /* Update its name and add it to name map */
-                if(!name.empty())
+                if(!name.isEmpty())
                     _file->meshesForName.emplace(name, _file->meshes.size() - 1);
-                _file->meshNames.back() = std::move(name);
+                _file->meshNames.back() = name;
 
                 /* Update its begin offset to be more precise */
-                std::get<0>(_file->meshes.back()) = _file->in->tellg();
+                _file->meshes.back().begin = next - begin;
 
             /* Otherwise this is a name of new mesh */
             } else {
                 /* Set end of the previous one */
-                std::get<1>(_file->meshes.back()) = end;
+                _file->meshes.back().end = lineBegin - begin;
 
                 /* Save name and offset of the new one. The end offset will be
                    updated later. */
-                if(!name.empty())
+                if(!name.isEmpty())
                     _file->meshesForName.emplace(name, _file->meshes.size());
-                _file->meshNames.emplace_back(std::move(name));
-                _file->meshes.emplace_back(_file->in->tellg(), 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset);
+                arrayAppend(_file->meshNames, InPlaceInit, name);
+                arrayAppend(_file->meshes, InPlaceInit, std::size_t(next - begin), 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset);
             }
 
-            continue;
-
         /* If there are any data/indices before the first name, it means that
            the first object is unnamed. We need to check for them. */
 
         /* Vertex data, update index offset for the following meshes */
-        } else if(keyword == "v") {
+        } else if(keyword == "v"_s) {
             ++positionIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vt") {
+        } else if(keyword == "vt"_s) {
             ++textureCoordinateIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vn") {
+        } else if(keyword == "vn"_s) {
             ++normalIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
 
         /* Index data, just mark that we found something for first unnamed
            object */
-        } else if(thisIsFirstMeshAndItHasNoData) for(const std::string data: {"p", "l", "f"}) {
-            if(keyword == data) {
-                thisIsFirstMeshAndItHasNoData = false;
-                break;
-            }
+        } else if(keyword == "p"_s || keyword == "l"_s || keyword == "f"_s) {
+            thisIsFirstMeshAndItHasNoData = false;
         }
 
-        /* Ignore the rest of the line */
-        ignoreLine(*_file->in);
+        it = next;
     }
 
     /* Set end of the last object */
-    _file->in->clear();
-    _file->in->seekg(0, std::ios::end);
-    std::get<1>(_file->meshes.back()) = _file->in->tellg();
+    _file->meshes.back().end = _file->data.size();
 }
 
 UnsignedInt ObjImporter::doMeshCount() const { return _file->meshes.size(); }
@@ -237,173 +677,71 @@ template<class T> bool checkAndDuplicateInto(const Containers::StridedArrayView1
 }
 
 Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt) {
-    /* Seek the file, set mesh parsing parameters */
-    std::streampos begin, end;
-    UnsignedInt positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset;
-    std::tie(begin, end, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset) = _file->meshes[id];
-    _file->in->seekg(begin);
+    /* Get the mesh range, set mesh parsing parameters */
+    const File::Mesh& mesh = _file->meshes[id];
+    const UnsignedInt positionIndexOffset = mesh.positionIndexOffset;
+    const UnsignedInt textureCoordinateIndexOffset = mesh.textureCoordinateIndexOffset;
+    const UnsignedInt normalIndexOffset = mesh.normalIndexOffset;
+    const char* const begin = _file->data.begin() + mesh.begin;
+    const char* const end = _file->data.begin() + mesh.end;
+
+    /* Split the mesh into newline-aligned chunks, a few for each thread so
+       the work is balanced even if some parts of the file are faster to
+       parse than others */
+    const UnsignedInt threadCount = Implementation::parallelThreadCount(configuration().value<UnsignedInt>("threads"));
+    std::size_t chunkCount = std::size_t(end - begin)/MinChunkSize;
+    if(chunkCount > threadCount*4) chunkCount = threadCount*4;
+    if(threadCount == 1 || !chunkCount) chunkCount = 1;
+    Containers::Array<Chunk> chunks{ValueInit, chunkCount};
+    {
+        const char* chunkBegin = begin;
+        for(std::size_t i = 0; i != chunkCount; ++i) {
+            chunks[i].begin = chunkBegin;
+            if(i + 1 == chunkCount) {
+                chunks[i].end = end;
+            } else {
+                const char* const split = begin + (end - begin)*(i + 1)/chunkCount;
+                const char* const lineEnd = findLineEnd(split < chunkBegin ? chunkBegin : split, end);
+                chunks[i].end = lineEnd == end ? end : lineEnd + 1;
+            }
+            chunkBegin = chunks[i].end;
+        }
+    }
+
+    Implementation::parallelFor(threadCount, chunkCount, [&](const std::size_t i) {
+        chunks[i].error = parseChunk(chunks[i], positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset);
+    });
 
+    /* Go through the chunks in order, report the first error a sequential
+       parser would encounter */
     Containers::Optional<MeshPrimitive> primitive;
-    Containers::Array<Vector3> positions;
-    Containers::Array<Vector3> normals;
-    Containers::Array<Vector2> textureCoordinates;
-    /* Taking a shortcut as there's fortunately nothing else than just 3 types
-       of data. First positions, then normals, then texture coordinates. */
-    Containers::Array<Vector3ui> indices;
     std::size_t textureCoordinateIndexCount = 0, normalIndexCount = 0;
-
-    try { while(_file->in->good() && _file->in->tellg() < end) {
-        /* Ignore comments */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
+    for(const Chunk& chunk: chunks) {
+        /* The first primitive in the chunk is always before the chunk's own
+           error, if there's any, so check it first */
+        if(primitive && chunk.firstPrimitive && *primitive != *chunk.firstPrimitive) {
+            Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << *chunk.firstPrimitive;
+            return Containers::NullOpt;
         }
-
-        /* Get the line */
-        std::string line;
-        std::getline(*_file->in, line);
-        line = Utility::String::trim(line);
-
-        /* Ignore empty lines */
-        if(line.empty()) continue;
-
-        /* Split the line into keyword and contents */
-        const std::size_t keywordEnd = line.find(' ');
-        const std::string keyword = line.substr(0, keywordEnd);
-        const std::string contents = keywordEnd != std::string::npos ?
-            Utility::String::ltrim(line.substr(keywordEnd+1)) : "";
-
-        /* Vertex position */
-        if(keyword == "v") {
-            Float extra{1.0f};
-            const Vector3 data = extractFloatData<3>(contents, &extra);
-            if(!Math::TypeTraits<Float>::equals(extra, 1.0f)) {
-                Error() << "Trade::ObjImporter::mesh(): homogeneous coordinates are not supported";
-                return Containers::NullOpt;
-            }
-
-            arrayAppend(positions, data);
-
-        /* Texture coordinate */
-        } else if(keyword == "vt") {
-            Float extra{0.0f};
-            const Vector2 data = extractFloatData<2>(contents, &extra);
-            if(!Math::TypeTraits<Float>::equals(extra, 0.0f)) {
-                Error() << "Trade::ObjImporter::mesh(): 3D texture coordinates are not supported";
-                return Containers::NullOpt;
-            }
-
-            arrayAppend(textureCoordinates, data);
-
-        /* Normal */
-        } else if(keyword == "vn") {
-            arrayAppend(normals, Vector3{extractFloatData<3>(contents)});
-
-        /* Indices */
-        } else if(keyword == "p" || keyword == "l" || keyword == "f") {
-            const std::vector<std::string> indexTuples = Utility::String::splitWithoutEmptyParts(contents, ' ');
-
-            /* Points */
-            if(keyword == "p") {
-                /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Points) {
-                    Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << MeshPrimitive::Points;
-                    return Containers::NullOpt;
-                }
-
-                /* Check vertex count per primitive */
-                if(indexTuples.size() != 1) {
-                    Error() << "Trade::ObjImporter::mesh(): wrong index count for point";
-                    return Containers::NullOpt;
-                }
-
-                primitive = MeshPrimitive::Points;
-
-            /* Lines */
-            } else if(keyword == "l") {
-                /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Lines) {
-                    Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << MeshPrimitive::Lines;
-                    return Containers::NullOpt;
-                }
-
-                /* Check vertex count per primitive */
-                if(indexTuples.size() != 2) {
-                    Error() << "Trade::ObjImporter::mesh(): wrong index count for line";
-                    return Containers::NullOpt;
-                }
-
-                primitive = MeshPrimitive::Lines;
-
-            /* Faces */
-            } else if(keyword == "f") {
-                /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Triangles) {
-                    Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << MeshPrimitive::Triangles;
-                    return Containers::NullOpt;
-                }
-
-                /* Check vertex count per primitive */
-                if(indexTuples.size() < 3) {
-                    Error() << "Trade::ObjImporter::mesh(): wrong index count for triangle";
-                    return Containers::NullOpt;
-                } else if(indexTuples.size() != 3) {
-                    Error() << "Trade::ObjImporter::mesh(): polygons are not supported";
-                    return Containers::NullOpt;
-                }
-
-                primitive = MeshPrimitive::Triangles;
-
-            } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
-
-            for(const std::string& indexTuple: indexTuples) {
-                std::vector<std::string> indexStrings = Utility::String::split(indexTuple, '/');
-                if(indexStrings.size() > 3) {
-                    Error() << "Trade::ObjImporter::mesh(): invalid index data";
-                    return Containers::NullOpt;
-                }
-
-                Vector3ui index;
-
-                /* Position indices */
-                index[0] = std::stoul(indexStrings[0]) - positionIndexOffset;
-
-                /* Texture coordinates */
-                if(indexStrings.size() == 2 || (indexStrings.size() == 3 && !indexStrings[1].empty())) {
-                    index[2] = std::stoul(indexStrings[1]) - textureCoordinateIndexOffset;
-                    ++textureCoordinateIndexCount;
-                }
-
-                /* Normal indices */
-                if(indexStrings.size() == 3) {
-                    index[1] = std::stoul(indexStrings[2]) - normalIndexOffset;
-                    ++normalIndexCount;
-                }
-
-                arrayAppend(indices, index);
-            }
-
-        /* Ignore unsupported keywords, error out on unknown keywords */
-        } else if(![&keyword](){
-            /* Using lambda to emulate for-else construct like in Python */
-            for(const std::string expected: {"mtllib", "usemtl", "g", "s"})
-                if(keyword == expected) return true;
-            return false;
-        }()) {
-            Error() << "Trade::ObjImporter::mesh(): unknown keyword" << keyword;
+        if(chunk.error != ParseError::None) {
+            printError(chunk, chunk.primitive ? *chunk.primitive : MeshPrimitive{});
             return Containers::NullOpt;
         }
 
-    }} catch(const std::exception&) {
-        Error() << "Trade::ObjImporter::mesh(): error while converting numeric data";
-        return Containers::NullOpt;
-    } catch(...) {
-        /* Error message already printed */
-        return Containers::NullOpt;
+        if(chunk.primitive) primitive = chunk.primitive;
+        textureCoordinateIndexCount += chunk.textureCoordinateIndexCount;
+        normalIndexCount += chunk.normalIndexCount;
     }
 
+    /* As the chunks are in order, the vertex data can be just concatenated */
+    Containers::Array<Vector3> positions = concatenate(chunks, &Chunk::positions);
+    Containers::Array<Vector3> normals = concatenate(chunks, &Chunk::normals);
+    Containers::Array<Vector2> textureCoordinates = concatenate(chunks, &Chunk::textureCoordinates);
+    std::size_t indexCount = 0;
+    for(const Chunk& chunk: chunks) indexCount += chunk.indices.size();
+
     /* There should be at least indexed position data */
-    if(positions.isEmpty() || indices.isEmpty()) {
+    if(positions.isEmpty() || !indexCount) {
         Error() << "Trade::ObjImporter::mesh(): incomplete position data";
         return Containers::NullOpt;
     }
@@ -419,23 +757,53 @@ Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt)
     }
 
     /* All index arrays should have the same length */
-    if(normalIndexCount && normalIndexCount != indices.size()) {
-        CORRADE_INTERNAL_ASSERT(normalIndexCount < indices.size());
+    if(normalIndexCount && normalIndexCount != indexCount) {
+        CORRADE_INTERNAL_ASSERT(normalIndexCount < indexCount);
         Error() << "Trade::ObjImporter::mesh(): some normal indices are missing";
         return Containers::NullOpt;
     }
-    if(textureCoordinateIndexCount && textureCoordinateIndexCount != indices.size()) {
-        CORRADE_INTERNAL_ASSERT(textureCoordinateIndexCount < indices.size());
+    if(textureCoordinateIndexCount && textureCoordinateIndexCount != indexCount) {
+        CORRADE_INTERNAL_ASSERT(textureCoordinateIndexCount < indexCount);
         Error() << "Trade::ObjImporter::mesh(): some texture coordinate indices are missing";
         return Containers::NullOpt;
     }
 
-    /* Merge index arrays. If any of the attributes was not there, the whole
-       index array has zeros, not affecting the uniqueness in any way. */
-    Containers::Array<char> indexData{NoInit, indices.size()*sizeof(UnsignedInt)};
+    /* The index tuples are already welded in each chunk. If any of the
+       attributes was not there, the tuples have zeros for it, not affecting
+       the uniqueness in any way. With a single chunk the indices are used
+       directly, otherwise the unique tuples of all chunks are welded again
+       and the per-chunk indices remapped to the combined tuple list. */
+    Containers::Array<Vector3ui> tuples;
+    Containers::Array<char> indexData;
+    if(chunks.size() == 1) {
+        tuples = std::move(chunks[0].tuples);
+        indexData = Containers::arrayAllocatorCast<char, ArrayAllocator>(std::move(chunks[0].indices));
+    } else {
+        TupleTable tupleTable;
+        Containers::Array<Containers::Array<UnsignedInt>> remaps{chunks.size()};
+        for(std::size_t i = 0; i != chunks.size(); ++i) {
+            remaps[i] = Containers::Array<UnsignedInt>{NoInit, chunks[i].tuples.size()};
+            for(std::size_t j = 0; j != chunks[i].tuples.size(); ++j)
+                remaps[i][j] = tupleTable.findOrInsert(tuples, chunks[i].tuples[j]);
+            chunks[i].tuples = nullptr;
+        }
+
+        indexData = Containers::Array<char>{NoInit, indexCount*sizeof(UnsignedInt)};
+        const Containers::ArrayView<UnsignedInt> indices = Containers::arrayCast<UnsignedInt>(indexData);
+        Containers::Array<std::size_t> indexOffsets{NoInit, chunks.size()};
+        for(std::size_t i = 0, offset = 0; i != chunks.size(); ++i) {
+            indexOffsets[i] = offset;
+            offset += chunks[i].indices.size();
+        }
+        Implementation::parallelFor(threadCount, chunks.size(), [&](const std::size_t i) {
+            const Containers::ArrayView<UnsignedInt> out = indices.slice(indexOffsets[i], indexOffsets[i] + chunks[i].indices.size());
+            for(std::size_t j = 0; j != out.size(); ++j)
+                out[j] = remaps[i][chunks[i].indices[j]];
+            chunks[i].indices = nullptr;
+        });
+    }
     const auto indexDataI = Containers::arrayCast<UnsignedInt>(indexData);
-    const std::size_t vertexCount = MeshTools::removeDuplicatesInPlaceInto(
-        Containers::arrayCast<2, char>(arrayView(indices)), indexDataI);
+    const std::size_t vertexCount = tuples.size();
 
     /* Allocate attribute and vertex data */
     std::size_t attributeCount = 1;
@@ -452,13 +820,13 @@ Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt)
     Containers::Array<char> vertexData{NoInit, vertexCount*stride};
 
     /* Duplicate the vertices into the output */
-    const auto indicesPerAttribute = Containers::arrayCast<2, const UnsignedInt>(stridedArrayView(indices)).transposed<0, 1>();
+    const auto indicesPerAttribute = Containers::arrayCast<2, const UnsignedInt>(stridedArrayView(tuples)).transposed<0, 1>();
     std::size_t attributeIndex = 0;
     std::size_t offset = 0;
     {
         Containers::StridedArrayView1D<Vector3> view{vertexData,
             reinterpret_cast<Vector3*>(vertexData.data()), vertexCount, stride};
-        if(!checkAndDuplicateInto(indicesPerAttribute[0].prefix(vertexCount), positions, view, positionIndexOffset))
+        if(!checkAndDuplicateInto(indicesPerAttribute[0], positions, view, positionIndexOffset))
             return Containers::NullOpt;
         attributeData[attributeIndex++] = MeshAttributeData{MeshAttribute::Position, view};
         offset += sizeof(Vector3);
@@ -466,7 +834,7 @@ Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt)
     if(normalIndexCount) {
         Containers::StridedArrayView1D<Vector3> view{vertexData,
             reinterpret_cast<Vector3*>(vertexData.data() + offset), vertexCount, stride};
-        if(!checkAndDuplicateInto(indicesPerAttribute[1].prefix(vertexCount), normals, view, normalIndexOffset))
+        if(!checkAndDuplicateInto(indicesPerAttribute[1], normals, view, normalIndexOffset))
             return Containers::NullOpt;
         attributeData[attributeIndex++] = MeshAttributeData{MeshAttribute::Normal, view};
         offset += sizeof(Vector3);
@@ -474,7 +842,7 @@ Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt)
     if(textureCoordinateIndexCount) {
         Containers::StridedArrayView1D<Vector2> view{vertexData,
             reinterpret_cast<Vector2*>(vertexData.data() + offset), vertexCount, stride};
-        if(!checkAndDuplicateInto(indicesPerAttribute[2].prefix(vertexCount), textureCoordinates, view, textureCoordinateIndexOffset))
+        if(!checkAndDuplicateInto(indicesPerAttribute[2], textureCoordinates, view, textureCoordinateIndexOffset))
             return Containers::NullOpt;
         attributeData[attributeIndex++] = MeshAttributeData{MeshAttribute::TextureCoordinates, view};
         offset += sizeof(Vector2);
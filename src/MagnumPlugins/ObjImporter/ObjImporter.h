@@ -98,6 +98,36 @@ positions with optional @ref VertexFormat::Vector3 normals and
 @ref VertexFormat::Vector2 texture coordinates, if present in the source file.
 
 Polygons (quads etc.) and material properties are currently not supported.
+
+The file is parsed directly from memory, without any intermediate copies of
+the lines. When opened with @ref openMemory(), for example with a
+memory-mapped file from @relativeref{Corrade,Utility::Path::mapRead()}, the
+data are referenced directly instead of being copied to an internal buffer,
+and it's the user responsibility to keep the memory alive and unchanged until
+the importer is closed. With @ref openData() the data are copied, with
+@ref openFile() the file is read into an internal buffer. Mesh boundaries and
+names are discovered in a quick scan on opening, the vertex data and indices
+are parsed only once a particular @ref mesh() is requested. Position, normal
+and texture coordinate index tuples are welded together already during
+parsing, so the peak memory use is proportional to the count of unique
+vertices and not to the count of face corners.
+
+@section Trade-ObjImporter-configuration Plugin-specific configuration
+
+It's possible to tune various import options through @ref configuration().
+See below for all options and their default values:
+
+@snippet MagnumPlugins/ObjImporter/ObjImporter.conf configuration_
+
+With the @cb{.ini} threads @ce option set to a value other than @cpp 1 @ce,
+meshes larger than a few hundred kilobytes are split into newline-aligned
+chunks that are parsed on multiple threads. Indices in an OBJ file are
+absolute, so the vertex data of the chunks are concatenated in order and the
+result is exactly the same as when parsing on a single thread, including the
+error reported for invalid files. If the platform doesn't support threads,
+the option is ignored.
+
+See @ref plugins-configuration for more information.
 */
 class MAGNUM_OBJIMPORTER_EXPORT ObjImporter: public AbstractImporter {
     public:
@@ -116,7 +146,6 @@ class MAGNUM_OBJIMPORTER_EXPORT ObjImporter: public AbstractImporter {
 
         MAGNUM_OBJIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_OBJIMPORTER_LOCAL void doOpenData(Containers::Array<char>&& data, DataFlags dataFlags) override;
-        MAGNUM_OBJIMPORTER_LOCAL void doOpenFile(Containers::StringView filename) override;
         MAGNUM_OBJIMPORTER_LOCAL void doClose() override;
 
         MAGNUM_OBJIMPORTER_LOCAL UnsignedInt doMeshCount() const override;
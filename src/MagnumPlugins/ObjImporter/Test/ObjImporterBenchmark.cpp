@@ -0,0 +1,149 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdio>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/MeshData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct ObjImporterBenchmark: TestSuite::Tester {
+    explicit ObjImporterBenchmark();
+
+    void openMemory();
+    void mesh();
+
+    private:
+        PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+        Containers::Array<char> _data[2];
+};
+
+/* A grid of 1449x1449 vertices, resulting in about 4.2 million triangles.
+   The variant with texture coordinates and normals is roughly 450 MB of
+   text. */
+constexpr UnsignedInt GridSize = 1449;
+
+const struct {
+    const char* name;
+    bool textureCoordinatesNormals;
+} Data[]{
+    {"positions", false},
+    {"positions, texture coordinates, normals", true}
+};
+
+void appendLine(Containers::Array<char>& out, const char* const buffer, const int size) {
+    arrayAppend(out, Containers::arrayView(buffer, size));
+}
+
+Containers::Array<char> generateGrid(const bool textureCoordinatesNormals) {
+    Containers::Array<char> out;
+    char buffer[128];
+
+    for(UnsignedInt y = 0; y != GridSize; ++y) {
+        for(UnsignedInt x = 0; x != GridSize; ++x) {
+            const Float u = Float(x)/(GridSize - 1);
+            const Float v = Float(y)/(GridSize - 1);
+            appendLine(out, buffer, std::snprintf(buffer, sizeof(buffer), "v %.6f %.6f %.6f\n", u*2.0f - 1.0f, v*2.0f - 1.0f, u*v*0.25f));
+            if(textureCoordinatesNormals) {
+                appendLine(out, buffer, std::snprintf(buffer, sizeof(buffer), "vt %.6f %.6f\n", u, v));
+                appendLine(out, buffer, std::snprintf(buffer, sizeof(buffer), "vn %.6f %.6f %.6f\n", -v*0.25f, -u*0.25f, 1.0f));
+            }
+        }
+    }
+
+    for(UnsignedInt y = 0; y != GridSize - 1; ++y) {
+        for(UnsignedInt x = 0; x != GridSize - 1; ++x) {
+            const UnsignedInt a = y*GridSize + x + 1;
+            const UnsignedInt b = a + 1;
+            const UnsignedInt c = a + GridSize;
+            const UnsignedInt d = c + 1;
+            if(textureCoordinatesNormals) {
+                appendLine(out, buffer, std::snprintf(buffer, sizeof(buffer), "f %u/%u/%u %u/%u/%u %u/%u/%u\n", a, a, a, b, b, b, d, d, d));
+                appendLine(out, buffer, std::snprintf(buffer, sizeof(buffer), "f %u/%u/%u %u/%u/%u %u/%u/%u\n", a, a, a, d, d, d, c, c, c));
+            } else {
+                appendLine(out, buffer, std::snprintf(buffer, sizeof(buffer), "f %u %u %u\n", a, b, d));
+                appendLine(out, buffer, std::snprintf(buffer, sizeof(buffer), "f %u %u %u\n", a, d, c));
+            }
+        }
+    }
+
+    return out;
+}
+
+ObjImporterBenchmark::ObjImporterBenchmark() {
+    addInstancedBenchmarks({&ObjImporterBenchmark::openMemory,
+                            &ObjImporterBenchmark::mesh}, 3,
+        Containers::arraySize(Data));
+
+    #ifdef OBJIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(OBJIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    for(std::size_t i = 0; i != Containers::arraySize(Data); ++i)
+        _data[i] = generateGrid(Data[i].textureCoordinatesNormals);
+}
+
+void ObjImporterBenchmark::openMemory() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+
+    /* Discovering mesh boundaries only, the memory is referenced without a
+       copy */
+    bool opened = false;
+    CORRADE_BENCHMARK(1)
+        opened = importer->openMemory(_data[testCaseInstanceId()]);
+
+    CORRADE_VERIFY(opened);
+    CORRADE_COMPARE(importer->meshCount(), 1);
+}
+
+void ObjImporterBenchmark::mesh() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    CORRADE_VERIFY(importer->openMemory(_data[testCaseInstanceId()]));
+
+    Containers::Optional<MeshData> mesh;
+    CORRADE_BENCHMARK(1)
+        mesh = importer->mesh(0);
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indexCount(), (GridSize - 1)*(GridSize - 1)*6);
+    CORRADE_COMPARE(mesh->vertexCount(), GridSize*GridSize);
+    CORRADE_COMPARE(mesh->attributeCount(), data.textureCoordinatesNormals ? 3 : 1);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::ObjImporterBenchmark)
@@ -58,6 +58,7 @@ struct ObjImporterTest: TestSuite::Tester {
     void meshTextureCoordinatesNormals();
 
     void meshIgnoredKeyword();
+    void meshFloatLiterals();
 
     void meshNamed();
     void meshNamedFirstUnnamed();
@@ -77,6 +78,8 @@ struct ObjImporterTest: TestSuite::Tester {
     void invalidIncompleteData();
     void invalidOptionalCoordinate();
 
+    void parallel();
+
     void openTwice();
     void importTwice();
 
@@ -118,6 +121,11 @@ const struct {
     const char* message;
 } InvalidNumbersData[]{
     {"invalid float literal", "error while converting numeric data"},
+    {"float literal exponent overflow", "error while converting numeric data"},
+    {"float literal with a too large mantissa", "error while converting numeric data"},
+    {"float literal without exponent digits", "error while converting numeric data"},
+    {"float literal with exponent sign only", "error while converting numeric data"},
+    {"float literal with sign only", "error while converting numeric data"},
     {"invalid integer literal", "error while converting numeric data"},
     {"position index out of range", "index 1 out of range for 1 vertices"},
     {"texture index out of range", "index 4 out of range for 3 vertices"},
@@ -167,6 +175,20 @@ const struct {
     {"texture with optional third component not zero", "3D texture coordinates are not supported"}
 };
 
+const struct {
+    const char* name;
+    const char* append;
+    const char* message;
+} ParallelData[]{
+    {"", "", nullptr},
+    {"error in the last chunk", "v 1 2\n",
+        "invalid float array size"},
+    {"unknown keyword in the last chunk", "bleh\n",
+        "unknown keyword bleh"},
+    {"mixed primitive in the last chunk", "p 1\n",
+        "mixed primitive MeshPrimitive::Triangles and MeshPrimitive::Points"},
+};
+
 ObjImporterTest::ObjImporterTest() {
     addTests({&ObjImporterTest::empty,
 
@@ -181,6 +203,7 @@ ObjImporterTest::ObjImporterTest() {
               &ObjImporterTest::meshTextureCoordinatesNormals,
 
               &ObjImporterTest::meshIgnoredKeyword,
+              &ObjImporterTest::meshFloatLiterals,
 
               &ObjImporterTest::meshNamed});
 
@@ -210,6 +233,9 @@ ObjImporterTest::ObjImporterTest() {
     addInstancedTests({&ObjImporterTest::invalidOptionalCoordinate},
         Containers::arraySize(InvalidOptionalCoordinateData));
 
+    addInstancedTests({&ObjImporterTest::parallel},
+        Containers::arraySize(ParallelData));
+
     addTests({&ObjImporterTest::openTwice,
               &ObjImporterTest::importTwice});
 
@@ -452,6 +478,29 @@ void ObjImporterTest::meshIgnoredKeyword() {
         TestSuite::Compare::Container);
 }
 
+void ObjImporterTest::meshFloatLiterals() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Path::join(OBJIMPORTER_TEST_DIR, "mesh-float-literals.obj")));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+
+    /* All the less common literal forms should be accepted */
+    const Containers::Optional<MeshData> data = importer->mesh(0);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data->primitive(), MeshPrimitive::Points);
+    CORRADE_COMPARE(data->attributeCount(), 1);
+    CORRADE_COMPARE_AS(data->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {0.5f, -0.25f, 5.0f},
+            {1.0f, 10.0f, 0.1f},
+            {2.5f, 0.0f, 6.25f}
+        }), TestSuite::Compare::Container);
+    CORRADE_VERIFY(data->isIndexed());
+    CORRADE_COMPARE(data->indexType(), MeshIndexType::UnsignedInt);
+    CORRADE_COMPARE_AS(data->indices<UnsignedInt>(),
+        Containers::arrayView<UnsignedInt>({0, 1, 2}),
+        TestSuite::Compare::Container);
+}
+
 void ObjImporterTest::meshNamed() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
     CORRADE_VERIFY(importer->openFile(Utility::Path::join(OBJIMPORTER_TEST_DIR, "mesh-named.obj")));
@@ -666,6 +715,64 @@ void ObjImporterTest::invalidOptionalCoordinate() {
     CORRADE_COMPARE(out.str(), Utility::formatString("Trade::ObjImporter::mesh(): {}\n", data.message));
 }
 
+void ObjImporterTest::parallel() {
+    auto&& data = ParallelData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Generate a file that's large enough to be split into several chunks,
+       with vertex data interleaved with faces so each chunk has both */
+    std::string file = "o Strip\n";
+    for(UnsignedInt i = 1; i <= 16384; ++i) {
+        file += Utility::formatString("v {} {} 0.5\nvt {} 0.25\nvn 0 0 {}\n", i*0.125f, i % 2, i*0.5f, i % 2 ? 1 : -1);
+        if(i >= 3)
+            file += Utility::formatString("f {0}/{0}/{0} {1}/{1}/{1} {2}/{2}/{2}\n", i - 2, i - 1, i);
+    }
+    file += data.append;
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    Containers::Pointer<AbstractImporter> parallelImporter = _manager.instantiate("ObjImporter");
+    parallelImporter->configuration().setValue("threads", 4);
+    CORRADE_VERIFY(importer->openData({file.data(), file.size()}));
+    CORRADE_VERIFY(parallelImporter->openData({file.data(), file.size()}));
+
+    /* If an error is expected, it should be the same in both cases */
+    if(data.message) {
+        std::ostringstream out;
+        {
+            Error redirectError{&out};
+            CORRADE_VERIFY(!importer->mesh(0));
+            CORRADE_VERIFY(!parallelImporter->mesh(0));
+        }
+        const std::string expected = Utility::formatString("Trade::ObjImporter::mesh(): {}\n", data.message);
+        CORRADE_COMPARE(out.str(), expected + expected);
+        return;
+    }
+
+    const Containers::Optional<MeshData> mesh = importer->mesh(0);
+    const Containers::Optional<MeshData> parallelMesh = parallelImporter->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_VERIFY(parallelMesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(mesh->vertexCount(), 16384);
+    CORRADE_COMPARE(mesh->indexCount(), 16382*3);
+    CORRADE_COMPARE(parallelMesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE_AS(parallelMesh->indices<UnsignedInt>(),
+        mesh->indices<UnsignedInt>(),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(parallelMesh->attribute<Vector3>(MeshAttribute::Position),
+        mesh->attribute<Vector3>(MeshAttribute::Position),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(parallelMesh->attribute<Vector3>(MeshAttribute::Normal),
+        mesh->attribute<Vector3>(MeshAttribute::Normal),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(parallelMesh->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        mesh->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        TestSuite::Compare::Container);
+
+    /* Verify the data got actually parsed correctly at the end as well */
+    CORRADE_COMPARE(parallelMesh->attribute<Vector3>(MeshAttribute::Position)[16383], (Vector3{2048.0f, 0.0f, 0.5f}));
+}
+
 void ObjImporterTest::openTwice() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
 
@@ -30,6 +30,7 @@
 #include <Corrade/Containers/StringView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h> /** @todo remove once Debug is stream-free */
 #include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Path.h>
@@ -51,6 +52,7 @@ struct TgaImageConverterTest: TestSuite::Tester {
 
     void rgb();
     void rgba();
+    void rle();
 
     void unsupportedMetadata();
 
@@ -80,6 +82,51 @@ const struct {
         "1D array images are unrepresentable in TGA, saving as a regular 2D image"}
 };
 
+/* Runs of five and eight equal pixels, separated by three different ones */
+constexpr char RleDataGrayscale[]{
+    1, 1, 1, 1, 1, 2, 3, 4,
+    5, 5, 5, 5, 5, 5, 5, 5
+};
+constexpr char RleDataRGB[]{
+    1, 2, 3, 1, 2, 3, 1, 2, 3, 1, 2, 3, 1, 2, 3, 2, 4, 6, 3, 6, 9, 4, 8, 12,
+    5, 10, 15, 5, 10, 15, 5, 10, 15, 5, 10, 15, 5, 10, 15, 5, 10, 15, 5, 10, 15, 5, 10, 15
+};
+constexpr char RleDataRGBA[]{
+    1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4, 2, 4, 6, 8, 3, 6, 9, 12, 4, 8, 12, 16,
+    5, 10, 15, 20, 5, 10, 15, 20, 5, 10, 15, 20, 5, 10, 15, 20, 5, 10, 15, 20, 5, 10, 15, 20, 5, 10, 15, 20, 5, 10, 15, 20
+};
+/* Repeat packet, raw packet, repeat packet, with channels swizzled */
+constexpr char RleExpectedGrayscale[]{
+    '\x84', 1, '\x02', 2, 3, 4, '\x87', 5
+};
+constexpr char RleExpectedRGB[]{
+    '\x84', 3, 2, 1, '\x02', 6, 4, 2, 9, 6, 3, 12, 8, 4, '\x87', 15, 10, 5
+};
+constexpr char RleExpectedRGBA[]{
+    '\x84', 3, 2, 1, 4, '\x02', 6, 4, 2, 8, 9, 6, 3, 12, 12, 8, 4, 16, '\x87', 15, 10, 5, 20
+};
+
+const struct {
+    const char* name;
+    PixelFormat format;
+    Containers::ArrayView<const char> data;
+    char imageType;
+    Containers::ArrayView<const char> expected;
+    const char* message;
+} RleData[]{
+    {"grayscale", PixelFormat::R8Unorm, Containers::arrayView(RleDataGrayscale), 11,
+        Containers::arrayView(RleExpectedGrayscale),
+        "Trade::TgaImageConverter::convertToData(): RLE-compressed 16 bytes to 8\n"},
+    {"RGB", PixelFormat::RGB8Unorm, Containers::arrayView(RleDataRGB), 10,
+        Containers::arrayView(RleExpectedRGB),
+        "Trade::TgaImageConverter::convertToData(): converting from RGB to BGR\n"
+        "Trade::TgaImageConverter::convertToData(): RLE-compressed 48 bytes to 18\n"},
+    {"RGBA", PixelFormat::RGBA8Unorm, Containers::arrayView(RleDataRGBA), 10,
+        Containers::arrayView(RleExpectedRGBA),
+        "Trade::TgaImageConverter::convertToData(): converting from RGBA to BGRA\n"
+        "Trade::TgaImageConverter::convertToData(): RLE-compressed 64 bytes to 23\n"},
+};
+
 TgaImageConverterTest::TgaImageConverterTest() {
     addTests({&TgaImageConverterTest::wrongFormat});
 
@@ -88,6 +135,9 @@ TgaImageConverterTest::TgaImageConverterTest() {
         &TgaImageConverterTest::rgba},
         Containers::arraySize(VerboseData));
 
+    addInstancedTests({&TgaImageConverterTest::rle},
+        Containers::arraySize(RleData));
+
     addInstancedTests({&TgaImageConverterTest::unsupportedMetadata},
         Containers::arraySize(UnsupportedMetadataData));
 
@@ -199,6 +249,41 @@ void TgaImageConverterTest::rgba() {
     CORRADE_COMPARE(out.str(), data.message32);
 }
 
+void TgaImageConverterTest::rle() {
+    auto&& data = RleData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    converter->configuration().setValue("rle", true);
+    converter->setFlags(ImageConverterFlag::Verbose);
+
+    const ImageView2D image{data.format, {8, 2}, data.data};
+
+    std::ostringstream out;
+    Containers::Optional<Containers::Array<char>> array;
+    {
+        Debug redirectOutput{&out};
+        array = converter->convertToData(image);
+    }
+    CORRADE_VERIFY(array);
+    CORRADE_COMPARE(out.str(), data.message);
+    CORRADE_COMPARE((*array)[2], data.imageType);
+    CORRADE_COMPARE_AS(array->exceptPrefix(18), data.expected,
+        TestSuite::Compare::Container);
+
+    if(!(_importerManager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TgaImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(*array));
+    Containers::Optional<Trade::ImageData2D> converted = importer->image2D(0);
+    CORRADE_VERIFY(converted);
+    CORRADE_COMPARE(converted->size(), Vector2i(8, 2));
+    CORRADE_COMPARE(converted->format(), data.format);
+    CORRADE_COMPARE_AS(converted->data(), data.data,
+        TestSuite::Compare::Container);
+}
+
 void TgaImageConverterTest::unsupportedMetadata() {
     auto&& data = UnsupportedMetadataData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
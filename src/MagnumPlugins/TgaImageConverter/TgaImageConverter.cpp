@@ -25,16 +25,20 @@
 
 #include "TgaImageConverter.h"
 
+#include <cstring>
 #include <fstream>
 #include <tuple>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Endianness.h>
 
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
-#include "Magnum/Math/Swizzle.h"
+#include "Magnum/Math/SwizzleBatch.h"
 #include "Magnum/Math/Vector4.h"
 #include "MagnumPlugins/TgaImporter/TgaHeader.h"
 
@@ -46,13 +50,65 @@ TgaImageConverter::TgaImageConverter(PluginManager::AbstractManager& manager, co
 
 ImageConverterFeatures TgaImageConverter::doFeatures() const { return ImageConverterFeature::Convert2DToData; }
 
+namespace {
+
+/* Encodes contiguous pixels of given size into RLE packets, returns the size
+   of the output. Packets don't cross scanlines, as recommended by the TGA
+   2.0 specification. A run of two or more equal pixels at the start of a
+   packet is never larger as a repeat packet (for single-byte pixels and a
+   run of two it's the same size), a raw packet is ended when a run of three
+   equal pixels starts, as that's where splitting the raw packet saves more
+   than the extra packet header costs. Thus, in the worst case, the
+   output is the size of the input plus one packet header for each 128 pixels
+   of a row. */
+template<std::size_t size> std::size_t encodeRle(const char* src, char* const out, const std::size_t width, const std::size_t height) {
+    char* dst = out;
+    for(std::size_t y = 0; y != height; ++y) {
+        const char* const rowEnd = src + width*size;
+        while(src != rowEnd) {
+            const std::size_t remaining = (rowEnd - src)/size;
+            const std::size_t max = remaining < 128 ? remaining : 128;
+
+            /* Count how many times the first pixel repeats */
+            std::size_t repeat = 1;
+            while(repeat != max && std::memcmp(src, src + repeat*size, size) == 0)
+                ++repeat;
+            if(repeat > 1) {
+                *dst++ = char(0x80|(repeat - 1));
+                std::memcpy(dst, src, size);
+                dst += size;
+                src += repeat*size;
+                continue;
+            }
+
+            /* Otherwise take pixels as-is until a run of three starts */
+            std::size_t raw = 1;
+            while(raw != max && !(raw + 2 < remaining &&
+                std::memcmp(src + raw*size, src + (raw + 1)*size, size) == 0 &&
+                std::memcmp(src + raw*size, src + (raw + 2)*size, size) == 0))
+                ++raw;
+            *dst++ = char(raw - 1);
+            std::memcpy(dst, src, raw*size);
+            dst += raw*size;
+            src += raw*size;
+        }
+    }
+
+    return dst - out;
+}
+
+}
+
 Containers::Optional<Containers::Array<char>> TgaImageConverter::doConvertToData(const ImageView2D& image) {
     /* Warn about lost metadata */
     if(image.flags() & ImageFlag2D::Array) {
         Warning{} << "Trade::TgaImageConverter::convertToData(): 1D array images are unrepresentable in TGA, saving as a regular 2D image";
     }
 
-    /* Initialize data buffer */
+    const bool rle = configuration().value<bool>("rle");
+
+    /* Initialize data buffer. With RLE enabled this is a temporary that gets
+       encoded into the output at the end. */
     const auto pixelSize = UnsignedByte(image.pixelSize());
     Containers::Array<char> data{ValueInit, sizeof(Implementation::TgaHeader) + pixelSize*image.size().product()};
 
@@ -61,10 +117,10 @@ Containers::Optional<Containers::Array<char>> TgaImageConverter::doConvertToData
     switch(image.format()) {
         case PixelFormat::RGB8Unorm:
         case PixelFormat::RGBA8Unorm:
-            header->imageType = 2;
+            header->imageType = rle ? 10 : 2;
             break;
         case PixelFormat::R8Unorm:
-            header->imageType = 3;
+            header->imageType = rle ? 11 : 3;
             break;
         default:
             Error() << "Trade::TgaImageConverter::convertToData(): unsupported pixel format" << image.format();
@@ -82,13 +138,37 @@ Containers::Optional<Containers::Array<char>> TgaImageConverter::doConvertToData
     if(image.format() == PixelFormat::RGB8Unorm) {
         if(flags() & ImageConverterFlag::Verbose)
             Debug{} << "Trade::TgaImageConverter::convertToData(): converting from RGB to BGR";
-        for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(pixels))
-            pixel = Math::gather<'b', 'g', 'r'>(pixel);
+        Math::swapRedBlueInPlace(Containers::arrayCast<Vector3ub>(pixels));
     } else if(image.format() == PixelFormat::RGBA8Unorm) {
         if(flags() & ImageConverterFlag::Verbose)
             Debug{} << "Trade::TgaImageConverter::convertToData(): converting from RGBA to BGRA";
-        for(Vector4ub& pixel: Containers::arrayCast<Vector4ub>(pixels))
-            pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
+        Math::swapRedBlueInPlace(Containers::arrayCast<Vector4ub>(pixels));
+    }
+
+    if(rle) {
+        const std::size_t width = image.size().x();
+        const std::size_t height = image.size().y();
+        Containers::Array<char> out{NoInit, sizeof(Implementation::TgaHeader) + height*(width*pixelSize + (width + 127)/128)};
+        Utility::copy(data.prefix(sizeof(Implementation::TgaHeader)), out.prefix(sizeof(Implementation::TgaHeader)));
+
+        const Containers::ArrayView<char> outPixels = out.exceptPrefix(sizeof(Implementation::TgaHeader));
+        std::size_t outPixelsSize;
+        if(pixelSize == 1)
+            outPixelsSize = encodeRle<1>(pixels.data(), outPixels.data(), width, height);
+        else if(pixelSize == 3)
+            outPixelsSize = encodeRle<3>(pixels.data(), outPixels.data(), width, height);
+        else
+            outPixelsSize = encodeRle<4>(pixels.data(), outPixels.data(), width, height);
+        CORRADE_INTERNAL_ASSERT(outPixelsSize <= outPixels.size());
+
+        if(flags() & ImageConverterFlag::Verbose)
+            Debug{} << "Trade::TgaImageConverter::convertToData(): RLE-compressed" << pixels.size() << "bytes to" << outPixelsSize;
+
+        /* Copy to an array of the exact size. Not using arrayResize() as
+           that would make the array have a custom deleter, which isn't
+           allowed. */
+        data = Containers::Array<char>{NoInit, sizeof(Implementation::TgaHeader) + outPixelsSize};
+        Utility::copy(out.prefix(data.size()), data);
     }
 
     /* GCC 4.8 needs extra help here */
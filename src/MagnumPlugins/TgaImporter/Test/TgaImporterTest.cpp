@@ -62,6 +62,7 @@ struct TgaImporterTest: TestSuite::Tester {
     void rleTooLarge();
 
     void openMemory();
+    void zeroCopy();
     void openTwice();
     void importTwice();
 
@@ -110,6 +111,19 @@ constexpr const char Color24Rle[] = {
     '\x82', 4, 5, 6
 };
 
+constexpr const char Grayscale8[] = {
+    0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+    1, 2,
+    3, 4,
+    5, 6
+};
+
+constexpr const char Grayscale8Rle[] = {
+    0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+    /* 6 pixels as-is */
+    '\x05', 1, 2, 3, 4, 5, 6
+};
+
 /* MSVC 2015 crashes when seeing constexpr here. Not doing that, then. */
 const struct {
     const char* name;
@@ -142,6 +156,31 @@ const struct {
     }},
 };
 
+/* MSVC 2015 crashes when seeing constexpr here. Not doing that, then. */
+const struct {
+    const char* name;
+    ImporterFlags flags;
+    bool memory;
+    Containers::ArrayView<const char> data;
+    PixelFormat format;
+    bool expectReferenced;
+    const char* message;
+} ZeroCopyData[]{
+    {"grayscale, memory", ImporterFlag::ZeroCopy, true,
+        Containers::arrayView(Grayscale8), PixelFormat::R8Unorm, true, ""},
+    {"grayscale, memory, verbose", ImporterFlag::ZeroCopy|ImporterFlag::Verbose, true,
+        Containers::arrayView(Grayscale8), PixelFormat::R8Unorm, true,
+        "Trade::TgaImporter::image2D(): referencing the data directly\n"},
+    {"grayscale, memory, flag not set", {}, true,
+        Containers::arrayView(Grayscale8), PixelFormat::R8Unorm, false, ""},
+    {"grayscale, data", ImporterFlag::ZeroCopy, false,
+        Containers::arrayView(Grayscale8), PixelFormat::R8Unorm, false, ""},
+    {"grayscale RLE, memory", ImporterFlag::ZeroCopy, true,
+        Containers::arrayView(Grayscale8Rle), PixelFormat::R8Unorm, false, ""},
+    {"color, memory", ImporterFlag::ZeroCopy, true,
+        Containers::arrayView(Color24), PixelFormat::RGB8Unorm, false, ""},
+};
+
 TgaImporterTest::TgaImporterTest() {
     addTests({&TgaImporterTest::openEmpty});
 
@@ -170,6 +209,9 @@ TgaImporterTest::TgaImporterTest() {
     addInstancedTests({&TgaImporterTest::openMemory},
         Containers::arraySize(OpenMemoryData));
 
+    addInstancedTests({&TgaImporterTest::zeroCopy},
+        Containers::arraySize(ZeroCopyData));
+
     addTests({&TgaImporterTest::openTwice,
               &TgaImporterTest::importTwice});
 
@@ -462,6 +504,46 @@ void TgaImporterTest::openMemory() {
     }), TestSuite::Compare::Container);
 }
 
+void TgaImporterTest::zeroCopy() {
+    auto&& data = ZeroCopyData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    importer->setFlags(data.flags);
+    if(data.memory)
+        CORRADE_VERIFY(importer->openMemory(data.data));
+    else
+        CORRADE_VERIFY(importer->openData(data.data));
+
+    std::ostringstream out;
+    Containers::Optional<Trade::ImageData2D> image;
+    {
+        Debug redirectOutput{&out};
+        image = importer->image2D(0);
+    }
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->format(), data.format);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE(out.str(), data.message);
+
+    if(data.expectReferenced) {
+        CORRADE_COMPARE(image->dataFlags(), DataFlag::ExternallyOwned);
+        CORRADE_COMPARE(image->data().data(), data.data.data() + 18);
+    } else {
+        CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+        CORRADE_VERIFY(image->data().data() != data.data.data() + 18);
+    }
+
+    /* The contents are the same in both cases */
+    if(data.format == PixelFormat::R8Unorm) {
+        CORRADE_COMPARE_AS(image->data(), Containers::arrayView<char>({
+            1, 2,
+            3, 4,
+            5, 6
+        }), TestSuite::Compare::Container);
+    }
+}
+
 void TgaImporterTest::openTwice() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
 
@@ -25,13 +25,14 @@
 
 #include "TgaImporter.h"
 
-#include <Corrade/Containers/ArrayView.h>
+#include <cstring>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Endianness.h>
 
 #include "Magnum/PixelFormat.h"
-#include "Magnum/Math/Swizzle.h"
+#include "Magnum/Math/SwizzleBatch.h"
 #include "Magnum/Math/Vector4.h"
 #include "Magnum/Trade/ImageData.h"
 #include "MagnumPlugins/TgaImporter/TgaHeader.h"
@@ -48,7 +49,10 @@ ImporterFeatures TgaImporter::doFeatures() const { return ImporterFeature::OpenD
 
 bool TgaImporter::doIsOpened() const { return _in; }
 
-void TgaImporter::doClose() { _in = nullptr; }
+void TgaImporter::doClose() {
+    _in = nullptr;
+    _inDataFlags = {};
+}
 
 void TgaImporter::doOpenData(Containers::Array<char>&& data, const DataFlags dataFlags) {
     /* Because here we're copying the data and using the _in to check if file
@@ -66,9 +70,11 @@ void TgaImporter::doOpenData(Containers::Array<char>&& data, const DataFlags dat
     /* Ttake over the existing array or copy the data if we can't */
     if(dataFlags & (DataFlag::Owned|DataFlag::ExternallyOwned)) {
         _in = std::move(data);
+        _inDataFlags = dataFlags;
     } else {
         _in = Containers::Array<char>{NoInit, data.size()};
         Utility::copy(data, _in);
+        _inDataFlags = DataFlag::Owned|DataFlag::Mutable;
     }
 }
 
@@ -132,8 +138,12 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
     const std::size_t pixelSize = header.bpp/8;
     const std::size_t outputSize = std::size_t(size.product())*pixelSize;
 
+    /* Adjust pixel storage if row size is not four byte aligned */
+    PixelStorage storage;
+    if((size.x()*header.bpp/8)%4 != 0)
+        storage.setAlignment(1);
+
     /* Copy data directly if not RLE */
-    Containers::Array<char> data{outputSize};
     Containers::ArrayView<const char> srcPixels = _in.exceptPrefix(sizeof(Implementation::TgaHeader));
     if(!rle) {
         /* Files that are larger are allowed in this case (but not for RLE) */
@@ -142,6 +152,21 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
             return Containers::NullOpt;
         }
 
+        /* If the memory is guaranteed to stay in scope and no swizzle is
+           needed, reference it directly instead of copying */
+        if((flags() & ImporterFlag::ZeroCopy) && format == PixelFormat::R8Unorm && (_inDataFlags & DataFlag::ExternallyOwned)) {
+            if(flags() & ImporterFlag::Verbose)
+                Debug{} << "Trade::TgaImporter::image2D(): referencing the data directly";
+            return ImageData2D{storage, format, size, DataFlag::ExternallyOwned, srcPixels.prefix(outputSize)};
+        }
+    }
+
+    /* Uncompressed data overwrite the whole output, RLE data may be shorter
+       than advertised and the rest should be zero-filled */
+    Containers::Array<char> data = rle ?
+        Containers::Array<char>{ValueInit, outputSize} :
+        Containers::Array<char>{NoInit, outputSize};
+    if(!rle) {
         Utility::copy(srcPixels.prefix(data.size()), data);
 
     /* Otherwise decode */
@@ -157,9 +182,9 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
 
             /* First bit set to 1 means copying the following pixel given
                number of times, 0 means copying the following number of
-               pixels once. We represent that operation with a stride. */
-            const std::size_t dataSize = (rleHeader & 0x80 ? 1 : count)*pixelSize;
-            const std::ptrdiff_t stride = rleHeader & 0x80 ? 0 : pixelSize;
+               pixels once. */
+            const bool repeat = rleHeader & 0x80;
+            const std::size_t dataSize = (repeat ? 1 : count)*pixelSize;
 
             /* Check bounds */
             if(1 + dataSize > srcPixels.size()) {
@@ -171,14 +196,20 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
                 return Containers::NullOpt;
             }
 
-            /* Copy the data */
-            Containers::StridedArrayView2D<const char> src{
-                srcPixels.slice(1, 1 + dataSize),
-                {count, pixelSize}, {stride, 1}};
-            Containers::StridedArrayView2D<char> dst{
-                dstPixels.prefix(count*pixelSize),
-                {count, pixelSize}};
-            Utility::copy(src, dst);
+            /* Copy the data. Raw packets are a single contiguous copy,
+               repeated grayscale pixels a memset() and the others are
+               copied pixel by pixel with a compile-time size. */
+            const char* const src = srcPixels.data() + 1;
+            char* const dst = dstPixels.data();
+            if(!repeat)
+                std::memcpy(dst, src, dataSize);
+            else if(pixelSize == 1)
+                std::memset(dst, *src, count);
+            else if(pixelSize == 3)
+                for(std::size_t i = 0; i != count; ++i)
+                    std::memcpy(dst + i*3, src, 3);
+            else for(std::size_t i = 0; i != count; ++i)
+                std::memcpy(dst + i*4, src, 4);
 
             /* Update views for the next round */
             srcPixels = srcPixels.exceptPrefix(1 + dataSize);
@@ -186,21 +217,14 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
         }
     }
 
-    /* Adjust pixel storage if row size is not four byte aligned */
-    PixelStorage storage;
-    if((size.x()*header.bpp/8)%4 != 0)
-        storage.setAlignment(1);
-
     if(format == PixelFormat::RGB8Unorm) {
         if(flags() & ImporterFlag::Verbose)
             Debug{} << "Trade::TgaImporter::image2D(): converting from BGR to RGB";
-        for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(data))
-            pixel = Math::gather<'b', 'g', 'r'>(pixel);
+        Math::swapRedBlueInPlace(Containers::arrayCast<Vector3ub>(data));
     } else if(format == PixelFormat::RGBA8Unorm) {
         if(flags() & ImporterFlag::Verbose)
             Debug{} << "Trade::TgaImporter::image2D(): converting from BGRA to RGBA";
-        for(Vector4ub& pixel: Containers::arrayCast<Vector4ub>(data))
-            pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
+        Math::swapRedBlueInPlace(Containers::arrayCast<Vector4ub>(data));
     }
 
     return ImageData2D{storage, format, size, std::move(data)};
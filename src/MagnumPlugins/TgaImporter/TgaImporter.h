@@ -98,6 +98,13 @@ are imported with default @ref PixelStorage parameters except for alignment,
 which may be changed to `1` if the data require it.
 
 RLE compression is supported, paletted images are not.
+
+If @ref ImporterFlag::ZeroCopy is set, the file was opened using
+@ref openMemory() and it's an uncompressed grayscale image, the returned
+@ref ImageData2D references the opened memory directly instead of being a copy,
+with @ref DataFlag::ExternallyOwned set. Color images always need the BGR(A)
+channels swizzled to RGB(A) and RLE-compressed images need to be decoded, so a
+copy is made in that case.
 */
 class MAGNUM_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
     public:
@@ -118,6 +125,7 @@ class MAGNUM_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
         Containers::Optional<ImageData2D> MAGNUM_TGAIMPORTER_LOCAL doImage2D(UnsignedInt id, UnsignedInt level) override;
 
         Containers::Array<char> _in;
+        DataFlags _inDataFlags;
 };
 
 }}